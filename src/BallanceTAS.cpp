@@ -5,8 +5,11 @@
 #include "physics_RT.h"
 #include "TASHook.h"
 #include "TASEngine.h"
+#include "GameEvents.h"
+#include "ProjectManager.h"
 #include "InGameOSD.h"
 #include "Recorder.h"
+#include "ScriptContextManager.h"
 #include "GameInterface.h"
 #include "UIManager.h"
 #include "Logger.h"
@@ -74,6 +77,15 @@ void BallanceTAS::OnLoad() {
     m_RecordingMaxFrames->SetComment("Maximum frames to record (prevents memory issues)");
     m_RecordingMaxFrames->SetDefaultInteger(1000000);
 
+    m_RecordingRingSeconds = GetConfig()->GetProperty("Recording", "RingSeconds");
+    m_RecordingRingSeconds->SetComment("Keep only the last N seconds of a recording (0 = keep everything)");
+    m_RecordingRingSeconds->SetDefaultFloat(0.0f);
+
+    // --- Scripting Configuration ---
+    m_ParallelContexts = GetConfig()->GetProperty("Scripting", "ParallelContexts");
+    m_ParallelContexts->SetComment("Tick script contexts marked as isolated on worker threads");
+    m_ParallelContexts->SetDefaultBoolean(false);
+
     // --- Startup Script Configuration ---
     m_StartupScriptEnabled = GetConfig()->GetProperty("Startup", "Enabled");
     m_StartupScriptEnabled->SetComment("Enable startup script auto-loading");
@@ -188,6 +200,14 @@ void BallanceTAS::OnModifyConfig(const char *category, const char *key, IPropert
         if (m_Engine && m_Engine->GetRecorder()) {
             m_Engine->GetRecorder()->SetMaxFrames(m_RecordingMaxFrames->GetInteger());
         }
+    } else if (prop == m_RecordingRingSeconds && m_Initialized) {
+        if (m_Engine && m_Engine->GetRecorder()) {
+            m_Engine->GetRecorder()->SetRingBufferSeconds(m_RecordingRingSeconds->GetFloat());
+        }
+    } else if (prop == m_ParallelContexts && m_Initialized) {
+        if (m_Engine && m_Engine->GetScriptContextManager()) {
+            m_Engine->GetScriptContextManager()->SetParallelTicking(m_ParallelContexts->GetBoolean());
+        }
     } else if (prop == m_StopKey) {
         // Update the stop key for the UI manager
         if (m_UIManager) {
@@ -363,9 +383,14 @@ bool BallanceTAS::Initialize() {
         // Configure recording settings
         if (auto *recorder = m_Engine->GetRecorder()) {
             recorder->SetMaxFrames(m_RecordingMaxFrames->GetInteger());
+            recorder->SetRingBufferSeconds(m_RecordingRingSeconds->GetFloat());
             recorder->SetAutoGenerate(true); // Always auto-generate
         }
 
+        if (auto *contextManager = m_Engine->GetScriptContextManager()) {
+            contextManager->SetParallelTicking(m_ParallelContexts->GetBoolean());
+        }
+
         return true;
     } catch (const std::exception &e) {
         Log::Error("Exception during initialization: %s", e.what());
@@ -450,6 +475,18 @@ void BallanceTAS::OnMenuStart() {
 }
 
 void BallanceTAS::OnProcess() {
+    if (m_Initialized && m_Engine) {
+        // Publish the project list of a finished background scan
+        if (auto *projectManager = m_Engine->GetProjectManager()) {
+            projectManager->PollRefresh();
+        }
+
+        // Grow recording storage here rather than inside the input hook
+        if (auto *recorder = m_Engine->GetRecorder()) {
+            recorder->PrepareStorage();
+        }
+    }
+
     if (m_Initialized && m_Engine && m_UIManager) {
         OnMenuStart();
 
@@ -501,13 +538,13 @@ void BallanceTAS::SkipRenderingForTicks(size_t ticks) {
 
 void BallanceTAS::OnPreStartMenu() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("pre_start_menu");
+        m_Engine->OnGameEvent(GameEvents::PreStartMenu);
     }
 }
 
 void BallanceTAS::OnPostStartMenu() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("post_start_menu");
+        m_Engine->OnGameEvent(GameEvents::PostStartMenu);
     }
 }
 
@@ -518,129 +555,129 @@ void BallanceTAS::OnExitGame() {
 void BallanceTAS::OnPreLoadLevel() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
         m_Engine->Start();
-        m_Engine->OnGameEvent("pre_load_level");
+        m_Engine->OnGameEvent(GameEvents::PreLoadLevel);
     }
 }
 
 void BallanceTAS::OnPostLoadLevel() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("post_load_level");
+        m_Engine->OnGameEvent(GameEvents::PostLoadLevel);
     }
 }
 
 void BallanceTAS::OnStartLevel() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("start_level");
+        m_Engine->OnGameEvent(GameEvents::StartLevel);
     }
 }
 
 void BallanceTAS::OnPreResetLevel() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("pre_reset_level");
+        m_Engine->OnGameEvent(GameEvents::PreResetLevel);
         m_Engine->Stop();
     }
 }
 
 void BallanceTAS::OnPostResetLevel() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("post_reset_level");
+        m_Engine->OnGameEvent(GameEvents::PostResetLevel);
     }
 }
 
 void BallanceTAS::OnPauseLevel() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("pause_level");
+        m_Engine->OnGameEvent(GameEvents::PauseLevel);
     }
 }
 
 void BallanceTAS::OnUnpauseLevel() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("unpause_level");
+        m_Engine->OnGameEvent(GameEvents::UnpauseLevel);
     }
 }
 
 void BallanceTAS::OnPreExitLevel() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("pre_exit_level");
+        m_Engine->OnGameEvent(GameEvents::PreExitLevel);
         m_Engine->Stop();
     }
 }
 
 void BallanceTAS::OnPostExitLevel() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("post_exit_level");
+        m_Engine->OnGameEvent(GameEvents::PostExitLevel);
     }
 }
 
 void BallanceTAS::OnPreNextLevel() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("pre_next_level");
+        m_Engine->OnGameEvent(GameEvents::PreNextLevel);
     }
 }
 
 void BallanceTAS::OnPostNextLevel() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("post_next_level");
+        m_Engine->OnGameEvent(GameEvents::PostNextLevel);
     }
 }
 
 void BallanceTAS::OnDead() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("ball_off");
+        m_Engine->OnGameEvent(GameEvents::BallOff);
     }
 }
 
 void BallanceTAS::OnPreEndLevel() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("pre_level_end");
+        m_Engine->OnGameEvent(GameEvents::PreLevelEnd);
     }
 }
 
 void BallanceTAS::OnPostEndLevel() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("post_level_end");
+        m_Engine->OnGameEvent(GameEvents::PostLevelEnd);
     }
 }
 
 void BallanceTAS::OnCounterActive() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("counter_active");
+        m_Engine->OnGameEvent(GameEvents::CounterActive);
     }
 }
 
 void BallanceTAS::OnCounterInactive() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("counter_inactive");
+        m_Engine->OnGameEvent(GameEvents::CounterInactive);
     }
 }
 
 void BallanceTAS::OnBallNavActive() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("ball_nav_active");
+        m_Engine->OnGameEvent(GameEvents::BallNavActive);
     }
 }
 
 void BallanceTAS::OnBallNavInactive() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("ball_nav_inactive");
+        m_Engine->OnGameEvent(GameEvents::BallNavInactive);
     }
 }
 
 void BallanceTAS::OnCamNavActive() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("cam_nav_active");
+        m_Engine->OnGameEvent(GameEvents::CamNavActive);
     }
 }
 
 void BallanceTAS::OnCamNavInactive() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("cam_nav_inactive");
+        m_Engine->OnGameEvent(GameEvents::CamNavInactive);
     }
 }
 
 void BallanceTAS::OnBallOff() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("ball_off");
+        m_Engine->OnGameEvent(GameEvents::BallOff);
     }
 }
 
@@ -650,7 +687,7 @@ void BallanceTAS::OnPreCheckpointReached() {
         if (m_Engine->GetGameInterface()) {
             sector = m_Engine->GetGameInterface()->GetCurrentSector();
         }
-        m_Engine->OnGameEvent("pre_checkpoint_reached", sector);
+        m_Engine->OnGameEvent(GameEvents::PreCheckpointReached, sector);
     }
 }
 
@@ -660,13 +697,13 @@ void BallanceTAS::OnPostCheckpointReached() {
         if (m_Engine->GetGameInterface()) {
             sector = m_Engine->GetGameInterface()->GetCurrentSector();
         }
-        m_Engine->OnGameEvent("post_checkpoint_reached", sector);
+        m_Engine->OnGameEvent(GameEvents::PostCheckpointReached, sector);
     }
 }
 
 void BallanceTAS::OnLevelFinish() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("level_finish");
+        m_Engine->OnGameEvent(GameEvents::LevelFinish);
         if (m_StopOnFinish->GetBoolean()) {
             m_Engine->Stop();
         }
@@ -675,7 +712,7 @@ void BallanceTAS::OnLevelFinish() {
 
 void BallanceTAS::OnGameOver() {
     if (m_Initialized && m_Engine && !m_Engine->IsShuttingDown()) {
-        m_Engine->OnGameEvent("game_over");
+        m_Engine->OnGameEvent(GameEvents::GameOver);
     }
 }
 
@@ -685,7 +722,7 @@ void BallanceTAS::OnExtraPoint() {
         if (m_Engine->GetGameInterface()) {
             points = m_Engine->GetGameInterface()->GetPoints();
         }
-        m_Engine->OnGameEvent("extra_point", points);
+        m_Engine->OnGameEvent(GameEvents::ExtraPoint, points);
     }
 }
 
@@ -695,7 +732,7 @@ void BallanceTAS::OnPreSubLife() {
         if (m_Engine->GetGameInterface()) {
             lifeCount = m_Engine->GetGameInterface()->GetLifeCount();
         }
-        m_Engine->OnGameEvent("pre_sub_life", lifeCount);
+        m_Engine->OnGameEvent(GameEvents::PreSubLife, lifeCount);
     }
 }
 
@@ -705,7 +742,7 @@ void BallanceTAS::OnPostSubLife() {
         if (m_Engine->GetGameInterface()) {
             lifeCount = m_Engine->GetGameInterface()->GetLifeCount();
         }
-        m_Engine->OnGameEvent("post_sub_life", lifeCount);
+        m_Engine->OnGameEvent(GameEvents::PostSubLife, lifeCount);
     }
 }
 
@@ -715,7 +752,7 @@ void BallanceTAS::OnPreLifeUp() {
         if (m_Engine->GetGameInterface()) {
             lifeCount = m_Engine->GetGameInterface()->GetLifeCount();
         }
-        m_Engine->OnGameEvent("pre_life_up", lifeCount);
+        m_Engine->OnGameEvent(GameEvents::PreLifeUp, lifeCount);
     }
 }
 
@@ -725,6 +762,6 @@ void BallanceTAS::OnPostLifeUp() {
         if (m_Engine->GetGameInterface()) {
             lifeCount = m_Engine->GetGameInterface()->GetLifeCount();
         }
-        m_Engine->OnGameEvent("post_life_up", lifeCount);
+        m_Engine->OnGameEvent(GameEvents::PostLifeUp, lifeCount);
     }
 }
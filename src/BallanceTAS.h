@@ -213,6 +213,10 @@ private:
 
     // --- Recording Configuration ---
     IProperty *m_RecordingMaxFrames = nullptr;
+    IProperty *m_RecordingRingSeconds = nullptr;
+
+    // --- Scripting Configuration ---
+    IProperty *m_ParallelContexts = nullptr;
 
     // --- Startup Script Configuration ---
     IProperty *m_StartupScriptEnabled = nullptr;
@@ -1,7 +1,68 @@
 #include "EventManager.h"
 
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
 #include "Logger.h"
 
+// ============================================================================
+// Event Name Interning
+// ============================================================================
+
+namespace {
+    struct EventNameTable {
+        std::shared_mutex mutex;
+        std::unordered_map<std::string, EventManager::EventId> ids;
+        std::deque<std::string> names{std::string()}; // Index 0 is kInvalidEventId; deque keeps references stable
+    };
+
+    EventNameTable &GetEventNameTable() {
+        static EventNameTable table;
+        return table;
+    }
+}
+
+EventManager::EventId EventManager::InternEvent(const std::string &eventName) {
+    if (eventName.empty()) {
+        return kInvalidEventId;
+    }
+
+    auto &table = GetEventNameTable();
+    {
+        std::shared_lock lock(table.mutex);
+        auto it = table.ids.find(eventName);
+        if (it != table.ids.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock lock(table.mutex);
+    auto [it, inserted] = table.ids.try_emplace(eventName, static_cast<EventId>(table.names.size()));
+    if (inserted) {
+        table.names.push_back(eventName);
+    }
+    return it->second;
+}
+
+EventManager::EventId EventManager::FindEvent(const std::string &eventName) {
+    auto &table = GetEventNameTable();
+    std::shared_lock lock(table.mutex);
+    auto it = table.ids.find(eventName);
+    return it != table.ids.end() ? it->second : kInvalidEventId;
+}
+
+const std::string &EventManager::GetEventName(EventId id) {
+    auto &table = GetEventNameTable();
+    std::shared_lock lock(table.mutex);
+    return id < table.names.size() ? table.names[id] : table.names[kInvalidEventId];
+}
+
+// ============================================================================
+// Listener Registration
+// ============================================================================
+
 EventManager::ListenerId EventManager::RegisterListener(const std::string &eventName, sol::function callback, bool oneTime) {
     if (eventName.empty()) {
         HandleError(eventName, "Event name cannot be empty");
@@ -13,9 +74,7 @@ EventManager::ListenerId EventManager::RegisterListener(const std::string &event
         return kInvalidListenerId;
     }
 
-    ListenerId id = m_NextListenerId.fetch_add(1, std::memory_order_relaxed);
-    m_Listeners[eventName].emplace_back(id, std::move(callback), oneTime);
-    return id;
+    return RegisterListener(InternEvent(eventName), Callback(std::move(callback)), oneTime);
 }
 
 EventManager::ListenerId EventManager::RegisterListener(const std::string &eventName, std::function<void()> callback, bool oneTime) {
@@ -29,9 +88,28 @@ EventManager::ListenerId EventManager::RegisterListener(const std::string &event
         return kInvalidListenerId;
     }
 
-    ListenerId id = m_NextListenerId.fetch_add(1, std::memory_order_relaxed);
-    m_Listeners[eventName].emplace_back(id, std::move(callback), oneTime);
-    return id;
+    return RegisterListener(InternEvent(eventName), Callback(std::move(callback)), oneTime);
+}
+
+EventManager::ListenerId EventManager::RegisterListener(EventId eventId, Callback callback, bool oneTime) {
+    if (GetEventName(eventId).empty()) {
+        HandleError(GetEventName(eventId), "Event ID is invalid");
+        return kInvalidListenerId;
+    }
+
+    CallbackEntry entry(kInvalidListenerId, std::move(callback), oneTime);
+    if (!IsCallbackValid(entry)) {
+        HandleError(GetEventName(eventId), "Callback is invalid");
+        return kInvalidListenerId;
+    }
+
+    if (eventId >= m_Listeners.size()) {
+        m_Listeners.resize(eventId + 1);
+    }
+
+    entry.id = m_NextListenerId.fetch_add(1, std::memory_order_relaxed);
+    m_Listeners[eventId].push_back(std::move(entry));
+    return m_Listeners[eventId].back().id;
 }
 
 EventManager::ListenerId EventManager::RegisterOnceListener(const std::string &eventName, sol::function callback) {
@@ -42,11 +120,24 @@ EventManager::ListenerId EventManager::RegisterOnceListener(const std::string &e
     return RegisterListener(eventName, std::move(callback), true);
 }
 
+// ============================================================================
+// Listener Removal
+// ============================================================================
+
 void EventManager::ClearListeners() {
     // CRITICAL: This must be called before the Lua VM is destroyed.
     // Sol2 function destructors may access the Lua VM during cleanup.
     // ScriptContext::Shutdown() ensures correct destruction order.
     try {
+        if (m_DispatchDepth > 0) {
+            // Called from a listener: release the callbacks, the dispatch drops the entries
+            for (auto &listeners : m_Listeners) {
+                for (auto &entry : listeners) {
+                    entry.callback.reset();
+                }
+            }
+            return;
+        }
         m_Listeners.clear();
     } catch (const std::exception &e) {
         // Log error but don't throw - we're likely in a cleanup path
@@ -56,10 +147,17 @@ void EventManager::ClearListeners() {
 
 void EventManager::ClearListeners(const std::string &eventName) {
     try {
-        auto it = m_Listeners.find(eventName);
-        if (it != m_Listeners.end()) {
-            m_Listeners.erase(it);
+        auto *listeners = FindListeners(FindEvent(eventName));
+        if (!listeners) {
+            return;
+        }
+        if (m_DispatchDepth > 0) {
+            for (auto &entry : *listeners) {
+                entry.callback.reset();
+            }
+            return;
         }
+        listeners->clear();
     } catch (const std::exception &e) {
         // Log error but don't throw
         Log::Error("EventManager::ClearListeners('%s'): Exception during cleanup: %s",
@@ -68,31 +166,53 @@ void EventManager::ClearListeners(const std::string &eventName) {
 }
 
 size_t EventManager::GetListenerCount(const std::string &eventName) const {
-    auto it = m_Listeners.find(eventName);
-    return it != m_Listeners.end() ? it->second.size() : 0;
+    return GetListenerCount(FindEvent(eventName));
+}
+
+size_t EventManager::GetListenerCount(EventId id) const {
+    const auto *listeners = FindListeners(id);
+    if (!listeners) {
+        return 0;
+    }
+
+    // Entries released during a dispatch are not listening anymore
+    size_t count = 0;
+    for (const auto &entry : *listeners) {
+        if (IsCallbackValid(entry)) {
+            ++count;
+        }
+    }
+    return count;
 }
 
 bool EventManager::HasListeners(const std::string &eventName) const {
-    auto it = m_Listeners.find(eventName);
-    return it != m_Listeners.end() && !it->second.empty();
+    return GetListenerCount(FindEvent(eventName)) > 0;
 }
 
 bool EventManager::UnregisterListener(const std::string &eventName, ListenerId id) {
+    return UnregisterListener(FindEvent(eventName), id);
+}
+
+bool EventManager::UnregisterListener(EventId eventId, ListenerId id) {
     if (id == kInvalidListenerId) {
         return false;
     }
 
-    auto it = m_Listeners.find(eventName);
-    if (it == m_Listeners.end()) {
+    auto *listeners = FindListeners(eventId);
+    if (!listeners) {
         return false;
     }
 
-    auto &listeners = it->second;
-    for (auto listenerIt = listeners.begin(); listenerIt != listeners.end(); ++listenerIt) {
-        if (listenerIt->id == id) {
-            listeners.erase(listenerIt);
-            if (listeners.empty()) {
-                m_Listeners.erase(it);
+    for (size_t i = 0; i < listeners->size(); ++i) {
+        if ((*listeners)[i].id == id) {
+            if (!IsCallbackValid((*listeners)[i])) {
+                return false; // Already released during a dispatch
+            }
+            if (m_DispatchDepth > 0) {
+                // Called from a listener: release the callback, the dispatch drops the entry
+                (*listeners)[i].callback.reset();
+            } else {
+                listeners->erase(listeners->begin() + static_cast<std::ptrdiff_t>(i));
             }
             return true;
         }
@@ -101,11 +221,25 @@ bool EventManager::UnregisterListener(const std::string &eventName, ListenerId i
     return false;
 }
 
+bool EventManager::RemoveListenerAt(EventId id, size_t index) {
+    auto &listeners = m_Listeners[id];
+    if (m_DispatchDepth > 1) {
+        // A nested dispatch: an outer FireEvent may hold indices into this list
+        listeners[index].callback.reset();
+        return false;
+    }
+    listeners.erase(listeners.begin() + static_cast<std::ptrdiff_t>(index));
+    return true;
+}
+
 bool EventManager::IsCallbackValid(const CallbackEntry &entry) {
-    if (std::holds_alternative<sol::function>(entry.callback)) {
-        return std::get<sol::function>(entry.callback).valid();
+    if (!entry.callback) {
+        return false; // Removed during a dispatch
+    }
+    if (std::holds_alternative<sol::function>(*entry.callback)) {
+        return std::get<sol::function>(*entry.callback).valid();
     } else {
-        return static_cast<bool>(std::get<std::function<void()>>(entry.callback));
+        return static_cast<bool>(std::get<std::function<void()>>(*entry.callback));
     }
 }
 
@@ -2,8 +2,8 @@
 
 #include <string>
 #include <vector>
-#include <unordered_map>
 #include <functional>
+#include <memory>
 #include <variant>
 #include <atomic>
 #include <cstdint>
@@ -30,12 +30,23 @@
  * 5. Invalid callbacks are automatically removed during FireEvent().
  *
  * This design ensures Lua callbacks never outlive their associated Lua VM.
+ *
+ * EVENT IDS:
+ * ==========
+ * Event names are interned into a process-wide table of integer EventIds shared
+ * by every EventManager, so an ID resolved once can be fired into any context.
+ * Listeners are stored in a vector indexed by EventId; the string overloads
+ * resolve the name and forward to the ID overloads. Hot paths (per-tick game
+ * events) should resolve the ID once and fire by ID.
  */
 class EventManager {
 public:
     using ListenerId = uint64_t;
     static constexpr ListenerId kInvalidListenerId = 0;
 
+    using EventId = uint32_t;
+    static constexpr EventId kInvalidEventId = 0;
+
     /**
      * @brief Callback variant that can hold either C++ function or Lua function
      */
@@ -43,14 +54,17 @@ public:
 
     /**
      * @brief Wrapper for callback with one-time execution flag
+     *
+     * The callback is shared so a listener removed while it runs stays alive
+     * until its call returns.
      */
     struct CallbackEntry {
-        Callback callback;
+        std::shared_ptr<const Callback> callback;
         bool oneTime = false;
         ListenerId id = kInvalidListenerId;
 
         CallbackEntry(ListenerId listenerId, Callback cb, bool once = false)
-            : callback(std::move(cb)), oneTime(once), id(listenerId) {
+            : callback(std::make_shared<const Callback>(std::move(cb))), oneTime(once), id(listenerId) {
         }
     };
 
@@ -59,6 +73,33 @@ public:
     EventManager(const EventManager &) = delete;
     EventManager &operator=(const EventManager &) = delete;
 
+    // === Event Name Interning ===
+
+    /**
+     * @brief Gets the ID of an event name, interning it on first use.
+     * @param eventName The event name.
+     * @return The event ID, or kInvalidEventId if the name is empty.
+     * @note Thread-safe. IDs stay valid for the lifetime of the process.
+     */
+    static EventId InternEvent(const std::string &eventName);
+
+    /**
+     * @brief Gets the ID of an event name without interning it.
+     * @param eventName The event name.
+     * @return The event ID, or kInvalidEventId if the name was never interned
+     *         (in which case nothing can be listening for it).
+     * @note Thread-safe.
+     */
+    static EventId FindEvent(const std::string &eventName);
+
+    /**
+     * @brief Gets the name of an interned event.
+     * @param id The event ID.
+     * @return The event name, or an empty string for unknown IDs.
+     * @note Thread-safe. The reference stays valid for the lifetime of the process.
+     */
+    static const std::string &GetEventName(EventId id);
+
     /**
      * @brief Register a Lua function to be called when an event is fired.
      * @param eventName The name of the event to listen for.
@@ -75,6 +116,14 @@ public:
      */
     ListenerId RegisterListener(const std::string &eventName, std::function<void()> callback, bool oneTime = false);
 
+    /**
+     * @brief Register a listener for an interned event.
+     * @param id The event ID (from InternEvent).
+     * @param callback The Lua or C++ function to call.
+     * @param oneTime If true, the listener will be removed after first call.
+     */
+    ListenerId RegisterListener(EventId id, Callback callback, bool oneTime = false);
+
     /**
      * @brief Register a C++ lambda to be called when an event is fired.
      * @param eventName The name of the event to listen for.
@@ -124,6 +173,14 @@ public:
     template <typename... Args>
     void FireEvent(const std::string &eventName, Args &&... args);
 
+    /**
+     * @brief Fire an interned event without hashing its name.
+     * @param id The event ID (from InternEvent or FindEvent).
+     * @param args The arguments to pass to Lua listeners (C++ listeners ignore args).
+     */
+    template <typename... Args>
+    void FireEvent(EventId id, Args &&... args);
+
     /**
      * @brief Unregister a listener using its handle.
      * @param eventName The event name associated with the listener.
@@ -132,6 +189,14 @@ public:
      */
     bool UnregisterListener(const std::string &eventName, ListenerId id);
 
+    /**
+     * @brief Unregister a listener of an interned event using its handle.
+     * @param eventId The event ID associated with the listener.
+     * @param id The listener identifier returned by RegisterListener.
+     * @return True if a listener was removed.
+     */
+    bool UnregisterListener(EventId eventId, ListenerId id);
+
     /**
      * @brief Clear all event listeners.
      */
@@ -150,6 +215,13 @@ public:
      */
     size_t GetListenerCount(const std::string &eventName) const;
 
+    /**
+     * @brief Get the number of listeners for an interned event.
+     * @param id The event ID.
+     * @return The number of listeners.
+     */
+    size_t GetListenerCount(EventId id) const;
+
     /**
      * @brief Check if an event has any listeners.
      * @param eventName The event name.
@@ -167,12 +239,12 @@ private:
 
     /**
      * @brief Call a callback with optional arguments.
-     * @param entry The callback entry to call.
+     * @param callback The callback to call.
      * @param args Arguments for Lua functions (ignored by C++ functions).
      * @return True if the call was successful.
      */
     template <typename... Args>
-    bool CallCallback(const CallbackEntry &entry, Args &&... args) const;
+    bool CallCallback(const Callback &callback, Args &&... args) const;
 
     /**
      * @brief Handle errors in callbacks.
@@ -181,8 +253,30 @@ private:
      */
     void HandleError(const std::string &eventName, const std::string &error) const;
 
-    std::unordered_map<std::string, std::vector<CallbackEntry>> m_Listeners;
+    /**
+     * @brief Gets the listener list of an event, or nullptr if it has none.
+     */
+    std::vector<CallbackEntry> *FindListeners(EventId id) {
+        return id < m_Listeners.size() ? &m_Listeners[id] : nullptr;
+    }
+
+    const std::vector<CallbackEntry> *FindListeners(EventId id) const {
+        return id < m_Listeners.size() ? &m_Listeners[id] : nullptr;
+    }
+
+    /**
+     * @brief Removes a listener from within FireEvent(); nested dispatches only drop
+     *        the callback so the outer dispatch's indices stay valid.
+     * @return True if the entry was erased from the list.
+     */
+    bool RemoveListenerAt(EventId id, size_t index);
+
+    // Listener lists indexed by EventId
+    std::vector<std::vector<CallbackEntry>> m_Listeners;
     std::atomic<ListenerId> m_NextListenerId{1};
+
+    // Nesting depth of FireEvent(); removals are deferred while dispatching
+    int m_DispatchDepth = 0;
 };
 
 // Template implementation
@@ -218,47 +312,59 @@ EventManager::ListenerId EventManager::RegisterOnceListener(const std::string &e
 
 template <typename... Args>
 void EventManager::FireEvent(const std::string &eventName, Args &&... args) {
-    auto it = m_Listeners.find(eventName);
-    if (it == m_Listeners.end()) {
-        return; // No listeners
+    const EventId id = FindEvent(eventName);
+    if (id != kInvalidEventId) {
+        FireEvent(id, std::forward<Args>(args)...);
     }
+}
 
-    // Process all listeners
-    for (auto listenerIt = it->second.begin(); listenerIt != it->second.end();) {
-        CallbackEntry &entry = *listenerIt;
+template <typename... Args>
+void EventManager::FireEvent(EventId id, Args &&... args) {
+    const auto *listeners = FindListeners(id);
+    if (!listeners || listeners->empty()) {
+        return; // No listeners
+    }
 
-        if (!IsCallbackValid(entry)) {
-            // Remove invalid callback
-            listenerIt = it->second.erase(listenerIt);
+    // Callbacks may register, remove or fire listeners while we dispatch: walk by
+    // index, re-fetch the list after every call and skip listeners added during
+    // this fire. Only the outermost dispatch erases entries, so indices stay valid.
+    ++m_DispatchDepth;
+    size_t end = listeners->size();
+    for (size_t i = 0; i < end && i < m_Listeners[id].size();) {
+        if (!IsCallbackValid(m_Listeners[id][i])) {
+            // Remove invalid (or unregistered) callback
+            if (RemoveListenerAt(id, i)) {
+                --end;
+            } else {
+                ++i;
+            }
             continue;
         }
 
-        bool success = CallCallback(entry, std::forward<Args>(args)...);
+        const bool oneTime = m_Listeners[id][i].oneTime;
+        const std::shared_ptr<const Callback> callback = m_Listeners[id][i].callback;
+        bool success = CallCallback(*callback, std::forward<Args>(args)...);
         if (!success) {
-            HandleError(eventName, "Callback execution failed");
+            HandleError(GetEventName(id), "Callback execution failed");
         }
 
         // Remove one-time listeners after execution (whether successful or not)
         // This prevents failed one-time listeners from being called repeatedly
-        if (entry.oneTime) {
-            listenerIt = it->second.erase(listenerIt);
+        if (oneTime && i < m_Listeners[id].size() && RemoveListenerAt(id, i)) {
+            --end;
         } else {
-            ++listenerIt;
+            ++i;
         }
     }
-
-    // Clean up empty event lists
-    if (it->second.empty()) {
-        m_Listeners.erase(it);
-    }
+    --m_DispatchDepth;
 }
 
 template <typename... Args>
-bool EventManager::CallCallback(const CallbackEntry &entry, Args &&... args) const {
+bool EventManager::CallCallback(const Callback &callback, Args &&... args) const {
     try {
-        if (std::holds_alternative<sol::function>(entry.callback)) {
+        if (std::holds_alternative<sol::function>(callback)) {
             // Lua function
-            const auto &luaFunc = std::get<sol::function>(entry.callback);
+            const auto &luaFunc = std::get<sol::function>(callback);
 
             // Double-check that the function is still valid before calling
             // Sol2 functions can become invalid if Lua state changes
@@ -279,7 +385,7 @@ bool EventManager::CallCallback(const CallbackEntry &entry, Args &&... args) con
             return true;
         } else {
             // C++ function (ignores arguments)
-            const auto &cppFunc = std::get<std::function<void()>>(entry.callback);
+            const auto &cppFunc = std::get<std::function<void()>>(callback);
             if (!cppFunc) {
                 HandleError("cpp_callback", "C++ function is null");
                 return false;
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "EventManager.h"
+
+/**
+ * @namespace GameEvents
+ * @brief IDs of the game events BallanceTAS forwards to the engine.
+ *
+ * Interned once at startup so the per-event path never builds or hashes a name.
+ */
+namespace GameEvents {
+    inline const EventManager::EventId PreStartMenu = EventManager::InternEvent("pre_start_menu");
+    inline const EventManager::EventId PostStartMenu = EventManager::InternEvent("post_start_menu");
+    inline const EventManager::EventId PreLoadLevel = EventManager::InternEvent("pre_load_level");
+    inline const EventManager::EventId PostLoadLevel = EventManager::InternEvent("post_load_level");
+    inline const EventManager::EventId StartLevel = EventManager::InternEvent("start_level");
+    inline const EventManager::EventId PreResetLevel = EventManager::InternEvent("pre_reset_level");
+    inline const EventManager::EventId PostResetLevel = EventManager::InternEvent("post_reset_level");
+    inline const EventManager::EventId PauseLevel = EventManager::InternEvent("pause_level");
+    inline const EventManager::EventId UnpauseLevel = EventManager::InternEvent("unpause_level");
+    inline const EventManager::EventId PreExitLevel = EventManager::InternEvent("pre_exit_level");
+    inline const EventManager::EventId PostExitLevel = EventManager::InternEvent("post_exit_level");
+    inline const EventManager::EventId PreNextLevel = EventManager::InternEvent("pre_next_level");
+    inline const EventManager::EventId PostNextLevel = EventManager::InternEvent("post_next_level");
+    inline const EventManager::EventId BallOff = EventManager::InternEvent("ball_off");
+    inline const EventManager::EventId PreLevelEnd = EventManager::InternEvent("pre_level_end");
+    inline const EventManager::EventId PostLevelEnd = EventManager::InternEvent("post_level_end");
+    inline const EventManager::EventId CounterActive = EventManager::InternEvent("counter_active");
+    inline const EventManager::EventId CounterInactive = EventManager::InternEvent("counter_inactive");
+    inline const EventManager::EventId BallNavActive = EventManager::InternEvent("ball_nav_active");
+    inline const EventManager::EventId BallNavInactive = EventManager::InternEvent("ball_nav_inactive");
+    inline const EventManager::EventId CamNavActive = EventManager::InternEvent("cam_nav_active");
+    inline const EventManager::EventId CamNavInactive = EventManager::InternEvent("cam_nav_inactive");
+    inline const EventManager::EventId PreCheckpointReached = EventManager::InternEvent("pre_checkpoint_reached");
+    inline const EventManager::EventId PostCheckpointReached = EventManager::InternEvent("post_checkpoint_reached");
+    inline const EventManager::EventId LevelFinish = EventManager::InternEvent("level_finish");
+    inline const EventManager::EventId GameOver = EventManager::InternEvent("game_over");
+    inline const EventManager::EventId ExtraPoint = EventManager::InternEvent("extra_point");
+    inline const EventManager::EventId PreSubLife = EventManager::InternEvent("pre_sub_life");
+    inline const EventManager::EventId PostSubLife = EventManager::InternEvent("post_sub_life");
+    inline const EventManager::EventId PreLifeUp = EventManager::InternEvent("pre_life_up");
+    inline const EventManager::EventId PostLifeUp = EventManager::InternEvent("post_life_up");
+}
@@ -132,6 +132,13 @@ RNGState GameInterface::GetRNGState() {
     return state;
 }
 
+void GameInterface::RestoreRNGState(const RNGState &state) {
+    // Restore physics and RNG states
+    m_IpionManager->GetEnvironment()->next_movement_check = state.next_movement_check;
+    ivp_srand(state.ivp_seed);
+    qh_srand(state.qh_seed);
+}
+
 void GameInterface::PushRNGState() {
     // Save current RNG state to stack and increment ID for next state
     RNGState state = {
@@ -152,10 +159,7 @@ void GameInterface::PopRNGState() {
     RNGState state = m_RNGStateStack.top();
     m_RNGStateStack.pop();
 
-    // Restore physics and RNG states
-    m_IpionManager->GetEnvironment()->next_movement_check = state.next_movement_check;
-    ivp_srand(state.ivp_seed);
-    qh_srand(state.qh_seed);
+    RestoreRNGState(state);
 }
 
 void GameInterface::ClearRNGStateStack() {
@@ -309,6 +313,20 @@ bool GameInterface::IsSleeping(CK3dEntity *obj) const {
     return ipionObj->m_RealObject->get_core()->movement_state >= IVP_MT_CALM;
 }
 
+bool GameInterface::SetPhysicsState(CK3dEntity *obj, const VxVector &position, const VxQuaternion &rotation,
+                                    const VxVector &velocity, const VxVector &angularVelocity) const {
+    if (!obj || !m_IpionManager) return false;
+
+    PhysicsObject *physObj = m_IpionManager->GetPhysicsObject(obj);
+    if (!physObj) return false;
+
+    obj->SetPosition(&position);
+    obj->SetQuaternion(&rotation);
+    physObj->SetVelocity(&velocity, &angularVelocity);
+    physObj->Wake();
+    return true;
+}
+
 XObjectArray GameInterface::GetFloors(CK3dEntity *ent, float zoom, float maxHeight) const {
     XObjectArray floors;
 
@@ -69,6 +69,7 @@ public:
     // RNG State Management
     // ========================================
     RNGState GetRNGState();
+    void RestoreRNGState(const RNGState &state);
     void PushRNGState();
     void PopRNGState();
     void ClearRNGStateStack();
@@ -163,6 +164,18 @@ public:
      */
     bool IsSleeping(CK3dEntity *obj) const;
 
+    /**
+     * @brief Restores the transform and velocities of a physicalized game entity.
+     * @param obj A pointer to the CK3dEntity.
+     * @param position The world position to apply.
+     * @param rotation The world rotation to apply.
+     * @param velocity The linear velocity to apply.
+     * @param angularVelocity The angular velocity to apply.
+     * @return True if the state was applied, false if obj is null or not physicalized.
+     */
+    bool SetPhysicsState(CK3dEntity *obj, const VxVector &position, const VxQuaternion &rotation,
+                         const VxVector &velocity, const VxVector &angularVelocity) const;
+
     /**
      * @brief Gets the floors under a game entity.
      * @param ent The entity to check.
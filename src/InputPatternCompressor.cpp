@@ -0,0 +1,45 @@
+#include "InputPatternCompressor.h"
+
+#include <algorithm>
+
+InputPatternCompressor::InputPatternCompressor(size_t maxPeriod, size_t minRepeats, size_t minSavedSteps)
+    : m_MaxPeriod(std::max<size_t>(maxPeriod, 1)),
+      m_MinRepeats(std::max<size_t>(minRepeats, 2)),
+      m_MinSavedSteps(minSavedSteps) {}
+
+void InputPatternCompressor::FindRuns(const std::vector<Step> &steps, std::vector<Run> &runs) const {
+    runs.clear();
+
+    const size_t count = steps.size();
+    size_t i = 0;
+    while (i < count) {
+        Run best;
+        size_t bestSaved = 0;
+
+        const size_t maxPeriod = std::min(m_MaxPeriod, (count - i) / m_MinRepeats);
+        for (size_t period = 1; period <= maxPeriod; ++period) {
+            // Length over which every step equals the one a period later
+            size_t matched = 0;
+            while (i + matched + period < count && steps[i + matched].Matches(steps[i + matched + period])) {
+                ++matched;
+            }
+
+            const size_t repeats = 1 + matched / period;
+            if (repeats < m_MinRepeats) continue;
+
+            const size_t saved = period * (repeats - 1);
+            if (saved > bestSaved) {
+                bestSaved = saved;
+                best = {i, period, repeats};
+            }
+        }
+
+        if (bestSaved == 0 || bestSaved < m_MinSavedSteps) {
+            ++i;
+            continue;
+        }
+
+        runs.push_back(best);
+        i = best.GetEnd();
+    }
+}
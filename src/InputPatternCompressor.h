@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class InputPatternCompressor
+ * @brief Finds periodically repeated stretches in a stream of script steps.
+ *
+ * A step is one scripted input action together with the wait that precedes it.
+ * The ScriptGenerator folds each run found here into a Lua loop, so a stretch of
+ * alternating taps or fixed-interval jumps becomes a few lines instead of
+ * thousands. Since a run repeats its steps exactly, waits included, the loop
+ * issues the same calls on the same ticks as the unrolled script.
+ *
+ * Runs are found greedily from the front: at each step every period up to the
+ * maximum is tried, and the one that removes the most steps wins.
+ */
+class InputPatternCompressor {
+public:
+    static constexpr uint16_t kBarrier = 0xFFFF; // Action of a step that never repeats
+
+    /**
+     * @struct Step
+     * @brief A scripted action and the ticks waited before it.
+     */
+    struct Step {
+        size_t wait = 0;
+        uint16_t action = kBarrier;
+
+        bool Matches(const Step &other) const {
+            return action != kBarrier && action == other.action && wait == other.wait;
+        }
+    };
+
+    /**
+     * @struct Run
+     * @brief Steps [begin, begin + period * repeats) repeat the first period steps.
+     */
+    struct Run {
+        size_t begin = 0;
+        size_t period = 0;
+        size_t repeats = 0;
+
+        size_t GetLength() const { return period * repeats; }
+        size_t GetEnd() const { return begin + GetLength(); }
+    };
+
+    /**
+     * @brief Creates a compressor.
+     * @param maxPeriod Longest repeated pattern, in steps.
+     * @param minRepeats Fewest repetitions worth a loop.
+     * @param minSavedSteps Fewest steps a loop must remove.
+     */
+    explicit InputPatternCompressor(size_t maxPeriod = 32, size_t minRepeats = 3, size_t minSavedSteps = 4);
+
+    /**
+     * @brief Finds the repeated runs of a step stream.
+     * @param steps The steps, in script order.
+     * @param runs Receives the runs in step order; they never overlap.
+     */
+    void FindRuns(const std::vector<Step> &steps, std::vector<Run> &runs) const;
+
+    /**
+     * @brief Makes the action of a key step.
+     * @param key Key index.
+     * @param transition Key transition value.
+     */
+    static uint16_t MakeAction(uint8_t key, uint8_t transition) {
+        return static_cast<uint16_t>((key << 8) | transition);
+    }
+
+private:
+    size_t m_MaxPeriod;
+    size_t m_MinRepeats;
+    size_t m_MinSavedSteps;
+};
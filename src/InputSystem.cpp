@@ -1,7 +1,7 @@
 #include "InputSystem.h"
 
-#include <set>
 #include <algorithm>
+#include <bit>
 #include <sstream>
 
 // Helper function to convert a string to lowercase
@@ -11,56 +11,51 @@ static std::string ToLower(std::string s) {
     return s;
 }
 
-// Helper function to trim whitespace
-static std::string Trim(const std::string &str) {
-    size_t start = str.find_first_not_of(" \t\n\r");
-    if (start == std::string::npos) return "";
-
-    size_t end = str.find_last_not_of(" \t\n\r");
-    return str.substr(start, end - start + 1);
-}
-
 InputSystem::InputSystem() {
     InitializeKeyMap();
 }
 
-std::vector<std::string> InputSystem::ParseKeyString(const std::string &keyString) const {
-    std::vector<std::string> keys;
-    std::string current;
-
-    for (char ch : keyString) {
-        if (isspace(ch)) {
-            if (!current.empty()) {
-                std::string trimmed = Trim(current);
-                if (!trimmed.empty()) {
-                    keys.push_back(ToLower(trimmed));
-                }
-                current.clear();
-            }
-        } else {
-            current += ch;
+KeyChord InputSystem::ParseChord(const std::string &keyString, std::string *firstUnknownKey) const {
+    KeyChord chord;
+    std::string token;
+
+    // Keys are separated by whitespace; every token is lowercased into one reused buffer
+    size_t i = 0;
+    while (i < keyString.size()) {
+        while (i < keyString.size() && isspace(static_cast<unsigned char>(keyString[i]))) ++i;
+        if (i >= keyString.size()) break;
+
+        token.clear();
+        while (i < keyString.size() && !isspace(static_cast<unsigned char>(keyString[i]))) {
+            token += static_cast<char>(std::tolower(static_cast<unsigned char>(keyString[i])));
+            ++i;
         }
-    }
 
-    // Add the last key
-    if (!current.empty()) {
-        std::string trimmed = Trim(current);
-        if (!trimmed.empty()) {
-            keys.push_back(ToLower(trimmed));
+        auto it = m_Keymap.find(token);
+        if (it != m_Keymap.end() && IsValidKeyCode(it->second) && it->second != 0) {
+            chord.AddKey(static_cast<uint8_t>(it->second));
+        } else {
+            if (firstUnknownKey && !chord.HasUnknownKeys()) {
+                *firstUnknownKey = token;
+            }
+            chord.MarkUnknownKey();
         }
     }
 
-    // Remove duplicates while preserving order
-    std::vector<std::string> uniqueKeys;
-    std::set<std::string> seen;
-    for (const auto &key : keys) {
-        if (seen.find(key) == seen.end()) {
-            uniqueKeys.push_back(key);
-            seen.insert(key);
-        }
+    return chord;
+}
+
+const KeyChord &InputSystem::GetCachedChord(const std::string &keyString) const {
+    auto it = m_ChordCache.find(keyString);
+    if (it != m_ChordCache.end()) {
+        return it->second;
     }
 
-    return uniqueKeys;
+    // Scripts that build key strings dynamically must not grow the cache forever
+    if (m_ChordCache.size() >= kMaxCachedChords) {
+        m_ChordCache.clear();
+    }
+    return m_ChordCache.emplace(keyString, ParseChord(keyString)).first->second;
 }
 
 void InputSystem::InitializeKeyMap() {
@@ -220,70 +215,78 @@ bool InputSystem::IsValidKey(const std::string &key) const {
     return GetKeyCode(key) != 0;
 }
 
+void InputSystem::PressKey(uint8_t code) {
+    m_KeyStates[code].ApplyPressEvent(m_CurrentTick);
+    m_PressedMask.Set(code);
+}
+
+void InputSystem::ReleaseKey(uint8_t code) {
+    m_KeyStates[code].ApplyReleaseEvent(m_CurrentTick);
+    m_ReleasedMask.Set(code);
+}
+
 void InputSystem::PressKeys(const std::string &keyString) {
-    auto keys = ParseKeyString(keyString);
-    for (const auto &key : keys) {
-        CKKEYBOARD code = GetKeyCode(key);
-        if (IsValidKeyCode(code) && code != 0) {
-            // Generate a press event for this frame
-            m_KeyStates[code].ApplyPressEvent(m_CurrentTick);
-        }
-    }
+    PressKeys(GetCachedChord(keyString));
+}
+
+void InputSystem::PressKeys(const KeyChord &chord) {
+    // Generate a press event for this frame
+    chord.GetMask().ForEach([this](uint8_t code) { PressKey(code); });
 }
 
 void InputSystem::PressKeysOneFrame(const std::string &keyString) {
-    auto keys = ParseKeyString(keyString);
-    for (const auto &key : keys) {
-        CKKEYBOARD code = GetKeyCode(key);
-        if (IsValidKeyCode(code) && code != 0) {
-            // Generate press event immediately, release will happen next frame
-            m_KeyStates[code].ApplyPressEvent(m_CurrentTick);
-
-            // Schedule release for next frame by setting held duration to 1
-            m_HeldKeys[code] = 1;
-        }
-    }
+    PressKeysOneFrame(GetCachedChord(keyString));
+}
+
+void InputSystem::PressKeysOneFrame(const KeyChord &chord) {
+    chord.GetMask().ForEach([this](uint8_t code) {
+        // Generate press event immediately, release will happen next frame
+        PressKey(code);
+
+        // Schedule release for next frame by setting held duration to 1
+        m_HeldKeyTicks[code] = 1;
+        m_HeldKeyMask.Set(code);
+    });
 }
 
 void InputSystem::HoldKeys(const std::string &keyString, int durationTicks) {
     if (durationTicks <= 0) return;
+    HoldKeys(GetCachedChord(keyString), durationTicks);
+}
+
+void InputSystem::HoldKeys(const KeyChord &chord, int durationTicks) {
+    if (durationTicks <= 0) return;
 
-    auto keys = ParseKeyString(keyString);
-    for (const auto &key : keys) {
-        CKKEYBOARD code = GetKeyCode(key);
-        if (IsValidKeyCode(code) && code != 0) {
-            // Generate press event now
-            m_KeyStates[code].ApplyPressEvent(m_CurrentTick);
+    chord.GetMask().ForEach([this, durationTicks](uint8_t code) {
+        // Generate press event now
+        PressKey(code);
 
-            // Schedule release after duration
-            m_HeldKeys[code] = durationTicks;
-        }
-    }
+        // Schedule release after duration
+        m_HeldKeyTicks[code] = durationTicks;
+        m_HeldKeyMask.Set(code);
+    });
 }
 
 void InputSystem::ReleaseKeys(const std::string &keyString) {
-    auto keys = ParseKeyString(keyString);
-    for (const auto &key : keys) {
-        CKKEYBOARD code = GetKeyCode(key);
-        if (IsValidKeyCode(code) && code != 0) {
-            // Generate release event for this frame
-            m_KeyStates[code].ApplyReleaseEvent(m_CurrentTick);
-
-            // Remove from held keys if it was being held
-            m_HeldKeys.erase(code);
-        }
-    }
+    ReleaseKeys(GetCachedChord(keyString));
+}
+
+void InputSystem::ReleaseKeys(const KeyChord &chord) {
+    chord.GetMask().ForEach([this](uint8_t code) {
+        // Generate release event for this frame
+        ReleaseKey(code);
+    });
+
+    // Remove from held keys if they were being held
+    m_HeldKeyMask.Remove(chord.GetMask());
 }
 
 void InputSystem::ReleaseAllKeys() {
     // Generate release events for all currently pressed keys
-    for (auto &keyState : m_KeyStates) {
-        if (keyState.currentState & KS_PRESSED) {
-            keyState.ApplyReleaseEvent(m_CurrentTick);
-        }
-    }
+    const KeyMask pressed = m_PressedMask;
+    pressed.ForEach([this](uint8_t code) { ReleaseKey(code); });
 
-    m_HeldKeys.clear();
+    m_HeldKeyMask.Clear();
 }
 
 // ===================================================================
@@ -298,19 +301,21 @@ void InputSystem::PressMouseButton(int buttonIndex) {
 void InputSystem::PressMouseButtonOneFrame(int buttonIndex) {
     if (buttonIndex < 0 || buttonIndex >= 4) return;
     m_MouseState.buttons[buttonIndex].ApplyPressEvent(m_CurrentTick);
-    m_HeldMouseButtons[buttonIndex] = 1;
+    m_HeldMouseTicks[buttonIndex] = 1;
+    m_HeldMouseMask |= 1u << buttonIndex;
 }
 
 void InputSystem::HoldMouseButton(int buttonIndex, int durationTicks) {
     if (buttonIndex < 0 || buttonIndex >= 4 || durationTicks <= 0) return;
     m_MouseState.buttons[buttonIndex].ApplyPressEvent(m_CurrentTick);
-    m_HeldMouseButtons[buttonIndex] = durationTicks;
+    m_HeldMouseTicks[buttonIndex] = durationTicks;
+    m_HeldMouseMask |= 1u << buttonIndex;
 }
 
 void InputSystem::ReleaseMouseButton(int buttonIndex) {
     if (buttonIndex < 0 || buttonIndex >= 4) return;
     m_MouseState.buttons[buttonIndex].ApplyReleaseEvent(m_CurrentTick);
-    m_HeldMouseButtons.erase(buttonIndex);
+    m_HeldMouseMask &= ~(1u << buttonIndex);
 }
 
 void InputSystem::ReleaseAllMouseButtons() {
@@ -319,7 +324,7 @@ void InputSystem::ReleaseAllMouseButtons() {
             btn.ApplyReleaseEvent(m_CurrentTick);
         }
     }
-    m_HeldMouseButtons.clear();
+    m_HeldMouseMask = 0;
 }
 
 void InputSystem::SetMousePosition(float x, float y) {
@@ -538,6 +543,8 @@ void InputSystem::Reset() {
     for (auto &keyState : m_KeyStates) {
         keyState.Reset();
     }
+    m_PressedMask.Clear();
+    m_ReleasedMask.Clear();
 
     m_MouseState.Reset();
 
@@ -545,57 +552,34 @@ void InputSystem::Reset() {
         pair.second.Reset();
     }
 
-    m_HeldKeys.clear();
-    m_HeldMouseButtons.clear();
+    m_HeldKeyMask.Clear();
+    m_HeldMouseMask = 0;
     m_HeldJoystickButtons.clear();
 }
 
 bool InputSystem::AreKeysDown(const std::string &keyString) const {
-    auto keys = ParseKeyString(keyString);
-    if (keys.empty()) return false;
-
-    for (const auto &key : keys) {
-        CKKEYBOARD code = GetKeyCode(key);
-        if (!IsValidKeyCode(code) || code == 0) return false;
-
-        if (!(m_KeyStates[code].currentState & KS_PRESSED)) {
-            return false;
-        }
-    }
+    return AreKeysDown(GetCachedChord(keyString));
+}
 
-    return true;
+bool InputSystem::AreKeysDown(const KeyChord &chord) const {
+    return chord.IsQueryable() && m_PressedMask.ContainsAll(chord.GetMask());
 }
 
 bool InputSystem::AreKeysUp(const std::string &keyString) const {
-    auto keys = ParseKeyString(keyString);
-    if (keys.empty()) return false;
-
-    for (const auto &key : keys) {
-        CKKEYBOARD code = GetKeyCode(key);
-        if (!IsValidKeyCode(code) || code == 0) return false;
-
-        if (m_KeyStates[code].currentState != KS_IDLE) {
-            return false;
-        }
-    }
+    return AreKeysUp(GetCachedChord(keyString));
+}
 
-    return true;
+bool InputSystem::AreKeysUp(const KeyChord &chord) const {
+    // Up means KS_IDLE: neither pressed nor released this frame
+    return chord.IsQueryable() && !(m_PressedMask | m_ReleasedMask).Intersects(chord.GetMask());
 }
 
 bool InputSystem::AreKeysToggled(const std::string &keyString) const {
-    auto keys = ParseKeyString(keyString);
-    if (keys.empty()) return false;
-
-    for (const auto &key : keys) {
-        CKKEYBOARD code = GetKeyCode(key);
-        if (!IsValidKeyCode(code) || code == 0) return false;
-
-        if (!(m_KeyStates[code].currentState & KS_RELEASED)) {
-            return false;
-        }
-    }
+    return AreKeysToggled(GetCachedChord(keyString));
+}
 
-    return true;
+bool InputSystem::AreKeysToggled(const KeyChord &chord) const {
+    return chord.IsQueryable() && m_ReleasedMask.ContainsAll(chord.GetMask());
 }
 
 std::vector<std::string> InputSystem::GetAvailableKeys() const {
@@ -616,12 +600,11 @@ std::vector<std::string> InputSystem::GetAvailableKeys() const {
 
 std::vector<CKKEYBOARD> InputSystem::GetPressedKeys() const {
     std::vector<CKKEYBOARD> pressedKeys;
+    pressedKeys.reserve(m_PressedMask.Count());
 
-    for (int code = 0; code < 256; ++code) {
-        if (m_KeyStates[code].currentState & KS_PRESSED) {
-            pressedKeys.push_back(static_cast<CKKEYBOARD>(code));
-        }
-    }
+    m_PressedMask.ForEach([&pressedKeys](uint8_t code) {
+        pressedKeys.push_back(static_cast<CKKEYBOARD>(code));
+    });
 
     return pressedKeys;
 }
@@ -665,28 +648,24 @@ bool InputSystem::HasConflicts(const InputSystem &other,
     bool hasConflicts = false;
 
     // Check keyboard conflicts
-    for (int code = 0; code < 256; ++code) {
-        bool thisPressed = m_KeyStates[code].currentState & KS_PRESSED;
-        bool otherPressed = other.m_KeyStates[code].currentState & KS_PRESSED;
-
-        if (thisPressed && otherPressed) {
-            hasConflicts = true;
-            if (outConflicts) {
-                // Find key name for this code
-                std::string keyName;
-                for (const auto &pair : m_Keymap) {
-                    if (pair.second == code) {
-                        keyName = pair.first;
-                        break;
-                    }
+    const KeyMask commonKeys = m_PressedMask & other.m_PressedMask;
+    commonKeys.ForEach([&](uint8_t code) {
+        hasConflicts = true;
+        if (outConflicts) {
+            // Find key name for this code
+            std::string keyName;
+            for (const auto &pair : m_Keymap) {
+                if (pair.second == code) {
+                    keyName = pair.first;
+                    break;
                 }
-                if (keyName.empty()) {
-                    keyName = "key_" + std::to_string(code);
-                }
-                outConflicts->push_back("Keyboard conflict: " + keyName);
             }
+            if (keyName.empty()) {
+                keyName = "key_" + std::to_string(code);
+            }
+            outConflicts->push_back("Keyboard conflict: " + keyName);
         }
-    }
+    });
 
     // Check mouse button conflicts
     for (size_t i = 0; i < m_MouseState.buttons.size(); ++i) {
@@ -749,38 +728,35 @@ void InputSystem::Apply(size_t currentTick, DX8InputManager *inputManager) {
         return;
     }
 
-    m_CurrentTick = currentTick;
+    AdvanceHeldInputs(currentTick);
+    WriteKeyboard(inputManager, m_PressedMask, m_ReleasedMask);
+    ApplyMouseAndJoysticks(inputManager);
+    PrepareNextFrame();
+}
 
-    // ===================================================================
-    // Step 1: Process held keys timers and generate press/release events
-    // ===================================================================
+void InputSystem::AdvanceHeldInputs(size_t currentTick) {
+    m_CurrentTick = currentTick;
 
     // Process held keyboard keys
-    for (auto it = m_HeldKeys.begin(); it != m_HeldKeys.end();) {
-        auto key = it->first;
-        int &ticks = it->second;
-
-        if (ticks == 1) {
+    const KeyMask held = m_HeldKeyMask;
+    held.ForEach([this](uint8_t code) {
+        if (m_HeldKeyTicks[code] <= 1) {
             // This is the last frame - generate release event
-            m_KeyStates[key].ApplyReleaseEvent(currentTick);
-            it = m_HeldKeys.erase(it);
+            ReleaseKey(code);
+            m_HeldKeyMask.Reset(code);
         } else {
-            --ticks;
-            ++it;
+            --m_HeldKeyTicks[code];
         }
-    }
+    });
 
     // Process held mouse buttons
-    for (auto it = m_HeldMouseButtons.begin(); it != m_HeldMouseButtons.end();) {
-        int button = it->first;
-        int &ticks = it->second;
-
-        if (ticks == 1) {
+    for (uint32_t mask = m_HeldMouseMask; mask != 0; mask &= mask - 1) {
+        const int button = std::countr_zero(mask);
+        if (m_HeldMouseTicks[button] <= 1) {
             m_MouseState.buttons[button].ApplyReleaseEvent(currentTick);
-            it = m_HeldMouseButtons.erase(it);
+            m_HeldMouseMask &= ~(1u << button);
         } else {
-            --ticks;
-            ++it;
+            --m_HeldMouseTicks[button];
         }
     }
 
@@ -802,23 +778,28 @@ void InputSystem::Apply(size_t currentTick, DX8InputManager *inputManager) {
             ++it;
         }
     }
+}
 
-    // ===================================================================
-    // Step 2: Apply keyboard state using DX8InputManager
-    // ===================================================================
+void InputSystem::WriteKeyboard(DX8InputManager *inputManager, const KeyMask &pressed, const KeyMask &released) {
+    // Pressed keys go down; keys neither pressed nor released (KS_IDLE) go up;
+    // keys only released this frame are left to the game
+    const KeyMask idle = ~(pressed | released);
 
-    for (int code = 0; code < 256; ++code) {
-        if (m_KeyStates[code].currentState & KS_PRESSED) {
-            inputManager->SetKeyDown(static_cast<CKDWORD>(code));
-        } else if (m_KeyStates[code].currentState == KS_IDLE) {
-            inputManager->SetKeyUp(static_cast<CKDWORD>(code));
-        }
+    std::array<CKDWORD, KeyMask::kKeyCount> keys;
+    int count = 0;
+    pressed.ForEach([&](uint8_t code) { keys[count++] = code; });
+    if (count > 0) {
+        inputManager->SetMultipleKeys(keys.data(), count, TRUE);
     }
 
-    // ===================================================================
-    // Step 3: Apply mouse state using DX8InputManager
-    // ===================================================================
+    count = 0;
+    idle.ForEach([&](uint8_t code) { keys[count++] = code; });
+    if (count > 0) {
+        inputManager->SetMultipleKeys(keys.data(), count, FALSE);
+    }
+}
 
+void InputSystem::ApplyMouseAndJoysticks(DX8InputManager *inputManager) {
     // Apply mouse button states
     for (size_t i = 0; i < m_MouseState.buttons.size(); ++i) {
         CK_MOUSEBUTTON button = static_cast<CK_MOUSEBUTTON>(i);
@@ -837,10 +818,7 @@ void InputSystem::Apply(size_t currentTick, DX8InputManager *inputManager) {
         inputManager->SetMouseWheel(m_MouseState.wheelDelta);
     }
 
-    // ===================================================================
-    // Step 4: Apply joystick states using DX8InputManager
-    // ===================================================================
-
+    // Apply joystick states
     for (const auto &pair : m_JoystickStates) {
         int joyIndex = pair.first;
         const JoystickState &joyState = pair.second;
@@ -869,14 +847,15 @@ void InputSystem::Apply(size_t currentTick, DX8InputManager *inputManager) {
 
     // Clear wheel delta after applying (it's a per-frame delta)
     m_MouseState.wheelDelta = 0;
-
-    PrepareNextFrame();
 }
 
 void InputSystem::PrepareNextFrame() {
-    for (auto &keyState : m_KeyStates) {
-        keyState.PrepareNextFrame();
-    }
+    // Only keys released this frame change state
+    m_ReleasedMask.ForEach([this](uint8_t code) {
+        m_KeyStates[code].PrepareNextFrame();
+    });
+    m_PressedMask.Remove(m_ReleasedMask);
+    m_ReleasedMask.Clear();
 }
 
 void InputSystem::Reset(unsigned char *keyboardState) {
@@ -7,6 +7,7 @@
 #include <map>
 
 #include "DX8InputManager.h"
+#include "KeyChord.h"
 
 // Forward declarations
 class DX8InputManager;
@@ -136,6 +137,11 @@ struct JoystickState {
  * - ENABLED: Completely overrides ALL input during TAS replay
  * - DISABLED: Does not touch keyboard state at all
  * - MINIMAL STATE: Only tracks current key states and simple timers
+ *
+ * Keyboard calls take either a key string or a precompiled KeyChord. Strings
+ * are parsed into chords once and cached; the pressed/released bits of
+ * m_KeyStates are mirrored in 256-bit masks so chord queries are a few
+ * word-wide operations.
  */
 class InputSystem {
 public:
@@ -148,18 +154,35 @@ public:
 
     // --- API for Lua Bindings ---
 
+    /**
+     * @brief Parses a key string into a reusable key chord.
+     * @param keyString The case-insensitive key name(s), separated by whitespace.
+     * @param firstUnknownKey Optional output receiving the first unknown key name.
+     * @return The chord (HasUnknownKeys() is set if any name was not recognized).
+     */
+    KeyChord ParseChord(const std::string &keyString, std::string *firstUnknownKey = nullptr) const;
+
+    /**
+     * @brief Gets the chord for a key string, parsing it only the first time it is seen.
+     * @param keyString The key string.
+     * @return Reference to the cached chord (valid until the next call).
+     */
+    const KeyChord &GetCachedChord(const std::string &keyString) const;
+
     /**
      * @brief Immediately presses the specified key(s).
      * @param keyString The case-insensitive key name(s). Can be single key ("up")
      *                  or combination ("up right", "up,right", "up;right").
      */
     void PressKeys(const std::string &keyString);
+    void PressKeys(const KeyChord &chord);
 
     /**
      * @brief Presses key(s) for exactly one frame, then automatically releases them.
      * @param keyString The key name(s) to press for one frame.
      */
     void PressKeysOneFrame(const std::string &keyString);
+    void PressKeysOneFrame(const KeyChord &chord);
 
     /**
      * @brief Holds key(s) for a specified number of frames, then automatically releases them.
@@ -167,12 +190,14 @@ public:
      * @param durationTicks The number of frames to hold the keys.
      */
     void HoldKeys(const std::string &keyString, int durationTicks);
+    void HoldKeys(const KeyChord &chord, int durationTicks);
 
     /**
      * @brief Immediately releases the specified key(s).
      * @param keyString The key name(s). Supports combinations.
      */
     void ReleaseKeys(const std::string &keyString);
+    void ReleaseKeys(const KeyChord &chord);
 
     /**
      * @brief Immediately releases all keys currently pressed by the TAS system.
@@ -405,6 +430,7 @@ public:
      * @return True if all specified keys are currently pressed by TAS.
      */
     bool AreKeysDown(const std::string &keyString) const;
+    bool AreKeysDown(const KeyChord &chord) const;
 
     /**
      * @brief Checks if key(s) are currently released by the TAS system.
@@ -412,6 +438,7 @@ public:
      * @return True if all specified keys are currently released by TAS.
      */
     bool AreKeysUp(const std::string &keyString) const;
+    bool AreKeysUp(const KeyChord &chord) const;
 
     /**
      * @brief Checks if key(s) are currently toggled (pressed and released).
@@ -419,6 +446,7 @@ public:
      * @return True if all specified keys are toggled (pressed and released).
      */
     bool AreKeysToggled(const std::string &keyString) const;
+    bool AreKeysToggled(const KeyChord &chord) const;
 
     /**
      * @brief Gets a list of all available key names.
@@ -434,6 +462,16 @@ public:
      */
     const std::array<KeyState, 256> &GetAllKeyStates() const { return m_KeyStates; }
 
+    /**
+     * @brief Gets the keys whose state has the pressed bit set.
+     */
+    const KeyMask &GetPressedKeyMask() const { return m_PressedMask; }
+
+    /**
+     * @brief Gets the keys whose state has the released bit set.
+     */
+    const KeyMask &GetReleasedKeyMask() const { return m_ReleasedMask; }
+
     /**
      * @brief Gets the complete mouse state for diagnostics/merging.
      * @return Reference to the internal mouse state.
@@ -483,6 +521,33 @@ public:
      */
     void Apply(size_t currentTick, DX8InputManager *inputManager);
 
+    // --- Apply Phases ---
+    // Apply() runs these in order for a single system. Callers merging several
+    // systems advance each one, union their key masks, write the keyboard once
+    // and then prepare each system for the next frame.
+
+    /**
+     * @brief Counts down timed key, mouse and joystick holds, releasing the expired ones.
+     * @param currentTick The current game tick
+     */
+    void AdvanceHeldInputs(size_t currentTick);
+
+    /**
+     * @brief Writes a keyboard state to the input manager in two batched calls.
+     * Keys in @p pressed are set down, keys in neither mask are set up and keys
+     * released this frame are left untouched.
+     * @param inputManager Pointer to the DX8InputManager instance
+     * @param pressed Keys to hold down
+     * @param released Keys released this frame
+     */
+    static void WriteKeyboard(DX8InputManager *inputManager, const KeyMask &pressed, const KeyMask &released);
+
+    /**
+     * @brief Applies mouse and joystick states and clears the per-frame wheel delta.
+     * @param inputManager Pointer to the DX8InputManager instance
+     */
+    void ApplyMouseAndJoysticks(DX8InputManager *inputManager);
+
     /**
      * @brief Prepares for next frame
      */
@@ -496,12 +561,14 @@ public:
 
 private:
     /**
-     * @brief Parses a key string into individual key names.
-     * Supports space, comma, and semicolon separators.
-     * @param keyString The input string like "up right" or "up,right"
-     * @return Vector of individual key names
+     * @brief Generates a press event for a key and updates the key masks.
      */
-    std::vector<std::string> ParseKeyString(const std::string &keyString) const;
+    void PressKey(uint8_t code);
+
+    /**
+     * @brief Generates a release event for a key and updates the key masks.
+     */
+    void ReleaseKey(uint8_t code);
 
     /**
      * @brief Converts a string key name to a CKKEYBOARD code.
@@ -528,6 +595,14 @@ private:
     // Keyboard state tracking
     std::array<KeyState, 256> m_KeyStates;
 
+    // Mirrors of the KS_PRESSED / KS_RELEASED bits of m_KeyStates
+    KeyMask m_PressedMask;
+    KeyMask m_ReleasedMask;
+
+    // Key strings seen by the string API (bounded, cleared when full)
+    static constexpr size_t kMaxCachedChords = 256;
+    mutable std::unordered_map<std::string, KeyChord> m_ChordCache;
+
     // Mouse state tracking
     MouseState m_MouseState;
 
@@ -537,11 +612,14 @@ private:
     // Current frame tracking
     size_t m_CurrentTick = 0;
 
-    // Keys being held for a specific duration (key -> remaining ticks)
-    std::unordered_map<CKKEYBOARD, int> m_HeldKeys;
+    // Keys being held for a specific duration: remaining ticks per key code,
+    // valid only where the bit in m_HeldKeyMask is set
+    std::array<int, 256> m_HeldKeyTicks{};
+    KeyMask m_HeldKeyMask;
 
-    // Mouse buttons being held for a specific duration (button -> remaining ticks)
-    std::unordered_map<int, int> m_HeldMouseButtons;
+    // Mouse buttons being held for a specific duration (same layout as keys)
+    std::array<int, 4> m_HeldMouseTicks{};
+    uint8_t m_HeldMouseMask = 0;
 
     // Joystick buttons being held for a specific duration ((joystick_id << 16 | button) -> remaining ticks)
     std::unordered_map<int, int> m_HeldJoystickButtons;
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Fixed 256-bit set of keyboard key codes
+ *
+ * One bit per CKKEYBOARD code. Set operations and subset tests run a word at
+ * a time, so testing or applying a whole key combination costs a handful of
+ * 64-bit operations regardless of how many keys it contains.
+ */
+class KeyMask {
+public:
+    static constexpr size_t kKeyCount = 256;
+    static constexpr size_t kWordCount = kKeyCount / 64;
+
+    constexpr KeyMask() = default;
+
+    void Set(uint8_t code) { m_Words[code >> 6] |= Bit(code); }
+    void Reset(uint8_t code) { m_Words[code >> 6] &= ~Bit(code); }
+    bool Test(uint8_t code) const { return (m_Words[code >> 6] & Bit(code)) != 0; }
+
+    void Clear() { m_Words = {}; }
+
+    bool Any() const {
+        return (m_Words[0] | m_Words[1] | m_Words[2] | m_Words[3]) != 0;
+    }
+
+    size_t Count() const {
+        size_t count = 0;
+        for (uint64_t word : m_Words) {
+            count += static_cast<size_t>(std::popcount(word));
+        }
+        return count;
+    }
+
+    /**
+     * @brief Checks if every key of another mask is set in this one
+     */
+    bool ContainsAll(const KeyMask &other) const {
+        uint64_t missing = 0;
+        for (size_t i = 0; i < kWordCount; ++i) {
+            missing |= other.m_Words[i] & ~m_Words[i];
+        }
+        return missing == 0;
+    }
+
+    /**
+     * @brief Checks if any key of another mask is set in this one
+     */
+    bool Intersects(const KeyMask &other) const {
+        uint64_t common = 0;
+        for (size_t i = 0; i < kWordCount; ++i) {
+            common |= other.m_Words[i] & m_Words[i];
+        }
+        return common != 0;
+    }
+
+    KeyMask &operator|=(const KeyMask &other) {
+        for (size_t i = 0; i < kWordCount; ++i) m_Words[i] |= other.m_Words[i];
+        return *this;
+    }
+
+    KeyMask &operator&=(const KeyMask &other) {
+        for (size_t i = 0; i < kWordCount; ++i) m_Words[i] &= other.m_Words[i];
+        return *this;
+    }
+
+    /**
+     * @brief Removes every key of another mask from this one
+     */
+    KeyMask &Remove(const KeyMask &other) {
+        for (size_t i = 0; i < kWordCount; ++i) m_Words[i] &= ~other.m_Words[i];
+        return *this;
+    }
+
+    KeyMask operator~() const {
+        KeyMask result;
+        for (size_t i = 0; i < kWordCount; ++i) result.m_Words[i] = ~m_Words[i];
+        return result;
+    }
+
+    friend KeyMask operator|(KeyMask a, const KeyMask &b) { return a |= b; }
+    friend KeyMask operator&(KeyMask a, const KeyMask &b) { return a &= b; }
+    bool operator==(const KeyMask &other) const { return m_Words == other.m_Words; }
+    bool operator!=(const KeyMask &other) const { return m_Words != other.m_Words; }
+
+    /**
+     * @brief Calls fn(code) for every set key in ascending code order
+     */
+    template <typename F>
+    void ForEach(F &&fn) const {
+        for (size_t i = 0; i < kWordCount; ++i) {
+            for (uint64_t word = m_Words[i]; word != 0; word &= word - 1) {
+                fn(static_cast<uint8_t>(i * 64 + std::countr_zero(word)));
+            }
+        }
+    }
+
+    const std::array<uint64_t, kWordCount> &GetWords() const { return m_Words; }
+
+private:
+    static uint64_t Bit(uint8_t code) { return uint64_t(1) << (code & 63); }
+
+    std::array<uint64_t, kWordCount> m_Words{};
+};
+
+/**
+ * @brief A key combination parsed once from a key string ("up right", "space")
+ *
+ * Produced by InputSystem::ParseChord() and accepted by every keyboard call of
+ * InputSystem. Scripts keep chords as Lua userdata so per-frame inputs skip
+ * string parsing and key name lookups entirely.
+ *
+ * A chord remembers whether its source string named unknown keys: such chords
+ * still press their known keys but never match in AreKeysDown/Up/Toggled,
+ * matching the behavior of the string API.
+ */
+class KeyChord {
+public:
+    KeyChord() = default;
+
+    const KeyMask &GetMask() const { return m_Mask; }
+    KeyMask &GetMask() { return m_Mask; }
+
+    void AddKey(uint8_t code) { m_Mask.Set(code); }
+    void MarkUnknownKey() { m_HasUnknownKeys = true; }
+
+    bool IsEmpty() const { return !m_Mask.Any(); }
+    bool HasUnknownKeys() const { return m_HasUnknownKeys; }
+    size_t GetKeyCount() const { return m_Mask.Count(); }
+
+    /**
+     * @brief Checks if the chord can be used in key state queries
+     */
+    bool IsQueryable() const { return !m_HasUnknownKeys && m_Mask.Any(); }
+
+    KeyChord &operator|=(const KeyChord &other) {
+        m_Mask |= other.m_Mask;
+        m_HasUnknownKeys = m_HasUnknownKeys || other.m_HasUnknownKeys;
+        return *this;
+    }
+
+    friend KeyChord operator|(KeyChord a, const KeyChord &b) { return a |= b; }
+
+    bool operator==(const KeyChord &other) const {
+        return m_Mask == other.m_Mask && m_HasUnknownKeys == other.m_HasUnknownKeys;
+    }
+
+private:
+    KeyMask m_Mask;
+    bool m_HasUnknownKeys = false;
+};
@@ -1,9 +1,13 @@
 #pragma once
 
 #include <atomic>
+#include <bit>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <utility>
+#include <vector>
 
 /**
  * @brief Lock-free Multi-Producer Single-Consumer (MPSC) queue
@@ -15,15 +19,21 @@
  * Design based on Dmitry Vyukov's intrusive MPSC queue with priority support.
  *
  * Properties:
- * - Wait-free enqueue (producers never block)
+ * - Lock-free enqueue (producers never block once the node pool is warm)
  * - Lock-free dequeue (consumer never blocks)
  * - Bounded memory (configurable max size)
  * - Priority ordering (within same-priority FIFO)
  * - No dynamic allocation on hot path after warmup
  *
+ * Nodes come from slabs owned by the queue and are recycled through a lock-free
+ * freelist (tagged indices guard against ABA). A slab is only allocated when the
+ * freelist runs dry, so steady-state traffic never touches the global allocator.
+ * A bitmask of non-empty lanes lets the consumer jump to the highest occupied
+ * priority instead of probing every lane.
+ *
  * Thread Safety:
  * - Multiple threads can call Enqueue() concurrently (lock-free)
- * - Only ONE thread may call Dequeue() (single consumer)
+ * - Only ONE thread may call Dequeue() / DequeueBatch() (single consumer)
  * - Size() is approximate (eventually consistent)
  *
  * Template Parameters:
@@ -32,16 +42,22 @@
  */
 template <typename T, int MaxPriority = 15>
 class LockFreeMPSCQueue {
+    static_assert(MaxPriority >= 0 && MaxPriority < 32, "Lane mask holds at most 32 priorities");
+
 public:
     /**
      * @brief Constructs a bounded MPSC queue
      * @param maxSize Maximum number of elements (0 = unbounded, not recommended)
      */
     explicit LockFreeMPSCQueue(size_t maxSize = 10000) : m_MaxSize(maxSize), m_ApproxSize(0) {
+        for (auto &slab : m_Slabs) {
+            slab.store(nullptr, std::memory_order_relaxed);
+        }
+
         // Initialize per-priority queues
         for (int i = 0; i <= MaxPriority; ++i) {
             // Create dummy stub nodes
-            Node *stub = new Node();
+            Node *stub = AcquireNode();
             m_PriorityQueues[i].head.store(stub, std::memory_order_relaxed);
             m_PriorityQueues[i].tail.store(stub, std::memory_order_relaxed);
         }
@@ -51,10 +67,10 @@ public:
         // Drain all queues
         while (Dequeue().has_value()) {}
 
-        // Delete stub nodes
-        for (int i = 0; i <= MaxPriority; ++i) {
-            Node *stub = m_PriorityQueues[i].head.load(std::memory_order_relaxed);
-            delete stub;
+        // Stub nodes live in the slabs, so releasing the slabs frees every node
+        const uint32_t slabCount = m_SlabCount.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < slabCount; ++i) {
+            delete[] m_Slabs[i].load(std::memory_order_relaxed);
         }
     }
 
@@ -78,8 +94,12 @@ public:
             return false;
         }
 
-        // Allocate node (only allocation on hot path)
-        Node *node = new Node(std::move(value));
+        // Take a recycled node (allocates a slab only while warming up)
+        Node *node = AcquireNode();
+        if (!node) {
+            return false;
+        }
+        node->value.emplace(std::move(value));
 
         // Enqueue into the appropriate priority queue
         EnqueueIntoPriorityQueue(node, priority);
@@ -97,16 +117,51 @@ public:
      * THREAD SAFETY: Only ONE thread may call this method!
      */
     std::optional<T> Dequeue() {
-        // Try queues from highest to lowest priority
-        for (int priority = MaxPriority; priority >= 0; --priority) {
+        // Jump straight to the highest occupied priority
+        int priority;
+        while ((priority = HighestOccupiedLane()) >= 0) {
             if (auto value = DequeueFromPriorityQueue(priority)) {
                 m_ApproxSize.fetch_sub(1, std::memory_order_relaxed);
                 return value;
             }
+            ClearLane(priority);
         }
         return std::nullopt;
     }
 
+    /**
+     * @brief Dequeues up to max messages in priority order (lock-free for single consumer)
+     * @param out Vector the messages are appended to
+     * @param max Maximum number of messages to dequeue
+     * @return Number of messages dequeued
+     *
+     * Messages enqueued while the batch is collected are not reordered into it;
+     * a higher-priority message arriving mid-batch is returned by the next call.
+     *
+     * THREAD SAFETY: Only ONE thread may call this method!
+     */
+    size_t DequeueBatch(std::vector<T> &out, size_t max) {
+        size_t count = 0;
+        int priority;
+        while (count < max && (priority = HighestOccupiedLane()) >= 0) {
+            // Drain the lane before moving on to lower priorities
+            while (count < max) {
+                auto value = DequeueFromPriorityQueue(priority);
+                if (!value) {
+                    ClearLane(priority);
+                    break;
+                }
+                out.push_back(std::move(*value));
+                ++count;
+            }
+        }
+
+        if (count > 0) {
+            m_ApproxSize.fetch_sub(count, std::memory_order_relaxed);
+        }
+        return count;
+    }
+
     /**
      * @brief Checks if queue is empty (approximate)
      * @return true if queue appears empty
@@ -131,14 +186,25 @@ public:
         return m_MaxSize;
     }
 
+    /**
+     * @brief Gets the number of nodes allocated by the pool so far
+     * @return Allocated node count (stops growing once traffic reaches a steady state)
+     */
+    size_t AllocatedNodes() const {
+        return static_cast<size_t>(m_SlabCount.load(std::memory_order_relaxed)) * kSlabSize;
+    }
+
 private:
+    static constexpr uint32_t kNullIndex = 0xFFFFFFFFu;
+    static constexpr uint32_t kSlabShift = 8;
+    static constexpr uint32_t kSlabSize = 1u << kSlabShift;
+    static constexpr uint32_t kMaxSlabs = 4096; // Up to 1M nodes
+
     struct Node {
-        std::atomic<Node *> next;
+        std::atomic<Node *> next{nullptr};
         std::optional<T> value;
-
-        Node() : next(nullptr), value(std::nullopt) {}
-
-        explicit Node(T &&val) : next(nullptr), value(std::move(val)) {}
+        uint32_t index = kNullIndex;          // Position in the slab pool
+        std::atomic<uint32_t> nextFree{kNullIndex}; // Freelist link
     };
 
     struct PriorityQueue {
@@ -158,6 +224,9 @@ private:
         // Atomically swap tail pointer and link previous tail to new node
         Node *prev = queue.tail.exchange(node, std::memory_order_acq_rel);
         prev->next.store(node, std::memory_order_release);
+
+        // Mark the lane as occupied (after linking, see ClearLane)
+        m_LaneMask.fetch_or(1u << priority, std::memory_order_release);
     }
 
     std::optional<T> DequeueFromPriorityQueue(int priority) {
@@ -172,18 +241,117 @@ private:
             return std::nullopt;
         }
 
-        // Extract value from next node
+        // Extract value from next node; it becomes the new stub
         std::optional<T> value = std::move(next->value);
+        next->value.reset();
 
         // Move head forward
         queue.head.store(next, std::memory_order_relaxed);
 
-        // Delete old head (it's now a stub)
-        delete head;
+        // Recycle old head. No producer can still reference it: the one that
+        // linked head->next was the last to see it as the tail.
+        ReleaseNode(head);
 
         return value;
     }
 
+    bool LaneHasItems(int priority) const {
+        const auto &queue = m_PriorityQueues[priority];
+        return queue.head.load(std::memory_order_relaxed)->next.load(std::memory_order_acquire) != nullptr;
+    }
+
+    int HighestOccupiedLane() const {
+        const uint32_t mask = m_LaneMask.load(std::memory_order_acquire);
+        return mask ? 31 - std::countl_zero(mask) : -1;
+    }
+
+    void ClearLane(int priority) {
+        // Producers set the bit after linking their node. Re-checking after the
+        // clear catches a producer that linked between our probe and the clear.
+        const uint32_t bit = 1u << priority;
+        m_LaneMask.fetch_and(~bit, std::memory_order_acq_rel);
+        if (LaneHasItems(priority)) {
+            m_LaneMask.fetch_or(bit, std::memory_order_relaxed);
+        }
+    }
+
+    // ===================================================================
+    // Node Pool
+    // ===================================================================
+
+    Node *NodeAt(uint32_t index) const {
+        return m_Slabs[index >> kSlabShift].load(std::memory_order_acquire) + (index & (kSlabSize - 1));
+    }
+
+    Node *AcquireNode() {
+        if (Node *node = PopFreeNode()) {
+            return node;
+        }
+        return AllocateSlab();
+    }
+
+    // Returns nullptr once the freelist is empty
+    Node *PopFreeNode() {
+        uint64_t head = m_FreeHead.load(std::memory_order_acquire);
+        while (true) {
+            const auto index = static_cast<uint32_t>(head);
+            if (index == kNullIndex) {
+                return nullptr;
+            }
+
+            // The tag in the upper half changes on every update, so a node that was
+            // popped and pushed back in the meantime makes the CAS fail (no ABA)
+            Node *node = NodeAt(index);
+            const uint64_t next = ((head >> 32) + 1) << 32 | node->nextFree.load(std::memory_order_relaxed);
+            if (m_FreeHead.compare_exchange_weak(head, next, std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+                return node;
+            }
+        }
+    }
+
+    void ReleaseNode(Node *node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+
+        uint64_t head = m_FreeHead.load(std::memory_order_relaxed);
+        uint64_t next;
+        do {
+            node->nextFree.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            next = ((head >> 32) + 1) << 32 | node->index;
+        } while (!m_FreeHead.compare_exchange_weak(head, next, std::memory_order_release,
+                                                   std::memory_order_relaxed));
+    }
+
+    Node *AllocateSlab() {
+        // Cold path: taken only while the pool grows to its working size
+        std::lock_guard<std::mutex> lock(m_SlabMutex);
+
+        // Another producer may have refilled the freelist while we waited. Pop it
+        // directly: going through AcquireNode could re-enter this function and
+        // lock m_SlabMutex twice if other producers drain the list meanwhile.
+        if (Node *node = PopFreeNode()) {
+            return node;
+        }
+
+        const uint32_t slabIndex = m_SlabCount.load(std::memory_order_relaxed);
+        if (slabIndex >= kMaxSlabs) {
+            return nullptr;
+        }
+
+        Node *slab = new Node[kSlabSize];
+        for (uint32_t i = 0; i < kSlabSize; ++i) {
+            slab[i].index = (slabIndex << kSlabShift) | i;
+        }
+        m_Slabs[slabIndex].store(slab, std::memory_order_release);
+        m_SlabCount.store(slabIndex + 1, std::memory_order_release);
+
+        // Keep the first node, publish the rest
+        for (uint32_t i = 1; i < kSlabSize; ++i) {
+            ReleaseNode(&slab[i]);
+        }
+        return &slab[0];
+    }
+
     // Configuration
     size_t m_MaxSize;
 
@@ -192,4 +360,13 @@ private:
 
     // Approximate size counter (relaxed ordering, for size limits only)
     alignas(64) std::atomic<size_t> m_ApproxSize;
+
+    // Bit i set = lane i may hold messages
+    alignas(64) std::atomic<uint32_t> m_LaneMask{0};
+
+    // Node pool: freelist head packs (tag << 32) | node index
+    alignas(64) std::atomic<uint64_t> m_FreeHead{kNullIndex};
+    std::atomic<Node *> m_Slabs[kMaxSlabs];
+    std::atomic<uint32_t> m_SlabCount{0};
+    std::mutex m_SlabMutex;
 };
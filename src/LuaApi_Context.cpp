@@ -3,12 +3,15 @@
 #include "Logger.h"
 #include <stdexcept>
 
+#include <VxMath.h>
+
 #include "TASEngine.h"
 #include "ScriptContext.h"
 #include "ScriptContextManager.h"
 #include "SharedDataManager.h"
 #include "MessageBus.h"
 #include "LuaScheduler.h"
+#include "WorkerPool.h"
 
 #include <atomic>
 #include <sstream>
@@ -16,6 +19,12 @@
 #include <algorithm>
 #include <cctype>
 
+namespace {
+    // Bumped on every registration, so a recreated context with the same name
+    // never reuses the correlation IDs of its predecessor
+    std::atomic<uint64_t> g_CorrelationEpoch{0};
+}
+
 // ===================================================================
 //  Context Communication API Registration
 // ===================================================================
@@ -136,7 +145,10 @@ void LuaApi::RegisterContextCommunicationApi(sol::table &tas, ScriptContext *con
         if (!contextPtr) {
             throw sol::error("shared.watch: context no longer exists");
         }
-        sharedData->Watch(contextName, contextPtr, key, callback);
+        // Deferred while ticking off the game thread, so watchers register in priority order
+        WorkerPool::RunOrDefer([sharedData, contextName, contextPtr, key, callback] {
+            sharedData->Watch(contextName, contextPtr, key, callback);
+        });
     };
 
     // tas.shared.unwatch(key) - Stop watching a key
@@ -147,7 +159,7 @@ void LuaApi::RegisterContextCommunicationApi(sol::table &tas, ScriptContext *con
         if (key.empty()) {
             return;
         }
-        sharedData->Unwatch(contextName, key);
+        WorkerPool::RunOrDefer([sharedData, contextName, key] { sharedData->Unwatch(contextName, key); });
     };
 
     // tas.shared.clear() - Clear all shared data
@@ -180,6 +192,101 @@ void LuaApi::RegisterContextCommunicationApi(sol::table &tas, ScriptContext *con
         return sharedData->GetSize();
     };
 
+    // ===================================================================
+    // Typed slots (tas.shared.slot(name))
+    // ===================================================================
+
+    sol::state_view lua = context->GetLuaState();
+    sol::usertype<SharedSlot> slotType = lua.new_usertype<SharedSlot>(
+        "SharedSlot",
+        sol::no_constructor // Use tas.shared.slot(name)
+    );
+
+    // slot:name() - Slot name
+    slotType["name"] = [](const SharedSlot &self) -> std::string {
+        return self.GetName();
+    };
+
+    // slot:version() - Version of the last write (0 = never written)
+    slotType["version"] = &SharedSlot::GetVersion;
+
+    // slot:changed(version) - True if the slot was written after `version`
+    slotType["changed"] = [](const SharedSlot &self, uint64_t version) -> bool {
+        return self.GetVersion() != version;
+    };
+
+    // slot:set(value) - Store a number, VxVector, array of up to 16 numbers or SharedBuffer
+    slotType["set"] = [](SharedSlot &self, sol::object value) -> uint64_t {
+        try {
+            return self.Store(SharedSlot::FromLuaObject(value));
+        } catch (const std::exception &e) {
+            throw sol::error(std::string("slot.set: ") + e.what());
+        }
+    };
+
+    // slot:get() - Returns value, version
+    slotType["get"] = [](const SharedSlot &self, sol::this_state ts) -> std::tuple<sol::object, uint64_t> {
+        SharedSlot::Value value;
+        const uint64_t version = self.Load(value);
+        return {SharedSlot::ToLuaObject(sol::state_view(ts), value), version};
+    };
+
+    // slot:read_into(target) - Copy a vector/array into an existing VxVector or table, returns version
+    slotType["read_into"] = [](const SharedSlot &self, sol::object target) -> uint64_t {
+        SharedSlot::Value value;
+        const uint64_t version = self.Load(value);
+        if (value.type != SharedSlot::Type::Vector && value.type != SharedSlot::Type::FloatArray) {
+            throw sol::error("slot.read_into: slot does not hold a vector or number array");
+        }
+
+        if (target.is<VxVector>()) {
+            if (value.count < 3) {
+                throw sol::error("slot.read_into: slot holds fewer than 3 numbers");
+            }
+            VxVector &v = target.as<VxVector &>();
+            v.x = value.floats[0];
+            v.y = value.floats[1];
+            v.z = value.floats[2];
+        } else if (target.get_type() == sol::type::table) {
+            sol::table t = target.as<sol::table>();
+            for (size_t i = 0; i < value.count; ++i) {
+                t[i + 1] = value.floats[i];
+            }
+        } else {
+            throw sol::error("slot.read_into: target must be a VxVector or a table");
+        }
+        return version;
+    };
+
+    // slot:watch(callback) - Call callback(new, old, name) on ticks where the slot changed
+    slotType["watch"] = [sharedData, contextManager, contextName](const SharedSlot &self, sol::function callback) {
+        if (!callback.valid()) {
+            throw sol::error("slot.watch: callback must be a valid function");
+        }
+        auto contextPtr = contextManager->GetContext(contextName);
+        if (!contextPtr) {
+            throw sol::error("slot.watch: context no longer exists");
+        }
+        WorkerPool::RunOrDefer([sharedData, contextName, contextPtr, name = self.GetName(), callback] {
+            sharedData->WatchSlot(contextName, contextPtr, name, callback);
+        });
+    };
+
+    // slot:unwatch() - Stop watching the slot
+    slotType["unwatch"] = [sharedData, contextName](const SharedSlot &self) {
+        WorkerPool::RunOrDefer([sharedData, contextName, name = self.GetName()] {
+            sharedData->UnwatchSlot(contextName, name);
+        });
+    };
+
+    // tas.shared.slot(name) - Get (or create) a typed slot
+    shared["slot"] = [sharedData](const std::string &name) -> std::shared_ptr<SharedSlot> {
+        if (name.empty()) {
+            throw sol::error("shared.slot: name cannot be empty");
+        }
+        return sharedData->GetSlot(name);
+    };
+
     // ===================================================================
     // Message API (tas.message.*)
     // ===================================================================
@@ -246,9 +353,19 @@ void LuaApi::RegisterContextCommunicationApi(sol::table &tas, ScriptContext *con
         }
     );
 
+    // Correlation IDs are numbered per context, so they do not depend on how
+    // contexts interleave (contexts may tick in parallel). The epoch is taken at
+    // registration, which happens on the game thread, and keeps IDs process-unique.
+    const uint64_t epoch = g_CorrelationEpoch.fetch_add(1, std::memory_order_relaxed) + 1;
+    auto nextCorrelationId = [contextName, epoch, counter = std::make_shared<uint64_t>(0)]() {
+        std::ostringstream oss;
+        oss << "req_" << contextName << '_' << epoch << '_' << std::setw(16) << std::setfill('0') << ++*counter;
+        return oss.str();
+    };
+
     // tas.message.request(target, type, data, timeout?) - Send request and wait for response (async)
     message["request"] = sol::overload(
-        [messageBus, context, contextName](const std::string &target, const std::string &type, sol::object data) -> sol::object {
+        [messageBus, context, contextName, nextCorrelationId](const std::string &target, const std::string &type, sol::object data) -> sol::object {
             if (!messageBus || !context) {
                 throw sol::error("message.request: MessageBus or Context not available");
             }
@@ -257,11 +374,7 @@ void LuaApi::RegisterContextCommunicationApi(sol::table &tas, ScriptContext *con
             }
 
             // Generate correlation ID for this request
-            static std::atomic<uint64_t> s_NextCorrelationId{1};
-            uint64_t id = s_NextCorrelationId.fetch_add(1, std::memory_order_relaxed);
-            std::ostringstream oss;
-            oss << "req_" << std::setw(16) << std::setfill('0') << id;
-            std::string correlationId = oss.str();
+            std::string correlationId = nextCorrelationId();
 
             // Send request message async
             if (!messageBus->SendRequestAsync(contextName, target, type, data, correlationId)) {
@@ -276,8 +389,8 @@ void LuaApi::RegisterContextCommunicationApi(sol::table &tas, ScriptContext *con
 
             return scheduler->YieldWaitForMessageResponse(correlationId, 5000);
         },
-        [messageBus, context, contextName](const std::string &target, const std::string &type,
-                                           sol::object data, int timeout) -> sol::object {
+        [messageBus, context, contextName, nextCorrelationId](const std::string &target, const std::string &type,
+                                                              sol::object data, int timeout) -> sol::object {
             if (!messageBus || !context) {
                 throw sol::error("message.request: MessageBus or Context not available");
             }
@@ -286,11 +399,7 @@ void LuaApi::RegisterContextCommunicationApi(sol::table &tas, ScriptContext *con
             }
 
             // Generate correlation ID
-            static std::atomic<uint64_t> s_NextCorrelationId{1};
-            uint64_t id = s_NextCorrelationId.fetch_add(1, std::memory_order_relaxed);
-            std::ostringstream oss;
-            oss << "req_" << std::setw(16) << std::setfill('0') << id;
-            std::string correlationId = oss.str();
+            std::string correlationId = nextCorrelationId();
 
             // Send request message async
             if (!messageBus->SendRequestAsync(contextName, target, type, data, correlationId)) {
@@ -323,7 +432,10 @@ void LuaApi::RegisterContextCommunicationApi(sol::table &tas, ScriptContext *con
         if (!contextPtr) {
             throw sol::error("message.on: context no longer exists");
         }
-        messageBus->RegisterLuaHandler(contextName, contextPtr, type, callback);
+        // Deferred while ticking off the game thread, so handlers register in priority order
+        WorkerPool::RunOrDefer([messageBus, contextName, contextPtr, type, callback] {
+            messageBus->RegisterLuaHandler(contextName, contextPtr, type, callback);
+        });
     };
 
     // tas.message.off(type) - Remove handler for message type
@@ -334,7 +446,7 @@ void LuaApi::RegisterContextCommunicationApi(sol::table &tas, ScriptContext *con
         if (type.empty()) {
             return;
         }
-        messageBus->RemoveHandler(contextName, type);
+        WorkerPool::RunOrDefer([messageBus, contextName, type] { messageBus->RemoveHandler(contextName, type); });
     };
 
     // tas.message.reply(message, response_data) - Reply to a request message
@@ -415,6 +527,19 @@ void LuaApi::RegisterContextCommunicationApi(sol::table &tas, ScriptContext *con
         return context->GetPriority();
     };
 
+    // tas.context.is_isolated() - Check if the context may tick on a worker thread
+    ctx["is_isolated"] = [context]() -> bool {
+        return context && context->IsIsolated();
+    };
+
+    // tas.context.set_isolated(isolated) - Allow this context to tick in parallel (from the next tick)
+    ctx["set_isolated"] = [context](bool isolated) {
+        if (!context) {
+            throw sol::error("context.set_isolated: Context not available");
+        }
+        context->SetIsolated(isolated);
+    };
+
     // tas.context.list() - List all active contexts
     ctx["list"] = [contextManager, context]() -> sol::table {
         if (!contextManager || !context) {
@@ -460,7 +585,10 @@ void LuaApi::RegisterContextCommunicationApi(sol::table &tas, ScriptContext *con
         if (eventName.empty()) {
             throw sol::error("context.subscribe: event name cannot be empty");
         }
-        contextManager->SubscribeToEvent(contextName, eventName);
+        // The subscription lists are not locked: off the game thread this is applied after the tick
+        WorkerPool::RunOrDefer([contextManager, contextName, eventName] {
+            contextManager->SubscribeToEvent(contextName, eventName);
+        });
     };
 
     // tas.context.unsubscribe(event_name) - Unsubscribe from global game event
@@ -471,6 +599,8 @@ void LuaApi::RegisterContextCommunicationApi(sol::table &tas, ScriptContext *con
         if (eventName.empty()) {
             return;
         }
-        contextManager->UnsubscribeFromEvent(contextName, eventName);
+        WorkerPool::RunOrDefer([contextManager, contextName, eventName] {
+            contextManager->UnsubscribeFromEvent(contextName, eventName);
+        });
     };
 }
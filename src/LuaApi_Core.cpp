@@ -192,7 +192,7 @@ void LuaApi::RegisterCoreApi(sol::table &tas, ScriptContext *context) {
         try {
             const TASProject *project = context->GetCurrentProject();
             if (project) {
-                return project->GetManifestTable();
+                return project->GetManifestTable(context->GetLuaState());
             }
         } catch (const std::exception &) {
             // Fall through to return empty table
@@ -33,43 +33,84 @@ void LuaApi::RegisterInputApi(sol::table &tas, ScriptContext *context) {
 
     sol::table keyboard = tas["keyboard"] = tas.create();
 
-    // tas.keyboard.press(key_string)
-    keyboard["press"] = [inputSystem](const std::string &keyString) {
-        if (keyString.empty()) {
+    // Key chords: key strings parsed once, accepted by every keyboard function
+    sol::state_view lua(tas.lua_state());
+    sol::usertype<KeyChord> chordType = lua.new_usertype<KeyChord>(
+        "KeyChord",
+        sol::no_constructor // Use tas.keyboard.chord()
+    );
+    chordType["count"] = &KeyChord::GetKeyCount;
+    chordType["is_empty"] = &KeyChord::IsEmpty;
+    chordType[sol::meta_function::bitwise_or] = [](const KeyChord &a, const KeyChord &b) { return a | b; };
+    chordType[sol::meta_function::addition] = [](const KeyChord &a, const KeyChord &b) { return a | b; };
+    chordType[sol::meta_function::equal_to] = [](const KeyChord &a, const KeyChord &b) { return a == b; };
+
+    // tas.keyboard.chord(key_string) - Precompile a key string for per-frame use
+    keyboard["chord"] = [inputSystem](const std::string &keyString) {
+        std::string unknownKey;
+        KeyChord chord = inputSystem->ParseChord(keyString, &unknownKey);
+        if (chord.HasUnknownKeys()) {
+            throw sol::error("keyboard.chord: unknown key '" + unknownKey + "'");
+        }
+        if (chord.IsEmpty()) {
+            throw sol::error("keyboard.chord: key string cannot be empty");
+        }
+        return chord;
+    };
+
+    // Resolves a key string or KeyChord argument (nullptr for an empty string)
+    auto resolveKeys = [inputSystem](const sol::object &keys, const char *functionName) -> const KeyChord * {
+        if (keys.is<KeyChord>()) {
+            return &keys.as<const KeyChord &>();
+        }
+        if (keys.get_type() != sol::type::string) {
+            throw sol::error(std::string(functionName) + ": expected a key string or KeyChord");
+        }
+        const std::string keyString = keys.as<std::string>();
+        return keyString.empty() ? nullptr : &inputSystem->GetCachedChord(keyString);
+    };
+
+    // tas.keyboard.press(keys)
+    keyboard["press"] = [inputSystem, resolveKeys](const sol::object &keys) {
+        const KeyChord *chord = resolveKeys(keys, "keyboard.press");
+        if (!chord) {
             throw sol::error("keyboard.press: key string cannot be empty");
         }
         // Press keys for exactly one frame
-        inputSystem->PressKeysOneFrame(keyString);
+        inputSystem->PressKeysOneFrame(*chord);
     };
 
-    // tas.keyboard.hold(key_string, duration_ticks)
-    keyboard["hold"] = sol::yielding([inputSystem, scheduler](const std::string &keyString, int duration) {
-        if (keyString.empty()) {
+    // tas.keyboard.hold(keys, duration_ticks)
+    keyboard["hold"] = sol::yielding([inputSystem, scheduler, resolveKeys](const sol::object &keys, int duration) {
+        const KeyChord *chord = resolveKeys(keys, "keyboard.hold");
+        if (!chord) {
             throw sol::error("keyboard.hold: key string cannot be empty");
         }
         if (duration <= 0) {
             throw sol::error("keyboard.hold: duration must be positive");
         }
         // InputSystem handles the timing internally
-        inputSystem->HoldKeys(keyString, duration);
+        inputSystem->HoldKeys(*chord, duration);
         // Yield for the specified duration
         scheduler->YieldTicks(duration);
     });
 
-    // tas.keyboard.key_down(key_string)
-    keyboard["key_down"] = [inputSystem](const std::string &keyString) {
-        if (keyString.empty()) {
+    // tas.keyboard.key_down(keys)
+    keyboard["key_down"] = [inputSystem, resolveKeys](const sol::object &keys) {
+        const KeyChord *chord = resolveKeys(keys, "keyboard.key_down");
+        if (!chord) {
             throw sol::error("keyboard.key_down: key string cannot be empty");
         }
-        inputSystem->PressKeys(keyString);
+        inputSystem->PressKeys(*chord);
     };
 
-    // tas.keyboard.key_up(key_string)
-    keyboard["key_up"] = [inputSystem](const std::string &keyString) {
-        if (keyString.empty()) {
+    // tas.keyboard.key_up(keys)
+    keyboard["key_up"] = [inputSystem, resolveKeys](const sol::object &keys) {
+        const KeyChord *chord = resolveKeys(keys, "keyboard.key_up");
+        if (!chord) {
             throw sol::error("keyboard.key_up: key string cannot be empty");
         }
-        inputSystem->ReleaseKeys(keyString);
+        inputSystem->ReleaseKeys(*chord);
     };
 
     // tas.keyboard.release_all()
@@ -77,28 +118,22 @@ void LuaApi::RegisterInputApi(sol::table &tas, ScriptContext *context) {
         inputSystem->ReleaseAllKeys();
     };
 
-    // tas.keyboard.are_keys_down(key_string)
-    keyboard["are_keys_down"] = [inputSystem](const std::string &keyString) {
-        if (keyString.empty()) {
-            return false;
-        }
-        return inputSystem->AreKeysDown(keyString);
+    // tas.keyboard.are_keys_down(keys)
+    keyboard["are_keys_down"] = [inputSystem, resolveKeys](const sol::object &keys) {
+        const KeyChord *chord = resolveKeys(keys, "keyboard.are_keys_down");
+        return chord && inputSystem->AreKeysDown(*chord);
     };
 
-    // tas.keyboard.are_keys_up(key_string)
-    keyboard["are_keys_up"] = [inputSystem](const std::string &keyString) {
-        if (keyString.empty()) {
-            return false;
-        }
-        return inputSystem->AreKeysUp(keyString);
+    // tas.keyboard.are_keys_up(keys)
+    keyboard["are_keys_up"] = [inputSystem, resolveKeys](const sol::object &keys) {
+        const KeyChord *chord = resolveKeys(keys, "keyboard.are_keys_up");
+        return chord && inputSystem->AreKeysUp(*chord);
     };
 
-    // tas.keyboard.are_keys_toggled(key_string)
-    keyboard["are_keys_toggled"] = [inputSystem](const std::string &keyString) -> bool {
-        if (keyString.empty()) {
-            return false;
-        }
-        return inputSystem->AreKeysToggled(keyString);
+    // tas.keyboard.are_keys_toggled(keys)
+    keyboard["are_keys_toggled"] = [inputSystem, resolveKeys](const sol::object &keys) -> bool {
+        const KeyChord *chord = resolveKeys(keys, "keyboard.are_keys_toggled");
+        return chord && inputSystem->AreKeysToggled(*chord);
     };
 
     // tas.keyboard.get_available_keys()
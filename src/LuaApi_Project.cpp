@@ -7,6 +7,7 @@
 #include "ProjectManager.h"
 #include "TASProject.h"
 #include "RecordPlayer.h"
+#include "TASControllers.h"
 #include "ScriptContextManager.h"
 #include "ScriptContext.h"
 #include "GameInterface.h"
@@ -269,6 +270,59 @@ void LuaApi::RegisterProjectApi(sol::table &tas, ScriptContext *context) {
         return false;
     };
 
+    // tas.project.translate(name) - Translate a record project to a script without playing it
+    project["translate"] = [context](const std::string &projectName) -> bool {
+        if (projectName.empty()) {
+            throw sol::error("project.translate: project name cannot be empty");
+        }
+
+        auto *pm = context->GetProjectManager();
+        auto *translation = context->GetTranslationController();
+        if (!pm || !translation) {
+            throw sol::error("project.translate: translation not available");
+        }
+
+        for (const auto &proj : pm->GetProjects()) {
+            if (proj && proj->IsRecordProject() && proj->GetName() == projectName) {
+                auto result = translation->TranslateOffline(
+                    proj.get(), TranslationController::MakeGenerationOptions(*proj));
+                if (!result.IsOk()) {
+                    Log::Warn("project.translate: %s", result.GetError().message.c_str());
+                    return false;
+                }
+                return true;
+            }
+        }
+
+        Log::Warn("project.translate: record project '%s' not found", projectName.c_str());
+        return false;
+    };
+
+    // tas.project.translate_directory(dir) - Translate every .tas record in a directory, returns the count queued
+    project["translate_directory"] = [context](const std::string &directory) -> int {
+        if (directory.empty()) {
+            throw sol::error("project.translate_directory: directory cannot be empty");
+        }
+
+        auto *translation = context->GetTranslationController();
+        if (!translation) {
+            throw sol::error("project.translate_directory: translation not available");
+        }
+
+        auto result = translation->TranslateDirectory(directory);
+        if (!result.IsOk()) {
+            Log::Warn("project.translate_directory: %s", result.GetError().message.c_str());
+            return 0;
+        }
+        return static_cast<int>(result.Unwrap());
+    };
+
+    // tas.project.is_translating() - Check if an offline translation is running
+    project["is_translating"] = [context]() -> bool {
+        auto *translation = context->GetTranslationController();
+        return translation && translation->IsTranslatingOffline();
+    };
+
     // tas.project.is_loaded() - Check if any project is loaded
     project["is_loaded"] = [context]() -> bool {
         auto *pm = context->GetProjectManager();
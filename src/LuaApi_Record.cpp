@@ -354,15 +354,15 @@ void LuaApi::RegisterRecordApi(sol::table &tas, ScriptContext *context) {
     // Save & Export Operations APIs
     // ===================================================================
 
-    // tas.record.save(path) - Save the current record
-    record["save"] = [recordPlayer](const std::string &path) -> bool {
+    // tas.record.save(path, [legacy]) - Save the current record
+    record["save"] = [recordPlayer](const std::string &path, sol::optional<bool> legacy) -> bool {
         if (!recordPlayer) {
             throw sol::error("record.save: RecordPlayer not available");
         }
         if (path.empty()) {
             throw sol::error("record.save: path cannot be empty");
         }
-        return recordPlayer->Save(path);
+        return recordPlayer->Save(path, legacy.value_or(false));
     };
 
     // tas.record.export_inputs(path, format) - Export inputs to text/JSON
@@ -832,7 +832,7 @@ void LuaApi::RegisterRecordApi(sol::table &tas, ScriptContext *context) {
         sol::table result = lua.create_table();
         result["name"] = macro->name;
         result["description"] = macro->description;
-        result["frame_count"] = macro->frames.size();
+        result["frame_count"] = macro->frames.GetSize();
         return result;
     };
 
@@ -850,7 +850,7 @@ void LuaApi::RegisterRecordApi(sol::table &tas, ScriptContext *context) {
             sol::table macro = lua.create_table();
             macro["name"] = macros[i].name;
             macro["description"] = macros[i].description;
-            macro["frame_count"] = macros[i].frames.size();
+            macro["frame_count"] = macros[i].frames.GetSize();
             result[i + 1] = macro;
         }
 
@@ -1012,6 +1012,25 @@ void LuaApi::RegisterRecordApi(sol::table &tas, ScriptContext *context) {
         recordPlayer->SetMaxHistorySize(static_cast<size_t>(size));
     };
 
+    // tas.record.get_history_bytes()
+    record["get_history_bytes"] = [recordPlayer]() -> double {
+        if (!recordPlayer) {
+            return 0;
+        }
+        return static_cast<double>(recordPlayer->GetHistoryBytes());
+    };
+
+    // tas.record.set_max_history_bytes(bytes)
+    record["set_max_history_bytes"] = [recordPlayer](double bytes) {
+        if (!recordPlayer) {
+            throw sol::error("record.set_max_history_bytes: RecordPlayer not available");
+        }
+        if (bytes < 0) {
+            throw sol::error("record.set_max_history_bytes: bytes must be non-negative");
+        }
+        recordPlayer->SetMaxHistoryBytes(static_cast<size_t>(bytes));
+    };
+
     // ===================================================================
     // Search & Filter APIs
     // ===================================================================
@@ -1135,7 +1154,7 @@ void LuaApi::RegisterRecordApi(sol::table &tas, ScriptContext *context) {
             branch["divergence_frame"] = branches[i].divergenceFrame;
             branch["convergence_frame"] = branches[i].convergenceFrame;
             branch["parent_branch"] = branches[i].parentBranch;
-            branch["frame_count"] = branches[i].frames.size();
+            branch["frame_count"] = branches[i].frames.GetSize();
             result[i + 1] = branch;
         }
 
@@ -1204,4 +1223,62 @@ void LuaApi::RegisterRecordApi(sol::table &tas, ScriptContext *context) {
 
         return result;
     };
+
+    // ===================================================================
+    // Keyframe APIs
+    // ===================================================================
+
+    // tas.record.is_seeking()
+    record["is_seeking"] = [recordPlayer]() -> bool {
+        if (!recordPlayer) {
+            return false;
+        }
+        return recordPlayer->IsSeeking();
+    };
+
+    // tas.record.set_keyframe_interval(frames)
+    record["set_keyframe_interval"] = [recordPlayer](int frames) {
+        if (!recordPlayer) {
+            throw sol::error("record.set_keyframe_interval: RecordPlayer not available");
+        }
+        if (frames < 0) {
+            throw sol::error("record.set_keyframe_interval: frames must be non-negative");
+        }
+        recordPlayer->SetKeyframeInterval(static_cast<size_t>(frames));
+    };
+
+    // tas.record.get_keyframe_interval()
+    record["get_keyframe_interval"] = [recordPlayer]() -> int {
+        if (!recordPlayer) {
+            return 0;
+        }
+        return static_cast<int>(recordPlayer->GetKeyframeInterval());
+    };
+
+    // tas.record.set_keyframe_budget(bytes)
+    record["set_keyframe_budget"] = [recordPlayer](double bytes) {
+        if (!recordPlayer) {
+            throw sol::error("record.set_keyframe_budget: RecordPlayer not available");
+        }
+        if (bytes < 0) {
+            throw sol::error("record.set_keyframe_budget: bytes must be non-negative");
+        }
+        recordPlayer->SetKeyframeBudget(static_cast<size_t>(bytes));
+    };
+
+    // tas.record.get_keyframe_count()
+    record["get_keyframe_count"] = [recordPlayer]() -> int {
+        if (!recordPlayer) {
+            return 0;
+        }
+        return static_cast<int>(recordPlayer->GetKeyframeCount());
+    };
+
+    // tas.record.clear_keyframes()
+    record["clear_keyframes"] = [recordPlayer]() {
+        if (!recordPlayer) {
+            throw sol::error("record.clear_keyframes: RecordPlayer not available");
+        }
+        recordPlayer->ClearKeyframes();
+    };
 }
@@ -0,0 +1,310 @@
+#include "LuaBytecodeCache.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <vector>
+
+#include "Logger.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char kEntryMagic[4] = {'T', 'L', 'B', 'C'};
+    constexpr uint32_t kEntryFormat = 1;
+    constexpr const char *kEntryExtension = ".luac";
+
+    // Fixed-size header in front of the dumped bytecode of every entry
+    struct EntryHeader {
+        char magic[4];
+        uint32_t format;
+        uint32_t luaVersion;
+        uint32_t reserved;
+        uint64_t sourceSize;
+        uint64_t key;
+    };
+    static_assert(sizeof(EntryHeader) == 32, "EntryHeader layout must stay stable");
+
+    uint64_t Mix(uint64_t h, uint64_t v) {
+        v *= 0xff51afd7ed558ccdULL;
+        v ^= v >> 33;
+        h ^= v;
+        return std::rotl(h, 27) * 0x9e3779b97f4a7c15ULL + 0x52dce729ULL;
+    }
+
+    uint64_t MixBytes(uint64_t h, const char *data, size_t size) {
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, data + i, 8);
+            h = Mix(h, word);
+        }
+        uint64_t tail = 0;
+        for (size_t shift = 0; i < size; ++i, shift += 8) {
+            tail |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << shift;
+        }
+        return Mix(h, tail);
+    }
+
+    int DumpWriter(lua_State *, const void *p, size_t size, void *userdata) {
+        static_cast<std::string *>(userdata)->append(static_cast<const char *>(p), size);
+        return 0;
+    }
+
+    sol::load_result MakeLoadResult(lua_State *L, int status) {
+        return sol::load_result(L, lua_absindex(L, -1), 1, 1, static_cast<sol::load_status>(status));
+    }
+}
+
+LuaBytecodeCache::LuaBytecodeCache(std::string cacheDir) : m_CacheDir(std::move(cacheDir)) {
+    std::error_code ec;
+    fs::create_directories(m_CacheDir, ec);
+    if (ec) {
+        Log::Warn("Could not create bytecode cache directory '%s': %s", m_CacheDir.c_str(), ec.message().c_str());
+    }
+}
+
+sol::load_result LuaBytecodeCache::LoadFile(sol::state_view lua, const std::string &path) {
+    lua_State *L = lua.lua_state();
+    const std::string chunkName = "@" + path;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        lua_pushfstring(L, "cannot open %s", path.c_str());
+        return MakeLoadResult(L, LUA_ERRFILE);
+    }
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (file.bad()) {
+        lua_pushfstring(L, "cannot read %s", path.c_str());
+        return MakeLoadResult(L, LUA_ERRFILE);
+    }
+
+    // Same prelude handling as luaL_loadfilex: skip a UTF-8 BOM and a '#' first line
+    size_t offset = 0;
+    if (content.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+        offset = 3;
+    }
+    if (offset < content.size() && content[offset] == '#') {
+        const size_t lineEnd = content.find('\n', offset);
+        offset = lineEnd == std::string::npos ? content.size() : lineEnd; // Keep the newline for line numbers
+    }
+
+    const char *source = content.data() + offset;
+    const size_t size = content.size() - offset;
+
+    // Precompiled files gain nothing from the cache
+    if (size >= 4 && std::memcmp(source, LUA_SIGNATURE, 4) == 0) {
+        return MakeLoadResult(L, luaL_loadbufferx(L, source, size, chunkName.c_str(), "b"));
+    }
+
+    return MakeLoadResult(L, LoadChunk(L, source, size, chunkName));
+}
+
+sol::load_result LuaBytecodeCache::LoadBuffer(sol::state_view lua, const std::string &source,
+                                              const std::string &chunkName) {
+    lua_State *L = lua.lua_state();
+    return MakeLoadResult(L, LoadChunk(L, source.data(), source.size(), chunkName));
+}
+
+void LuaBytecodeCache::InstallSearcher(sol::state_view lua, const std::shared_ptr<LuaBytecodeCache> &cache) {
+    sol::table package = lua["package"];
+    if (!cache || !package.valid()) {
+        return;
+    }
+
+    sol::table searchers = package["searchers"];
+    searchers[2] = [cache](sol::this_state ts, const std::string &name) -> sol::variadic_results {
+        sol::state_view state(ts);
+        sol::table pkg = state["package"];
+        sol::protected_function searchpath = pkg["searchpath"];
+
+        sol::variadic_results results;
+        sol::protected_function_result found = searchpath(name, pkg.get<std::string>("path"));
+        if (!found.valid() || found.get_type(0) != sol::type::string) {
+            // Let require report where it looked
+            std::string message = found.valid() && found.return_count() > 1 ? found.get<std::string>(1) : "";
+            results.push_back(sol::make_object(state, message));
+            return results;
+        }
+
+        const std::string filename = found.get<std::string>(0);
+        sol::load_result chunk = cache->LoadFile(state, filename);
+        if (!chunk.valid()) {
+            sol::error err = chunk;
+            throw sol::error("error loading module '" + name + "' from file '" + filename + "':\n\t" + err.what());
+        }
+
+        sol::function loader = chunk;
+        results.push_back(sol::make_object(state, loader));
+        results.push_back(sol::make_object(state, filename));
+        return results;
+    };
+}
+
+void LuaBytecodeCache::Prune(uint64_t maxBytes) {
+    struct Entry {
+        fs::file_time_type lastUse;
+        uint64_t size;
+        fs::path path;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t totalBytes = 0;
+
+    std::error_code iterEc;
+    for (fs::directory_iterator it(m_CacheDir, iterEc), end; !iterEc && it != end; it.increment(iterEc)) {
+        std::error_code ec;
+        if (!it->is_regular_file(ec)) {
+            continue;
+        }
+
+        const fs::path &path = it->path();
+        if (path.extension() != kEntryExtension) {
+            // Leftover of an interrupted write
+            fs::remove(path, ec);
+            continue;
+        }
+
+        std::error_code sizeEc;
+        Entry entry{it->last_write_time(ec), it->file_size(sizeEc), path};
+        if (!ec && !sizeEc) {
+            totalBytes += entry.size;
+            entries.push_back(std::move(entry));
+        }
+    }
+
+    if (totalBytes <= maxBytes) {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        return a.lastUse < b.lastUse;
+    });
+
+    size_t removed = 0;
+    std::error_code ec;
+    for (const Entry &entry : entries) {
+        if (totalBytes <= maxBytes) {
+            break;
+        }
+        if (fs::remove(entry.path, ec)) {
+            totalBytes -= entry.size;
+            ++removed;
+        }
+    }
+
+    Log::Info("Pruned %zu bytecode cache entries (%llu bytes kept).",
+              removed, static_cast<unsigned long long>(totalBytes));
+}
+
+int LuaBytecodeCache::LoadChunk(lua_State *L, const char *source, size_t size, const std::string &chunkName) {
+    const uint64_t key = HashChunk(source, size, chunkName);
+
+    std::string bytecode;
+    if (ReadEntry(key, size, bytecode)) {
+        if (luaL_loadbufferx(L, bytecode.data(), bytecode.size(), chunkName.c_str(), "b") == LUA_OK) {
+            m_Hits.fetch_add(1, std::memory_order_relaxed);
+
+            // The modification time doubles as the last use for Prune()
+            std::error_code ec;
+            fs::last_write_time(EntryPath(key), fs::file_time_type::clock::now(), ec);
+            return LUA_OK;
+        }
+        lua_pop(L, 1); // Unloadable entry, compile from source and replace it
+    }
+
+    m_Misses.fetch_add(1, std::memory_order_relaxed);
+
+    const int status = luaL_loadbufferx(L, source, size, chunkName.c_str(), "t");
+    if (status != LUA_OK) {
+        return status;
+    }
+
+    // Keep debug info so errors still carry source names and line numbers
+    bytecode.clear();
+    if (lua_dump(L, DumpWriter, &bytecode, 0) == 0 && !bytecode.empty()) {
+        WriteEntry(key, size, bytecode);
+    }
+    return LUA_OK;
+}
+
+bool LuaBytecodeCache::ReadEntry(uint64_t key, size_t sourceSize, std::string &bytecode) const {
+    std::ifstream file(EntryPath(key), std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    EntryHeader header{};
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+        return false;
+    }
+    if (std::memcmp(header.magic, kEntryMagic, sizeof(kEntryMagic)) != 0 ||
+        header.format != kEntryFormat ||
+        header.luaVersion != LUA_VERSION_NUM ||
+        header.sourceSize != sourceSize ||
+        header.key != key) {
+        return false;
+    }
+
+    bytecode.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return !bytecode.empty();
+}
+
+void LuaBytecodeCache::WriteEntry(uint64_t key, size_t sourceSize, const std::string &bytecode) {
+    EntryHeader header{};
+    std::memcpy(header.magic, kEntryMagic, sizeof(kEntryMagic));
+    header.format = kEntryFormat;
+    header.luaVersion = LUA_VERSION_NUM;
+    header.sourceSize = sourceSize;
+    header.key = key;
+
+    // Write aside and rename so concurrent readers never see a partial entry
+    const std::string path = EntryPath(key);
+    const std::string tempPath = path + "." + std::to_string(m_WriteSerial.fetch_add(1)) + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return;
+        }
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(bytecode.data(), static_cast<std::streamsize>(bytecode.size()));
+        if (!file) {
+            file.close();
+            std::error_code ec;
+            fs::remove(tempPath, ec);
+            return;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+    }
+}
+
+std::string LuaBytecodeCache::EntryPath(uint64_t key) const {
+    char name[17];
+    snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+    return (fs::path(m_CacheDir) / (std::string(name) + kEntryExtension)).string();
+}
+
+uint64_t LuaBytecodeCache::HashChunk(const char *source, size_t size, const std::string &chunkName) {
+    uint64_t h = Mix(0xcbf29ce484222325ULL, static_cast<uint64_t>(size));
+    h = MixBytes(h, source, size);
+    h = MixBytes(h, chunkName.data(), chunkName.size());
+    h = Mix(h, (static_cast<uint64_t>(LUA_VERSION_NUM) << 32) | kEntryFormat);
+
+    // Final avalanche
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <sol/sol.hpp>
+
+/**
+ * @class LuaBytecodeCache
+ * @brief On-disk cache of compiled Lua chunks keyed by source content.
+ *
+ * Every chunk is identified by a 64-bit hash of its source text, its chunk
+ * name and the Lua version. A hit loads the dumped bytecode with
+ * luaL_loadbufferx, skipping the parser entirely; a miss compiles the source
+ * as text, dumps it with lua_dump and stores it for the next load. Editing a
+ * script changes its hash, so stale entries are simply never looked up again
+ * and are eventually removed by Prune().
+ *
+ * Entries are only an optimization: a missing, truncated or unloadable entry
+ * falls back to compiling the source, and write failures are ignored.
+ *
+ * Thread Safety:
+ * - Load calls may run concurrently on different Lua states (isolated
+ *   contexts ticked in parallel); entries are published with an atomic rename
+ * - Prune() must not run concurrently with loads
+ */
+class LuaBytecodeCache {
+public:
+    /**
+     * @brief Creates a cache stored in the given directory (created on demand).
+     * @param cacheDir Directory holding the cache entries.
+     */
+    explicit LuaBytecodeCache(std::string cacheDir);
+
+    // LuaBytecodeCache is not copyable or movable
+    LuaBytecodeCache(const LuaBytecodeCache &) = delete;
+    LuaBytecodeCache &operator=(const LuaBytecodeCache &) = delete;
+
+    /**
+     * @brief Loads a Lua source file as a function, like luaL_loadfile.
+     * @param lua The Lua state to load into.
+     * @param path Path to the source file.
+     * @return The load result; on success it holds the chunk function.
+     */
+    sol::load_result LoadFile(sol::state_view lua, const std::string &path);
+
+    /**
+     * @brief Loads Lua source held in memory as a function, like luaL_loadbuffer.
+     * @param lua The Lua state to load into.
+     * @param source The source text.
+     * @param chunkName Name used in error messages and debug info (e.g. "@manifest.lua").
+     * @return The load result; on success it holds the chunk function.
+     */
+    sol::load_result LoadBuffer(sol::state_view lua, const std::string &source, const std::string &chunkName);
+
+    /**
+     * @brief Routes `require` of Lua files in a state through a cache.
+     *
+     * Replaces the Lua file searcher (package.searchers[2]). Module lookup
+     * still follows package.path; only the compilation step changes.
+     * @param lua The Lua state (the package library must be open).
+     * @param cache The cache to use; the searcher keeps it alive.
+     */
+    static void InstallSearcher(sol::state_view lua, const std::shared_ptr<LuaBytecodeCache> &cache);
+
+    /**
+     * @brief Removes the least recently used entries until the cache fits a size budget.
+     * @param maxBytes Maximum total size of the cache entries.
+     */
+    void Prune(uint64_t maxBytes);
+
+    const std::string &GetDirectory() const { return m_CacheDir; }
+    uint64_t GetHitCount() const { return m_Hits.load(std::memory_order_relaxed); }
+    uint64_t GetMissCount() const { return m_Misses.load(std::memory_order_relaxed); }
+
+private:
+    int LoadChunk(lua_State *L, const char *source, size_t size, const std::string &chunkName);
+    bool ReadEntry(uint64_t key, size_t sourceSize, std::string &bytecode) const;
+    void WriteEntry(uint64_t key, size_t sourceSize, const std::string &bytecode);
+    std::string EntryPath(uint64_t key) const;
+
+    static uint64_t HashChunk(const char *source, size_t size, const std::string &chunkName);
+
+    std::string m_CacheDir;
+    std::atomic<uint64_t> m_Hits{0};
+    std::atomic<uint64_t> m_Misses{0};
+    std::atomic<uint64_t> m_WriteSerial{0};
+};
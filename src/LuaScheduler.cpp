@@ -1,6 +1,7 @@
 #include "LuaScheduler.h"
 
 #include "Logger.h"
+#include <algorithm>
 #include <stdexcept>
 #include <utility>
 
@@ -10,6 +11,12 @@
 #include "ScriptContextManager.h"
 #include "MessageBus.h"
 
+void SchedulerTask::Wake() {
+    if (LuaScheduler *scheduler = m_WakeScheduler.load()) {
+        scheduler->Wake(m_WakeSequence);
+    }
+}
+
 EventWaitTask::EventWaitTask(std::string eventName, TASEngine *engine, EventManager *eventManager)
     : m_EventName(std::move(eventName)), m_Engine(engine), m_EventManager(eventManager), m_EventReceived(false) {
     if (!m_EventManager) {
@@ -18,6 +25,7 @@ EventWaitTask::EventWaitTask(std::string eventName, TASEngine *engine, EventMana
 
     std::function<void()> callback = [this]() {
         m_EventReceived = true;
+        Wake();
     };
     m_ListenerId = m_EventManager->RegisterListener(m_EventName, callback, true);
 
@@ -42,60 +50,59 @@ EventWaitTask::~EventWaitTask() {
 MessageResponseTask::MessageResponseTask(std::string correlationId, TASEngine *engine, int timeoutTicks)
     : m_CorrelationId(std::move(correlationId)),
       m_Engine(engine),
-      m_TimeoutTicks(timeoutTicks),
-      m_ResponseReceived(false) {
-}
-
-MessageResponseTask::~MessageResponseTask() {
-    // No cleanup needed - responses are managed by MessageBus
-}
-
-bool MessageResponseTask::IsComplete() {
-    // Check for timeout
-    if (m_TimeoutTicks <= 0) {
-        if (m_Engine) {
-            Log::Warn("MessageResponseTask: Timeout waiting for response (correlation_id: %s)",
-                      m_CorrelationId.c_str());
-        }
-        return true; // Timeout
-    }
-
-    // Try to get response from MessageBus
+      m_TimeoutTicks(timeoutTicks) {
     auto *contextManager = m_Engine ? m_Engine->GetScriptContextManager() : nullptr;
-    auto *messageBus = contextManager ? contextManager->GetMessageBus() : nullptr;
+    m_MessageBus = contextManager ? contextManager->GetMessageBus() : nullptr;
 
-    if (!messageBus) {
+    if (!m_MessageBus) {
         if (m_Engine) {
             Log::Error("MessageResponseTask: MessageBus not available");
         }
-        return true; // Error - complete to avoid hanging
+        return; // Complete immediately to avoid hanging
     }
 
-    auto response = messageBus->TryGetResponse(m_CorrelationId);
-    if (response.has_value()) {
-        // Response received! Store the serialized value
+    // May run on the MessageBus consumer thread, under its response lock
+    m_Watching = true;
+    m_MessageBus->WatchResponse(m_CorrelationId, [this](MessageBus::Message &&response) {
+        m_ResponseData = std::move(response.data);
         m_ResponseReceived = true;
-        m_ResponseData = response->data; // Store MessageBus::Message::SerializedValue as std::any
-        return true;
+        Wake();
+    });
+}
+
+MessageResponseTask::~MessageResponseTask() {
+    // Guarantees the callback is neither running nor invoked after this point
+    if (m_Watching && m_MessageBus) {
+        m_MessageBus->UnwatchResponse(m_CorrelationId);
     }
+}
+
+void MessageResponseTask::OnTimer() {
+    if (m_ResponseReceived) return;
 
-    // Still waiting - decrement timeout
-    --m_TimeoutTicks;
-    return false;
+    if (m_MessageBus) {
+        m_MessageBus->UnwatchResponse(m_CorrelationId);
+    }
+    if (m_ResponseReceived) return; // Arrived just before the watcher was removed
+
+    m_TimedOut = true;
+    if (m_Engine) {
+        Log::Warn("MessageResponseTask: Timeout waiting for response (correlation_id: %s)",
+                  m_CorrelationId.c_str());
+    }
 }
 
 sol::object MessageResponseTask::GetResponse(sol::state_view lua) const {
-    if (!m_ResponseReceived || !m_ResponseData.has_value()) {
+    if (!m_ResponseReceived) {
         return sol::make_object(lua, sol::nil);
     }
 
     try {
-        // Extract the SerializedValue and convert to Lua object
-        const auto &serializedValue = std::any_cast<const MessageBus::Message::SerializedValue &>(m_ResponseData);
-        return serializedValue.ToLuaObject(lua);
-    } catch (const std::bad_any_cast &) {
+        // Decode the response payload straight into the caller's state
+        return m_ResponseData.ToLuaObject(lua);
+    } catch (const std::exception &e) {
         if (m_Engine) {
-            Log::Error("MessageResponseTask: Failed to cast response data");
+            Log::Error("MessageResponseTask: Failed to decode response data: %s", e.what());
         }
         return sol::make_object(lua, sol::nil);
     }
@@ -140,6 +147,7 @@ void LuaScheduler::StartCoroutine(sol::coroutine co) {
     // and it remains on the stack as part of the execution context until it's done.
     if (m_CurrentThread->coroutine.status() != sol::call_status::yielded) {
         m_ThreadStack.pop();
+        FinishThread(thread);
     }
 
     // Reset current thread pointer to the top of the stack
@@ -180,6 +188,7 @@ void LuaScheduler::StartCoroutine(sol::function func) {
     // and it remains on the stack as part of the execution context until it's done.
     if (m_CurrentThread->coroutine.status() != sol::call_status::yielded) {
         m_ThreadStack.pop();
+        FinishThread(thread);
     }
 
     // Reset current thread pointer to the top of the stack
@@ -209,10 +218,7 @@ sol::coroutine LuaScheduler::StartCoroutineAndTrack(sol::function func) {
     auto task = std::make_shared<ImmediateTask>();
 
     // Add to task list
-    detail::SchedulerThreadTask threadTask;
-    threadTask.thread = thread;
-    threadTask.task = task;
-    m_Tasks.push_back(threadTask);
+    AddThreadTask(thread, task);
 
     // Return the coroutine reference for tracking
     return thread->coroutine;
@@ -231,10 +237,7 @@ sol::coroutine LuaScheduler::StartCoroutineAndTrack(sol::coroutine co) {
     auto task = std::make_shared<ImmediateTask>();
 
     // Add to task list
-    detail::SchedulerThreadTask threadTask;
-    threadTask.thread = thread;
-    threadTask.task = task;
-    m_Tasks.push_back(threadTask);
+    AddThreadTask(thread, task);
 
     // Return the coroutine reference for tracking
     return thread->coroutine;
@@ -255,10 +258,7 @@ void LuaScheduler::AddCoroutineTask(sol::coroutine co) {
     auto task = std::make_shared<ImmediateTask>();
 
     // Add to task list
-    detail::SchedulerThreadTask threadTask;
-    threadTask.thread = thread;
-    threadTask.task = task;
-    m_Tasks.push_back(threadTask);
+    AddThreadTask(thread, task);
 }
 
 void LuaScheduler::AddCoroutineTask(sol::function func) {
@@ -276,63 +276,320 @@ void LuaScheduler::AddCoroutineTask(sol::function func) {
     auto task = std::make_shared<ImmediateTask>();
 
     // Add to task list
-    detail::SchedulerThreadTask threadTask;
-    threadTask.thread = thread;
-    threadTask.task = task;
-    m_Tasks.push_back(threadTask);
+    AddThreadTask(thread, task);
 }
 
 void LuaScheduler::Tick() {
     m_ThreadValidator.AssertOwnership();
 
-    // Process coroutine-based tasks
-    for (auto i = m_Tasks.begin(); i != m_Tasks.end();) {
+    // Collect what is due this tick: coroutines woken since the last tick plus
+    // expired timers, oldest first
+    ++m_CurrentTick;
+    CollectWakeups();
+    m_DueThreads.swap(m_WokenThreads);
+    m_ThreadTimers.Advance(m_DueThreads);
+    m_BackgroundTimers.Advance(m_DueBackground);
+    std::make_heap(m_DueThreads.begin(), m_DueThreads.end(), detail::SchedulerTimer::LaterSequence);
+    std::sort(m_DueBackground.begin(), m_DueBackground.end(), detail::SchedulerTimer::BySequence);
+
+    // Process coroutine-based tasks. Due entries are merged with the polled
+    // tasks by sequence, so coroutines resume in the order they yielded.
+    m_Phase = TickPhase::Coroutines;
+    m_ResumeCursor = 0;
+    for (auto i = m_Tasks.begin();;) {
+        // Pick up coroutines woken by whatever the previous resume did
+        if (m_HasWakeups.load(std::memory_order_acquire)) {
+            CollectWakeups();
+        }
+
+        if (i == m_Tasks.end() && m_DueThreads.empty()) {
+            break;
+        }
+
+        if (!m_DueThreads.empty() && (i == m_Tasks.end() || m_DueThreads.front().sequence < i->sequence)) {
+            std::pop_heap(m_DueThreads.begin(), m_DueThreads.end(), detail::SchedulerTimer::LaterSequence);
+            detail::SchedulerTimer due = std::move(m_DueThreads.back());
+            m_DueThreads.pop_back();
+            m_ResumeCursor = due.sequence;
+            ResumeDue(due);
+            continue;
+        }
+
+        m_ResumeCursor = i->sequence;
+
         // If the thread is dead, remove it
         if (i->thread->coroutine.status() != sol::call_status::yielded) {
+            auto thread = std::move(i->thread);
             i = m_Tasks.erase(i);
+            FinishThread(thread);
             continue;
         }
 
         // Is this task complete?
         if (i->task->IsComplete()) {
-            // Get the thread task
-            detail::SchedulerThreadTask thread_task = *i;
-            // Remove it from the pending list
+            // Get the thread and remove it from the pending list
+            auto thread = std::move(i->thread);
             i = m_Tasks.erase(i);
 
-            // Set the current thread
-            m_ThreadStack.push(thread_task.thread);
-            m_CurrentThread = thread_task.thread;
-
-            // Resume the thread
-            auto result = thread_task.thread->coroutine();
-
-            // Reset current thread
-            m_ThreadStack.pop();
-            if (m_ThreadStack.empty()) {
-                m_CurrentThread = nullptr;
-            } else {
-                m_CurrentThread = m_ThreadStack.top();
-            }
-
-            // Handle any errors
-            if (!result.valid()) {
-                sol::error err = result;
-                Log::Error("Coroutine resume error: %s", err.what());
-            }
+            ResumeThread(thread);
         } else {
             ++i;
         }
     }
 
     // Process background tasks
-    for (auto i = m_BackgroundTasks.begin(); i != m_BackgroundTasks.end();) {
-        if ((*i)->IsComplete()) {
+    m_Phase = TickPhase::Background;
+    size_t nextDue = 0;
+    for (auto i = m_BackgroundTasks.begin(); i != m_BackgroundTasks.end() || nextDue < m_DueBackground.size();) {
+        if (nextDue < m_DueBackground.size() &&
+            (i == m_BackgroundTasks.end() || m_DueBackground[nextDue].sequence < i->sequence)) {
+            auto task = std::move(m_DueBackground[nextDue++].task);
+            task->OnTimer();
+            continue;
+        }
+
+        if (i->task->IsComplete()) {
             i = m_BackgroundTasks.erase(i);
         } else {
             ++i;
         }
     }
+    m_DueBackground.clear();
+    m_Phase = TickPhase::Idle;
+}
+
+void LuaScheduler::ResumeThread(const std::shared_ptr<detail::SchedulerCothread> &thread) {
+    // Set the current thread
+    m_ThreadStack.push(thread);
+    m_CurrentThread = thread;
+
+    // Resume the thread
+    auto result = thread->coroutine();
+
+    // Reset current thread
+    m_ThreadStack.pop();
+    if (m_ThreadStack.empty()) {
+        m_CurrentThread = nullptr;
+    } else {
+        m_CurrentThread = m_ThreadStack.top();
+    }
+
+    if (thread->coroutine.status() != sol::call_status::yielded) {
+        FinishThread(thread);
+    }
+
+    // Handle any errors
+    if (!result.valid()) {
+        sol::error err = result;
+        Log::Error("Coroutine resume error: %s", err.what());
+    }
+}
+
+void LuaScheduler::ResumeDue(detail::SchedulerTimer &due) {
+    std::shared_ptr<detail::SchedulerCothread> thread = std::move(due.thread);
+    if (!thread) {
+        // Timeout of a wake-driven task, unless something woke it first
+        --m_PendingTimeouts;
+        auto it = m_Parked.find(due.sequence);
+        if (it == m_Parked.end()) {
+            return;
+        }
+        thread = std::move(it->second.thread);
+        m_Parked.erase(it);
+        due.task->OnTimer();
+    }
+
+    if (thread->coroutine.status() == sol::call_status::yielded) {
+        ResumeThread(thread);
+    } else {
+        FinishThread(thread);
+    }
+}
+
+void LuaScheduler::FinishThread(const std::shared_ptr<detail::SchedulerCothread> &thread) {
+    lua_State *key = GetThreadKey(thread->coroutine);
+    if (!key || m_LiveThreads.erase(key) == 0) {
+        return;
+    }
+
+    auto waiters = m_CoroutineWaiters.find(key);
+    if (waiters == m_CoroutineWaiters.end()) {
+        return;
+    }
+    std::vector<uint64_t> sequences = std::move(waiters->second);
+    m_CoroutineWaiters.erase(waiters);
+
+    for (uint64_t sequence : sequences) {
+        auto it = m_Parked.find(sequence);
+        if (it == m_Parked.end()) {
+            continue; // Already woken, e.g. a race another coroutine won
+        }
+
+        auto &parked = it->second;
+        if (parked.awaiting > 0) {
+            --parked.awaiting;
+        }
+        if (parked.task->OnCoroutineFinished(parked.awaiting)) {
+            Wake(sequence);
+        }
+    }
+}
+
+lua_State *LuaScheduler::GetThreadKey(const sol::coroutine &co) const {
+    if (!co.valid()) {
+        return nullptr;
+    }
+
+    // Coroutines living on the main state share it and cannot be told apart
+    lua_State *L = co.lua_state();
+    return L != GetLuaState().lua_state() ? L : nullptr;
+}
+
+void LuaScheduler::Wake(uint64_t sequence) {
+    std::lock_guard<std::mutex> lock(m_WakeMutex);
+    m_Wakeups.push_back(sequence);
+    m_HasWakeups.store(true, std::memory_order_release);
+}
+
+void LuaScheduler::CollectWakeups() {
+    {
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        m_Wakeups.swap(m_WakeupsSwap);
+        m_HasWakeups.store(false, std::memory_order_relaxed);
+    }
+
+    for (uint64_t sequence : m_WakeupsSwap) {
+        auto it = m_Parked.find(sequence);
+        if (it == m_Parked.end()) {
+            continue; // Already resumed (timeout, repeated wake)
+        }
+
+        detail::SchedulerTimer ready;
+        ready.sequence = sequence;
+        ready.thread = std::move(it->second.thread);
+        m_Parked.erase(it);
+
+        // Resume in this pass only if the coroutine's turn has not passed yet
+        if (m_Phase == TickPhase::Coroutines && sequence > m_ResumeCursor) {
+            m_DueThreads.push_back(std::move(ready));
+            std::push_heap(m_DueThreads.begin(), m_DueThreads.end(), detail::SchedulerTimer::LaterSequence);
+        } else {
+            m_WokenThreads.push_back(std::move(ready));
+        }
+    }
+    m_WakeupsSwap.clear();
+}
+
+void LuaScheduler::AddThreadTask(std::shared_ptr<detail::SchedulerCothread> thread,
+                                 std::shared_ptr<SchedulerTask> task) {
+    const uint64_t sequence = m_NextSequence++;
+
+    if (lua_State *key = GetThreadKey(thread->coroutine)) {
+        m_LiveThreads.insert(key);
+    }
+
+    if (task->IsWakeDriven() || task->GetAwaitedCoroutines()) {
+        if (ParkThread(sequence, thread, task)) {
+            return;
+        }
+    } else if (const int ticks = task->GetTimerTicks(); ticks > 0) {
+        // A sleeping coroutine always wakes on a later tick, even when it yields during Tick()
+        detail::SchedulerTimer timer;
+        timer.sequence = sequence;
+        timer.thread = std::move(thread);
+        m_ThreadTimers.Schedule(m_CurrentTick + ticks, std::move(timer));
+        return;
+    }
+
+    detail::SchedulerThreadTask threadTask;
+    threadTask.sequence = sequence;
+    threadTask.thread = std::move(thread);
+    threadTask.task = std::move(task);
+    m_Tasks.push_back(std::move(threadTask));
+}
+
+bool LuaScheduler::ParkThread(uint64_t sequence, std::shared_ptr<detail::SchedulerCothread> &thread,
+                              std::shared_ptr<SchedulerTask> &task) {
+    detail::SchedulerParkedThread parked;
+
+    size_t alreadyFinished = 0;
+    if (const auto *coroutines = task->GetAwaitedCoroutines()) {
+        // Only coroutines this scheduler runs report their completion. Ones that
+        // already finished (or never yielded) count as done; anything else still
+        // running keeps being polled.
+        lua_State *self = GetThreadKey(thread->coroutine);
+        for (const auto &co : *coroutines) {
+            lua_State *key = GetThreadKey(co);
+            if (key && key != self && m_LiveThreads.find(key) != m_LiveThreads.end()) {
+                continue;
+            }
+            if (SchedulerTask::IsCoroutineRunning(co)) {
+                return false;
+            }
+            ++alreadyFinished;
+        }
+        for (const auto &co : *coroutines) {
+            lua_State *key = GetThreadKey(co);
+            if (key && m_LiveThreads.find(key) != m_LiveThreads.end()) {
+                m_CoroutineWaiters[key].push_back(sequence);
+            }
+        }
+        parked.awaiting = coroutines->size() - alreadyFinished;
+    }
+
+    // Publish the wake target before checking for completion, so a wake racing
+    // with the check is never lost (a duplicate one is ignored)
+    task->m_WakeSequence = sequence;
+    task->m_WakeScheduler.store(this);
+
+    const int timeoutTicks = task->IsWakeDriven() ? task->GetTimerTicks() : 0;
+    if (timeoutTicks > 0) {
+        detail::SchedulerTimer timeout;
+        timeout.sequence = sequence;
+        timeout.task = task;
+        m_ThreadTimers.Schedule(m_CurrentTick + timeoutTicks, std::move(timeout));
+        ++m_PendingTimeouts;
+    }
+
+    bool complete = task->IsWakeDriven() && task->IsComplete();
+    if (task->GetAwaitedCoroutines() && (parked.awaiting == 0 || alreadyFinished > 0)) {
+        complete = complete || task->OnCoroutineFinished(parked.awaiting);
+    }
+    parked.thread = std::move(thread);
+    parked.task = std::move(task);
+    m_Parked.emplace(sequence, std::move(parked));
+
+    if (complete) {
+        Wake(sequence);
+    }
+    return true;
+}
+
+void LuaScheduler::AddBackgroundTask(std::shared_ptr<SchedulerTask> task) {
+    const uint64_t sequence = m_NextSequence++;
+
+    const int ticks = task->GetTimerTicks();
+    if (ticks > 0) {
+        // Counted like a polled task: the first check is in this tick's background
+        // pass when Tick() is running, otherwise in the next tick
+        const uint64_t firstTick = m_Phase == TickPhase::Idle ? m_CurrentTick + 1 : m_CurrentTick;
+        const uint64_t due = firstTick + static_cast<uint64_t>(ticks) - 1;
+
+        detail::SchedulerTimer timer;
+        timer.sequence = sequence;
+        timer.task = std::move(task);
+        if (due <= m_CurrentTick) {
+            m_DueBackground.push_back(std::move(timer));
+        } else {
+            m_BackgroundTimers.Schedule(due, std::move(timer));
+        }
+        return;
+    }
+
+    detail::SchedulerBackgroundTask backgroundTask;
+    backgroundTask.sequence = sequence;
+    backgroundTask.task = std::move(task);
+    m_BackgroundTasks.push_back(std::move(backgroundTask));
 }
 
 void LuaScheduler::Clear() {
@@ -340,6 +597,20 @@ void LuaScheduler::Clear() {
 
     m_Tasks.clear();
     m_BackgroundTasks.clear();
+    m_ThreadTimers.Clear();
+    m_BackgroundTimers.Clear();
+    m_DueThreads.clear();
+    m_DueBackground.clear();
+    m_PendingTimeouts = 0;
+    m_Parked.clear();
+    m_WokenThreads.clear();
+    m_LiveThreads.clear();
+    m_CoroutineWaiters.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        m_Wakeups.clear();
+        m_HasWakeups.store(false, std::memory_order_relaxed);
+    }
     m_CurrentThread = nullptr;
     // Clear the thread stack
     while (!m_ThreadStack.empty()) {
@@ -348,11 +619,14 @@ void LuaScheduler::Clear() {
 }
 
 bool LuaScheduler::IsRunning() const {
-    return !m_Tasks.empty() || !m_BackgroundTasks.empty();
+    return !m_Tasks.empty() || !m_BackgroundTasks.empty() || !m_Parked.empty() || !m_WokenThreads.empty() ||
+           m_ThreadTimers.Size() > m_PendingTimeouts || !m_BackgroundTimers.IsEmpty();
 }
 
 size_t LuaScheduler::GetTaskCount() const {
-    return m_Tasks.size() + m_BackgroundTasks.size();
+    // Timeouts belong to parked coroutines that are already counted
+    return m_Tasks.size() + m_BackgroundTasks.size() + m_Parked.size() + m_WokenThreads.size() +
+           (m_ThreadTimers.Size() - m_PendingTimeouts) + m_BackgroundTimers.Size();
 }
 
 void LuaScheduler::YieldTicks(int ticks) {
@@ -473,7 +747,7 @@ void LuaScheduler::StartRepeatFor(sol::function task, int ticks) {
     }
 
     auto repeatTask = std::make_shared<RepeatForTicksTask>(task, ticks);
-    m_BackgroundTasks.push_back(repeatTask);
+    AddBackgroundTask(repeatTask);
 }
 
 void LuaScheduler::StartRepeatUntil(sol::function task, sol::function condition) {
@@ -490,7 +764,7 @@ void LuaScheduler::StartRepeatUntil(sol::function task, sol::function condition)
     }
 
     auto repeatTask = std::make_shared<RepeatUntilTask>(task, condition);
-    m_BackgroundTasks.push_back(repeatTask);
+    AddBackgroundTask(repeatTask);
 }
 
 void LuaScheduler::StartRepeatWhile(sol::function task, sol::function condition) {
@@ -507,7 +781,7 @@ void LuaScheduler::StartRepeatWhile(sol::function task, sol::function condition)
     }
 
     auto repeatTask = std::make_shared<RepeatWhileTask>(task, condition);
-    m_BackgroundTasks.push_back(repeatTask);
+    AddBackgroundTask(repeatTask);
 }
 
 void LuaScheduler::StartDelay(sol::function task, int delayTicks) {
@@ -524,7 +798,7 @@ void LuaScheduler::StartDelay(sol::function task, int delayTicks) {
     }
 
     auto delayTask = std::make_shared<DelayTask>(task, delayTicks);
-    m_BackgroundTasks.push_back(delayTask);
+    AddBackgroundTask(delayTask);
 }
 
 void LuaScheduler::StartTimeout(sol::function task, int timeoutTicks) {
@@ -541,7 +815,7 @@ void LuaScheduler::StartTimeout(sol::function task, int timeoutTicks) {
     }
 
     auto timeoutTask = std::make_shared<TimeoutTask>(task, timeoutTicks);
-    m_BackgroundTasks.push_back(timeoutTask);
+    AddBackgroundTask(timeoutTask);
 }
 
 void LuaScheduler::StartDebounce(sol::function task, int debounceTicks) {
@@ -558,7 +832,7 @@ void LuaScheduler::StartDebounce(sol::function task, int debounceTicks) {
     }
 
     auto debounceTask = std::make_shared<DebounceTask>(task, debounceTicks);
-    m_BackgroundTasks.push_back(debounceTask);
+    AddBackgroundTask(debounceTask);
 }
 
 void LuaScheduler::StartSequence(const std::vector<sol::function> &tasks) {
@@ -570,7 +844,7 @@ void LuaScheduler::StartSequence(const std::vector<sol::function> &tasks) {
     }
 
     auto sequenceTask = std::make_shared<SequenceTask>(tasks);
-    m_BackgroundTasks.push_back(sequenceTask);
+    AddBackgroundTask(sequenceTask);
 }
 
 void LuaScheduler::StartRetry(sol::function task, int maxAttempts) {
@@ -587,7 +861,7 @@ void LuaScheduler::StartRetry(sol::function task, int maxAttempts) {
     }
 
     auto retryTask = std::make_shared<RetryTask>(task, maxAttempts);
-    m_BackgroundTasks.push_back(retryTask);
+    AddBackgroundTask(retryTask);
 }
 
 void LuaScheduler::StartParallel(const std::vector<sol::function> &functions) {
@@ -611,8 +885,5 @@ void LuaScheduler::StartParallel(const std::vector<sol::coroutine> &coroutines)
 }
 
 void LuaScheduler::Yield(std::shared_ptr<SchedulerTask> task) {
-    detail::SchedulerThreadTask thread_task;
-    thread_task.thread = m_CurrentThread;
-    thread_task.task = std::move(task);
-    m_Tasks.push_back(thread_task);
+    AddThreadTask(m_CurrentThread, std::move(task));
 }
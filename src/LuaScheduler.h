@@ -4,16 +4,22 @@
 #include <list>
 #include <stack>
 #include <memory>
+#include <mutex>
+#include <atomic>
 #include <cstdint>
-#include <any>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <sol/sol.hpp>
 
+#include "MessagePayload.h"
 #include "ThreadOwnershipValidator.h"
+#include "TimerWheel.h"
 
 // Forward declare to avoid circular dependency
 class TASEngine;
 class ScriptContext;
+class LuaScheduler;
 
 /**
  * @class SchedulerTask
@@ -23,8 +29,87 @@ class SchedulerTask {
 public:
     virtual ~SchedulerTask() = default;
     virtual bool IsComplete() = 0;
+
+    /**
+     * @brief Gets the number of ticks after which a purely time-based task completes.
+     * @return Tick count, or 0 if the task must be polled with IsComplete() every tick.
+     *
+     * Tasks with a positive count are parked in the scheduler's timing wheel
+     * instead of being polled; OnTimer() is called once when they expire.
+     */
+    virtual int GetTimerTicks() const { return 0; }
+
+    /**
+     * @brief Called once when a timer task expires.
+     */
+    virtual void OnTimer() {}
+
+    /**
+     * @brief Checks whether the task signals completion through Wake() instead of polling.
+     *
+     * Wake-driven tasks are parked off the polled list until they call Wake(). A positive
+     * GetTimerTicks() is then a timeout: OnTimer() is called and the coroutine resumes if
+     * nothing woke it first.
+     */
+    virtual bool IsWakeDriven() const { return false; }
+
+    /**
+     * @brief Gets the coroutines whose completion this task waits for.
+     * @return The coroutines, or nullptr if the task does not wait on coroutines.
+     */
+    virtual const std::vector<sol::coroutine> *GetAwaitedCoroutines() const { return nullptr; }
+
+    /**
+     * @brief Called by the scheduler when one of the awaited coroutines finishes.
+     * @param remaining Number of awaited coroutines still running.
+     * @return True if the task is now complete.
+     */
+    virtual bool OnCoroutineFinished(size_t remaining) { return remaining == 0; }
+
+    /**
+     * @brief Checks whether a coroutine is suspended at a yield or currently running.
+     *
+     * Reads the state of the coroutine's thread rather than sol::coroutine::status(),
+     * which only reflects the last call made through that particular handle.
+     * @param co The coroutine.
+     * @return False if the coroutine finished, failed, was never started or is invalid.
+     */
+    static bool IsCoroutineRunning(const sol::coroutine &co);
+
+protected:
+    /**
+     * @brief Moves the coroutine waiting on this task to its scheduler's ready queue.
+     * @note Safe to call from any thread; does nothing until the task is parked.
+     */
+    void Wake();
+
+private:
+    friend class LuaScheduler;
+
+    std::atomic<LuaScheduler *> m_WakeScheduler{nullptr};
+    uint64_t m_WakeSequence = 0;
 };
 
+inline bool SchedulerTask::IsCoroutineRunning(const sol::coroutine &co) {
+    if (!co.valid()) {
+        return false;
+    }
+
+    lua_State *L = co.lua_state();
+    switch (lua_status(L)) {
+    case LUA_YIELD:
+        return true;
+    case LUA_OK: {
+        // Same test as coroutine.status(): a thread with an active call is running,
+        // otherwise it is dead or has not started
+        lua_Debug ar;
+        return lua_getstack(L, 0, &ar) != 0;
+    }
+    default:
+        return false; // Stopped by an error
+    }
+}
+
 class ImmediateTask : public SchedulerTask {
 public:
     ImmediateTask() = default;
@@ -47,6 +132,8 @@ public:
         return m_RemainingTicks <= 0;
     }
 
+    int GetTimerTicks() const override { return m_RemainingTicks > 1 ? m_RemainingTicks : 1; }
+
 private:
     int m_RemainingTicks;
 };
@@ -82,13 +169,15 @@ public:
 
     bool IsComplete() override {
         for (const auto &co : m_Coroutines) {
-            if (co.valid() && co.status() == sol::call_status::yielded) {
+            if (IsCoroutineRunning(co)) {
                 return false; // At least one still running
             }
         }
         return true; // All done or invalid
     }
 
+    const std::vector<sol::coroutine> *GetAwaitedCoroutines() const override { return &m_Coroutines; }
+
 private:
     std::vector<sol::coroutine> m_Coroutines;
 };
@@ -106,7 +195,7 @@ public:
         if (m_SomeCompleted) return true;
 
         for (const auto &co : m_Coroutines) {
-            if (!co.valid() || co.status() != sol::call_status::yielded) {
+            if (!IsCoroutineRunning(co)) {
                 m_SomeCompleted = true;
                 return true; // At least one completed
             }
@@ -114,6 +203,13 @@ public:
         return false; // All still running
     }
 
+    const std::vector<sol::coroutine> *GetAwaitedCoroutines() const override { return &m_Coroutines; }
+
+    bool OnCoroutineFinished(size_t) override {
+        m_SomeCompleted = true;
+        return true;
+    }
+
 private:
     std::vector<sol::coroutine> m_Coroutines;
     bool m_SomeCompleted;
@@ -245,6 +341,13 @@ public:
             return false;
         }
 
+        OnTimer();
+        return true;
+    }
+
+    int GetTimerTicks() const override { return (m_DelayTicks > 0 ? m_DelayTicks : 0) + 1; }
+
+    void OnTimer() override {
         if (!m_TaskExecuted) {
             if (m_Task.valid()) {
                 try {
@@ -255,8 +358,6 @@ public:
             }
             m_TaskExecuted = true;
         }
-
-        return true;
     }
 
 private:
@@ -348,13 +449,15 @@ public:
 
     bool IsComplete() override {
         for (const auto &co : m_Coroutines) {
-            if (co.valid() && co.status() == sol::call_status::yielded) {
+            if (IsCoroutineRunning(co)) {
                 return false; // At least one still running
             }
         }
         return true; // All done or invalid
     }
 
+    const std::vector<sol::coroutine> *GetAwaitedCoroutines() const override { return &m_Coroutines; }
+
 private:
     std::vector<sol::coroutine> m_Coroutines;
 };
@@ -407,6 +510,8 @@ public:
         return m_EventReceived;
     }
 
+    bool IsWakeDriven() const override { return true; }
+
 private:
     std::string m_EventName;
     TASEngine *m_Engine;
@@ -415,23 +520,27 @@ private:
     uint64_t m_ListenerId = 0;
 };
 
-// Forward declare MessageBus::Message::SerializedValue
-class MessageBus;
-
-namespace MessageBusInternal {
-    struct SerializedValue;
-}
-
 /**
  * @class MessageResponseTask
  * @brief Waits for a message response with a specific correlation ID
+ *
+ * The MessageBus hands the response over when it arrives; the timeout runs on
+ * the scheduler's timing wheel.
  */
 class MessageResponseTask : public SchedulerTask {
 public:
     MessageResponseTask(std::string correlationId, TASEngine *engine, int timeoutTicks);
     ~MessageResponseTask() override;
 
-    bool IsComplete() override;
+    bool IsComplete() override {
+        return m_ResponseReceived || m_TimedOut || !m_Watching;
+    }
+
+    bool IsWakeDriven() const override { return true; }
+
+    int GetTimerTicks() const override { return m_TimeoutTicks > 1 ? m_TimeoutTicks : 1; }
+
+    void OnTimer() override;
 
     /**
      * @brief Gets the response data if available.
@@ -448,10 +557,12 @@ public:
 private:
     std::string m_CorrelationId;
     TASEngine *m_Engine;
+    class MessageBus *m_MessageBus = nullptr;
     int m_TimeoutTicks;
-    bool m_ResponseReceived;
-    std::any m_ResponseData;
-    // Stores MessageBus::Message::SerializedValue as std::any to avoid forward declaration issues
+    bool m_Watching = false;
+    bool m_TimedOut = false;
+    std::atomic<bool> m_ResponseReceived{false}; // Set by the MessageBus consumer thread
+    MessagePayload m_ResponseData;
 };
 
 /**
@@ -472,23 +583,29 @@ public:
         --m_RemainingTicks;
 
         if (m_RemainingTicks <= 0) {
-            if (m_Task.valid()) {
-                try {
-                    m_Task();
-                } catch (const std::exception &) {
-                    // Log error
-                }
-            }
-            m_TaskExecuted = true;
+            OnTimer();
             return true;
         }
 
         return false;
     }
 
-    void Reset() {
-        m_RemainingTicks = m_DebounceTicks;
-        m_TaskExecuted = false;
+    int GetTimerTicks() const override {
+        if (m_TaskExecuted) return 0;
+        return m_RemainingTicks > 1 ? m_RemainingTicks : 1;
+    }
+
+    void OnTimer() override {
+        if (m_TaskExecuted) return;
+
+        if (m_Task.valid()) {
+            try {
+                m_Task();
+            } catch (const std::exception &) {
+                // Log error
+            }
+        }
+        m_TaskExecuted = true;
     }
 
 private:
@@ -556,8 +673,43 @@ namespace detail {
     };
 
     struct SchedulerThreadTask {
+        uint64_t sequence = 0; // Scheduling order, used to merge with expired timers
+        std::shared_ptr<SchedulerCothread> thread;
+        std::shared_ptr<SchedulerTask> task;
+    };
+
+    /**
+     * @brief A coroutine parked on a wake-driven task.
+     */
+    struct SchedulerParkedThread {
+        std::shared_ptr<SchedulerCothread> thread;
+        std::shared_ptr<SchedulerTask> task;
+        size_t awaiting = 0; // Awaited coroutines still running
+    };
+
+    struct SchedulerBackgroundTask {
+        uint64_t sequence = 0;
+        std::shared_ptr<SchedulerTask> task;
+    };
+
+    /**
+     * @brief Entry in a scheduler timing wheel or ready queue: a coroutine to resume,
+     *        the timeout of a parked coroutine (task set, no thread) or a background
+     *        timer task.
+     */
+    struct SchedulerTimer {
+        uint64_t sequence = 0;
         std::shared_ptr<SchedulerCothread> thread;
         std::shared_ptr<SchedulerTask> task;
+
+        static bool BySequence(const SchedulerTimer &lhs, const SchedulerTimer &rhs) {
+            return lhs.sequence < rhs.sequence;
+        }
+
+        // Heap order with the oldest entry on top
+        static bool LaterSequence(const SchedulerTimer &lhs, const SchedulerTimer &rhs) {
+            return lhs.sequence > rhs.sequence;
+        }
     };
 }
 
@@ -585,6 +737,25 @@ namespace detail {
  * If multi-threaded context execution is required in the future, each ScriptContext
  * must have its own dedicated thread, OR all LuaScheduler methods must be protected
  * with a per-scheduler mutex.
+ *
+ * TIMERS AND WAKE-UPS:
+ * ====================
+ * Purely time-based waits (wait_ticks, delay, debounce) are parked in hierarchical
+ * timing wheels keyed by their target tick, so Tick() only touches the ones that
+ * expire. Coroutines waiting on an event, a message response or other coroutines
+ * are parked until EventManager, MessageBus or the scheduler itself (when a
+ * coroutine finishes) wakes them into the ready queue. Only predicate-style tasks
+ * are polled every tick, so the cost of a tick follows the number of wake-ups
+ * rather than the number of waiters.
+ *
+ * Expired timers, woken coroutines and polled tasks are processed in the order
+ * they were scheduled. A coroutine woken during Tick() resumes in the same tick
+ * if its turn has not passed yet, and in the next tick otherwise - the same as
+ * if it had been polled.
+ *
+ * Wake() is the only entry point that may be called from another thread (the
+ * MessageBus consumer); it only appends to a mutex-protected queue that Tick()
+ * drains on the owning thread.
  */
 class LuaScheduler {
 public:
@@ -647,6 +818,12 @@ public:
      */
     void Tick();
 
+    /**
+     * @brief Hands the scheduler to another thread (see ScriptContext::TransferOwnership).
+     * @param owner The thread that may use the scheduler from now on.
+     */
+    void TransferOwnership(std::thread::id owner) { m_ThreadValidator.SetOwner(owner); }
+
     /**
      * @brief Stops all running coroutines and clears tasks.
      */
@@ -723,15 +900,96 @@ public:
     void StartParallel(const std::vector<sol::coroutine> &coroutines);
 
 private:
+    friend class SchedulerTask; // Wake()
+
+    enum class TickPhase {
+        Idle,
+        Coroutines,
+        Background
+    };
+
     void Yield(std::shared_ptr<SchedulerTask> task);
 
+    /**
+     * @brief Parks a coroutine on a task, in the timing wheel if the task is time-based.
+     */
+    void AddThreadTask(std::shared_ptr<detail::SchedulerCothread> thread, std::shared_ptr<SchedulerTask> task);
+
+    /**
+     * @brief Adds a background task, in the timing wheel if the task is time-based.
+     */
+    void AddBackgroundTask(std::shared_ptr<SchedulerTask> task);
+
+    /**
+     * @brief Parks a coroutine on a wake-driven task.
+     * @return False if the task cannot be woken and has to be polled instead.
+     */
+    bool ParkThread(uint64_t sequence, std::shared_ptr<detail::SchedulerCothread> &thread,
+                    std::shared_ptr<SchedulerTask> &task);
+
+    /**
+     * @brief Resumes a parked coroutine with it as the current thread.
+     */
+    void ResumeThread(const std::shared_ptr<detail::SchedulerCothread> &thread);
+
+    /**
+     * @brief Resumes a due entry (timer, timeout or woken coroutine) during Tick().
+     */
+    void ResumeDue(detail::SchedulerTimer &due);
+
+    /**
+     * @brief Called when a scheduled coroutine has run to completion or died; wakes
+     *        the coroutines waiting on it.
+     */
+    void FinishThread(const std::shared_ptr<detail::SchedulerCothread> &thread);
+
+    /**
+     * @brief Gets the key identifying a coroutine's thread, or nullptr if it has none of its own.
+     */
+    lua_State *GetThreadKey(const sol::coroutine &co) const;
+
+    /**
+     * @brief Queues a parked coroutine for resumption (any thread).
+     */
+    void Wake(uint64_t sequence);
+
+    /**
+     * @brief Moves woken coroutines from the wake queue to the due list (owning thread).
+     */
+    void CollectWakeups();
+
     TASEngine *m_Engine;
     ScriptContext *m_Context; // nullptr for legacy mode, non-null for multi-context mode
+
+    // Wake queue, the only state touched from other threads. Declared before the
+    // task containers so it outlives the tasks that may still call Wake().
+    std::mutex m_WakeMutex;
+    std::vector<uint64_t> m_Wakeups;
+    std::vector<uint64_t> m_WakeupsSwap;
+    std::atomic<bool> m_HasWakeups{false};
+
     std::shared_ptr<detail::SchedulerCothread> m_CurrentThread;
     std::list<detail::SchedulerThreadTask> m_Tasks;
-    std::list<std::shared_ptr<SchedulerTask>> m_BackgroundTasks;
+    std::list<detail::SchedulerBackgroundTask> m_BackgroundTasks;
     std::stack<std::shared_ptr<detail::SchedulerCothread>> m_ThreadStack;
 
+    // Time-based tasks, keyed by the tick they expire at
+    uint64_t m_CurrentTick = 0;
+    uint64_t m_NextSequence = 1;
+    TickPhase m_Phase = TickPhase::Idle;
+    TimerWheel<detail::SchedulerTimer> m_ThreadTimers;
+    TimerWheel<detail::SchedulerTimer> m_BackgroundTimers;
+    std::vector<detail::SchedulerTimer> m_DueThreads;    // Due this tick, heap ordered by sequence
+    std::vector<detail::SchedulerTimer> m_DueBackground; // Expiring this tick, by sequence
+    size_t m_PendingTimeouts = 0;                        // Timeout entries in m_ThreadTimers
+    uint64_t m_ResumeCursor = 0;                         // Sequence of the last entry processed this tick
+
+    // Coroutines parked on wake-driven tasks, by sequence
+    std::unordered_map<uint64_t, detail::SchedulerParkedThread> m_Parked;
+    std::vector<detail::SchedulerTimer> m_WokenThreads; // Woken too late for this tick
+    std::unordered_set<lua_State *> m_LiveThreads;      // Scheduled coroutines that have not finished
+    std::unordered_map<lua_State *, std::vector<uint64_t>> m_CoroutineWaiters;
+
     // Thread safety enforcement
     mutable ThreadOwnershipValidator m_ThreadValidator{"LuaScheduler"};
 };
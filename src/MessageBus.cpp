@@ -11,172 +11,16 @@
 #include "ScriptContext.h"
 #include "Logger.h"
 
-// Thread-local depth counter to detect circular references during serialization
-thread_local int g_SerializationDepth = 0;
-constexpr int MAX_SERIALIZATION_DEPTH = 100;
-
-MessageBus::SerializedTable MessageBus::SerializeTable(const sol::table &table) {
-    // Check recursion depth to prevent stack overflow from circular references
-    if (g_SerializationDepth > MAX_SERIALIZATION_DEPTH) {
-        throw std::runtime_error("MessageBus: Table serialization exceeded maximum depth (possible circular reference)");
-    }
-
-    // RAII depth tracker
-    struct DepthGuard {
-        DepthGuard() { ++g_SerializationDepth; }
-        ~DepthGuard() { --g_SerializationDepth; }
-    } depthGuard;
-
-    SerializedTable result;
-
-    for (const auto &pair : table) {
-        const sol::object &key = pair.first;
-        const sol::object &value = pair.second;
-
-        if (key.get_type() == sol::type::string) {
-            std::string keyStr = key.as<std::string>();
-            result[keyStr] = Message::SerializedValue::FromLuaObject(value);
-        } else {
-            throw std::runtime_error("MessageBus: Table serialization encountered non-string key.");
-        }
-    }
-
-    return result;
-}
-
-sol::table MessageBus::DeserializeTable(sol::state_view lua, const SerializedTable &data) {
-    sol::table table = lua.create_table();
-
-    for (const auto &entry : data) {
-        table[entry.first] = entry.second.ToLuaObject(lua);
-    }
-
-    return table;
-}
-
-sol::table MessageBus::DeserializeArray(sol::state_view lua, const SerializedArray &data) {
-    sol::table table = lua.create_table(static_cast<int>(data.size()), 0);
-
-    for (const auto &entry : data) {
-        table[entry.first] = entry.second.ToLuaObject(lua);
-    }
-
-    return table;
-}
-
-sol::object MessageBus::Message::SerializedValue::ToLuaObject(sol::state_view lua) const {
-    switch (type) {
-    case Type::Nil:
-        return sol::make_object(lua, sol::nil);
-    case Type::Boolean:
-        return sol::make_object(lua, std::any_cast<bool>(data));
-    case Type::Number:
-        return sol::make_object(lua, std::any_cast<double>(data));
-    case Type::String:
-        return sol::make_object(lua, std::any_cast<const std::string &>(data));
-    case Type::Array: {
-        const auto &arrayData = std::any_cast<const MessageBus::SerializedArray &>(data);
-        sol::table table = MessageBus::DeserializeArray(lua, arrayData);
-        return sol::make_object(lua, table);
-    }
-    case Type::Table: {
-        const auto &tableData = std::any_cast<const MessageBus::SerializedTable &>(data);
-        sol::table table = MessageBus::DeserializeTable(lua, tableData);
-        return sol::make_object(lua, table);
-    }
-    case Type::SharedBufferRef: {
-        // Return the SharedBuffer as a Lua userdata
-        auto buffer = std::any_cast<std::shared_ptr<SharedBuffer>>(data);
-        return sol::make_object(lua, buffer);
-    }
-    default:
-        return sol::make_object(lua, sol::nil);
-    }
-}
-
-MessageBus::Message::SerializedValue MessageBus::Message::SerializedValue::FromLuaObject(sol::object obj) {
-    sol::type objType = obj.get_type();
-
-    switch (objType) {
-    case sol::type::nil:
-    case sol::type::none:
-        return SerializedValue(Type::Nil, std::any{});
-    case sol::type::boolean:
-        return SerializedValue(Type::Boolean, std::any(obj.as<bool>()));
-    case sol::type::number:
-        return SerializedValue(Type::Number, std::any(obj.as<double>()));
-    case sol::type::string:
-        return SerializedValue(Type::String, std::any(obj.as<std::string>()));
-    case sol::type::table: {
-        sol::table tbl = obj.as<sol::table>();
-
-        bool hasStringKey = false;
-        bool hasNumericKey = false;
-        std::vector<std::pair<size_t, sol::object>> numericEntries;
-
-        for (const auto &entry : tbl) {
-            const sol::object &key = entry.first;
-
-            if (key.get_type() == sol::type::string) {
-                hasStringKey = true;
-                if (hasNumericKey) {
-                    throw std::runtime_error(
-                        "MessageBus: Mixed string and numeric keys are not supported in message payload tables.");
-                }
-            } else if (key.get_type() == sol::type::number) {
-                double rawKey = key.as<double>();
-                if (!std::isfinite(rawKey) || std::floor(rawKey) != rawKey || rawKey < 0) {
-                    throw std::runtime_error(
-                        "MessageBus: Numeric table keys must be non-negative integers for message payloads.");
-                }
-                hasNumericKey = true;
-                if (hasStringKey) {
-                    throw std::runtime_error(
-                        "MessageBus: Mixed string and numeric keys are not supported in message payload tables.");
-                }
-                numericEntries.emplace_back(static_cast<size_t>(rawKey), entry.second);
-            } else {
-                throw std::runtime_error("MessageBus: Unsupported table key type for message payload.");
-            }
-        }
-
-        if (hasNumericKey) {
-            std::sort(numericEntries.begin(), numericEntries.end(),
-                      [](const auto &lhs, const auto &rhs) {
-                          return lhs.first < rhs.first;
-                      });
-
-            MessageBus::SerializedArray arrayData;
-            arrayData.reserve(numericEntries.size());
-            for (const auto &entry : numericEntries) {
-                arrayData.emplace_back(entry.first, SerializedValue::FromLuaObject(entry.second));
-            }
-
-            return SerializedValue(Type::Array, std::any(std::move(arrayData)));
-        }
-
-        auto serialized = MessageBus::SerializeTable(tbl);
-        return SerializedValue(Type::Table, std::any(std::move(serialized)));
-    }
-    case sol::type::function:
-        throw std::runtime_error("MessageBus: Functions cannot be serialized in messages");
-    case sol::type::userdata:
-    case sol::type::lightuserdata: {
-        // Check if this is a SharedBuffer userdata
-        if (obj.is<std::shared_ptr<SharedBuffer>>()) {
-            auto buffer = obj.as<std::shared_ptr<SharedBuffer>>();
-            return SerializedValue::FromSharedBuffer(buffer);
-        }
-        throw std::runtime_error("MessageBus: Userdata cannot be serialized in messages (use SharedBuffer for large data)");
-    }
-    case sol::type::thread:
-        throw std::runtime_error("MessageBus: Threads cannot be serialized in messages");
-    default:
-        throw std::runtime_error("MessageBus: Unsupported Lua type for message payload");
-    }
+namespace {
+    // Outbox capturing the current thread's sends (see MessageBus::OutboxScope)
+    thread_local MessageBus *t_CaptureBus = nullptr;
+    thread_local MessageBus::Outbox *t_CaptureOutbox = nullptr;
 }
 
-MessageBus::MessageBus(TASEngine *engine) : m_Engine(engine), m_MessageQueue(m_QueueConfig.maxQueueSize) {
+MessageBus::MessageBus(TASEngine *engine)
+    : m_Engine(engine),
+      m_MessageQueue(m_QueueConfig.maxQueueSize),
+      m_HandlerTable(std::make_shared<const HandlerTable>()) {
     if (!m_Engine) {
         throw std::runtime_error("MessageBus requires a valid TASEngine instance.");
     }
@@ -199,7 +43,7 @@ bool MessageBus::Initialize() {
         ClearMessages();
         {
             std::lock_guard<std::mutex> lock(m_HandlersMutex);
-            m_Handlers.clear();
+            PublishHandlers(std::make_shared<HandlerTable>());
         }
 
         m_IsInitialized = true;
@@ -220,7 +64,7 @@ void MessageBus::Shutdown() {
         ClearMessages();
         {
             std::lock_guard<std::mutex> lock(m_HandlersMutex);
-            m_Handlers.clear();
+            PublishHandlers(std::make_shared<HandlerTable>());
         }
 
         m_IsInitialized = false;
@@ -244,7 +88,7 @@ bool MessageBus::SendMessage(const std::string &senderContext,
     }
 
     try {
-        Message::SerializedValue payload = Message::SerializedValue::FromLuaObject(data);
+        MessagePayload payload = MessagePayload::FromLuaObject(data);
 
         // NEW: Check message size limits (Sprint 2)
         size_t estimatedSize = payload.EstimateSize();
@@ -295,7 +139,7 @@ void MessageBus::RegisterHandler(const std::string &contextName,
         std::lock_guard<std::mutex> lock(m_HandlersMutex);
         // Create HandlerEntry with empty context (for non-Lua handlers without lifetime tracking)
         HandlerEntry entry(std::weak_ptr<ScriptContext>(), std::move(handler), ++m_HandlerGeneration);
-        m_Handlers[contextName][messageType].push_back(std::move(entry));
+        AddHandlerEntry(contextName, messageType, std::move(entry));
     } catch (const std::exception &e) {
         Log::Error("[%s] MessageBus: Failed to register handler for '%s': %s",
                    contextName.c_str(), messageType.c_str(), e.what());
@@ -365,7 +209,7 @@ void MessageBus::RegisterLuaHandler(const std::string &contextName,
     try {
         std::lock_guard<std::mutex> lock(m_HandlersMutex);
         HandlerEntry entry(contextPtr, std::move(handler), ++m_HandlerGeneration);
-        m_Handlers[contextName][messageType].push_back(std::move(entry));
+        AddHandlerEntry(contextName, messageType, std::move(entry));
         Log::Info("[%s] Registered handler for message type '%s' (generation: %llu).",
                   contextName.c_str(), messageType.c_str(), m_HandlerGeneration);
     } catch (const std::exception &e) {
@@ -376,21 +220,63 @@ void MessageBus::RegisterLuaHandler(const std::string &contextName,
 
 void MessageBus::RemoveHandler(const std::string &contextName, const std::string &messageType) {
     std::lock_guard<std::mutex> lock(m_HandlersMutex);
-    auto contextIt = m_Handlers.find(contextName);
-    if (contextIt != m_Handlers.end()) {
-        contextIt->second.erase(messageType);
-        if (contextIt->second.empty()) {
-            m_Handlers.erase(contextIt);
-        }
+    const auto current = m_HandlerTable.load(std::memory_order_acquire);
+    auto contextIt = current->byContext.find(contextName);
+    if (contextIt == current->byContext.end() || !contextIt->second.count(messageType)) {
+        return;
     }
+
+    auto table = std::make_shared<HandlerTable>(*current);
+    auto &handlerMap = table->byContext[contextName];
+    handlerMap.erase(messageType);
+    if (handlerMap.empty()) {
+        table->byContext.erase(contextName);
+    }
+    PublishHandlers(std::move(table));
 }
 
 void MessageBus::RemoveAllHandlers(const std::string &contextName) {
     std::lock_guard<std::mutex> lock(m_HandlersMutex);
-    m_Handlers.erase(contextName);
+    const auto current = m_HandlerTable.load(std::memory_order_acquire);
+    if (!current->byContext.count(contextName)) {
+        return;
+    }
+
+    auto table = std::make_shared<HandlerTable>(*current);
+    table->byContext.erase(contextName);
+    PublishHandlers(std::move(table));
+}
+
+void MessageBus::AddHandlerEntry(const std::string &contextName, const std::string &messageType, HandlerEntry entry) {
+    // Copy-on-write: only the list that changes is duplicated, other lists are shared
+    auto table = std::make_shared<HandlerTable>(*m_HandlerTable.load(std::memory_order_acquire));
+    auto &slot = table->byContext[contextName][messageType];
+
+    auto handlers = slot ? std::make_shared<HandlerList>(*slot) : std::make_shared<HandlerList>();
+    handlers->push_back(std::move(entry));
+    slot = std::move(handlers);
+
+    PublishHandlers(std::move(table));
+}
+
+void MessageBus::PublishHandlers(std::shared_ptr<HandlerTable> table) {
+    // Rebuild the broadcast index from the per-context lists
+    table->byType.clear();
+    for (const auto &[contextName, handlerMap] : table->byContext) {
+        for (const auto &[messageType, handlers] : handlerMap) {
+            table->byType[messageType].emplace_back(contextName, handlers);
+        }
+    }
+
+    m_HandlerTable.store(std::move(table), std::memory_order_release);
 }
 
 bool MessageBus::EnqueueMessage(Message message) {
+    if (t_CaptureBus == this) {
+        t_CaptureOutbox->push_back(std::move(message));
+        return true;
+    }
+
     // Lock-free enqueue with priority
     // Priority is extracted from the message and passed to the queue
     int priority = static_cast<int>(message.priority);
@@ -439,7 +325,7 @@ bool MessageBus::SendRequestAsync(const std::string &senderContext,
     }
 
     try {
-        Message::SerializedValue payload = Message::SerializedValue::FromLuaObject(data);
+        MessagePayload payload = MessagePayload::FromLuaObject(data);
         Message requestMsg(senderContext, targetContext, requestType, std::move(payload),
                            Priority::High, correlationId, false);
 
@@ -462,12 +348,18 @@ sol::object MessageBus::SendRequest(const std::string &senderContext,
 
     sol::state_view callerState = data.lua_state();
 
+    if (t_CaptureBus == this) {
+        Log::Error("[%s] MessageBus: Synchronous request '%s' is not available during a parallel tick.",
+                   senderContext.c_str(), requestType.c_str());
+        return sol::make_object(callerState, sol::nil);
+    }
+
     // Generate unique correlation ID
     std::string correlationId = GenerateCorrelationId();
 
     // Send request message with correlation ID
     try {
-        Message::SerializedValue payload = Message::SerializedValue::FromLuaObject(data);
+        MessagePayload payload = MessagePayload::FromLuaObject(data);
         Message requestMsg(senderContext, targetContext, requestType, std::move(payload),
                            Priority::High, correlationId, false);
 
@@ -505,7 +397,7 @@ bool MessageBus::SendResponse(const std::string &senderContext,
     }
 
     try {
-        Message::SerializedValue payload = Message::SerializedValue::FromLuaObject(responseData);
+        MessagePayload payload = MessagePayload::FromLuaObject(responseData);
         Message responseMsg(senderContext, targetContext, "response",
                             std::move(payload), Priority::High, correlationId, true);
 
@@ -521,6 +413,24 @@ bool MessageBus::SendResponse(const std::string &senderContext,
     return true;
 }
 
+MessageBus::OutboxScope::OutboxScope(MessageBus &bus, Outbox &outbox)
+    : m_PreviousBus(t_CaptureBus), m_PreviousOutbox(t_CaptureOutbox) {
+    t_CaptureBus = &bus;
+    t_CaptureOutbox = &outbox;
+}
+
+MessageBus::OutboxScope::~OutboxScope() {
+    t_CaptureBus = m_PreviousBus;
+    t_CaptureOutbox = m_PreviousOutbox;
+}
+
+void MessageBus::FlushOutbox(Outbox &outbox) {
+    for (auto &message : outbox) {
+        EnqueueMessage(std::move(message));
+    }
+    outbox.clear();
+}
+
 std::string MessageBus::GenerateCorrelationId() {
     uint64_t id = m_NextCorrelationId.fetch_add(1, std::memory_order_relaxed);
     std::ostringstream oss;
@@ -540,7 +450,7 @@ std::optional<MessageBus::Message> MessageBus::WaitForResponse(const std::string
         // Check if response is available
         auto it = m_PendingResponses.find(correlationId);
         if (it != m_PendingResponses.end()) {
-            Message response = std::move(it->second);
+            Message response = std::move(it->second.message);
             m_PendingResponses.erase(it);
             return response;
         }
@@ -548,7 +458,8 @@ std::optional<MessageBus::Message> MessageBus::WaitForResponse(const std::string
         // ACCURACY FIX: Check deadline BEFORE waiting to handle spurious wakeups correctly
         auto now = std::chrono::steady_clock::now();
         if (now >= deadline) {
-            // Timeout - no response received
+            // Timeout - no response received; a late one is dropped on arrival
+            m_AbandonedResponses[correlationId] = now;
             return std::nullopt;
         }
 
@@ -561,32 +472,84 @@ std::optional<MessageBus::Message> MessageBus::WaitForResponse(const std::string
 
 void MessageBus::NotifyResponse(const Message &response) {
     std::lock_guard<std::mutex> lock(m_ResponseMutex);
-    m_PendingResponses[response.correlationId] = response;
+
+    // A watcher takes the response directly, nothing is left behind to poll for
+    auto watcher = m_ResponseWatchers.find(response.correlationId);
+    if (watcher != m_ResponseWatchers.end()) {
+        ResponseCallback callback = std::move(watcher->second);
+        m_ResponseWatchers.erase(watcher);
+        callback(Message(response));
+        return;
+    }
+
+    // Its waiter timed out or went away; storing it could hand it to a later request
+    auto abandoned = m_AbandonedResponses.find(response.correlationId);
+    if (abandoned != m_AbandonedResponses.end()) {
+        m_AbandonedResponses.erase(abandoned);
+        Log::Warn("[%s] MessageBus: Dropped late response '%s' from '%s'.", response.targetContext.c_str(),
+                  response.correlationId.c_str(), response.senderContext.c_str());
+        return;
+    }
+
+    m_PendingResponses[response.correlationId] = {response, std::chrono::steady_clock::now()};
     m_ResponseCV.notify_all();
 }
 
+void MessageBus::ExpireResponses() {
+    std::lock_guard<std::mutex> lock(m_ResponseMutex);
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now < m_NextResponseSweep) {
+        return;
+    }
+    m_NextResponseSweep = now + std::chrono::seconds(1);
+
+    for (auto it = m_PendingResponses.begin(); it != m_PendingResponses.end();) {
+        if (now - it->second.arrivedAt >= kResponseTtl) {
+            Log::Warn("[%s] MessageBus: Discarded unclaimed response '%s'.",
+                      it->second.message.targetContext.c_str(), it->first.c_str());
+            it = m_PendingResponses.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (auto it = m_AbandonedResponses.begin(); it != m_AbandonedResponses.end();) {
+        if (now - it->second >= kResponseTtl) {
+            it = m_AbandonedResponses.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void MessageBus::ProcessMessages() {
     if (!m_IsInitialized) return;
 
-    // Drain queue directly (lock-free dequeue by single consumer)
-    // Messages are automatically delivered in priority order
-    while (auto maybeMessage = m_MessageQueue.Dequeue()) {
-        const Message &msg = *maybeMessage;
+    ExpireResponses();
 
-        try {
-            // Check if this is a response message
-            if (msg.isResponse) {
-                // Notify waiting thread
-                NotifyResponse(msg);
-            } else {
-                // Deliver normal message to handlers
-                DeliverMessage(msg);
+    // Drain queue in batches (lock-free dequeue by single consumer)
+    // Messages are automatically delivered in priority order
+    while (m_MessageQueue.DequeueBatch(m_ProcessBatch, kProcessBatchSize) > 0) {
+        for (const Message &msg : m_ProcessBatch) {
+            try {
+                // Check if this is a response message
+                if (msg.isResponse) {
+                    // Notify waiting thread
+                    NotifyResponse(msg);
+                } else {
+                    // Deliver normal message to handlers
+                    DeliverMessage(msg);
+                }
+            } catch (const std::exception &e) {
+                Log::Error("[%s] MessageBus: Exception delivering message '%s' to '%s': %s",
+                           msg.senderContext.c_str(), msg.messageType.c_str(),
+                           msg.targetContext.c_str(), e.what());
             }
-        } catch (const std::exception &e) {
-            Log::Error("[%s] MessageBus: Exception delivering message '%s' to '%s': %s",
-                       msg.senderContext.c_str(), msg.messageType.c_str(),
-                       msg.targetContext.c_str(), e.what());
         }
+
+        // Keeps capacity, so steady-state batches do not allocate
+        m_ProcessBatch.clear();
     }
 }
 
@@ -615,43 +578,61 @@ std::optional<MessageBus::Message> MessageBus::TryGetResponse(const std::string
     std::lock_guard<std::mutex> lock(m_ResponseMutex);
     auto it = m_PendingResponses.find(correlationId);
     if (it != m_PendingResponses.end()) {
-        Message response = std::move(it->second);
+        Message response = std::move(it->second.message);
         m_PendingResponses.erase(it);
         return response;
     }
     return std::nullopt;
 }
 
+void MessageBus::WatchResponse(const std::string &correlationId, ResponseCallback callback) {
+    if (!callback) return;
+
+    std::lock_guard<std::mutex> lock(m_ResponseMutex);
+    auto it = m_PendingResponses.find(correlationId);
+    if (it != m_PendingResponses.end()) {
+        Message response = std::move(it->second.message);
+        m_PendingResponses.erase(it);
+        callback(std::move(response));
+        return;
+    }
+
+    m_ResponseWatchers[correlationId] = std::move(callback);
+}
+
+void MessageBus::UnwatchResponse(const std::string &correlationId) {
+    std::lock_guard<std::mutex> lock(m_ResponseMutex);
+    if (m_ResponseWatchers.erase(correlationId) > 0) {
+        // The response has not arrived yet; drop it when it does
+        m_AbandonedResponses[correlationId] = std::chrono::steady_clock::now();
+    }
+}
+
 void MessageBus::DeliverMessage(const Message &message) {
-    std::vector<std::pair<std::string, std::vector<HandlerEntry>>> deliveries;
-    {
-        std::lock_guard<std::mutex> lock(m_HandlersMutex);
+    // The snapshot is immutable and stays alive while we hold it, so handlers may
+    // register or remove handlers during delivery without affecting this pass
+    const std::shared_ptr<const HandlerTable> table = m_HandlerTable.load(std::memory_order_acquire);
 
-        if (message.targetContext == "*") {
-            for (const auto &[contextName, handlerMap] : m_Handlers) {
-                if (contextName == message.senderContext) {
-                    continue;
-                }
+    if (message.targetContext == "*") {
+        auto typeIt = table->byType.find(message.messageType);
+        if (typeIt == table->byType.end()) {
+            return;
+        }
 
-                auto typeIt = handlerMap.find(message.messageType);
-                if (typeIt != handlerMap.end()) {
-                    deliveries.emplace_back(contextName, typeIt->second);
-                }
+        for (const auto &[contextName, handlers] : typeIt->second) {
+            if (contextName != message.senderContext) {
+                InvokeHandlers(contextName, *handlers, message);
             }
-        } else {
-            auto ctxIt = m_Handlers.find(message.targetContext);
-            if (ctxIt != m_Handlers.end()) {
-                auto typeIt = ctxIt->second.find(message.messageType);
-                if (typeIt != ctxIt->second.end()) {
-                    deliveries.emplace_back(message.targetContext, typeIt->second);
-                }
+        }
+    } else {
+        auto ctxIt = table->byContext.find(message.targetContext);
+        if (ctxIt != table->byContext.end()) {
+            auto typeIt = ctxIt->second.find(message.messageType);
+            if (typeIt != ctxIt->second.end()) {
+                InvokeHandlers(message.targetContext, *typeIt->second, message);
             }
         }
     }
-
-    for (const auto &entry : deliveries) {
-        InvokeHandlers(entry.first, entry.second, message);
-    }
 }
 
 void MessageBus::InvokeHandlers(const std::string &contextName,
@@ -667,57 +648,3 @@ void MessageBus::InvokeHandlers(const std::string &contextName,
         }
     }
 }
-
-// ============================================================================
-// SharedBuffer Support (Sprint 2)
-// ============================================================================
-
-MessageBus::Message::SerializedValue MessageBus::Message::SerializedValue::FromSharedBuffer(
-    std::shared_ptr<SharedBuffer> buffer) {
-    if (!buffer) {
-        throw std::invalid_argument("MessageBus: Cannot create SerializedValue from null SharedBuffer");
-    }
-    return SerializedValue(Type::SharedBufferRef, std::any(buffer));
-}
-
-std::shared_ptr<SharedBuffer> MessageBus::Message::SerializedValue::AsSharedBuffer() const {
-    if (type != Type::SharedBufferRef) {
-        throw std::runtime_error("MessageBus: SerializedValue is not a SharedBufferRef");
-    }
-    return std::any_cast<std::shared_ptr<SharedBuffer>>(data);
-}
-
-size_t MessageBus::Message::SerializedValue::EstimateSize() const {
-    switch (type) {
-    case Type::Nil:
-        return 1;
-    case Type::Boolean:
-        return 1;
-    case Type::Number:
-        return 8;
-    case Type::String:
-        return std::any_cast<const std::string &>(data).size();
-    case Type::Array: {
-        const auto &arrayData = std::any_cast<const MessageBus::SerializedArray &>(data);
-        size_t total = 0;
-        for (const auto &entry : arrayData) {
-            total += entry.second.EstimateSize();
-        }
-        return total;
-    }
-    case Type::Table: {
-        const auto &tableData = std::any_cast<const MessageBus::SerializedTable &>(data);
-        size_t total = 0;
-        for (const auto &entry : tableData) {
-            total += entry.first.size();          // Key size
-            total += entry.second.EstimateSize(); // Value size
-        }
-        return total;
-    }
-    case Type::SharedBufferRef:
-        // SharedBuffer is reference-counted, only count pointer overhead
-        return sizeof(std::shared_ptr<SharedBuffer>);
-    default:
-        return 0;
-    }
-}
@@ -8,11 +8,13 @@
 #include <optional>
 #include <condition_variable>
 #include <atomic>
-#include <any>
+#include <memory>
+#include <chrono>
 
 #include <sol/sol.hpp>
 
 #include "LockFreeMPSCQueue.h"
+#include "MessagePayload.h"
 #include "SharedBuffer.h"
 
 // Forward declarations
@@ -78,35 +80,7 @@ public:
         std::string senderContext; // Name of the sending context
         std::string targetContext; // Name of the target context ("*" for broadcast)
         std::string messageType;   // Type of message (used to route to handlers)
-        struct SerializedValue {
-            enum class Type {
-                Nil,
-                Boolean,
-                Number,
-                String,
-                Array,
-                Table,
-                SharedBufferRef // NEW: Reference to shared buffer (zero-copy)
-            };
-
-            Type type = Type::Nil;
-            std::any data; // For SharedBufferRef: std::shared_ptr<SharedBuffer>
-
-            SerializedValue() = default;
-
-            SerializedValue(Type t, std::any payload) : type(t), data(std::move(payload)) {}
-
-            sol::object ToLuaObject(sol::state_view lua) const;
-            static SerializedValue FromLuaObject(sol::object obj);
-
-            // NEW: Factory methods for SharedBuffer
-            static SerializedValue FromSharedBuffer(std::shared_ptr<SharedBuffer> buffer);
-            std::shared_ptr<SharedBuffer> AsSharedBuffer() const;
-
-            // NEW: Get estimated size in bytes
-            size_t EstimateSize() const;
-        } data;
-
+        MessagePayload data;       // Flat encoded payload (SharedBuffers by reference)
         Priority priority;         // Message priority
         std::string correlationId; // Correlation ID for request/response pattern
         bool isResponse;           // True if this is a response message
@@ -115,7 +89,7 @@ public:
         }
 
         Message(std::string sender, std::string target, std::string type,
-                SerializedValue payload,
+                MessagePayload payload,
                 Priority prio = Priority::Normal,
                 std::string corrId = "", bool isResp = false)
             : senderContext(std::move(sender)),
@@ -262,6 +236,40 @@ public:
      */
     void RemoveAllHandlers(const std::string &contextName);
 
+    // --- Deferred Sending ---
+
+    /**
+     * @brief Messages captured from one context during a tick.
+     */
+    using Outbox = std::vector<Message>;
+
+    /**
+     * @brief Redirects messages sent on the current thread into an outbox.
+     *
+     * ScriptContextManager uses this for contexts ticked on the worker pool: each
+     * sends into its own outbox, flushed at the context's place in the priority
+     * order, so the queue sees the same message order as a serial tick. Synchronous
+     * requests are refused while capturing.
+     */
+    class OutboxScope {
+    public:
+        OutboxScope(MessageBus &bus, Outbox &outbox);
+        ~OutboxScope();
+
+        OutboxScope(const OutboxScope &) = delete;
+        OutboxScope &operator=(const OutboxScope &) = delete;
+
+    private:
+        MessageBus *m_PreviousBus;
+        Outbox *m_PreviousOutbox;
+    };
+
+    /**
+     * @brief Enqueues captured messages in capture order and clears the outbox.
+     * @param outbox The outbox to flush.
+     */
+    void FlushOutbox(Outbox &outbox);
+
     /**
      * @brief Processes all pending messages in the queue.
      * This should be called once per tick.
@@ -305,6 +313,28 @@ public:
      */
     std::optional<Message> TryGetResponse(const std::string &correlationId);
 
+    /**
+     * @brief Callback receiving a watched response.
+     */
+    using ResponseCallback = std::function<void(Message &&)>;
+
+    /**
+     * @brief Hands a response to a callback instead of storing it for TryGetResponse().
+     * @param correlationId The correlation ID to watch.
+     * @param callback Invoked once, immediately if the response already arrived, otherwise
+     *                 from ProcessMessages(). It runs under the response lock and must not
+     *                 call back into the MessageBus.
+     */
+    void WatchResponse(const std::string &correlationId, ResponseCallback callback);
+
+    /**
+     * @brief Removes a response callback that has not fired yet.
+     * A response arriving later for this ID is dropped rather than stored.
+     * @param correlationId The watched correlation ID.
+     * @note Once this returns the callback is not running and will not be invoked.
+     */
+    void UnwatchResponse(const std::string &correlationId);
+
 private:
     /**
      * @brief Represents a handler entry with context lifetime tracking.
@@ -320,6 +350,34 @@ private:
             : context(std::move(ctx)), handler(std::move(h)), generation(gen) {}
     };
 
+    using HandlerList = std::vector<HandlerEntry>;
+
+    /**
+     * @brief Immutable snapshot of all registered handlers.
+     *
+     * Published with a single atomic store and never modified afterwards.
+     * Writers copy the current snapshot, replace the affected handler list and
+     * publish the copy; lists that did not change are shared between snapshots.
+     */
+    struct HandlerTable {
+        // contextName -> messageType -> handlers
+        std::unordered_map<std::string, std::unordered_map<std::string, std::shared_ptr<const HandlerList>>> byContext;
+        // messageType -> (contextName, handlers), used for broadcasts
+        std::unordered_map<std::string, std::vector<std::pair<std::string, std::shared_ptr<const HandlerList>>>> byType;
+    };
+
+    /**
+     * @brief Appends a handler entry and publishes a new snapshot.
+     * @note Caller must hold m_HandlersMutex.
+     */
+    void AddHandlerEntry(const std::string &contextName, const std::string &messageType, HandlerEntry entry);
+
+    /**
+     * @brief Rebuilds the broadcast index of a table and publishes it.
+     * @note Caller must hold m_HandlersMutex.
+     */
+    void PublishHandlers(std::shared_ptr<HandlerTable> table);
+
     /**
      * @brief Delivers a message to its target context(s).
      * @param message The message to deliver.
@@ -336,13 +394,6 @@ private:
                         const std::vector<HandlerEntry> &handlerEntries,
                         const Message &message);
 
-    using SerializedTable = std::unordered_map<std::string, Message::SerializedValue>;
-    using SerializedArray = std::vector<std::pair<size_t, Message::SerializedValue>>;
-
-    static SerializedTable SerializeTable(const sol::table &table);
-    static sol::table DeserializeTable(sol::state_view lua, const SerializedTable &data);
-    static sol::table DeserializeArray(sol::state_view lua, const SerializedArray &data);
-
     /**
      * @brief Enqueues a message with overflow handling.
      * @param message The message to enqueue.
@@ -370,6 +421,20 @@ private:
      */
     void NotifyResponse(const Message &response);
 
+    /**
+     * @brief Drops stored responses nobody claimed and forgets old abandoned IDs.
+     * Runs at most once a second.
+     */
+    void ExpireResponses();
+
+    // Unclaimed responses and abandoned IDs are kept this long
+    static constexpr std::chrono::seconds kResponseTtl{30};
+
+    struct PendingResponse {
+        Message message;
+        std::chrono::steady_clock::time_point arrivedAt;
+    };
+
     // Core references
     TASEngine *m_Engine;
 
@@ -380,7 +445,8 @@ private:
     // ===============================
     // MessageBus uses three mutexes to protect different subsystems:
     // 1. m_QueueMutex: Protects message queue operations
-    // 2. m_HandlersMutex: Protects handler registration/removal
+    // 2. m_HandlersMutex: Serializes handler registration/removal (delivery reads
+    //    the published snapshot without locking)
     // 3. m_ResponseMutex: Protects request/response tracking
     //
     // LOCK HIERARCHY (always acquire in this order to prevent deadlock):
@@ -399,7 +465,7 @@ private:
     //   ProcessMessages() {
     //     1. Lock m_QueueMutex, copy messages, unlock
     //     2. For each message:
-    //        a. Lock m_HandlersMutex, copy handlers, unlock
+    //        a. Load the handler snapshot (one atomic load, no copy)
     //        b. Invoke handlers WITHOUT holding any locks
     //        c. Handlers may safely call SendMessage/SendResponse
     //   }
@@ -409,18 +475,25 @@ private:
     // Priority support is always enabled with lock-free queue
     LockFreeMPSCQueue<Message, 15> m_MessageQueue;
 
+    // Reused by ProcessMessages() (consumer thread only)
+    static constexpr size_t kProcessBatchSize = 64;
+    std::vector<Message> m_ProcessBatch;
+
     // Statistics
     std::atomic<size_t> m_DroppedMessageCount{0};
 
-    // Message handlers: contextName -> messageType -> HandlerEntries
+    // Message handlers (RCU-style snapshot, replaced under m_HandlersMutex)
     mutable std::mutex m_HandlersMutex;
-    std::unordered_map<std::string, std::unordered_map<std::string, std::vector<HandlerEntry>>> m_Handlers;
+    std::atomic<std::shared_ptr<const HandlerTable>> m_HandlerTable;
     uint64_t m_HandlerGeneration = 0; // Global generation counter for handler versioning
 
     // Request/Response tracking
     mutable std::mutex m_ResponseMutex;
     std::condition_variable m_ResponseCV;
-    std::unordered_map<std::string, Message> m_PendingResponses;
+    std::unordered_map<std::string, PendingResponse> m_PendingResponses;
+    std::unordered_map<std::string, ResponseCallback> m_ResponseWatchers;
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> m_AbandonedResponses; // Waiter gone
+    std::chrono::steady_clock::time_point m_NextResponseSweep;
     std::atomic<uint64_t> m_NextCorrelationId{1};
 
     // Initialization state
@@ -0,0 +1,477 @@
+#include "MessagePayload.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+}
+
+namespace {
+    enum class Tag : uint8_t {
+        Nil,
+        False,
+        True,
+        Number,
+        String,
+        StringRef,
+        Table,
+        Array,
+        NumberArray,
+        SparseArray,
+        BufferRef
+    };
+
+    // Nesting limit, also catches circular references
+    constexpr int kMaxDepth = 100;
+}
+
+// ============================================================================
+// Encoder
+// ============================================================================
+
+class MessagePayload::Encoder {
+public:
+    Encoder(lua_State *L, MessagePayload &payload) : L(L), m_Bytes(payload.m_Bytes), m_Buffers(payload.m_Buffers) {}
+
+    void Encode(int index, int depth) {
+        switch (lua_type(L, index)) {
+        case LUA_TNONE:
+        case LUA_TNIL:
+            PutTag(Tag::Nil);
+            break;
+        case LUA_TBOOLEAN:
+            PutTag(lua_toboolean(L, index) ? Tag::True : Tag::False);
+            break;
+        case LUA_TNUMBER:
+            PutTag(Tag::Number);
+            PutDouble(static_cast<double>(lua_tonumber(L, index)));
+            break;
+        case LUA_TSTRING: {
+            size_t length = 0;
+            const char *str = lua_tolstring(L, index, &length);
+            PutString(str, length);
+            break;
+        }
+        case LUA_TTABLE:
+            EncodeTable(index, depth);
+            break;
+        case LUA_TFUNCTION:
+            throw std::runtime_error("MessageBus: Functions cannot be serialized in messages");
+        case LUA_TUSERDATA:
+        case LUA_TLIGHTUSERDATA: {
+            // SharedBuffer userdata travels by reference
+            sol::stack_object obj(L, index);
+            if (obj.is<std::shared_ptr<SharedBuffer>>()) {
+                PutTag(Tag::BufferRef);
+                PutVarint(m_Buffers.size());
+                m_Buffers.push_back(obj.as<std::shared_ptr<SharedBuffer>>());
+                break;
+            }
+            throw std::runtime_error("MessageBus: Userdata cannot be serialized in messages (use SharedBuffer for large data)");
+        }
+        case LUA_TTHREAD:
+            throw std::runtime_error("MessageBus: Threads cannot be serialized in messages");
+        default:
+            throw std::runtime_error("MessageBus: Unsupported Lua type for message payload");
+        }
+    }
+
+private:
+    void EncodeTable(int index, int depth) {
+        if (depth > kMaxDepth) {
+            throw std::runtime_error("MessageBus: Table serialization exceeded maximum depth (possible circular reference)");
+        }
+        if (!lua_checkstack(L, 3)) {
+            throw std::runtime_error("MessageBus: Lua stack exhausted while serializing message payload");
+        }
+
+        // First pass: classify keys and values
+        size_t count = 0;
+        bool hasStringKey = false;
+        bool hasNumericKey = false;
+        bool hasZeroKey = false;
+        bool allNumbers = true;
+        double maxKey = 0.0;
+
+        lua_pushnil(L);
+        while (lua_next(L, index) != 0) {
+            const int keyType = lua_type(L, -2);
+            if (keyType == LUA_TSTRING) {
+                hasStringKey = true;
+            } else if (keyType == LUA_TNUMBER) {
+                const double rawKey = lua_tonumber(L, -2);
+                if (!std::isfinite(rawKey) || std::floor(rawKey) != rawKey || rawKey < 0) {
+                    throw std::runtime_error(
+                        "MessageBus: Numeric table keys must be non-negative integers for message payloads.");
+                }
+                hasNumericKey = true;
+                hasZeroKey |= rawKey == 0;
+                maxKey = std::max(maxKey, rawKey);
+            } else {
+                throw std::runtime_error("MessageBus: Unsupported table key type for message payload.");
+            }
+
+            if (hasStringKey && hasNumericKey) {
+                throw std::runtime_error(
+                    "MessageBus: Mixed string and numeric keys are not supported in message payload tables.");
+            }
+
+            allNumbers &= lua_type(L, -1) == LUA_TNUMBER;
+            ++count;
+            lua_pop(L, 1);
+        }
+
+        if (!hasNumericKey) {
+            PutTag(Tag::Table);
+            PutVarint(count);
+
+            lua_pushnil(L);
+            while (lua_next(L, index) != 0) {
+                size_t length = 0;
+                const char *key = lua_tolstring(L, -2, &length);
+                PutString(key, length);
+                Encode(lua_gettop(L), depth + 1);
+                lua_pop(L, 1);
+            }
+            return;
+        }
+
+        // Distinct integer keys with no zero and max == count are exactly 1..count
+        if (!hasZeroKey && maxKey == static_cast<double>(count)) {
+            PutTag(allNumbers ? Tag::NumberArray : Tag::Array);
+            PutVarint(count);
+
+            for (size_t i = 1; i <= count; ++i) {
+                lua_rawgeti(L, index, static_cast<lua_Integer>(i));
+                if (allNumbers) {
+                    PutDouble(static_cast<double>(lua_tonumber(L, -1)));
+                } else {
+                    Encode(lua_gettop(L), depth + 1);
+                }
+                lua_pop(L, 1);
+            }
+            return;
+        }
+
+        // Sparse array: keys are written in ascending order
+        std::vector<lua_Integer> keys;
+        keys.reserve(count);
+        lua_pushnil(L);
+        while (lua_next(L, index) != 0) {
+            keys.push_back(static_cast<lua_Integer>(lua_tonumber(L, -2)));
+            lua_pop(L, 1);
+        }
+        std::sort(keys.begin(), keys.end());
+
+        PutTag(Tag::SparseArray);
+        PutVarint(count);
+        for (lua_Integer key : keys) {
+            PutVarint(static_cast<uint64_t>(key));
+            lua_rawgeti(L, index, key);
+            Encode(lua_gettop(L), depth + 1);
+            lua_pop(L, 1);
+        }
+    }
+
+    void PutTag(Tag tag) {
+        m_Bytes.push_back(static_cast<uint8_t>(tag));
+    }
+
+    void PutVarint(uint64_t value) {
+        while (value >= 0x80) {
+            m_Bytes.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        m_Bytes.push_back(static_cast<uint8_t>(value));
+    }
+
+    void PutDouble(double value) {
+        const size_t offset = m_Bytes.size();
+        m_Bytes.resize(offset + sizeof(double));
+        std::memcpy(m_Bytes.data() + offset, &value, sizeof(double));
+    }
+
+    void PutString(const char *str, size_t length) {
+        // Lua strings stay alive while the value is being encoded, so views into them are safe
+        auto [it, inserted] = m_Strings.try_emplace(std::string_view(str, length), m_NextStringId);
+        if (!inserted) {
+            PutTag(Tag::StringRef);
+            PutVarint(it->second);
+            return;
+        }
+
+        ++m_NextStringId;
+        PutTag(Tag::String);
+        PutVarint(length);
+        m_Bytes.insert(m_Bytes.end(), str, str + length);
+    }
+
+    lua_State *L;
+    std::vector<uint8_t> &m_Bytes;
+    std::vector<std::shared_ptr<SharedBuffer>> &m_Buffers;
+    std::unordered_map<std::string_view, uint32_t> m_Strings;
+    uint32_t m_NextStringId = 0;
+};
+
+// ============================================================================
+// Decoder
+// ============================================================================
+
+class MessagePayload::Decoder {
+public:
+    Decoder(lua_State *L, const MessagePayload &payload)
+        : L(L),
+          m_Pos(payload.m_Bytes.data()),
+          m_End(payload.m_Bytes.data() + payload.m_Bytes.size()),
+          m_Buffers(payload.m_Buffers) {}
+
+    // Pushes the next value onto the Lua stack
+    void Decode() {
+        const Tag tag = GetTag();
+        switch (tag) {
+        case Tag::Nil:
+            lua_pushnil(L);
+            break;
+        case Tag::False:
+            lua_pushboolean(L, 0);
+            break;
+        case Tag::True:
+            lua_pushboolean(L, 1);
+            break;
+        case Tag::Number:
+            lua_pushnumber(L, static_cast<lua_Number>(GetDouble()));
+            break;
+        case Tag::String:
+        case Tag::StringRef: {
+            const std::string_view str = GetString(tag);
+            lua_pushlstring(L, str.data(), str.size());
+            break;
+        }
+        case Tag::Table: {
+            const int count = GetCount();
+            CheckStack();
+            lua_createtable(L, 0, count);
+            for (int i = 0; i < count; ++i) {
+                const std::string_view key = GetString(GetTag());
+                lua_pushlstring(L, key.data(), key.size());
+                Decode();
+                lua_rawset(L, -3);
+            }
+            break;
+        }
+        case Tag::Array: {
+            const int count = GetCount();
+            CheckStack();
+            lua_createtable(L, count, 0);
+            for (int i = 1; i <= count; ++i) {
+                Decode();
+                lua_rawseti(L, -2, i);
+            }
+            break;
+        }
+        case Tag::NumberArray: {
+            const int count = GetCount();
+            Need(static_cast<size_t>(count) * sizeof(double));
+            CheckStack();
+            lua_createtable(L, count, 0);
+            for (int i = 1; i <= count; ++i) {
+                lua_pushnumber(L, static_cast<lua_Number>(GetDouble()));
+                lua_rawseti(L, -2, i);
+            }
+            break;
+        }
+        case Tag::SparseArray: {
+            const int count = GetCount();
+            CheckStack();
+            lua_createtable(L, 0, count);
+            for (int i = 0; i < count; ++i) {
+                const auto key = static_cast<lua_Integer>(GetVarint());
+                Decode();
+                lua_rawseti(L, -2, key);
+            }
+            break;
+        }
+        case Tag::BufferRef: {
+            const uint64_t slot = GetVarint();
+            if (slot >= m_Buffers.size()) {
+                throw std::runtime_error("MessagePayload: Invalid shared buffer reference");
+            }
+            sol::stack::push(L, m_Buffers[static_cast<size_t>(slot)]);
+            break;
+        }
+        default:
+            throw std::runtime_error("MessagePayload: Invalid value tag");
+        }
+    }
+
+private:
+    void Need(size_t size) const {
+        if (static_cast<size_t>(m_End - m_Pos) < size) {
+            throw std::runtime_error("MessagePayload: Truncated payload");
+        }
+    }
+
+    void CheckStack() const {
+        if (!lua_checkstack(L, 3)) {
+            throw std::runtime_error("MessagePayload: Lua stack exhausted while decoding payload");
+        }
+    }
+
+    Tag GetTag() {
+        Need(1);
+        return static_cast<Tag>(*m_Pos++);
+    }
+
+    uint64_t GetVarint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            Need(1);
+            const uint8_t byte = *m_Pos++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw std::runtime_error("MessagePayload: Malformed varint");
+    }
+
+    int GetCount() {
+        const uint64_t count = GetVarint();
+        // Every element takes at least one byte, which also bounds the table preallocation
+        Need(static_cast<size_t>(std::min<uint64_t>(count, static_cast<uint64_t>(m_End - m_Pos) + 1)));
+        return static_cast<int>(count);
+    }
+
+    double GetDouble() {
+        Need(sizeof(double));
+        double value;
+        std::memcpy(&value, m_Pos, sizeof(double));
+        m_Pos += sizeof(double);
+        return value;
+    }
+
+    std::string_view GetString(Tag tag) {
+        if (tag == Tag::StringRef) {
+            const uint64_t id = GetVarint();
+            if (id >= m_Strings.size()) {
+                throw std::runtime_error("MessagePayload: Invalid string reference");
+            }
+            return m_Strings[static_cast<size_t>(id)];
+        }
+        if (tag != Tag::String) {
+            throw std::runtime_error("MessagePayload: Expected a string");
+        }
+
+        const uint64_t length = GetVarint();
+        Need(static_cast<size_t>(length));
+        std::string_view str(reinterpret_cast<const char *>(m_Pos), static_cast<size_t>(length));
+        m_Pos += length;
+        m_Strings.push_back(str);
+        return str;
+    }
+
+    lua_State *L;
+    const uint8_t *m_Pos;
+    const uint8_t *m_End;
+    const std::vector<std::shared_ptr<SharedBuffer>> &m_Buffers;
+    std::vector<std::string_view> m_Strings;
+};
+
+// ============================================================================
+// MessagePayload
+// ============================================================================
+
+MessagePayload MessagePayload::FromLuaObject(const sol::object &obj) {
+    MessagePayload payload;
+    lua_State *L = obj.lua_state();
+    if (!L || !obj.valid()) {
+        payload.m_Bytes.push_back(static_cast<uint8_t>(Tag::Nil));
+        return payload;
+    }
+
+    payload.m_Bytes.reserve(64);
+
+    const int top = lua_gettop(L);
+    obj.push(L);
+    try {
+        Encoder encoder(L, payload);
+        encoder.Encode(lua_gettop(L), 0);
+    } catch (...) {
+        lua_settop(L, top);
+        throw;
+    }
+    lua_settop(L, top);
+
+    return payload;
+}
+
+MessagePayload MessagePayload::FromSharedBuffer(std::shared_ptr<SharedBuffer> buffer) {
+    if (!buffer) {
+        throw std::invalid_argument("MessageBus: Cannot create payload from null SharedBuffer");
+    }
+
+    MessagePayload payload;
+    payload.m_Bytes = {static_cast<uint8_t>(Tag::BufferRef), 0};
+    payload.m_Buffers.push_back(std::move(buffer));
+    return payload;
+}
+
+sol::object MessagePayload::ToLuaObject(sol::state_view lua) const {
+    if (m_Bytes.empty()) {
+        return sol::make_object(lua, sol::nil);
+    }
+
+    lua_State *L = lua.lua_state();
+    const int top = lua_gettop(L);
+    try {
+        Decoder decoder(L, *this);
+        decoder.Decode();
+    } catch (...) {
+        lua_settop(L, top);
+        throw;
+    }
+
+    sol::object result(L, -1);
+    lua_settop(L, top);
+    return result;
+}
+
+MessagePayload::Type MessagePayload::GetType() const {
+    if (m_Bytes.empty()) {
+        return Type::Nil;
+    }
+
+    switch (static_cast<Tag>(m_Bytes[0])) {
+    case Tag::False:
+    case Tag::True:
+        return Type::Boolean;
+    case Tag::Number:
+        return Type::Number;
+    case Tag::String:
+    case Tag::StringRef:
+        return Type::String;
+    case Tag::Array:
+    case Tag::NumberArray:
+    case Tag::SparseArray:
+        return Type::Array;
+    case Tag::Table:
+        return Type::Table;
+    case Tag::BufferRef:
+        return Type::SharedBufferRef;
+    default:
+        return Type::Nil;
+    }
+}
+
+std::shared_ptr<SharedBuffer> MessagePayload::AsSharedBuffer() const {
+    if (GetType() != Type::SharedBufferRef) {
+        throw std::runtime_error("MessageBus: Payload is not a SharedBufferRef");
+    }
+    return m_Buffers.front();
+}
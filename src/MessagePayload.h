@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <sol/sol.hpp>
+
+#include "SharedBuffer.h"
+
+/**
+ * @class MessagePayload
+ * @brief Flat binary encoding of a Lua value sent through the MessageBus.
+ *
+ * The whole value lives in one contiguous byte buffer as a stream of tagged
+ * records, so encoding a message costs a single growing allocation and the
+ * payload size is known without walking the value again.
+ *
+ * Layout (all counts and ids are LEB128 varints):
+ *
+ *   Nil | False | True
+ *   Number       double (8 bytes)
+ *   String       length, bytes          (defines the next string id)
+ *   StringRef    id                     (repeats an earlier string)
+ *   Table        count, { key, value }  (keys are String / StringRef)
+ *   Array        count, value...        (dense 1..count)
+ *   NumberArray  count, double...       (dense 1..count, numbers only)
+ *   SparseArray  count, { index, value } (non-negative integer keys, ascending)
+ *   BufferRef    slot                   (index into the SharedBuffer side table)
+ *
+ * Strings are interned per payload, so table keys repeated across an array of
+ * records are stored once. SharedBuffer values are kept as references in a side
+ * table and are never copied.
+ *
+ * Decoding pushes values straight onto the target Lua state through the C API,
+ * without building intermediate C++ objects.
+ */
+class MessagePayload {
+public:
+    /**
+     * @brief Type of the top-level value.
+     */
+    enum class Type : uint8_t {
+        Nil,
+        Boolean,
+        Number,
+        String,
+        Array,
+        Table,
+        SharedBufferRef // Reference to shared buffer (zero-copy)
+    };
+
+    MessagePayload() = default;
+
+    /**
+     * @brief Encodes a Lua value.
+     * @param obj The value to encode.
+     * @return The encoded payload.
+     * @throws std::runtime_error if the value contains functions, threads, userdata other
+     *         than SharedBuffer, mixed or unsupported table keys, or nests too deeply.
+     */
+    static MessagePayload FromLuaObject(const sol::object &obj);
+
+    /**
+     * @brief Creates a payload referencing a shared buffer (zero-copy).
+     * @param buffer The buffer to reference.
+     * @return The payload.
+     */
+    static MessagePayload FromSharedBuffer(std::shared_ptr<SharedBuffer> buffer);
+
+    /**
+     * @brief Decodes the payload into a Lua state.
+     * @param lua The target Lua state.
+     * @return The decoded value.
+     */
+    sol::object ToLuaObject(sol::state_view lua) const;
+
+    /**
+     * @brief Gets the type of the top-level value.
+     * @return The value type.
+     */
+    Type GetType() const;
+
+    /**
+     * @brief Gets the referenced shared buffer.
+     * @return The buffer.
+     * @throws std::runtime_error if the payload is not a SharedBufferRef.
+     */
+    std::shared_ptr<SharedBuffer> AsSharedBuffer() const;
+
+    /**
+     * @brief Gets the encoded size in bytes (shared buffers count as a pointer).
+     * @return The payload size.
+     */
+    size_t EstimateSize() const {
+        return m_Bytes.size() + m_Buffers.size() * sizeof(std::shared_ptr<SharedBuffer>);
+    }
+
+    /**
+     * @brief Gets the encoded bytes.
+     * @return The byte buffer.
+     */
+    const std::vector<uint8_t> &GetBytes() const { return m_Bytes; }
+
+private:
+    class Encoder;
+    class Decoder;
+
+    std::vector<uint8_t> m_Bytes;
+    std::vector<std::shared_ptr<SharedBuffer>> m_Buffers;
+};
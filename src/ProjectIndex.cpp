@@ -0,0 +1,247 @@
+#include "ProjectIndex.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char kIndexMagic[4] = {'T', 'P', 'I', 'X'};
+    constexpr uint32_t kIndexVersion = 1;
+
+    class IndexWriter {
+    public:
+        template <typename T>
+        void Pod(const T &value) {
+            m_Buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        void String(const std::string &value) {
+            Pod(static_cast<uint32_t>(value.size()));
+            m_Buffer.append(value);
+        }
+
+        const std::string &GetBuffer() const { return m_Buffer; }
+
+    private:
+        std::string m_Buffer;
+    };
+
+    class IndexReader {
+    public:
+        explicit IndexReader(const std::string &data) : m_Data(data) {}
+
+        template <typename T>
+        bool Pod(T &value) {
+            if (m_Data.size() - m_Offset < sizeof(T)) {
+                return false;
+            }
+            std::memcpy(&value, m_Data.data() + m_Offset, sizeof(T));
+            m_Offset += sizeof(T);
+            return true;
+        }
+
+        bool String(std::string &value) {
+            uint32_t size = 0;
+            if (!Pod(size) || m_Data.size() - m_Offset < size) {
+                return false;
+            }
+            value.assign(m_Data.data() + m_Offset, size);
+            m_Offset += size;
+            return true;
+        }
+
+        bool AtEnd() const { return m_Offset == m_Data.size(); }
+
+    private:
+        const std::string &m_Data;
+        size_t m_Offset = 0;
+    };
+
+    enum InfoFlags : uint8_t {
+        kFlagValid = 1 << 0,
+        kFlagZip = 1 << 1,
+        kFlagConstantDeltaTime = 1 << 2,
+    };
+
+    void WriteInfo(IndexWriter &out, const TASProjectInfo &info) {
+        out.Pod(static_cast<uint8_t>(info.type));
+        out.Pod(static_cast<uint8_t>(info.scope));
+        out.String(info.name);
+        out.String(info.author);
+        out.String(info.description);
+        out.String(info.entryScript);
+        out.String(info.targetLevel);
+        out.String(info.executionTrigger);
+        out.Pod(info.updateRate);
+
+        uint8_t flags = 0;
+        if (info.isValid) flags |= kFlagValid;
+        if (info.isZipProject) flags |= kFlagZip;
+        if (info.hasConstantDeltaTime) flags |= kFlagConstantDeltaTime;
+        out.Pod(flags);
+
+        out.Pod(static_cast<uint32_t>(info.manifestFields.size()));
+        for (const auto &field : info.manifestFields) {
+            out.String(field.key);
+            out.Pod(static_cast<uint8_t>(field.type));
+            out.String(field.text);
+            out.Pod(field.number);
+        }
+    }
+
+    bool ReadInfo(IndexReader &in, TASProjectInfo &info) {
+        uint8_t type = 0;
+        uint8_t scope = 0;
+        uint8_t flags = 0;
+        uint32_t fieldCount = 0;
+        if (!in.Pod(type) || !in.Pod(scope) ||
+            !in.String(info.name) || !in.String(info.author) || !in.String(info.description) ||
+            !in.String(info.entryScript) || !in.String(info.targetLevel) || !in.String(info.executionTrigger) ||
+            !in.Pod(info.updateRate) || !in.Pod(flags) || !in.Pod(fieldCount)) {
+            return false;
+        }
+        if (type > static_cast<uint8_t>(ProjectType::Mixed) || scope > static_cast<uint8_t>(ProjectScope::Global)) {
+            return false;
+        }
+
+        info.type = static_cast<ProjectType>(type);
+        info.scope = static_cast<ProjectScope>(scope);
+        info.isValid = (flags & kFlagValid) != 0;
+        info.isZipProject = (flags & kFlagZip) != 0;
+        info.hasConstantDeltaTime = (flags & kFlagConstantDeltaTime) != 0;
+
+        info.manifestFields.clear();
+        for (uint32_t i = 0; i < fieldCount; ++i) {
+            ManifestField field;
+            uint8_t fieldType = 0;
+            if (!in.String(field.key) || !in.Pod(fieldType) || !in.String(field.text) || !in.Pod(field.number) ||
+                fieldType > static_cast<uint8_t>(ManifestField::Type::Boolean)) {
+                return false;
+            }
+            field.type = static_cast<ManifestField::Type>(fieldType);
+            info.manifestFields.push_back(std::move(field));
+        }
+        return true;
+    }
+}
+
+bool ProjectIndex::ReadStamp(const std::string &filePath, Stamp &stamp) {
+    std::error_code ec;
+    const uint64_t size = fs::file_size(filePath, ec);
+    if (ec) {
+        return false;
+    }
+    const auto mtime = fs::last_write_time(filePath, ec);
+    if (ec) {
+        return false;
+    }
+
+    stamp.size = size;
+    stamp.mtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+    return true;
+}
+
+const ProjectIndex::Entry *ProjectIndex::Find(const std::string &path, SourceKind kind, const Stamp &stamp) const {
+    auto it = m_ByPath.find(path);
+    if (it == m_ByPath.end()) {
+        return nullptr;
+    }
+
+    const Entry &entry = m_Entries[it->second];
+    return entry.kind == kind && entry.stamp == stamp ? &entry : nullptr;
+}
+
+void ProjectIndex::Add(Entry entry) {
+    auto it = m_ByPath.find(entry.path);
+    if (it != m_ByPath.end()) {
+        m_Entries[it->second] = std::move(entry);
+        return;
+    }
+
+    m_ByPath.emplace(entry.path, m_Entries.size());
+    m_Entries.push_back(std::move(entry));
+}
+
+void ProjectIndex::Clear() {
+    m_Entries.clear();
+    m_ByPath.clear();
+}
+
+bool ProjectIndex::Load(const std::string &filePath) {
+    Clear();
+
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    IndexReader in(data);
+    char magic[4] = {};
+    uint32_t version = 0;
+    uint32_t count = 0;
+    if (!in.Pod(magic) || std::memcmp(magic, kIndexMagic, sizeof(kIndexMagic)) != 0 ||
+        !in.Pod(version) || version != kIndexVersion || !in.Pod(count)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        Entry entry;
+        uint8_t kind = 0;
+        uint8_t hasProject = 0;
+        if (!in.String(entry.path) || !in.Pod(kind) || kind > static_cast<uint8_t>(SourceKind::Record) ||
+            !in.Pod(entry.stamp.size) || !in.Pod(entry.stamp.mtime) || !in.Pod(hasProject) ||
+            !ReadInfo(in, entry.info)) {
+            Clear();
+            return false;
+        }
+        entry.kind = static_cast<SourceKind>(kind);
+        entry.hasProject = hasProject != 0;
+        Add(std::move(entry));
+    }
+
+    if (!in.AtEnd()) {
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+bool ProjectIndex::Save(const std::string &filePath) const {
+    IndexWriter out;
+    out.Pod(kIndexMagic);
+    out.Pod(kIndexVersion);
+    out.Pod(static_cast<uint32_t>(m_Entries.size()));
+    for (const auto &entry : m_Entries) {
+        out.String(entry.path);
+        out.Pod(static_cast<uint8_t>(entry.kind));
+        out.Pod(entry.stamp.size);
+        out.Pod(entry.stamp.mtime);
+        out.Pod(static_cast<uint8_t>(entry.hasProject ? 1 : 0));
+        WriteInfo(out, entry.info);
+    }
+
+    const std::string tempPath = filePath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(out.GetBuffer().data(), static_cast<std::streamsize>(out.GetBuffer().size()));
+        if (!file) {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, filePath, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "TASProject.h"
+
+/**
+ * @class ProjectIndex
+ * @brief Persistent record of the project sources found under the TAS root.
+ *
+ * Each entry remembers the size and modification time of a project source
+ * (the manifest of a directory project, the zip file, or the .tas file)
+ * together with the project info parsed from it. A refresh only parses the
+ * sources whose stamp changed and copies everything else from the previous
+ * index. Sources that failed to load are remembered too, so a broken zip is
+ * not reopened on every refresh.
+ *
+ * Thread Safety:
+ * - None; an index is built by one scan and then handed over as a whole
+ */
+class ProjectIndex {
+public:
+    enum class SourceKind : uint8_t {
+        Directory, // Directory project, stamped by its manifest.lua
+        Zip,       // Zip project, stamped by the archive
+        Record     // .tas record file
+    };
+
+    struct Stamp {
+        uint64_t size = 0;
+        int64_t mtime = 0;
+
+        bool operator==(const Stamp &other) const = default;
+    };
+
+    struct Entry {
+        std::string path; // Normalized project path
+        SourceKind kind = SourceKind::Directory;
+        Stamp stamp;
+        bool hasProject = false; // False if the source did not load as a valid project
+        TASProjectInfo info;
+    };
+
+    /**
+     * @brief Reads the stamp of a file.
+     * @param filePath The file to stat.
+     * @param stamp Receives the size and modification time.
+     * @return False if the file cannot be stat'ed.
+     */
+    static bool ReadStamp(const std::string &filePath, Stamp &stamp);
+
+    /**
+     * @brief Finds an up-to-date entry.
+     * @param path The normalized project path.
+     * @param kind The source kind.
+     * @param stamp The current stamp of the source.
+     * @return The entry, or nullptr if unknown or stale.
+     */
+    const Entry *Find(const std::string &path, SourceKind kind, const Stamp &stamp) const;
+
+    /**
+     * @brief Adds an entry, replacing any entry with the same path.
+     */
+    void Add(Entry entry);
+
+    const std::vector<Entry> &GetEntries() const { return m_Entries; }
+    size_t GetSize() const { return m_Entries.size(); }
+    void Clear();
+
+    /**
+     * @brief Loads an index file written by Save().
+     * @param filePath The index file.
+     * @return False if the file is missing, from another format version, or damaged;
+     *         the index is left empty in that case.
+     */
+    bool Load(const std::string &filePath);
+
+    /**
+     * @brief Writes the index to a file (through a temporary file and a rename).
+     * @param filePath The index file.
+     * @return True on success.
+     */
+    bool Save(const std::string &filePath) const;
+
+private:
+    std::vector<Entry> m_Entries;
+    std::unordered_map<std::string, size_t> m_ByPath;
+};
@@ -9,19 +9,22 @@
 #include <zip.h>
 
 #include "TASEngine.h"
+#include "LuaBytecodeCache.h"
 #include "Logger.h"
 
 namespace fs = std::filesystem;
 
+namespace {
+    // Compiled chunks beyond this budget are evicted least recently used first
+    constexpr uint64_t kBytecodeCacheBudget = 64ull * 1024 * 1024;
+}
+
 ProjectManager::ProjectManager(TASEngine *engine)
     : m_Engine(engine) {
     if (!m_Engine) {
         throw std::runtime_error("ProjectManager requires a valid TASEngine instance.");
     }
 
-    // Initialize dedicated Lua state for manifest parsing
-    m_ManifestState.open_libraries(sol::lib::base, sol::lib::string, sol::lib::table, sol::lib::math);
-
     // Define the root directory for all TAS projects.
     m_TASRootPath = m_Engine->GetPath();
 
@@ -36,63 +39,147 @@ ProjectManager::ProjectManager(TASEngine *engine)
         fs::create_directories(m_TempDir);
     }
 
+    // Compiled Lua chunks, keyed by source content
+    m_BytecodeCache = std::make_shared<LuaBytecodeCache>(m_TASRootPath + "cache\\bytecode\\");
+    m_BytecodeCache->Prune(kBytecodeCacheBudget);
+
+    // Projects parsed by previous sessions
+    m_IndexPath = m_TASRootPath + "cache\\projects.idx";
+    if (!m_Index.Load(m_IndexPath)) {
+        Log::Info("No usable project index, all projects will be parsed.");
+    }
+
+    CleanupTempDirectories();
     RefreshProjects();
 }
 
 ProjectManager::~ProjectManager() {
+    if (m_ScanThread.joinable()) {
+        m_ScanThread.join();
+    }
     CleanupTempDirectories();
 }
 
 void ProjectManager::RefreshProjects() {
-    // Clean up previous project temp directories
-    CleanupTempDirectories();
+    // A synchronous refresh supersedes any background scan
+    if (m_ScanThread.joinable()) {
+        m_ScanThread.join();
+        m_ScanResult.reset();
+        m_RescanRequested = false;
+    }
 
-    m_Projects.clear();
-    m_ProjectTempDirectories.clear();
-    m_CurrentProject = nullptr;
+    size_t parsedCount = 0;
+    ProjectIndex index = ScanProjects(m_Index, parsedCount);
+    PublishIndex(std::move(index), parsedCount);
+}
+
+void ProjectManager::RefreshProjectsAsync() {
+    if (m_ScanThread.joinable()) {
+        if (!m_ScanDone.load(std::memory_order_acquire)) {
+            m_RescanRequested = true;
+            return;
+        }
+        PollRefresh();
+        if (m_ScanThread.joinable()) {
+            return; // PollRefresh() started the requested rescan
+        }
+    }
+
+    m_ScanDone.store(false, std::memory_order_relaxed);
+    m_ScanThread = std::thread([this, previous = m_Index]() {
+        try {
+            size_t parsedCount = 0;
+            m_ScanResult = std::make_unique<ProjectIndex>(ScanProjects(previous, parsedCount));
+            m_ScanParsedCount = parsedCount;
+        } catch (const std::exception &e) {
+            Log::Error("Exception during background project scan: %s", e.what());
+        }
+        m_ScanDone.store(true, std::memory_order_release);
+    });
+}
+
+bool ProjectManager::PollRefresh() {
+    ReleaseRetiredProjects();
+
+    if (!m_ScanThread.joinable() || !m_ScanDone.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    m_ScanThread.join();
+    std::unique_ptr<ProjectIndex> result = std::move(m_ScanResult);
+    if (result) {
+        PublishIndex(std::move(*result), m_ScanParsedCount);
+    }
+
+    if (m_RescanRequested) {
+        m_RescanRequested = false;
+        RefreshProjectsAsync();
+    }
+    return result != nullptr;
+}
 
+ProjectIndex ProjectManager::ScanProjects(const ProjectIndex &previous, size_t &parsedCount) {
     Log::Info("Scanning for TAS projects in: %s", m_TASRootPath.c_str());
 
-    int directoryProjects = 0;
-    int zipProjects = 0;
-    int recordProjects = 0;
+    // Manifests are parsed in a state owned by this scan, so scans can run off the game thread
+    sol::state manifestState;
+    manifestState.open_libraries(sol::lib::base, sol::lib::string, sol::lib::table, sol::lib::math);
+
+    ProjectIndex index;
+    parsedCount = 0;
+
+    auto addSource = [&](const std::string &path, ProjectIndex::SourceKind kind,
+                         const ProjectIndex::Stamp &stamp, auto &&load) {
+        if (const auto *known = previous.Find(path, kind, stamp)) {
+            index.Add(*known);
+            return;
+        }
+
+        ProjectIndex::Entry entry;
+        entry.path = path;
+        entry.kind = kind;
+        entry.stamp = stamp;
+
+        std::unique_ptr<TASProject> project = load();
+        if (project && project->IsValid()) {
+            entry.hasProject = true;
+            entry.info = project->GetInfo();
+        }
+        index.Add(std::move(entry));
+        ++parsedCount;
+    };
 
     try {
         for (const auto &entry : fs::directory_iterator(m_TASRootPath)) {
+            ProjectIndex::Stamp stamp;
             if (entry.is_directory()) {
-                // Traditional directory-based script project
+                // Traditional directory-based script project, stamped by its manifest
                 std::string projectPath = NormalizePath(entry.path().string());
                 std::string manifestPath = projectPath + "\\manifest.lua";
-                if (fs::exists(manifestPath) && ValidateProjectStructure(projectPath)) {
-                    auto project = LoadDirectoryProject(projectPath);
-                    if (project && project->IsValid()) {
-                        m_Projects.push_back(std::move(project));
-                        directoryProjects++;
-                    }
+                if (ProjectIndex::ReadStamp(manifestPath, stamp) && ValidateProjectStructure(projectPath)) {
+                    addSource(projectPath, ProjectIndex::SourceKind::Directory, stamp, [&] {
+                        return LoadDirectoryProject(manifestState, projectPath);
+                    });
                 }
             } else if (entry.is_regular_file()) {
                 std::string filePath = NormalizePath(entry.path().string());
                 std::string extension = entry.path().extension().string();
                 std::transform(extension.begin(), extension.end(), extension.begin(), tolower);
 
-                if (extension == ".zip") {
+                if (extension == ".zip" && ProjectIndex::ReadStamp(filePath, stamp)) {
                     // Zip-based script project
-                    if (ValidateZipProject(filePath)) {
-                        auto project = LoadZipProject(filePath);
-                        if (project && project->IsValid()) {
-                            m_Projects.push_back(std::move(project));
-                            zipProjects++;
+                    addSource(filePath, ProjectIndex::SourceKind::Zip, stamp, [&]() -> std::unique_ptr<TASProject> {
+                        if (!ValidateZipProject(filePath)) {
+                            Log::Warn("Invalid zip project structure: %s", filePath.c_str());
+                            return nullptr;
                         }
-                    } else {
-                        Log::Warn("Invalid zip project structure: %s", filePath.c_str());
-                    }
-                } else if (extension == ".tas") {
+                        return LoadZipProject(manifestState, filePath);
+                    });
+                } else if (extension == ".tas" && ProjectIndex::ReadStamp(filePath, stamp)) {
                     // Binary record project
-                    auto project = LoadRecordProject(filePath);
-                    if (project && project->IsValid()) {
-                        m_Projects.push_back(std::move(project));
-                        recordProjects++;
-                    }
+                    addSource(filePath, ProjectIndex::SourceKind::Record, stamp, [&] {
+                        return LoadRecordProject(filePath);
+                    });
                 }
             }
         }
@@ -100,18 +187,84 @@ void ProjectManager::RefreshProjects() {
         Log::Error("Filesystem error while scanning for projects: %s", e.what());
     }
 
+    Log::Info("Scanned %zu project sources (%zu parsed, %zu unchanged).",
+              index.GetSize(), parsedCount, index.GetSize() - parsedCount);
+    return index;
+}
+
+void ProjectManager::PublishIndex(ProjectIndex index, size_t parsedCount) {
+    const bool indexChanged = parsedCount > 0 || index.GetSize() != m_Index.GetSize();
+
+    // Current projects by path, so unchanged ones keep their object (and their extraction)
+    std::unordered_map<std::string, std::unique_ptr<TASProject>> previous;
+    for (auto &project : m_Projects) {
+        std::string path = project->GetPath();
+        previous.emplace(std::move(path), std::move(project));
+    }
+    m_Projects.clear();
+
+    int directoryProjects = 0;
+    int zipProjects = 0;
+    int recordProjects = 0;
+
+    for (const auto &entry : index.GetEntries()) {
+        if (!entry.hasProject) {
+            continue;
+        }
+
+        auto it = previous.find(entry.path);
+        if (it != previous.end() && it->second->GetInfo() == entry.info) {
+            m_Projects.push_back(std::move(it->second));
+            previous.erase(it);
+        } else {
+            m_Projects.push_back(std::make_unique<TASProject>(entry.path, entry.info));
+        }
+
+        switch (entry.kind) {
+        case ProjectIndex::SourceKind::Directory: directoryProjects++; break;
+        case ProjectIndex::SourceKind::Zip: zipProjects++; break;
+        case ProjectIndex::SourceKind::Record: recordProjects++; break;
+        }
+    }
+
+    // Projects that were removed or replaced. A running TAS may still point at one (the playback
+    // controller and script contexts hold raw pointers), so they are only released once idle.
+    for (auto &[path, project] : previous) {
+        m_RetiredProjects.push_back(std::move(project));
+    }
+    ReleaseRetiredProjects();
+
     // Sort projects alphabetically by name for consistent UI display.
     std::sort(m_Projects.begin(), m_Projects.end(), [](const auto &a, const auto &b) {
         return a->GetName() < b->GetName();
     });
 
+    m_Index = std::move(index);
+    if (indexChanged && !m_Index.Save(m_IndexPath)) {
+        Log::Warn("Could not save project index: %s", m_IndexPath.c_str());
+    }
+
     Log::Info("Found %d valid TAS projects (%d directories, %d zip files, %d record files).",
                                 static_cast<int>(m_Projects.size()), directoryProjects, zipProjects, recordProjects);
 }
 
-std::unique_ptr<TASProject> ProjectManager::LoadDirectoryProject(const std::string &projectPath) {
+void ProjectManager::ReleaseRetiredProjects() {
+    if (m_RetiredProjects.empty() || !m_Engine->IsIdle()) {
+        return;
+    }
+
+    for (auto &project : m_RetiredProjects) {
+        if (m_CurrentProject == project.get()) {
+            m_CurrentProject = nullptr;
+        }
+        CleanupProjectTempDirectory(project.get());
+    }
+    m_RetiredProjects.clear();
+}
+
+std::unique_ptr<TASProject> ProjectManager::LoadDirectoryProject(sol::state &lua, const std::string &projectPath) {
     std::string manifestPath = projectPath + "\\manifest.lua";
-    sol::table manifest_table = ParseManifestFile(manifestPath);
+    sol::table manifest_table = ParseManifestFile(lua, manifestPath);
 
     if (!manifest_table.valid()) {
         Log::Warn("Could not parse manifest for directory project at: %s", projectPath.c_str());
@@ -124,7 +277,7 @@ std::unique_ptr<TASProject> ProjectManager::LoadDirectoryProject(const std::stri
     return project;
 }
 
-std::unique_ptr<TASProject> ProjectManager::LoadZipProject(const std::string &zipPath) {
+std::unique_ptr<TASProject> ProjectManager::LoadZipProject(sol::state &lua, const std::string &zipPath) {
     // Read manifest from zip
     std::string manifestContent;
     if (!ReadFileFromZip(zipPath, "manifest.lua", manifestContent)) {
@@ -132,24 +285,9 @@ std::unique_ptr<TASProject> ProjectManager::LoadZipProject(const std::string &zi
         return nullptr;
     }
 
-    // Create temporary file for manifest
-    std::string tempManifest = m_TempDir + "temp_manifest_" + std::to_string(
-        std::chrono::steady_clock::now().time_since_epoch().count()) + ".lua";
-
     try {
-        std::ofstream tempFile(tempManifest);
-        if (!tempFile.is_open()) {
-            Log::Error("Could not create temporary manifest file: %s", tempManifest.c_str());
-            return nullptr;
-        }
-        tempFile << manifestContent;
-        tempFile.close();
-
-        // Parse the temporary manifest
-        sol::table manifest_table = ParseManifestFile(tempManifest);
-
-        // Clean up temporary file
-        fs::remove(tempManifest);
+        // Parse straight from memory; the stable chunk name lets the bytecode cache reuse it
+        sol::table manifest_table = ParseManifestSource(lua, manifestContent, "@" + zipPath + "\\manifest.lua");
 
         if (!manifest_table.valid()) {
             Log::Warn("Could not parse manifest for zip project: %s", zipPath.c_str());
@@ -161,10 +299,6 @@ std::unique_ptr<TASProject> ProjectManager::LoadZipProject(const std::string &zi
 
         return project;
     } catch (const std::exception &e) {
-        // Ensure cleanup even on exceptions
-        if (fs::exists(tempManifest)) {
-            fs::remove(tempManifest);
-        }
         Log::Error("Exception loading zip project %s: %s", zipPath.c_str(), e.what());
         return nullptr;
     }
@@ -623,31 +757,54 @@ bool ProjectManager::ValidateProjectStructure(const std::string &projectPath) {
         fs::is_regular_file(manifestPath) && fs::is_regular_file(mainScriptPath);
 }
 
-sol::table ProjectManager::ParseManifestFile(const std::string &path) {
+sol::table ProjectManager::ParseManifestFile(sol::state &lua, const std::string &path) {
+    try {
+        return RunManifestChunk(lua, m_BytecodeCache->LoadFile(lua, path), path);
+    } catch (const sol::error &e) {
+        Log::Error("Exception while parsing manifest '%s': %s", path.c_str(), e.what());
+        return sol::table();
+    }
+}
+
+sol::table ProjectManager::ParseManifestSource(sol::state &lua, const std::string &source,
+                                               const std::string &chunkName) {
     try {
-        sol::table envTable = m_ManifestState.create_table();
-        envTable[sol::metatable_key] = m_ManifestState.create_table_with(
-            sol::meta_method::index, m_ManifestState.globals()
-        );
+        return RunManifestChunk(lua, m_BytecodeCache->LoadBuffer(lua, source, chunkName), chunkName);
+    } catch (const sol::error &e) {
+        Log::Error("Exception while parsing manifest '%s': %s", chunkName.c_str(), e.what());
+        return sol::table();
+    }
+}
 
-        sol::environment env(m_ManifestState, envTable);
+sol::table ProjectManager::RunManifestChunk(sol::state &lua, sol::load_result chunk, const std::string &name) {
+    if (!chunk.valid()) {
+        sol::error err = chunk;
+        Log::Error("Error parsing manifest file '%s': %s", name.c_str(), err.what());
+        return sol::table();
+    }
 
-        sol::protected_function_result result = m_ManifestState.safe_script_file(path, env);
+    sol::table envTable = lua.create_table();
+    envTable[sol::metatable_key] = lua.create_table_with(
+        sol::meta_method::index, lua.globals()
+    );
 
-        if (!result.valid()) {
-            sol::error err = result;
-            Log::Error("Error parsing manifest file '%s': %s", path.c_str(), err.what());
-            return sol::table();
-        }
+    sol::environment env(lua, envTable);
 
-        if (result.get_type() == sol::type::table) {
-            return result.get<sol::table>();
-        }
+    sol::protected_function manifestFunc = chunk;
+    env.set_on(manifestFunc);
 
-        Log::Warn("Manifest file '%s' did not return a table.", path.c_str());
-        return sol::table();
-    } catch (const sol::error &e) {
-        Log::Error("Exception while parsing manifest '%s': %s", path.c_str(), e.what());
+    sol::protected_function_result result = manifestFunc();
+
+    if (!result.valid()) {
+        sol::error err = result;
+        Log::Error("Error parsing manifest file '%s': %s", name.c_str(), err.what());
         return sol::table();
     }
+
+    if (result.get_type() == sol::type::table) {
+        return result.get<sol::table>();
+    }
+
+    Log::Warn("Manifest file '%s' did not return a table.", name.c_str());
+    return sol::table();
 }
@@ -1,20 +1,30 @@
 #pragma once
 
 #include <vector>
+#include <atomic>
 #include <memory>
 #include <string>
+#include <thread>
 #include <unordered_map>
 
 #include <sol/sol.hpp>
 
 #include "TASProject.h"
+#include "ProjectIndex.h"
 
 class TASEngine;
+class LuaBytecodeCache;
 
 /**
  * @class ProjectManager
  * @brief Discovers, loads, and manages TAS projects from the filesystem.
  * Supports directory-based projects, zip-based projects, and binary record files.
+ *
+ * Parsed projects are remembered in a persistent ProjectIndex, so a refresh
+ * only opens sources that changed since the last scan. Scans can run on a
+ * background thread; their result is published on the game thread by
+ * PollRefresh(), replacing the project list in one step. Projects whose
+ * source did not change keep their TASProject object across refreshes.
  */
 class ProjectManager {
 public:
@@ -23,9 +33,29 @@ public:
 
     /**
      * @brief Scans the TAS directory and reloads the list of all available projects.
+     * Only sources that changed since the last scan are parsed. Blocks until done.
      */
     void RefreshProjects();
 
+    /**
+     * @brief Starts a project scan on a background thread.
+     * The current list stays in use until PollRefresh() publishes the result.
+     * A request made while a scan is running schedules another scan after it.
+     */
+    void RefreshProjectsAsync();
+
+    /**
+     * @brief Publishes the result of a finished background scan. Call once per frame.
+     * Also frees projects retired by earlier refreshes once no TAS is active.
+     * @return True if the project list was replaced.
+     */
+    bool PollRefresh();
+
+    /**
+     * @brief Checks if a background scan is in progress.
+     */
+    bool IsRefreshing() const { return m_ScanThread.joinable(); }
+
     /**
      * @brief Extracts a zip file to a temporary directory for execution.
      * @param zipPath Path to the zip file to extract.
@@ -67,6 +97,12 @@ public:
      */
     std::string GetTempDirectory() const { return m_TempDir; }
 
+    /**
+     * @brief Gets the bytecode cache shared by manifests and script contexts.
+     * @return The cache; script contexts keep it alive through their require searcher.
+     */
+    const std::shared_ptr<LuaBytecodeCache> &GetBytecodeCache() const { return m_BytecodeCache; }
+
     /**
      * @brief Cleans up temporary directories used for zip extraction.
      */
@@ -79,19 +115,44 @@ public:
     void CleanupProjectTempDirectory(TASProject *project);
 
 private:
+    /**
+     * @brief Lists the project sources under the TAS root, parsing only changed ones.
+     * Runs on the scan thread: only touches members that never change after construction.
+     * @param previous The index of the last scan.
+     * @param parsedCount Receives the number of sources that had to be parsed.
+     * @return The index describing the current sources.
+     */
+    ProjectIndex ScanProjects(const ProjectIndex &previous, size_t &parsedCount);
+
+    /**
+     * @brief Replaces the project list with the projects of a scanned index.
+     * Unchanged projects keep their TASProject object; dropped ones are retired.
+     * @param index The scanned index.
+     * @param parsedCount Number of sources parsed by the scan (0 = nothing new to save).
+     */
+    void PublishIndex(ProjectIndex index, size_t parsedCount);
+
+    /**
+     * @brief Frees retired projects and their temp directories once no TAS is active.
+     * Until then they stay alive, since playback and script contexts may still point at them.
+     */
+    void ReleaseRetiredProjects();
+
     /**
      * @brief Loads a single project from a directory.
+     * @param lua The Lua state used for manifest parsing.
      * @param projectPath The root directory of the project to load.
      * @return A unique_ptr to the TASProject, or nullptr if loading fails.
      */
-    std::unique_ptr<TASProject> LoadDirectoryProject(const std::string &projectPath);
+    std::unique_ptr<TASProject> LoadDirectoryProject(sol::state &lua, const std::string &projectPath);
 
     /**
      * @brief Loads a single project from a zip file.
+     * @param lua The Lua state used for manifest parsing.
      * @param zipPath Path to the zip file containing the project.
      * @return A unique_ptr to the TASProject, or nullptr if loading fails.
      */
-    std::unique_ptr<TASProject> LoadZipProject(const std::string &zipPath);
+    std::unique_ptr<TASProject> LoadZipProject(sol::state &lua, const std::string &zipPath);
 
     /**
      * @brief Loads a single project from a .tas record file.
@@ -102,10 +163,29 @@ private:
 
     /**
      * @brief Parses a manifest.lua file in a secure, sandboxed Lua environment.
+     * @param lua The Lua state used for manifest parsing.
      * @param path The full path to the manifest.lua file.
      * @return A sol::table containing the manifest data, or an invalid table on error.
      */
-    sol::table ParseManifestFile(const std::string &path);
+    sol::table ParseManifestFile(sol::state &lua, const std::string &path);
+
+    /**
+     * @brief Parses manifest source held in memory (e.g. read from a zip archive).
+     * @param lua The Lua state used for manifest parsing.
+     * @param source The manifest source text.
+     * @param chunkName Stable chunk name identifying the manifest in errors and in the bytecode cache.
+     * @return A sol::table containing the manifest data, or an invalid table on error.
+     */
+    sol::table ParseManifestSource(sol::state &lua, const std::string &source, const std::string &chunkName);
+
+    /**
+     * @brief Runs a loaded manifest chunk in the sandboxed environment.
+     * @param lua The Lua state the chunk was loaded into.
+     * @param chunk The loaded manifest chunk.
+     * @param name Manifest name used in log messages.
+     * @return A sol::table containing the manifest data, or an invalid table on error.
+     */
+    sol::table RunManifestChunk(sol::state &lua, sol::load_result chunk, const std::string &name);
 
     /**
      * @brief Reads a file from within a zip archive.
@@ -155,10 +235,22 @@ private:
     std::string m_TASRootPath;
     std::string m_TempDir; // Base directory for temporary extractions
 
-    sol::state m_ManifestState; // Dedicated Lua state for manifest parsing
+    std::shared_ptr<LuaBytecodeCache> m_BytecodeCache; // Compiled manifests and scripts
+
+    // Persistent index of parsed project sources
+    ProjectIndex m_Index;
+    std::string m_IndexPath;
+
+    // Background scan (the result is written before m_ScanDone is set)
+    std::thread m_ScanThread;
+    std::atomic<bool> m_ScanDone{false};
+    std::unique_ptr<ProjectIndex> m_ScanResult;
+    size_t m_ScanParsedCount = 0;
+    bool m_RescanRequested = false;
 
     std::vector<std::unique_ptr<TASProject>> m_Projects;
     TASProject *m_CurrentProject = nullptr; // Current project being worked on, if any.
+    std::vector<std::unique_ptr<TASProject>> m_RetiredProjects; // Dropped by a rescan, freed once idle
 
     // Track temporary directories for cleanup - maps project pointer to temp directory path
     std::unordered_map<TASProject *, std::string> m_ProjectTempDirectories;
@@ -0,0 +1,348 @@
+#include "RecordFormat.h"
+
+#include <cstring>
+#include <algorithm>
+
+#include <CKGlobals.h>
+
+#include "Logger.h"
+
+// ===================================================================
+// ChunkedRecordReader
+// ===================================================================
+
+bool ChunkedRecordReader::IsChunkedRecord(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    uint32_t magic = 0;
+    file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    return file.gcount() == sizeof(magic) && magic == RecordFormat::kFileMagic;
+}
+
+bool ChunkedRecordReader::Open(const std::string &path) {
+    Close();
+
+    m_File.open(path, std::ios::binary);
+    if (!m_File) {
+        Log::Error("Could not open record file: %s", path.c_str());
+        return false;
+    }
+
+    m_File.read(reinterpret_cast<char *>(&m_Header), sizeof(m_Header));
+    if (m_File.gcount() != sizeof(m_Header) || m_Header.magic != RecordFormat::kFileMagic) {
+        Log::Error("Invalid chunked record header: %s", path.c_str());
+        Close();
+        return false;
+    }
+
+    if (m_Header.version > RecordFormat::kVersion) {
+        Log::Error("Unsupported chunked record version %u: %s", m_Header.version, path.c_str());
+        Close();
+        return false;
+    }
+
+    m_File.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<uint64_t>(m_File.tellg());
+    if (fileSize < sizeof(RecordFileHeader) + sizeof(RecordFileFooter)) {
+        Log::Error("Chunked record is truncated: %s", path.c_str());
+        Close();
+        return false;
+    }
+
+    RecordFileFooter footer = {};
+    m_File.seekg(static_cast<std::streamoff>(fileSize - sizeof(footer)), std::ios::beg);
+    m_File.read(reinterpret_cast<char *>(&footer), sizeof(footer));
+    if (m_File.gcount() != sizeof(footer) || footer.magic != RecordFormat::kIndexMagic) {
+        Log::Error("Chunked record footer is missing or corrupt: %s", path.c_str());
+        Close();
+        return false;
+    }
+
+    const uint64_t indexSize = static_cast<uint64_t>(footer.blockCount) * sizeof(RecordBlockEntry);
+    if (footer.indexOffset + indexSize + sizeof(footer) != fileSize) {
+        Log::Error("Chunked record index is out of bounds: %s", path.c_str());
+        Close();
+        return false;
+    }
+
+    m_Index.resize(footer.blockCount);
+    m_File.seekg(static_cast<std::streamoff>(footer.indexOffset), std::ios::beg);
+    m_File.read(reinterpret_cast<char *>(m_Index.data()), static_cast<std::streamsize>(indexSize));
+    if (static_cast<uint64_t>(m_File.gcount()) != indexSize) {
+        Log::Error("Failed to read chunked record index: %s", path.c_str());
+        Close();
+        return false;
+    }
+
+    // Validate the index against the declared geometry. GetFrame() finds a frame's block
+    // by division, so every block but the last must be full.
+    uint64_t frameSum = 0;
+    for (size_t i = 0; i < m_Index.size(); ++i) {
+        const RecordBlockEntry &entry = m_Index[i];
+        const bool isLast = i + 1 == m_Index.size();
+        if (entry.frameCount == 0 || entry.frameCount > m_Header.framesPerBlock ||
+            (!isLast && entry.frameCount != m_Header.framesPerBlock) ||
+            entry.offset + entry.compressedSize > footer.indexOffset) {
+            Log::Error("Chunked record block index is corrupt: %s", path.c_str());
+            Close();
+            return false;
+        }
+        frameSum += entry.frameCount;
+    }
+
+    if (frameSum != footer.totalFrames) {
+        Log::Error("Chunked record frame count mismatch: %s", path.c_str());
+        Close();
+        return false;
+    }
+
+    m_TotalFrames = static_cast<size_t>(footer.totalFrames);
+    return true;
+}
+
+void ChunkedRecordReader::Close() {
+    if (m_File.is_open()) {
+        m_File.close();
+    }
+    m_File.clear();
+
+    m_Header = {};
+    m_Index.clear();
+    m_TotalFrames = 0;
+    m_UseCounter = 0;
+    for (auto &slot : m_Cache) {
+        slot.blockIndex = static_cast<size_t>(-1);
+        slot.lastUse = 0;
+        slot.frames.clear();
+        slot.frames.shrink_to_fit();
+    }
+    m_Scratch.clear();
+    m_Scratch.shrink_to_fit();
+}
+
+const RecordFrameData *ChunkedRecordReader::GetFrame(size_t frame) {
+    if (frame >= m_TotalFrames || m_Header.framesPerBlock == 0) {
+        return nullptr;
+    }
+
+    // Every block except the last one is full, so the block is a plain division
+    const size_t blockIndex = frame / m_Header.framesPerBlock;
+    CachedBlock *block = AcquireBlock(blockIndex);
+    if (!block) {
+        return nullptr;
+    }
+
+    return &block->frames[frame % m_Header.framesPerBlock];
+}
+
+bool ChunkedRecordReader::ReadAll(std::vector<RecordFrameData> &outFrames) {
+    outFrames.resize(m_TotalFrames);
+
+    size_t offset = 0;
+    for (size_t i = 0; i < m_Index.size(); ++i) {
+        if (!DecodeBlock(i, outFrames.data() + offset)) {
+            outFrames.clear();
+            return false;
+        }
+        offset += m_Index[i].frameCount;
+    }
+
+    return true;
+}
+
+bool ChunkedRecordReader::DecodeBlock(size_t blockIndex, RecordFrameData *dest) {
+    const RecordBlockEntry &entry = m_Index[blockIndex];
+
+    m_Scratch.resize(entry.compressedSize);
+    m_File.clear();
+    m_File.seekg(static_cast<std::streamoff>(entry.offset), std::ios::beg);
+    m_File.read(m_Scratch.data(), entry.compressedSize);
+    if (static_cast<size_t>(m_File.gcount()) != entry.compressedSize) {
+        Log::Error("Failed to read record block %zu.", blockIndex);
+        return false;
+    }
+
+    const int uncompressedSize = static_cast<int>(entry.frameCount * sizeof(RecordFrameData));
+    char *data = CKUnPackData(uncompressedSize, m_Scratch.data(), static_cast<int>(entry.compressedSize));
+    if (!data) {
+        Log::Error("Failed to decompress record block %zu.", blockIndex);
+        return false;
+    }
+
+    memcpy(dest, data, uncompressedSize);
+    CKDeletePointer(data);
+    return true;
+}
+
+ChunkedRecordReader::CachedBlock *ChunkedRecordReader::AcquireBlock(size_t blockIndex) {
+    CachedBlock *victim = &m_Cache[0];
+    for (auto &slot : m_Cache) {
+        if (slot.blockIndex == blockIndex) {
+            slot.lastUse = ++m_UseCounter;
+            return &slot;
+        }
+        if (slot.lastUse < victim->lastUse) {
+            victim = &slot;
+        }
+    }
+
+    victim->frames.resize(m_Index[blockIndex].frameCount);
+    if (!DecodeBlock(blockIndex, victim->frames.data())) {
+        victim->blockIndex = static_cast<size_t>(-1);
+        victim->lastUse = 0;
+        return nullptr;
+    }
+
+    victim->blockIndex = blockIndex;
+    victim->lastUse = ++m_UseCounter;
+    return victim;
+}
+
+// ===================================================================
+// LegacyRecordReader
+// ===================================================================
+
+bool LegacyRecordReader::ReadAll(const std::string &path, std::vector<RecordFrameData> &outFrames) {
+    outFrames.clear();
+
+    try {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            Log::Error("Could not open record file: %s", path.c_str());
+            return false;
+        }
+
+        // The 4-byte header holds the uncompressed payload size
+        uint32_t uncompressedSize = 0;
+        file.read(reinterpret_cast<char *>(&uncompressedSize), sizeof(uncompressedSize));
+        if (file.gcount() != sizeof(uncompressedSize)) {
+            Log::Error("Failed to read uncompressed size header from file.");
+            return false;
+        }
+
+        if (uncompressedSize == 0) {
+            Log::Warn("Record file is empty.");
+            return true; // Empty recording is technically valid
+        }
+
+        if (uncompressedSize % sizeof(RecordFrameData) != 0) {
+            Log::Error("Uncompressed size is not a multiple of FrameData size. File may be corrupt.");
+            return false;
+        }
+
+        file.seekg(0, std::ios::end);
+        const std::streampos fileSize = file.tellg();
+        file.seekg(sizeof(uncompressedSize), std::ios::beg);
+
+        const size_t compressedSize = static_cast<size_t>(fileSize) - sizeof(uncompressedSize);
+        std::vector<char> compressedData(compressedSize);
+        file.read(compressedData.data(), static_cast<std::streamsize>(compressedSize));
+        if (static_cast<size_t>(file.gcount()) != compressedSize) {
+            Log::Error("Failed to read compressed data payload.");
+            return false;
+        }
+
+        char *uncompressedData = CKUnPackData(static_cast<int>(uncompressedSize), compressedData.data(),
+                                              static_cast<int>(compressedSize));
+        if (!uncompressedData) {
+            Log::Error("Failed to decompress TAS record data using CKUnPackData.");
+            return false;
+        }
+
+        outFrames.resize(uncompressedSize / sizeof(RecordFrameData));
+        std::memcpy(outFrames.data(), uncompressedData, uncompressedSize);
+        CKDeletePointer(uncompressedData);
+        return true;
+    } catch (const std::exception &e) {
+        Log::Error("Exception loading record: %s", e.what());
+        outFrames.clear();
+        return false;
+    }
+}
+
+// ===================================================================
+// ChunkedRecordWriter
+// ===================================================================
+
+bool ChunkedRecordWriter::Write(const std::string &path, const RecordFrameData *frames, size_t frameCount,
+                                uint32_t framesPerBlock) {
+    if (framesPerBlock == 0) {
+        framesPerBlock = RecordFormat::kDefaultFramesPerBlock;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        Log::Error("Failed to open file for writing: %s", path.c_str());
+        return false;
+    }
+
+    RecordFileHeader header = {};
+    header.magic = RecordFormat::kFileMagic;
+    header.version = RecordFormat::kVersion;
+    header.framesPerBlock = framesPerBlock;
+    header.baseDeltaTime = frameCount > 0 ? frames[0].deltaTime : 0.0f;
+
+    bool constantDeltaTime = true;
+    for (size_t i = 1; i < frameCount; ++i) {
+        if (frames[i].deltaTime != header.baseDeltaTime) {
+            constantDeltaTime = false;
+            break;
+        }
+    }
+    if (constantDeltaTime) {
+        header.flags |= RecordFormat::kFlagConstantDeltaTime;
+    }
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    std::vector<RecordBlockEntry> index;
+    index.reserve((frameCount + framesPerBlock - 1) / framesPerBlock);
+
+    uint64_t offset = sizeof(header);
+    for (size_t start = 0; start < frameCount; start += framesPerBlock) {
+        const size_t count = std::min<size_t>(framesPerBlock, frameCount - start);
+        const int blockSize = static_cast<int>(count * sizeof(RecordFrameData));
+
+        int compressedSize = 0;
+        char *compressed = CKPackData(reinterpret_cast<char *>(const_cast<RecordFrameData *>(frames + start)),
+                                      blockSize, compressedSize, 9);
+        if (!compressed || compressedSize <= 0) {
+            Log::Error("Failed to compress record block at frame %zu.", start);
+            if (compressed) {
+                CKDeletePointer(compressed);
+            }
+            return false;
+        }
+
+        file.write(compressed, compressedSize);
+        CKDeletePointer(compressed);
+
+        RecordBlockEntry entry = {};
+        entry.offset = offset;
+        entry.compressedSize = static_cast<uint32_t>(compressedSize);
+        entry.frameCount = static_cast<uint32_t>(count);
+        index.push_back(entry);
+
+        offset += static_cast<uint64_t>(compressedSize);
+    }
+
+    RecordFileFooter footer = {};
+    footer.indexOffset = offset;
+    footer.totalFrames = frameCount;
+    footer.blockCount = static_cast<uint32_t>(index.size());
+    footer.magic = RecordFormat::kIndexMagic;
+
+    file.write(reinterpret_cast<const char *>(index.data()),
+               static_cast<std::streamsize>(index.size() * sizeof(RecordBlockEntry)));
+    file.write(reinterpret_cast<const char *>(&footer), sizeof(footer));
+
+    if (!file) {
+        Log::Error("Failed to write chunked record: %s", path.c_str());
+        return false;
+    }
+
+    return true;
+}
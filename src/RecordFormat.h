@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @struct RecordKeyState
+ * @brief Matches the exact binary format from legacy TAS records.
+ */
+#pragma pack(push, 1)
+struct RecordKeyState {
+    unsigned key_up    : 1;
+    unsigned key_down  : 1;
+    unsigned key_left  : 1;
+    unsigned key_right : 1;
+    unsigned key_shift : 1;
+    unsigned key_space : 1;
+    unsigned key_q     : 1;
+    unsigned key_esc   : 1;
+    unsigned key_enter : 1;
+};
+#pragma pack(pop)
+
+/**
+ * @struct RecordFrameData
+ * @brief Matches the exact binary format from legacy TAS records.
+ */
+#pragma pack(push, 1)
+struct RecordFrameData {
+    float deltaTime;
+
+    union {
+        RecordKeyState keyState;
+        int keyStates;
+    };
+
+    RecordFrameData() : deltaTime(0.0f), keyStates(0) {
+    }
+
+    explicit RecordFrameData(float deltaTime) : deltaTime(deltaTime) {
+        keyStates = 0;
+    }
+};
+#pragma pack(pop)
+
+// ===================================================================
+// Chunked Record Container
+// ===================================================================
+//
+// Layout (little endian):
+//
+//   RecordFileHeader
+//   block 0 .. block N-1     (each block compressed independently)
+//   RecordBlockEntry[N]      (block index)
+//   RecordFileFooter         (locates the index)
+//
+// Legacy records start with a 4-byte uncompressed size instead of the magic.
+// The magic value is not a multiple of sizeof(RecordFrameData), so it can never
+// be mistaken for a valid legacy size header.
+
+namespace RecordFormat {
+    constexpr uint32_t kFileMagic = 0x53415442;  // "BTAS"
+    constexpr uint32_t kIndexMagic = 0x58444E49; // "INDX"
+    constexpr uint16_t kVersion = 1;
+
+    constexpr uint32_t kDefaultFramesPerBlock = 4096;
+
+    // Header flags
+    constexpr uint16_t kFlagConstantDeltaTime = 1 << 0;
+}
+
+#pragma pack(push, 1)
+struct RecordFileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    uint32_t framesPerBlock;
+    float baseDeltaTime; // Delta time of the first frame
+};
+
+struct RecordBlockEntry {
+    uint64_t offset;         // Absolute file offset of the compressed block
+    uint32_t compressedSize; // Size of the compressed block in bytes
+    uint32_t frameCount;     // Number of frames stored in the block
+};
+
+struct RecordFileFooter {
+    uint64_t indexOffset; // Absolute file offset of the block index
+    uint64_t totalFrames;
+    uint32_t blockCount;
+    uint32_t magic;
+};
+#pragma pack(pop)
+
+/**
+ * @class ChunkedRecordReader
+ * @brief Random-access reader for chunked .tas records.
+ *
+ * Only the header and block index are read when the file is opened. Frame blocks
+ * are read and decompressed on demand into a small LRU cache, so playback touches
+ * just the blocks around the playhead and seeking never inflates the whole record.
+ */
+class ChunkedRecordReader {
+public:
+    ChunkedRecordReader() = default;
+    ~ChunkedRecordReader() = default;
+
+    ChunkedRecordReader(const ChunkedRecordReader &) = delete;
+    ChunkedRecordReader &operator=(const ChunkedRecordReader &) = delete;
+
+    /**
+     * @brief Checks whether a file starts with the chunked record magic.
+     * @param path Path to the .tas file.
+     * @return True if the file uses the chunked container.
+     */
+    static bool IsChunkedRecord(const std::string &path);
+
+    /**
+     * @brief Opens a chunked record and loads its block index.
+     * @param path Path to the .tas file.
+     * @return True if the header, footer and index are valid.
+     */
+    bool Open(const std::string &path);
+
+    /**
+     * @brief Closes the file and drops all cached blocks.
+     */
+    void Close();
+
+    bool IsOpen() const { return m_File.is_open(); }
+
+    size_t GetTotalFrames() const { return m_TotalFrames; }
+    size_t GetBlockCount() const { return m_Index.size(); }
+    uint32_t GetFramesPerBlock() const { return m_Header.framesPerBlock; }
+    float GetBaseDeltaTime() const { return m_Header.baseDeltaTime; }
+    bool HasConstantDeltaTime() const { return (m_Header.flags & RecordFormat::kFlagConstantDeltaTime) != 0; }
+
+    /**
+     * @brief Gets a frame, decompressing its block if it is not cached.
+     * @param frame The frame number (0-based).
+     * @return Pointer into the block cache (valid until the next call), or nullptr on error.
+     */
+    const RecordFrameData *GetFrame(size_t frame);
+
+    /**
+     * @brief Decompresses every block into a contiguous frame vector.
+     * @param outFrames Receives all frames of the record.
+     * @return True if all blocks were decoded successfully.
+     */
+    bool ReadAll(std::vector<RecordFrameData> &outFrames);
+
+private:
+    struct CachedBlock {
+        size_t blockIndex = static_cast<size_t>(-1);
+        uint64_t lastUse = 0;
+        std::vector<RecordFrameData> frames;
+    };
+
+    static constexpr size_t kCacheSlots = 4;
+
+    bool DecodeBlock(size_t blockIndex, RecordFrameData *dest);
+    CachedBlock *AcquireBlock(size_t blockIndex);
+
+    std::ifstream m_File;
+    RecordFileHeader m_Header = {};
+    std::vector<RecordBlockEntry> m_Index;
+    size_t m_TotalFrames = 0;
+
+    CachedBlock m_Cache[kCacheSlots];
+    uint64_t m_UseCounter = 0;
+    std::vector<char> m_Scratch; // Compressed block staging buffer
+};
+
+/**
+ * @class LegacyRecordReader
+ * @brief Reads legacy .tas records (4-byte uncompressed size followed by one packed payload).
+ */
+class LegacyRecordReader {
+public:
+    /**
+     * @brief Inflates a legacy record into a contiguous frame vector.
+     * @param path Path to the .tas file.
+     * @param outFrames Receives all frames of the record (empty for an empty record).
+     * @return True if the file was read and decompressed successfully.
+     */
+    static bool ReadAll(const std::string &path, std::vector<RecordFrameData> &outFrames);
+};
+
+/**
+ * @class ChunkedRecordWriter
+ * @brief Writes frames into the chunked .tas container.
+ */
+class ChunkedRecordWriter {
+public:
+    /**
+     * @brief Writes frames to a chunked record file.
+     * @param path Destination path.
+     * @param frames Frame data to write.
+     * @param frameCount Number of frames.
+     * @param framesPerBlock Number of frames compressed together per block.
+     * @return True if the file was written successfully.
+     */
+    static bool Write(const std::string &path, const RecordFrameData *frames, size_t frameCount,
+                      uint32_t framesPerBlock = RecordFormat::kDefaultFramesPerBlock);
+};
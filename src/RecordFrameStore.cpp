@@ -0,0 +1,318 @@
+#include "RecordFrameStore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iterator>
+
+namespace {
+    const RecordFrameData kBlankFrame;
+}
+
+bool RecordFrameStore::IsSameFrame(const RecordFrameData &a, const RecordFrameData &b) {
+    return std::memcmp(&a, &b, sizeof(RecordFrameData)) == 0;
+}
+
+void RecordFrameStore::Clear() {
+    m_Blocks.clear();
+    m_Blocks.shrink_to_fit();
+    m_BlockStarts.clear();
+    m_BlockStarts.shrink_to_fit();
+    m_StartsValid = 0;
+    m_Size = 0;
+    m_Version = NextVersion();
+}
+
+void RecordFrameStore::Assign(const RecordFrameData *frames, size_t count) {
+    Clear();
+
+    std::vector<Run> runs;
+    for (size_t i = 0; i < count; ++i) {
+        AppendRun(runs, 1, frames[i]);
+    }
+    ReplaceBlocks(0, 0, runs);
+    m_Size = count;
+}
+
+size_t RecordFrameStore::GetRunCount() const {
+    size_t count = 0;
+    for (const auto &block : m_Blocks) {
+        count += block->runs.size();
+    }
+    return count;
+}
+
+size_t RecordFrameStore::ByteSize() const {
+    size_t bytes = sizeof(*this) + m_Blocks.capacity() * sizeof(BlockPtr) + m_BlockStarts.capacity() * sizeof(size_t);
+    for (const auto &block : m_Blocks) {
+        bytes += sizeof(Block) + block->runs.capacity() * sizeof(Run);
+    }
+    return bytes;
+}
+
+size_t RecordFrameStore::GetSharedBlockCount() const {
+    return static_cast<size_t>(std::count_if(m_Blocks.begin(), m_Blocks.end(),
+                                             [](const BlockPtr &block) { return block.use_count() > 1; }));
+}
+
+const RecordFrameData &RecordFrameStore::Get(size_t frame) const {
+    size_t block, run, runStart;
+    if (!Locate(frame, block, run, runStart)) {
+        return kBlankFrame;
+    }
+    return m_Blocks[block]->runs[run].value;
+}
+
+const RecordFrameData &RecordFrameStore::Get(size_t frame, Cursor &cursor) const {
+    if (cursor.m_Version == m_Version) {
+        if (frame >= cursor.m_RunStart && frame < cursor.m_RunEnd) {
+            return m_Blocks[cursor.m_Block]->runs[cursor.m_Run].value;
+        }
+
+        // Step into the next run
+        if (frame == cursor.m_RunEnd && frame < m_Size) {
+            if (++cursor.m_Run == m_Blocks[cursor.m_Block]->runs.size()) {
+                ++cursor.m_Block;
+                cursor.m_Run = 0;
+            }
+            const Run &run = m_Blocks[cursor.m_Block]->runs[cursor.m_Run];
+            cursor.m_RunStart = frame;
+            cursor.m_RunEnd = frame + run.length;
+            return run.value;
+        }
+    }
+
+    size_t block, run, runStart;
+    if (!Locate(frame, block, run, runStart)) {
+        return kBlankFrame;
+    }
+
+    cursor.m_Version = m_Version;
+    cursor.m_Block = block;
+    cursor.m_Run = run;
+    cursor.m_RunStart = runStart;
+    cursor.m_RunEnd = runStart + m_Blocks[block]->runs[run].length;
+    return m_Blocks[block]->runs[run].value;
+}
+
+void RecordFrameStore::Set(size_t frame, const RecordFrameData &value) {
+    if (frame >= m_Size || IsSameFrame(Get(frame), value)) {
+        return;
+    }
+    Splice(frame, 1, {value}, 1);
+}
+
+void RecordFrameStore::Splice(size_t frame, size_t removeCount, const std::vector<RecordFrameData> &insert,
+                              size_t insertRepeat) {
+    frame = std::min(frame, m_Size);
+    removeCount = std::min(removeCount, m_Size - frame);
+    const size_t insertCount = insert.size() * insertRepeat;
+    if (removeCount == 0 && insertCount == 0) {
+        return;
+    }
+
+    std::vector<Run> pattern;
+    for (const auto &value : insert) {
+        AppendRun(pattern, 1, value);
+    }
+
+    if (m_Blocks.empty()) {
+        std::vector<Run> runs;
+        for (size_t i = 0; i < insertRepeat; ++i) {
+            for (const auto &run : pattern) {
+                AppendRun(runs, run.length, run.value);
+            }
+        }
+        ReplaceBlocks(0, 0, runs);
+        m_Size = insertCount;
+        return;
+    }
+
+    // Rewrite the blocks holding the edited range, plus one neighbour on each
+    // side so runs coalesce across the edit
+    UpdateBlockStarts();
+    size_t first = FindBlock(std::min(frame, m_Size - 1));
+    size_t last = removeCount > 0 ? FindBlock(frame + removeCount - 1) : first;
+    first = first > 0 ? first - 1 : 0;
+    last = std::min(last + 1, m_Blocks.size() - 1);
+
+    const size_t begin = m_BlockStarts[first];
+    const size_t end = m_BlockStarts[last] + m_Blocks[last]->frameCount;
+
+    // Appends the stored frames of [from, to), skipping blocks outside the range
+    std::vector<Run> runs;
+    auto appendStored = [&](size_t from, size_t to) {
+        size_t pos = begin;
+        for (size_t b = first; b <= last && pos < to; ++b) {
+            const Block &block = *m_Blocks[b];
+            if (pos + block.frameCount <= from) {
+                pos += block.frameCount;
+                continue;
+            }
+            for (const auto &run : block.runs) {
+                const size_t runEnd = pos + run.length;
+                const size_t clippedStart = std::max(pos, from);
+                const size_t clippedEnd = std::min(runEnd, to);
+                if (clippedStart < clippedEnd) {
+                    AppendRun(runs, clippedEnd - clippedStart, run.value);
+                }
+                pos = runEnd;
+            }
+        }
+    };
+
+    appendStored(begin, frame);
+    if (pattern.size() == 1) {
+        AppendRun(runs, pattern[0].length * insertRepeat, pattern[0].value);
+    } else {
+        for (size_t i = 0; i < insertRepeat; ++i) {
+            for (const auto &run : pattern) {
+                AppendRun(runs, run.length, run.value);
+            }
+        }
+    }
+    appendStored(frame + removeCount, end);
+
+    ReplaceBlocks(first, last + 1, runs);
+    m_Size = m_Size - removeCount + insertCount;
+}
+
+void RecordFrameStore::CopyRange(size_t frame, size_t count, std::vector<RecordFrameData> &outFrames) const {
+    outFrames.clear();
+
+    size_t block, run, runStart;
+    if (!Locate(frame, block, run, runStart)) {
+        return;
+    }
+
+    count = std::min(count, m_Size - frame);
+    outFrames.reserve(count);
+
+    size_t skip = frame - runStart;
+    while (outFrames.size() < count) {
+        const Run &current = m_Blocks[block]->runs[run];
+        const size_t take = std::min(current.length - skip, count - outFrames.size());
+        outFrames.insert(outFrames.end(), take, current.value);
+        skip = 0;
+
+        if (++run == m_Blocks[block]->runs.size()) {
+            ++block;
+            run = 0;
+        }
+    }
+}
+
+RecordFrameStore RecordFrameStore::Slice(size_t frame, size_t count) const {
+    RecordFrameStore slice;
+    if (frame >= m_Size || count == 0) {
+        return slice;
+    }
+
+    count = std::min(count, m_Size - frame);
+    const size_t end = frame + count;
+
+    UpdateBlockStarts();
+    const size_t last = FindBlock(end - 1);
+    for (size_t b = FindBlock(frame); b <= last; ++b) {
+        const size_t blockStart = m_BlockStarts[b];
+        const Block &block = *m_Blocks[b];
+
+        // Blocks inside the range are shared, the ones cut by its ends are copied
+        if (blockStart >= frame && blockStart + block.frameCount <= end) {
+            slice.m_Blocks.push_back(m_Blocks[b]);
+            continue;
+        }
+
+        std::vector<Run> runs;
+        size_t pos = blockStart;
+        for (const auto &run : block.runs) {
+            const size_t clippedStart = std::max(pos, frame);
+            const size_t clippedEnd = std::min(pos + run.length, end);
+            if (clippedStart < clippedEnd) {
+                AppendRun(runs, clippedEnd - clippedStart, run.value);
+            }
+            pos += run.length;
+        }
+        slice.ReplaceBlocks(slice.m_Blocks.size(), slice.m_Blocks.size(), runs);
+    }
+
+    slice.m_Size = count;
+    return slice;
+}
+
+size_t RecordFrameStore::FindBlock(size_t frame) const {
+    return static_cast<size_t>(std::upper_bound(m_BlockStarts.begin(), m_BlockStarts.end(), frame) -
+                               m_BlockStarts.begin()) - 1;
+}
+
+bool RecordFrameStore::Locate(size_t frame, size_t &block, size_t &run, size_t &runStart) const {
+    if (frame >= m_Size) {
+        return false;
+    }
+
+    UpdateBlockStarts();
+    block = FindBlock(frame);
+
+    size_t pos = m_BlockStarts[block];
+    const auto &runs = m_Blocks[block]->runs;
+    for (run = 0; run + 1 < runs.size() && frame >= pos + runs[run].length; ++run) {
+        pos += runs[run].length;
+    }
+    runStart = pos;
+    return true;
+}
+
+void RecordFrameStore::UpdateBlockStarts() const {
+    if (m_StartsValid == m_Blocks.size() && m_BlockStarts.size() == m_Blocks.size()) {
+        return;
+    }
+
+    m_BlockStarts.resize(m_Blocks.size());
+    for (size_t b = m_StartsValid; b < m_Blocks.size(); ++b) {
+        m_BlockStarts[b] = b == 0 ? 0 : m_BlockStarts[b - 1] + m_Blocks[b - 1]->frameCount;
+    }
+    m_StartsValid = m_Blocks.size();
+}
+
+void RecordFrameStore::ReplaceBlocks(size_t first, size_t last, std::vector<Run> &runs) {
+    // Spread the runs evenly so the new blocks have room to grow
+    const size_t blockCount = (runs.size() + kMaxRunsPerBlock - 1) / kMaxRunsPerBlock;
+    std::vector<BlockPtr> blocks;
+    blocks.reserve(blockCount);
+
+    size_t next = 0;
+    for (size_t b = 0; b < blockCount; ++b) {
+        const size_t take = runs.size() / blockCount + (b < runs.size() % blockCount ? 1 : 0);
+        auto block = std::make_shared<Block>();
+        block->runs.assign(runs.begin() + next, runs.begin() + next + take);
+        for (const auto &run : block->runs) {
+            block->frameCount += run.length;
+        }
+        blocks.push_back(std::move(block));
+        next += take;
+    }
+
+    // Blocks being replaced are released, not modified, so stores sharing them are unaffected
+    m_Blocks.erase(m_Blocks.begin() + first, m_Blocks.begin() + last);
+    m_Blocks.insert(m_Blocks.begin() + first, std::make_move_iterator(blocks.begin()),
+                    std::make_move_iterator(blocks.end()));
+
+    m_StartsValid = std::min(m_StartsValid, first);
+    m_Version = NextVersion();
+}
+
+void RecordFrameStore::AppendRun(std::vector<Run> &runs, size_t length, const RecordFrameData &value) {
+    if (length == 0) {
+        return;
+    }
+    if (!runs.empty() && IsSameFrame(runs.back().value, value)) {
+        runs.back().length += length;
+    } else {
+        runs.push_back({length, value});
+    }
+}
+
+uint64_t RecordFrameStore::NextVersion() {
+    static std::atomic<uint64_t> lastVersion{0};
+    return ++lastVersion;
+}
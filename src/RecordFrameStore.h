@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "RecordFormat.h"
+
+/**
+ * @class RecordFrameStore
+ * @brief Run-length encoded frame sequence used by RecordPlayer for editing.
+ *
+ * Records repeat the same key state and delta time for long stretches, so
+ * frames are stored as runs of identical frames. Runs are grouped into blocks
+ * of at most kMaxRunsPerBlock runs, with a prefix of block start frames that is
+ * rebuilt lazily from the first modified block.
+ *
+ * - Random access is a binary search over the blocks plus a scan of one block.
+ * - Splicing rewrites only the blocks around the edited range and shifts block
+ *   entries, never individual frames; inserting N copies of a frame adds one run.
+ * - A Cursor remembers the run of the last access, so reading frames in order
+ *   (as Tick does) is O(1) per frame.
+ *
+ * Blocks are immutable and reference counted. Copying a store or taking a
+ * Slice() shares the blocks, and an edit replaces only the blocks it touches,
+ * so branches and macros cut from a record cost a block table, not the frames.
+ *
+ * References returned by Get() stay valid until the store is modified.
+ */
+class RecordFrameStore {
+public:
+    static constexpr size_t kMaxRunsPerBlock = 32;
+
+    /**
+     * @struct Run
+     * @brief A frame repeated length times.
+     */
+    struct Run {
+        size_t length = 0;
+        RecordFrameData value;
+    };
+
+    /**
+     * @class Cursor
+     * @brief Remembers the run of the last access for sequential reads.
+     * A cursor notices when the store was modified or replaced and relocates itself.
+     */
+    class Cursor {
+    public:
+        Cursor() = default;
+
+    private:
+        friend class RecordFrameStore;
+
+        uint64_t m_Version = 0; // 0 never matches a store
+        size_t m_Block = 0;
+        size_t m_Run = 0;
+        size_t m_RunStart = 0;
+        size_t m_RunEnd = 0;
+    };
+
+    /**
+     * @brief Removes all frames and releases their memory.
+     */
+    void Clear();
+
+    /**
+     * @brief Replaces the contents with the given frames.
+     * @param frames The frames to store.
+     * @param count Number of frames.
+     */
+    void Assign(const RecordFrameData *frames, size_t count);
+    void Assign(const std::vector<RecordFrameData> &frames) { Assign(frames.data(), frames.size()); }
+
+    size_t GetSize() const { return m_Size; }
+    bool IsEmpty() const { return m_Size == 0; }
+
+    /**
+     * @brief Gets the number of runs, a measure of how well the record compresses.
+     */
+    size_t GetRunCount() const;
+
+    /**
+     * @brief Approximates the memory held by the store, counting shared blocks in full.
+     * @return Size in bytes.
+     */
+    size_t ByteSize() const;
+
+    size_t GetBlockCount() const { return m_Blocks.size(); }
+
+    /**
+     * @brief Gets the number of blocks also referenced by another store.
+     */
+    size_t GetSharedBlockCount() const;
+
+    /**
+     * @brief Gets a frame.
+     * @param frame The frame number; must be less than GetSize().
+     */
+    const RecordFrameData &Get(size_t frame) const;
+
+    /**
+     * @brief Gets a frame, starting the search from the cursor's run.
+     * @param frame The frame number; must be less than GetSize().
+     * @param cursor Cursor of the caller; O(1) if frame is in or right after its run.
+     */
+    const RecordFrameData &Get(size_t frame, Cursor &cursor) const;
+
+    /**
+     * @brief Overwrites a frame.
+     * @param frame The frame number; must be less than GetSize().
+     * @param value The new frame.
+     */
+    void Set(size_t frame, const RecordFrameData &value);
+
+    /**
+     * @brief Replaces frames [frame, frame + removeCount) with insert repeated insertRepeat times.
+     * Out-of-range positions are clamped to the end of the store.
+     * @param frame First frame to replace.
+     * @param removeCount Number of frames to remove.
+     * @param insert Frame pattern to insert.
+     * @param insertRepeat Number of times the pattern is inserted.
+     */
+    void Splice(size_t frame, size_t removeCount, const std::vector<RecordFrameData> &insert, size_t insertRepeat = 1);
+
+    /**
+     * @brief Copies a range of frames.
+     * @param frame First frame to copy.
+     * @param count Number of frames; clamped to the end of the store.
+     * @param outFrames Receives the frames.
+     */
+    void CopyRange(size_t frame, size_t count, std::vector<RecordFrameData> &outFrames) const;
+
+    /**
+     * @brief Gets a range of frames as a store sharing this store's blocks.
+     * Only the blocks cut by the range boundaries are copied.
+     * @param frame First frame of the range.
+     * @param count Number of frames; clamped to the end of the store.
+     * @return The store holding the range.
+     */
+    RecordFrameStore Slice(size_t frame, size_t count) const;
+
+    /**
+     * @brief Calls fn(length, value) for every run in frame order.
+     */
+    template <typename Fn>
+    void ForEachRun(Fn &&fn) const {
+        for (const auto &block : m_Blocks) {
+            for (const auto &run : block->runs) {
+                fn(run.length, run.value);
+            }
+        }
+    }
+
+    static bool IsSameFrame(const RecordFrameData &a, const RecordFrameData &b);
+
+private:
+    struct Block {
+        size_t frameCount = 0;
+        std::vector<Run> runs;
+    };
+
+    using BlockPtr = std::shared_ptr<const Block>;
+
+    /**
+     * @brief Finds the block holding a frame; the block starts must be up to date.
+     */
+    size_t FindBlock(size_t frame) const;
+
+    /**
+     * @brief Finds the run holding a frame.
+     * @return False if the frame is out of range.
+     */
+    bool Locate(size_t frame, size_t &block, size_t &run, size_t &runStart) const;
+
+    /**
+     * @brief Brings the block start prefix up to date.
+     */
+    void UpdateBlockStarts() const;
+
+    /**
+     * @brief Splits runs into blocks and stores them in place of blocks [first, last).
+     */
+    void ReplaceBlocks(size_t first, size_t last, std::vector<Run> &runs);
+
+    static void AppendRun(std::vector<Run> &runs, size_t length, const RecordFrameData &value);
+
+    /**
+     * @brief Gets a version number no store has used yet.
+     * Copies keep their source's version, since they hold the same blocks.
+     */
+    static uint64_t NextVersion();
+
+    std::vector<BlockPtr> m_Blocks;
+    size_t m_Size = 0;
+    uint64_t m_Version = NextVersion();
+
+    // Start frame of each block, valid below m_StartsValid
+    mutable std::vector<size_t> m_BlockStarts;
+    mutable size_t m_StartsValid = 0;
+};
@@ -0,0 +1,234 @@
+#include "RecordKeyIndex.h"
+
+#include <bit>
+
+namespace {
+    const char *const kKeyNames[RecordKeyIndex::kKeyCount] = {
+        "up", "down", "left", "right", "shift", "space", "q", "esc", "enter"
+    };
+
+    // Reads 64 bits starting at an arbitrary bit position (zero past the end)
+    uint64_t ReadBits(const std::vector<uint64_t> &words, size_t pos) {
+        const size_t word = pos / 64;
+        const size_t shift = pos % 64;
+
+        uint64_t bits = word < words.size() ? words[word] >> shift : 0;
+        if (shift != 0 && word + 1 < words.size()) {
+            bits |= words[word + 1] << (64 - shift);
+        }
+        return bits;
+    }
+
+    // Copies a bit range between word vectors, one destination word at a time
+    void CopyBits(const std::vector<uint64_t> &src, size_t srcPos,
+                  std::vector<uint64_t> &dst, size_t dstPos, size_t count) {
+        while (count > 0) {
+            const size_t word = dstPos / 64;
+            const size_t shift = dstPos % 64;
+            const size_t n = std::min<size_t>(64 - shift, count);
+
+            const uint64_t mask = (n == 64 ? ~0ULL : ((1ULL << n) - 1)) << shift;
+            dst[word] = (dst[word] & ~mask) | ((ReadBits(src, srcPos) << shift) & mask);
+
+            srcPos += n;
+            dstPos += n;
+            count -= n;
+        }
+    }
+}
+
+int RecordKeyIndex::GetKeySlot(const std::string &keyName) {
+    for (size_t i = 0; i < kKeyCount; ++i) {
+        if (keyName == kKeyNames[i]) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+const char *RecordKeyIndex::GetKeyName(size_t slot) {
+    return slot < kKeyCount ? kKeyNames[slot] : "";
+}
+
+void RecordKeyIndex::Clear() {
+    m_Built = false;
+    m_FrameCount = 0;
+    m_PrefixValidWords = 0;
+    for (size_t i = 0; i < kKeyCount; ++i) {
+        m_Bits[i].clear();
+        m_Bits[i].shrink_to_fit();
+        m_Prefix[i].clear();
+        m_Prefix[i].shrink_to_fit();
+    }
+}
+
+void RecordKeyIndex::Reset(size_t frameCount) {
+    m_Built = true;
+    m_FrameCount = frameCount;
+    m_PrefixValidWords = 0;
+    for (size_t i = 0; i < kKeyCount; ++i) {
+        m_Bits[i].assign(WordCount(frameCount), 0);
+    }
+}
+
+void RecordKeyIndex::SetFrame(size_t frame, const RecordKeyState &keyState) {
+    if (!m_Built || frame >= m_FrameCount) {
+        return;
+    }
+
+    const bool pressed[kKeyCount] = {
+        keyState.key_up != 0, keyState.key_down != 0, keyState.key_left != 0,
+        keyState.key_right != 0, keyState.key_shift != 0, keyState.key_space != 0,
+        keyState.key_q != 0, keyState.key_esc != 0, keyState.key_enter != 0
+    };
+
+    const size_t word = frame / 64;
+    const uint64_t bit = 1ULL << (frame % 64);
+    for (size_t i = 0; i < kKeyCount; ++i) {
+        if (pressed[i]) {
+            m_Bits[i][word] |= bit;
+        } else {
+            m_Bits[i][word] &= ~bit;
+        }
+    }
+
+    InvalidatePrefix(frame);
+}
+
+void RecordKeyIndex::Insert(size_t frame, size_t count) {
+    if (!m_Built || count == 0 || frame > m_FrameCount) {
+        return;
+    }
+
+    const size_t newCount = m_FrameCount + count;
+    for (size_t i = 0; i < kKeyCount; ++i) {
+        std::vector<uint64_t> bits(WordCount(newCount), 0);
+        CopyBits(m_Bits[i], 0, bits, 0, frame);
+        CopyBits(m_Bits[i], frame, bits, frame + count, m_FrameCount - frame);
+        m_Bits[i].swap(bits);
+    }
+
+    m_FrameCount = newCount;
+    InvalidatePrefix(frame);
+}
+
+void RecordKeyIndex::Erase(size_t frame, size_t count) {
+    if (!m_Built || frame >= m_FrameCount) {
+        return;
+    }
+
+    count = std::min(count, m_FrameCount - frame);
+    if (count == 0) {
+        return;
+    }
+
+    const size_t newCount = m_FrameCount - count;
+    for (size_t i = 0; i < kKeyCount; ++i) {
+        std::vector<uint64_t> bits(WordCount(newCount), 0);
+        CopyBits(m_Bits[i], 0, bits, 0, frame);
+        CopyBits(m_Bits[i], frame + count, bits, frame, newCount - frame);
+        m_Bits[i].swap(bits);
+    }
+
+    m_FrameCount = newCount;
+    InvalidatePrefix(frame);
+}
+
+bool RecordKeyIndex::Test(size_t slot, size_t frame) const {
+    if (slot >= kKeyCount || frame >= m_FrameCount) {
+        return false;
+    }
+    return (m_Bits[slot][frame / 64] >> (frame % 64)) & 1;
+}
+
+size_t RecordKeyIndex::Count(size_t slot, size_t start, size_t end) const {
+    end = std::min(end, m_FrameCount);
+    if (slot >= kKeyCount || start >= end) {
+        return 0;
+    }
+
+    UpdatePrefix();
+    return Rank(slot, end) - Rank(slot, start);
+}
+
+void RecordKeyIndex::FindAll(uint32_t slotMask, size_t start, size_t end, std::vector<size_t> &outFrames) const {
+    end = std::min(end, m_FrameCount);
+    if (slotMask == 0 || start >= end) {
+        return;
+    }
+
+    const size_t firstWord = start / 64;
+    const size_t lastWord = (end - 1) / 64;
+    for (size_t w = firstWord; w <= lastWord; ++w) {
+        uint64_t match = ~0ULL;
+        for (size_t i = 0; i < kKeyCount && match != 0; ++i) {
+            if (slotMask & (1u << i)) {
+                match &= m_Bits[i][w];
+            }
+        }
+
+        // Clip the first and last words to the requested range
+        if (w == firstWord) {
+            match &= ~0ULL << (start % 64);
+        }
+        if (w == lastWord && end % 64 != 0) {
+            match &= (1ULL << (end % 64)) - 1;
+        }
+
+        while (match != 0) {
+            outFrames.push_back(w * 64 + static_cast<size_t>(std::countr_zero(match)));
+            match &= match - 1;
+        }
+    }
+}
+
+size_t RecordKeyIndex::FindChange(size_t slot, size_t start) const {
+    if (slot >= kKeyCount || start >= m_FrameCount) {
+        return npos;
+    }
+
+    // XOR against the reference state turns every differing frame into a set bit
+    const uint64_t reference = Test(slot, start) ? ~0ULL : 0;
+    const size_t wordCount = WordCount(m_FrameCount);
+    for (size_t w = start / 64; w < wordCount; ++w) {
+        uint64_t diff = m_Bits[slot][w] ^ reference;
+        if (w == start / 64) {
+            diff &= (start % 64 == 63) ? 0 : (~0ULL << (start % 64 + 1));
+        }
+        if (w == wordCount - 1 && m_FrameCount % 64 != 0) {
+            diff &= (1ULL << (m_FrameCount % 64)) - 1;
+        }
+        if (diff != 0) {
+            return w * 64 + static_cast<size_t>(std::countr_zero(diff));
+        }
+    }
+
+    return npos;
+}
+
+size_t RecordKeyIndex::Rank(size_t slot, size_t frame) const {
+    const size_t word = frame / 64;
+    size_t rank = m_Prefix[slot][word];
+    if (frame % 64 != 0) {
+        rank += std::popcount(m_Bits[slot][word] & ((1ULL << (frame % 64)) - 1));
+    }
+    return rank;
+}
+
+void RecordKeyIndex::UpdatePrefix() const {
+    const size_t wordCount = WordCount(m_FrameCount);
+    if (m_PrefixValidWords >= wordCount && m_Prefix[0].size() == wordCount + 1) {
+        return;
+    }
+
+    for (size_t i = 0; i < kKeyCount; ++i) {
+        auto &prefix = m_Prefix[i];
+        prefix.resize(wordCount + 1);
+        prefix[0] = 0;
+        for (size_t w = m_PrefixValidWords; w < wordCount; ++w) {
+            prefix[w + 1] = prefix[w] + static_cast<uint32_t>(std::popcount(m_Bits[i][w]));
+        }
+    }
+
+    m_PrefixValidWords = wordCount;
+}
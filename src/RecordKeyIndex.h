@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "RecordFormat.h"
+
+/**
+ * @class RecordKeyIndex
+ * @brief Bit-sliced columnar index over the key states of a record.
+ *
+ * Each key of RecordKeyState is stored as its own bitset (one bit per frame),
+ * with a prefix popcount per 64-frame word. Key-combination searches become
+ * word-wide AND operations, and counting a key over any frame range is O(1)
+ * once the prefix counts are up to date.
+ *
+ * The index is maintained incrementally by RecordPlayer. Prefix counts are
+ * rebuilt lazily from the first modified word when a count is requested.
+ */
+class RecordKeyIndex {
+public:
+    static constexpr size_t kKeyCount = 9;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * @brief Gets the index slot for a key name.
+     * @param keyName The key name (e.g., "up", "space").
+     * @return The key slot, or -1 if the name is unknown.
+     */
+    static int GetKeySlot(const std::string &keyName);
+
+    /**
+     * @brief Gets the key name for an index slot.
+     * @param slot The key slot.
+     * @return The key name, or an empty string if the slot is invalid.
+     */
+    static const char *GetKeyName(size_t slot);
+
+    /**
+     * @brief Clears the index and marks it as not built.
+     */
+    void Clear();
+
+    /**
+     * @brief Resets the index to the given number of frames with all keys released.
+     * @param frameCount Number of frames.
+     */
+    void Reset(size_t frameCount);
+
+    bool IsBuilt() const { return m_Built; }
+    size_t GetFrameCount() const { return m_FrameCount; }
+
+    /**
+     * @brief Updates the key bits of a frame. Does nothing if the index is not built.
+     * @param frame The frame number (0-based).
+     * @param keyState The new key state.
+     */
+    void SetFrame(size_t frame, const RecordKeyState &keyState);
+
+    /**
+     * @brief Inserts frames with all keys released. Does nothing if the index is not built.
+     * @param frame Insert position.
+     * @param count Number of frames to insert.
+     */
+    void Insert(size_t frame, size_t count);
+
+    /**
+     * @brief Erases frames. Does nothing if the index is not built.
+     * @param frame First frame to erase.
+     * @param count Number of frames to erase.
+     */
+    void Erase(size_t frame, size_t count);
+
+    /**
+     * @brief Checks whether a key is pressed in a frame.
+     * @param slot The key slot.
+     * @param frame The frame number (0-based).
+     * @return True if the key is pressed.
+     */
+    bool Test(size_t slot, size_t frame) const;
+
+    /**
+     * @brief Counts the frames where a key is pressed.
+     * @param slot The key slot.
+     * @param start First frame (inclusive).
+     * @param end Last frame (exclusive).
+     * @return Number of frames with the key pressed.
+     */
+    size_t Count(size_t slot, size_t start, size_t end) const;
+
+    /**
+     * @brief Collects the frames where all keys in a slot mask are pressed.
+     * @param slotMask Bit mask of key slots (bit i = slot i).
+     * @param start First frame (inclusive).
+     * @param end Last frame (exclusive).
+     * @param outFrames Receives the matching frame numbers.
+     */
+    void FindAll(uint32_t slotMask, size_t start, size_t end, std::vector<size_t> &outFrames) const;
+
+    /**
+     * @brief Finds the next frame where a key changes state.
+     * @param slot The key slot.
+     * @param start Frame whose state is the reference.
+     * @return The first frame after start with a different state, or npos.
+     */
+    size_t FindChange(size_t slot, size_t start) const;
+
+private:
+    static size_t WordCount(size_t frameCount) { return (frameCount + 63) / 64; }
+
+    size_t Rank(size_t slot, size_t frame) const;
+    void UpdatePrefix() const;
+    void InvalidatePrefix(size_t frame) { m_PrefixValidWords = std::min(m_PrefixValidWords, frame / 64); }
+
+    bool m_Built = false;
+    size_t m_FrameCount = 0;
+    std::vector<uint64_t> m_Bits[kKeyCount];
+
+    // m_Prefix[slot][w] = number of set bits in words [0, w)
+    mutable std::vector<uint32_t> m_Prefix[kKeyCount];
+    mutable size_t m_PrefixValidWords = 0;
+};
@@ -9,6 +9,7 @@
 #include "TASEngine.h"
 #include "TASProject.h"
 #include "GameInterface.h"
+#include "RecordTranslator.h"
 
 RecordPlayer::RecordPlayer(TASEngine *engine) : m_Engine(engine) {
     if (!m_Engine) {
@@ -58,8 +59,14 @@ void RecordPlayer::Stop() {
     m_IsPaused = false;
     m_CurrentFrame = 0;
     m_TotalFrames = 0;
-    m_Frames.clear();
-    m_Frames.shrink_to_fit();
+    m_Frames.Clear();
+    m_MainFrames.Clear();
+    m_CurrentBranch.clear();
+    m_Reader.reset();
+    m_KeyIndex.Clear();
+    m_SeekTarget = kNoSeekTarget;
+    ClearKeyframes();
+    ClearHistory();
 
     Log::Info("Record playback stopped.");
 }
@@ -93,8 +100,31 @@ bool RecordPlayer::Seek(size_t frame) {
         return false;
     }
 
-    m_CurrentFrame = frame;
-    Log::Info("Seeked to frame %zu.", frame);
+    // Restore a keyframe when going backward, or when it lies ahead of the playhead
+    const RecordKeyframe *keyframe = FindKeyframe(frame);
+    if (keyframe && (frame < m_CurrentFrame || keyframe->frame > m_CurrentFrame) && RestoreKeyframe(*keyframe)) {
+        m_CurrentFrame = keyframe->frame;
+    } else if (frame < m_CurrentFrame) {
+        Log::Warn("No keyframe at or before frame %zu; game state is not rewound.", frame);
+        m_CurrentFrame = frame;
+        m_SeekTarget = kNoSeekTarget;
+        return true;
+    }
+
+    if (frame == m_CurrentFrame) {
+        m_SeekTarget = kNoSeekTarget;
+        Log::Info("Seeked to frame %zu.", frame);
+        return true;
+    }
+
+    // Replay the remaining frames as fast as possible
+    m_SeekTarget = frame;
+    auto *gameInterface = m_Engine->GetGameInterface();
+    if (gameInterface) {
+        gameInterface->SkipRenderForTicks(frame - m_CurrentFrame);
+    }
+
+    Log::Info("Fast-forwarding from frame %zu to frame %zu.", m_CurrentFrame, frame);
     return true;
 }
 
@@ -147,90 +177,115 @@ void RecordPlayer::Tick(size_t currentTick, unsigned char *keyboardState) {
         return;
     }
 
+    CaptureKeyframe();
+
     // Apply input for the current frame
-    ApplyFrameInput(m_Frames[m_CurrentFrame], m_Frames[m_CurrentFrame + 1], keyboardState);
+    ApplyFrameInput(FrameAt(m_CurrentFrame), FrameAt(m_CurrentFrame + 1), keyboardState);
 
     // Advance to next frame
     m_CurrentFrame++;
+
+    if (m_SeekTarget != kNoSeekTarget && m_CurrentFrame >= m_SeekTarget) {
+        m_SeekTarget = kNoSeekTarget;
+        Log::Info("Seeked to frame %zu.", m_CurrentFrame);
+    }
 }
 
 float RecordPlayer::GetFrameDeltaTime(size_t currentTick) const {
     if (!m_IsPlaying || m_CurrentFrame >= m_TotalFrames) {
         return 1000.0f / 132.0f; // Default delta time
     }
-    return m_Frames[m_CurrentFrame].deltaTime;
+    return FrameAt(m_CurrentFrame).deltaTime;
 }
 
 bool RecordPlayer::LoadRecord(const std::string &recordPath) {
-    try {
-        Log::Info("Loading TAS record: %s", recordPath.c_str());
+    m_Frames.Clear();
+    m_MainFrames.Clear();
+    m_CurrentBranch.clear();
+    m_Reader.reset();
+    m_KeyIndex.Clear();
+    m_TotalFrames = 0;
+    m_SeekTarget = kNoSeekTarget;
+    ClearKeyframes();
 
-        // --- 1. Read the entire file ---
-        std::ifstream file(recordPath, std::ios::binary);
-        if (!file) {
-            Log::Error("Could not open record file: %s", recordPath.c_str());
-            return false;
-        }
+    // Journaled diffs refer to the previous record's frames
+    ClearHistory();
 
-        // --- 2. Read the 4-byte header for uncompressed size (legacy format) ---
-        uint32_t uncompressedSize;
-        file.read(reinterpret_cast<char *>(&uncompressedSize), sizeof(uncompressedSize));
-        if (file.gcount() != sizeof(uncompressedSize)) {
-            Log::Error("Failed to read uncompressed size header from file.");
-            return false;
-        }
+    if (!ChunkedRecordReader::IsChunkedRecord(recordPath)) {
+        return LoadLegacyRecord(recordPath);
+    }
 
-        if (uncompressedSize == 0) {
-            Log::Warn("Record file is empty.");
-            m_TotalFrames = 0;
-            m_Frames.clear();
-            return true; // Empty recording is technically valid
-        }
+    Log::Info("Loading chunked TAS record: %s", recordPath.c_str());
 
-        // The uncompressed data must be a multiple of the FrameData size.
-        if (uncompressedSize % sizeof(RecordFrameData) != 0) {
-            Log::Error(
-                "Uncompressed size is not a multiple of FrameData size. File may be corrupt.");
-            return false;
-        }
+    // Only the header and block index are read here; frame blocks are
+    // decompressed on demand around the playhead.
+    auto reader = std::make_unique<ChunkedRecordReader>();
+    if (!reader->Open(recordPath)) {
+        return false;
+    }
 
-        // --- 3. Read the compressed payload ---
-        file.seekg(0, std::ios::end);
-        std::streampos fileSize = file.tellg();
-        file.seekg(sizeof(uncompressedSize), std::ios::beg);
+    m_TotalFrames = reader->GetTotalFrames();
+    m_Reader = std::move(reader);
 
-        size_t compressedSize = static_cast<size_t>(fileSize) - sizeof(uncompressedSize);
-        std::vector<char> compressedData(compressedSize);
-        file.read(compressedData.data(), compressedSize);
-        if (static_cast<size_t>(file.gcount()) != compressedSize) {
-            Log::Error("Failed to read compressed data payload.");
-            return false;
-        }
-        file.close();
+    Log::Info("Record opened successfully: %zu frames in %zu blocks", m_TotalFrames, m_Reader->GetBlockCount());
+    return true;
+}
 
-        // --- 4. Decompress using CKUnPackData function ---
-        char *uncompressedData = CKUnPackData(static_cast<int>(uncompressedSize), compressedData.data(),
-                                              compressedSize);
-        if (!uncompressedData) {
-            Log::Error("Failed to decompress TAS record data using CKUnPackData.");
-            return false;
-        }
+bool RecordPlayer::LoadLegacyRecord(const std::string &recordPath) {
+    Log::Info("Loading TAS record: %s", recordPath.c_str());
 
-        // --- 5. Copy the decompressed data to our frame vector ---
-        size_t frameCount = uncompressedSize / sizeof(RecordFrameData);
-        m_TotalFrames = frameCount;
-        m_Frames.resize(frameCount + 1); // +1 for the next frame input
-        memcpy(m_Frames.data(), uncompressedData, uncompressedSize);
+    std::vector<RecordFrameData> frames;
+    if (!LegacyRecordReader::ReadAll(recordPath, frames)) {
+        m_TotalFrames = 0;
+        return false;
+    }
+
+    m_Frames.Assign(frames);
+    m_TotalFrames = m_Frames.GetSize();
+    Log::Info("Record loaded successfully: %zu frames in %zu runs", m_TotalFrames, m_Frames.GetRunCount());
+    return true;
+}
 
-        // Clean up the decompressed data
-        CKDeletePointer(uncompressedData);
+const RecordFrameData &RecordPlayer::FrameAt(size_t frame) const {
+    static const RecordFrameData blankFrame;
 
-        Log::Info("Record loaded successfully: %zu frames", m_TotalFrames);
+    if (frame >= m_TotalFrames) {
+        return blankFrame;
+    }
+
+    if (m_Reader) {
+        const RecordFrameData *data = m_Reader->GetFrame(frame);
+        return data ? *data : blankFrame;
+    }
+
+    return m_Frames.Get(frame, m_FrameCursor);
+}
+
+const RecordKeyIndex &RecordPlayer::GetKeyIndex() const {
+    if (!m_KeyIndex.IsBuilt()) {
+        m_KeyIndex.Reset(m_TotalFrames);
+        for (size_t i = 0; i < m_TotalFrames; ++i) {
+            m_KeyIndex.SetFrame(i, FrameAt(i).keyState);
+        }
+    }
+    return m_KeyIndex;
+}
+
+bool RecordPlayer::MaterializeFrames() {
+    if (!m_Reader) {
         return true;
-    } catch (const std::exception &e) {
-        Log::Error("Exception loading record: %s", e.what());
+    }
+
+    std::vector<RecordFrameData> frames;
+    if (!m_Reader->ReadAll(frames)) {
+        Log::Error("Failed to decompress record frames for editing.");
         return false;
     }
+
+    m_Frames.Assign(frames);
+
+    m_Reader.reset();
+    return true;
 }
 
 void RecordPlayer::ApplyFrameInput(const RecordFrameData &currentFrame,
@@ -246,25 +301,14 @@ void RecordPlayer::ApplyFrameInput(const RecordFrameData &currentFrame,
     const RecordKeyState &next = nextFrame.keyState;
 
     // Set keyboard state
-    keyboardState[m_KeyUp] = ConvertKeyState(current.key_up, next.key_up);
-    keyboardState[m_KeyDown] = ConvertKeyState(current.key_down, next.key_down);
-    keyboardState[m_KeyLeft] = ConvertKeyState(current.key_left, next.key_left);
-    keyboardState[m_KeyRight] = ConvertKeyState(current.key_right, next.key_right);
-    keyboardState[CKKEY_Q] = ConvertKeyState(current.key_q, next.key_q);
-    keyboardState[m_KeyShift] = ConvertKeyState(current.key_shift, next.key_shift);
-    keyboardState[m_KeySpace] = ConvertKeyState(current.key_space, next.key_space);
-    keyboardState[CKKEY_ESCAPE] = ConvertKeyState(current.key_esc, next.key_esc);
-}
-
-int RecordPlayer::ConvertKeyState(bool current, bool next) {
-    int state = KS_IDLE; // Default to idle state
-    if (current != KS_IDLE) {
-        state |= KS_PRESSED; // Key is currently pressed
-        if (next == KS_IDLE) {
-            state |= KS_RELEASED; // Key was just released
-        }
-    }
-    return state;
+    keyboardState[m_KeyUp] = RecordTranslator::ConvertKeyState(current.key_up, next.key_up);
+    keyboardState[m_KeyDown] = RecordTranslator::ConvertKeyState(current.key_down, next.key_down);
+    keyboardState[m_KeyLeft] = RecordTranslator::ConvertKeyState(current.key_left, next.key_left);
+    keyboardState[m_KeyRight] = RecordTranslator::ConvertKeyState(current.key_right, next.key_right);
+    keyboardState[CKKEY_Q] = RecordTranslator::ConvertKeyState(current.key_q, next.key_q);
+    keyboardState[m_KeyShift] = RecordTranslator::ConvertKeyState(current.key_shift, next.key_shift);
+    keyboardState[m_KeySpace] = RecordTranslator::ConvertKeyState(current.key_space, next.key_space);
+    keyboardState[CKKEY_ESCAPE] = RecordTranslator::ConvertKeyState(current.key_esc, next.key_esc);
 }
 
 // ===================================================================
@@ -282,7 +326,7 @@ bool RecordPlayer::GetFrameInput(size_t frame, RecordFrameData *outData) const {
         return false;
     }
 
-    *outData = m_Frames[frame];
+    *outData = FrameAt(frame);
     return true;
 }
 
@@ -292,8 +336,18 @@ bool RecordPlayer::SetFrameInput(size_t frame, const RecordFrameData &inputData)
         return false;
     }
 
-    m_Frames[frame] = inputData;
+    if (!MaterializeFrames()) {
+        return false;
+    }
+
+    const RecordFrameData previous = m_Frames.Get(frame);
+    m_Frames.Set(frame, inputData);
+    m_KeyIndex.SetFrame(frame, inputData.keyState);
+    InvalidateKeyframes(frame);
     m_IsModified = true;
+
+    PushFrameEdit(EditActionType::ModifyFrame, "Modify frame " + std::to_string(frame), frame,
+                  {previous}, {inputData});
     return true;
 }
 
@@ -303,12 +357,25 @@ bool RecordPlayer::SetFrameKey(size_t frame, const std::string &key, bool presse
         return false;
     }
 
-    if (!SetKeyStateBit(m_Frames[frame].keyState, key, pressed)) {
+    if (!MaterializeFrames()) {
+        return false;
+    }
+
+    const RecordFrameData previous = m_Frames.Get(frame);
+    RecordFrameData updated = previous;
+    if (!SetKeyStateBit(updated.keyState, key, pressed)) {
         Log::Error("SetFrameKey: invalid key name '%s'.", key.c_str());
         return false;
     }
 
+    m_Frames.Set(frame, updated);
+    m_KeyIndex.SetFrame(frame, updated.keyState);
+    InvalidateKeyframes(frame);
     m_IsModified = true;
+
+    PushFrameEdit(EditActionType::SetFrameKey,
+                  "Set key '" + key + "' at frame " + std::to_string(frame), frame,
+                  {previous}, {updated});
     return true;
 }
 
@@ -316,7 +383,7 @@ float RecordPlayer::GetFrameDeltaTimeByFrame(size_t frame) const {
     if (frame >= m_TotalFrames) {
         return 0.0f;
     }
-    return m_Frames[frame].deltaTime;
+    return FrameAt(frame).deltaTime;
 }
 
 bool RecordPlayer::SetFrameDeltaTime(size_t frame, float deltaTime) {
@@ -331,8 +398,19 @@ bool RecordPlayer::SetFrameDeltaTime(size_t frame, float deltaTime) {
         return false;
     }
 
-    m_Frames[frame].deltaTime = deltaTime;
+    if (!MaterializeFrames()) {
+        return false;
+    }
+
+    const RecordFrameData previous = m_Frames.Get(frame);
+    RecordFrameData updated = previous;
+    updated.deltaTime = deltaTime;
+    m_Frames.Set(frame, updated);
+    InvalidateKeyframes(frame);
     m_IsModified = true;
+
+    PushFrameEdit(EditActionType::SetDeltaTime, "Set delta time at frame " + std::to_string(frame), frame,
+                  {previous}, {updated});
     return true;
 }
 
@@ -351,15 +429,21 @@ bool RecordPlayer::InsertFrames(size_t startFrame, size_t count) {
         return false;
     }
 
+    if (!MaterializeFrames()) {
+        return false;
+    }
+
     // Create blank frames with default delta time
     RecordFrameData blankFrame;
-    blankFrame.deltaTime = m_TotalFrames > 0 ? m_Frames[0].deltaTime : (1000.0f / 132.0f);
+    blankFrame.deltaTime = m_TotalFrames > 0 ? m_Frames.Get(0).deltaTime : (1000.0f / 132.0f);
     blankFrame.keyStates = 0;
 
     // Insert blank frames at the specified position
-    m_Frames.insert(m_Frames.begin() + startFrame, count, blankFrame);
-    m_TotalFrames += count;
-    m_IsModified = true;
+    SpliceFrames(startFrame, 0, {blankFrame}, count);
+
+    PushFrameEdit(EditActionType::InsertFrames,
+                  "Insert " + std::to_string(count) + " frames at " + std::to_string(startFrame),
+                  startFrame, {}, {blankFrame}, count);
 
     Log::Info("Inserted %zu blank frames at position %zu.", count, startFrame);
     return true;
@@ -376,10 +460,18 @@ bool RecordPlayer::DeleteFrames(size_t startFrame, size_t count) {
         return false;
     }
 
+    if (!MaterializeFrames()) {
+        return false;
+    }
+
     size_t actualCount = std::min(count, m_TotalFrames - startFrame);
-    m_Frames.erase(m_Frames.begin() + startFrame, m_Frames.begin() + startFrame + actualCount);
-    m_TotalFrames -= actualCount;
-    m_IsModified = true;
+    std::vector<RecordFrameData> removed;
+    m_Frames.CopyRange(startFrame, actualCount, removed);
+    SpliceFrames(startFrame, actualCount, {}, 1);
+
+    PushFrameEdit(EditActionType::DeleteFrames,
+                  "Delete " + std::to_string(actualCount) + " frames at " + std::to_string(startFrame),
+                  startFrame, std::move(removed), {});
 
     Log::Info("Deleted %zu frames starting at position %zu.", actualCount, startFrame);
     return true;
@@ -402,20 +494,25 @@ bool RecordPlayer::CopyFrames(size_t srcStart, size_t destStart, size_t count) {
         return false;
     }
 
+    if (!MaterializeFrames()) {
+        return false;
+    }
+
     size_t actualCount = std::min(count, m_TotalFrames - srcStart);
 
     // Copy the frame range
-    std::vector<RecordFrameData> copiedFrames(m_Frames.begin() + srcStart, m_Frames.begin() + srcStart + actualCount);
+    std::vector<RecordFrameData> copiedFrames;
+    m_Frames.CopyRange(srcStart, actualCount, copiedFrames);
 
-    // Insert/overwrite at destination
-    if (destStart + actualCount > m_TotalFrames) {
-        // Extend the vector if necessary
-        m_Frames.resize(destStart + actualCount);
-        m_TotalFrames = destStart + actualCount;
-    }
+    // Overwrite at destination, extending the record past its end if necessary
+    size_t overwrittenCount = std::min(actualCount, m_TotalFrames - destStart);
+    std::vector<RecordFrameData> overwritten;
+    m_Frames.CopyRange(destStart, overwrittenCount, overwritten);
+    SpliceFrames(destStart, overwrittenCount, copiedFrames, 1);
 
-    std::copy(copiedFrames.begin(), copiedFrames.end(), m_Frames.begin() + destStart);
-    m_IsModified = true;
+    PushFrameEdit(EditActionType::CopyFrames,
+                  "Copy " + std::to_string(actualCount) + " frames to " + std::to_string(destStart),
+                  destStart, std::move(overwritten), std::move(copiedFrames));
 
     Log::Info("Copied %zu frames from %zu to %zu.", actualCount, srcStart, destStart);
     return true;
@@ -431,10 +528,16 @@ bool RecordPlayer::DuplicateFrame(size_t frame, size_t count) {
         return true;
     }
 
-    RecordFrameData frameData = m_Frames[frame];
-    m_Frames.insert(m_Frames.begin() + frame + 1, count, frameData);
-    m_TotalFrames += count;
-    m_IsModified = true;
+    if (!MaterializeFrames()) {
+        return false;
+    }
+
+    RecordFrameData frameData = m_Frames.Get(frame);
+    SpliceFrames(frame + 1, 0, {frameData}, count);
+
+    PushFrameEdit(EditActionType::DuplicateFrame,
+                  "Duplicate frame " + std::to_string(frame) + " x" + std::to_string(count),
+                  frame + 1, {}, {frameData}, count);
 
     Log::Info("Duplicated frame %zu %zu times.", frame, count);
     return true;
@@ -457,9 +560,7 @@ bool RecordPlayer::SeekRelative(int offset) {
         return false;
     }
 
-    m_CurrentFrame = static_cast<size_t>(newFrame);
-    Log::Info("Seeked relatively by %d to frame %zu.", offset, m_CurrentFrame);
-    return true;
+    return Seek(static_cast<size_t>(newFrame));
 }
 
 float RecordPlayer::GetProgress() const {
@@ -478,7 +579,7 @@ std::string RecordPlayer::GetInputString(size_t frame) const {
         return "";
     }
 
-    const RecordKeyState &keyState = m_Frames[frame].keyState;
+    const RecordKeyState &keyState = FrameAt(frame).keyState;
     std::string result;
 
     // Build a string representation of pressed keys
@@ -506,7 +607,7 @@ std::vector<std::string> RecordPlayer::GetPressedKeys(size_t frame) const {
         return keys;
     }
 
-    const RecordKeyState &keyState = m_Frames[frame].keyState;
+    const RecordKeyState &keyState = FrameAt(frame).keyState;
 
     if (keyState.key_up) keys.push_back("up");
     if (keyState.key_down) keys.push_back("down");
@@ -526,16 +627,13 @@ int RecordPlayer::FindInputChange(size_t startFrame, const std::string &key) con
         return -1;
     }
 
-    bool currentState = GetKeyStateBit(m_Frames[startFrame].keyState, key);
-
-    for (size_t i = startFrame + 1; i < m_TotalFrames; i++) {
-        bool newState = GetKeyStateBit(m_Frames[i].keyState, key);
-        if (newState != currentState) {
-            return static_cast<int>(i);
-        }
+    const int slot = RecordKeyIndex::GetKeySlot(key);
+    if (slot < 0) {
+        return -1; // Unknown keys never change
     }
 
-    return -1; // No change found
+    const size_t frame = GetKeyIndex().FindChange(static_cast<size_t>(slot), startFrame);
+    return frame == RecordKeyIndex::npos ? -1 : static_cast<int>(frame);
 }
 
 // ===================================================================
@@ -547,8 +645,9 @@ bool RecordPlayer::CompareFrames(size_t frame1, size_t frame2) const {
         return false;
     }
 
-    const RecordFrameData &f1 = m_Frames[frame1];
-    const RecordFrameData &f2 = m_Frames[frame2];
+    // Copy both frames: they may live in different streamed blocks
+    const RecordFrameData f1 = FrameAt(frame1);
+    const RecordFrameData f2 = FrameAt(frame2);
 
     return f1.deltaTime == f2.deltaTime && f1.keyStates == f2.keyStates;
 }
@@ -561,8 +660,9 @@ bool RecordPlayer::Validate() const {
 
     // Check for valid delta times
     for (size_t i = 0; i < m_TotalFrames; i++) {
-        if (m_Frames[i].deltaTime <= 0.0f) {
-            Log::Error("Validate: frame %zu has invalid delta time %.3f.", i, m_Frames[i].deltaTime);
+        const float deltaTime = FrameAt(i).deltaTime;
+        if (deltaTime <= 0.0f) {
+            Log::Error("Validate: frame %zu has invalid delta time %.3f.", i, deltaTime);
             return false;
         }
     }
@@ -575,13 +675,31 @@ bool RecordPlayer::Validate() const {
 // Save & Export Operations Implementation
 // ===================================================================
 
-bool RecordPlayer::Save(const std::string &path) {
+bool RecordPlayer::Save(const std::string &path, bool legacyFormat) {
     try {
         Log::Info("Saving record to: %s", path.c_str());
 
+        if (!MaterializeFrames()) {
+            return false;
+        }
+
+        // Both formats serialize a flat frame array
+        std::vector<RecordFrameData> frames;
+        m_Frames.CopyRange(0, m_TotalFrames, frames);
+
+        if (!legacyFormat) {
+            if (!ChunkedRecordWriter::Write(path, frames.data(), m_TotalFrames)) {
+                return false;
+            }
+
+            m_IsModified = false;
+            Log::Info("Record saved successfully: %zu frames.", m_TotalFrames);
+            return true;
+        }
+
         // Prepare uncompressed data
         size_t uncompressedSize = m_TotalFrames * sizeof(RecordFrameData);
-        const char *uncompressedData = reinterpret_cast<const char *>(m_Frames.data());
+        const char *uncompressedData = reinterpret_cast<const char *>(frames.data());
 
         // Compress data using CKPackData
         int compressedSize = 0;
@@ -635,7 +753,7 @@ bool RecordPlayer::ExportInputs(const std::string &path, const std::string &form
             // Plain text format
             file << "Frame,DeltaTime,Keys\n";
             for (size_t i = 0; i < m_TotalFrames; i++) {
-                file << i << "," << m_Frames[i].deltaTime << "," << GetInputString(i) << "\n";
+                file << i << "," << FrameAt(i).deltaTime << "," << GetInputString(i) << "\n";
             }
         } else if (format == "json") {
             // JSON format
@@ -645,7 +763,7 @@ bool RecordPlayer::ExportInputs(const std::string &path, const std::string &form
             for (size_t i = 0; i < m_TotalFrames; i++) {
                 file << "    {\n";
                 file << "      \"frame\": " << i << ",\n";
-                file << "      \"deltaTime\": " << m_Frames[i].deltaTime << ",\n";
+                file << "      \"deltaTime\": " << FrameAt(i).deltaTime << ",\n";
                 file << "      \"keys\": [";
 
                 auto keys = GetPressedKeys(i);
@@ -679,19 +797,6 @@ bool RecordPlayer::ExportInputs(const std::string &path, const std::string &form
 // Helper Methods Implementation
 // ===================================================================
 
-bool RecordPlayer::GetKeyStateBit(const RecordKeyState &keyState, const std::string &keyName) {
-    if (keyName == "up") return keyState.key_up;
-    if (keyName == "down") return keyState.key_down;
-    if (keyName == "left") return keyState.key_left;
-    if (keyName == "right") return keyState.key_right;
-    if (keyName == "shift") return keyState.key_shift;
-    if (keyName == "space") return keyState.key_space;
-    if (keyName == "q") return keyState.key_q;
-    if (keyName == "esc") return keyState.key_esc;
-    if (keyName == "enter") return keyState.key_enter;
-    return false;
-}
-
 bool RecordPlayer::SetKeyStateBit(RecordKeyState &keyState, const std::string &keyName, bool pressed) {
     if (keyName == "up") {
         keyState.key_up = pressed;
@@ -755,7 +860,7 @@ bool RecordPlayer::AddSection(size_t startFrame, size_t endFrame, const std::str
     section.color = color;
 
     m_Sections[name] = section;
-    PushUndoAction(EditActionType::AddSection, "Add section: " + name);
+    PushSectionEdit(EditActionType::AddSection, "Add section: " + name, std::nullopt, section);
 
     Log::Info("Added section '%s' [%zu-%zu]", name.c_str(), startFrame, endFrame);
     return true;
@@ -767,8 +872,9 @@ bool RecordPlayer::RemoveSection(const std::string &name) {
         return false;
     }
 
+    RecordSection removed = std::move(it->second);
     m_Sections.erase(it);
-    PushUndoAction(EditActionType::RemoveSection, "Remove section: " + name);
+    PushSectionEdit(EditActionType::RemoveSection, "Remove section: " + name, std::move(removed), std::nullopt);
 
     Log::Info("Removed section '%s'", name.c_str());
     return true;
@@ -809,11 +915,14 @@ bool RecordPlayer::RenameSection(const std::string &oldName, const std::string &
         return false;
     }
 
+    RecordSection previous = it->second;
     RecordSection section = it->second;
     section.name = newName;
     m_Sections.erase(it);
     m_Sections[newName] = section;
 
+    PushSectionEdit(EditActionType::ModifySection, "Rename section: " + oldName + " -> " + newName,
+                    std::move(previous), std::move(section));
     return true;
 }
 
@@ -830,9 +939,11 @@ bool RecordPlayer::MoveSection(const std::string &name, size_t newStartFrame) {
         return false;
     }
 
+    RecordSection previous = it->second;
     it->second.startFrame = newStartFrame;
     it->second.endFrame = newEndFrame;
 
+    PushSectionEdit(EditActionType::ModifySection, "Move section: " + name, std::move(previous), it->second);
     return true;
 }
 
@@ -846,9 +957,11 @@ bool RecordPlayer::ResizeSection(const std::string &name, size_t newStartFrame,
         return false;
     }
 
+    RecordSection previous = it->second;
     it->second.startFrame = newStartFrame;
     it->second.endFrame = newEndFrame;
 
+    PushSectionEdit(EditActionType::ModifySection, "Resize section: " + name, std::move(previous), it->second);
     return true;
 }
 
@@ -870,7 +983,7 @@ bool RecordPlayer::AddMarker(size_t frame, const std::string &name, MarkerType t
     marker.color = color;
 
     m_Markers[name] = marker;
-    PushUndoAction(EditActionType::AddMarker, "Add marker: " + name);
+    PushMarkerEdit(EditActionType::AddMarker, "Add marker: " + name, std::nullopt, marker);
 
     Log::Info("Added marker '%s' at frame %zu", name.c_str(), frame);
     return true;
@@ -882,8 +995,9 @@ bool RecordPlayer::RemoveMarker(const std::string &name) {
         return false;
     }
 
+    RecordMarker removed = std::move(it->second);
     m_Markers.erase(it);
-    PushUndoAction(EditActionType::RemoveMarker, "Remove marker: " + name);
+    PushMarkerEdit(EditActionType::RemoveMarker, "Remove marker: " + name, std::move(removed), std::nullopt);
 
     Log::Info("Removed marker '%s'", name.c_str());
     return true;
@@ -934,11 +1048,14 @@ bool RecordPlayer::RenameMarker(const std::string &oldName, const std::string &n
         return false;
     }
 
+    RecordMarker previous = it->second;
     RecordMarker marker = it->second;
     marker.name = newName;
     m_Markers.erase(it);
     m_Markers[newName] = marker;
 
+    PushMarkerEdit(EditActionType::ModifyMarker, "Rename marker: " + oldName + " -> " + newName,
+                   std::move(previous), std::move(marker));
     return true;
 }
 
@@ -948,7 +1065,10 @@ bool RecordPlayer::MoveMarker(const std::string &name, size_t newFrame) {
         return false;
     }
 
+    RecordMarker previous = it->second;
     it->second.frame = newFrame;
+
+    PushMarkerEdit(EditActionType::ModifyMarker, "Move marker: " + name, std::move(previous), it->second);
     return true;
 }
 
@@ -1004,7 +1124,8 @@ size_t RecordPlayer::AddComment(size_t frame, const std::string &text,
     comment.category = category;
 
     m_Comments.push_back(comment);
-    PushUndoAction(EditActionType::AddComment, "Add comment at frame " + std::to_string(frame));
+    PushCommentEdit(EditActionType::AddComment, "Add comment at frame " + std::to_string(frame),
+                    m_Comments.size() - 1, std::nullopt, comment);
 
     return m_Comments.size() - 1;
 }
@@ -1017,7 +1138,7 @@ size_t RecordPlayer::AddRangeComment(size_t startFrame, size_t endFrame, const s
     comment.category = category;
 
     m_Comments.push_back(comment);
-    PushUndoAction(EditActionType::AddComment, "Add range comment");
+    PushCommentEdit(EditActionType::AddComment, "Add range comment", m_Comments.size() - 1, std::nullopt, comment);
 
     return m_Comments.size() - 1;
 }
@@ -1027,8 +1148,9 @@ bool RecordPlayer::RemoveComment(size_t index) {
         return false;
     }
 
+    RecordComment removed = std::move(m_Comments[index]);
     m_Comments.erase(m_Comments.begin() + index);
-    PushUndoAction(EditActionType::RemoveComment, "Remove comment");
+    PushCommentEdit(EditActionType::RemoveComment, "Remove comment", index, std::move(removed), std::nullopt);
 
     return true;
 }
@@ -1059,9 +1181,11 @@ bool RecordPlayer::EditComment(size_t index, const std::string &newText) {
         return false;
     }
 
+    RecordComment previous = m_Comments[index];
     m_Comments[index].text = newText;
     m_Comments[index].timestamp = std::time(nullptr);
 
+    PushCommentEdit(EditActionType::ModifyComment, "Edit comment", index, std::move(previous), m_Comments[index]);
     return true;
 }
 
@@ -1078,12 +1202,15 @@ bool RecordPlayer::SaveMacro(const std::string &name, size_t startFrame, size_t
         return false;
     }
 
-    RecordMacro macro(name, description);
-    macro.frames.assign(m_Frames.begin() + startFrame, m_Frames.begin() + endFrame + 1);
+    if (!MaterializeFrames()) {
+        return false;
+    }
 
-    m_Macros[name] = macro;
+    RecordMacro macro(name, description);
+    macro.frames = m_Frames.Slice(startFrame, endFrame - startFrame + 1);
 
-    Log::Info("Saved macro '%s' (%zu frames)", name.c_str(), macro.frames.size());
+    Log::Info("Saved macro '%s' (%zu frames)", name.c_str(), macro.frames.GetSize());
+    m_Macros[name] = std::move(macro);
     return true;
 }
 
@@ -1118,21 +1245,30 @@ bool RecordPlayer::InsertMacro(const std::string &name, size_t atFrame, size_t r
         return false;
     }
 
-    const auto &macro = it->second;
-    size_t totalFrames = macro.frames.size() * repeatCount;
+    if (atFrame > m_TotalFrames) {
+        Log::Error("InsertMacro: frame %zu is out of bounds (total: %zu).", atFrame, m_TotalFrames);
+        return false;
+    }
 
-    // Insert frames
-    m_Frames.insert(m_Frames.begin() + atFrame, totalFrames, RecordFrameData());
+    if (!MaterializeFrames()) {
+        return false;
+    }
 
-    // Copy macro data
-    for (size_t i = 0; i < repeatCount; ++i) {
-        std::copy(macro.frames.begin(), macro.frames.end(),
-                  m_Frames.begin() + atFrame + i * macro.frames.size());
+    const auto &macro = it->second;
+    if (macro.frames.IsEmpty() || repeatCount == 0) {
+        return true;
     }
 
-    m_TotalFrames = m_Frames.size();
+    std::vector<RecordFrameData> pattern;
+    macro.frames.CopyRange(0, macro.frames.GetSize(), pattern);
+
+    SpliceFrames(atFrame, 0, pattern, repeatCount);
     UpdateMetadataStats();
 
+    PushFrameEdit(EditActionType::InsertMacro,
+                  "Insert macro '" + name + "' x" + std::to_string(repeatCount) + " at " + std::to_string(atFrame),
+                  atFrame, {}, std::move(pattern), repeatCount);
+
     Log::Info("Inserted macro '%s' x%zu at frame %zu", name.c_str(), repeatCount, atFrame);
     return true;
 }
@@ -1177,18 +1313,55 @@ void RecordPlayer::RemoveTag(const std::string &tag) {
 
 // --- Undo/Redo System ---
 
+size_t EditAction::ByteSize() const {
+    auto metadataBytes = [](const std::unordered_map<std::string, std::string> &metadata) {
+        size_t bytes = 0;
+        for (const auto &pair : metadata) {
+            bytes += pair.first.size() + pair.second.size();
+        }
+        return bytes;
+    };
+
+    size_t bytes = sizeof(EditAction) + description.size();
+    bytes += (before.size() + after.size()) * sizeof(RecordFrameData);
+
+    for (const auto *section : {&sectionBefore, &sectionAfter}) {
+        if (*section) {
+            bytes += (*section)->name.size() + (*section)->description.size() + (*section)->color.size() +
+                     metadataBytes((*section)->metadata);
+        }
+    }
+    for (const auto *marker : {&markerBefore, &markerAfter}) {
+        if (*marker) {
+            bytes += (*marker)->name.size() + (*marker)->description.size() + (*marker)->color.size() +
+                     metadataBytes((*marker)->metadata);
+        }
+    }
+    for (const auto *comment : {&commentBefore, &commentAfter}) {
+        if (*comment) {
+            bytes += (*comment)->text.size() + (*comment)->author.size() + (*comment)->category.size();
+        }
+    }
+
+    return bytes;
+}
+
 bool RecordPlayer::Undo() {
     if (m_UndoStack.empty()) {
         return false;
     }
 
-    // For now, basic implementation - just clear redo stack and notify
-    // Full implementation would need to serialize/deserialize state
-    EditAction action = m_UndoStack.back();
+    if (!MaterializeFrames()) {
+        return false;
+    }
+
+    EditAction action = std::move(m_UndoStack.back());
     m_UndoStack.pop_back();
-    m_RedoStack.push_back(action);
+
+    ApplyEdit(action, false);
 
     Log::Info("Undo: %s", action.description.c_str());
+    m_RedoStack.push_back(std::move(action));
     return true;
 }
 
@@ -1197,11 +1370,17 @@ bool RecordPlayer::Redo() {
         return false;
     }
 
-    EditAction action = m_RedoStack.back();
+    if (!MaterializeFrames()) {
+        return false;
+    }
+
+    EditAction action = std::move(m_RedoStack.back());
     m_RedoStack.pop_back();
-    m_UndoStack.push_back(action);
+
+    ApplyEdit(action, true);
 
     Log::Info("Redo: %s", action.description.c_str());
+    m_UndoStack.push_back(std::move(action));
     return true;
 }
 
@@ -1216,6 +1395,17 @@ std::string RecordPlayer::GetRedoDescription() const {
 void RecordPlayer::ClearHistory() {
     m_UndoStack.clear();
     m_RedoStack.clear();
+    m_HistoryBytes = 0;
+}
+
+void RecordPlayer::SetMaxHistorySize(size_t size) {
+    m_MaxHistorySize = size;
+    TrimHistory();
+}
+
+void RecordPlayer::SetMaxHistoryBytes(size_t bytes) {
+    m_MaxHistoryBytes = bytes;
+    TrimHistory();
 }
 
 // --- Search & Filter ---
@@ -1232,33 +1422,24 @@ std::vector<size_t> RecordPlayer::FindFramesWithKeys(const std::string &keyStrin
         return result;
     }
 
-    // Parse key string (simplified - assumes format like "up+space")
-    std::vector<std::string> keys;
+    // Parse key string (simplified - assumes format like "up+space") into a key slot mask
+    uint32_t slotMask = 0;
     size_t pos = 0;
-    std::string temp = keyString;
-    while ((pos = temp.find('+')) != std::string::npos) {
-        keys.push_back(temp.substr(0, pos));
-        temp.erase(0, pos + 1);
-    }
-    keys.push_back(temp);
-
-    // Search frames
-    for (size_t i = startFrame; i <= endFrame; ++i) {
-        const auto &frame = m_Frames[i];
-        bool allMatch = true;
-
-        for (const auto &key : keys) {
-            if (!GetKeyStateBit(frame.keyState, key)) {
-                allMatch = false;
-                break;
-            }
+    while (pos <= keyString.size()) {
+        size_t next = keyString.find('+', pos);
+        if (next == std::string::npos) {
+            next = keyString.size();
         }
 
-        if (allMatch) {
-            result.push_back(i);
+        const int slot = RecordKeyIndex::GetKeySlot(keyString.substr(pos, next - pos));
+        if (slot < 0) {
+            return result; // Unknown keys never match
         }
+        slotMask |= 1u << slot;
+        pos = next + 1;
     }
 
+    GetKeyIndex().FindAll(slotMask, startFrame, endFrame + 1, result);
     return result;
 }
 
@@ -1266,7 +1447,7 @@ std::vector<size_t> RecordPlayer::FindFramesByDeltaTime(float deltaTime, float t
     std::vector<size_t> result;
 
     for (size_t i = 0; i < m_TotalFrames; ++i) {
-        if (std::abs(m_Frames[i].deltaTime - deltaTime) <= tolerance) {
+        if (std::abs(FrameAt(i).deltaTime - deltaTime) <= tolerance) {
             result.push_back(i);
         }
     }
@@ -1292,24 +1473,12 @@ std::unordered_map<std::string, float> RecordPlayer::GetStatistics(size_t startF
     float totalTime = 0.0f;
     float minDelta = std::numeric_limits<float>::max();
     float maxDelta = 0.0f;
-    std::unordered_map<std::string, size_t> inputCounts;
 
     for (size_t i = startFrame; i <= endFrame; ++i) {
-        const auto &frame = m_Frames[i];
+        const auto &frame = FrameAt(i);
         totalTime += frame.deltaTime;
         minDelta = std::min(minDelta, frame.deltaTime);
         maxDelta = std::max(maxDelta, frame.deltaTime);
-
-        // Count inputs
-        if (frame.keyState.key_up) inputCounts["up"]++;
-        if (frame.keyState.key_down) inputCounts["down"]++;
-        if (frame.keyState.key_left) inputCounts["left"]++;
-        if (frame.keyState.key_right) inputCounts["right"]++;
-        if (frame.keyState.key_shift) inputCounts["shift"]++;
-        if (frame.keyState.key_space) inputCounts["space"]++;
-        if (frame.keyState.key_q) inputCounts["q"]++;
-        if (frame.keyState.key_esc) inputCounts["esc"]++;
-        if (frame.keyState.key_enter) inputCounts["enter"]++;
     }
 
     size_t frameCount = endFrame - startFrame + 1;
@@ -1322,8 +1491,12 @@ std::unordered_map<std::string, float> RecordPlayer::GetStatistics(size_t startF
     stats["max_delta_time"] = maxDelta;
 
     // Store input counts (using floats for consistency)
-    for (const auto &pair : inputCounts) {
-        stats["input_" + pair.first] = static_cast<float>(pair.second);
+    const RecordKeyIndex &keyIndex = GetKeyIndex();
+    for (size_t slot = 0; slot < RecordKeyIndex::kKeyCount; ++slot) {
+        const size_t count = keyIndex.Count(slot, startFrame, endFrame + 1);
+        if (count > 0) {
+            stats[std::string("input_") + RecordKeyIndex::GetKeyName(slot)] = static_cast<float>(count);
+        }
     }
 
     return stats;
@@ -1342,16 +1515,20 @@ bool RecordPlayer::CreateBranch(const std::string &name, size_t divergenceFrame,
         return false;
     }
 
+    if (!MaterializeFrames()) {
+        return false;
+    }
+
     RecordBranch branch;
     branch.name = name;
     branch.description = description;
     branch.divergenceFrame = divergenceFrame;
     branch.parentBranch = m_CurrentBranch;
 
-    // Copy frames from divergence point
-    branch.frames.assign(m_Frames.begin() + divergenceFrame, m_Frames.end());
+    // The branch starts as the current timeline; blocks are copied only once either side edits them
+    branch.frames = m_Frames;
 
-    m_Branches[name] = branch;
+    m_Branches[name] = std::move(branch);
 
     Log::Info("Created branch '%s' at frame %zu", name.c_str(), divergenceFrame);
     return true;
@@ -1363,28 +1540,52 @@ bool RecordPlayer::DeleteBranch(const std::string &name) {
         return false;
     }
 
+    if (name == m_CurrentBranch) {
+        Log::Error("Cannot delete the current branch '%s'.", name.c_str());
+        return false;
+    }
+
     m_Branches.erase(it);
     Log::Info("Deleted branch '%s'", name.c_str());
     return true;
 }
 
 bool RecordPlayer::SwitchBranch(const std::string &name) {
-    if (name.empty()) {
-        // Switch to main branch
-        m_CurrentBranch = "";
+    if (name == m_CurrentBranch) {
         return true;
     }
 
     auto it = m_Branches.find(name);
-    if (it == m_Branches.end()) {
+    if (!name.empty() && it == m_Branches.end()) {
+        return false;
+    }
+
+    if (!MaterializeFrames()) {
         return false;
     }
 
-    // Switch to branch
+    // Park the current frames with the branch being left and take the target's;
+    // only the block tables move
+    RecordFrameStore &target = name.empty() ? m_MainFrames : it->second.frames;
+    RecordFrameStore &current = m_CurrentBranch.empty() ? m_MainFrames : m_Branches[m_CurrentBranch].frames;
+    current = std::move(m_Frames);
+    m_Frames = std::move(target);
+    target.Clear();
+
     m_CurrentBranch = name;
-    // In a full implementation, would swap frames here
+    m_TotalFrames = m_Frames.GetSize();
+    m_CurrentFrame = std::min(m_CurrentFrame, m_TotalFrames);
+    m_SeekTarget = kNoSeekTarget;
+    m_KeyIndex.Clear();
+    ClearKeyframes();
+
+    // Journaled diffs refer to the previous branch's frames
+    ClearHistory();
 
-    Log::Info("Switched to branch '%s'", name.c_str());
+    m_IsModified = true;
+    UpdateMetadataStats();
+
+    Log::Info("Switched to branch '%s' (%zu frames)", name.empty() ? "main" : name.c_str(), m_TotalFrames);
     return true;
 }
 
@@ -1393,6 +1594,11 @@ std::vector<RecordBranch> RecordPlayer::GetAllBranches() const {
     result.reserve(m_Branches.size());
     for (const auto &pair : m_Branches) {
         result.push_back(pair.second);
+
+        // The current branch's frames are the ones being played and edited
+        if (pair.first == m_CurrentBranch) {
+            result.back().frames = m_Frames;
+        }
     }
     return result;
 }
@@ -1441,27 +1647,299 @@ std::vector<SavestateLink> RecordPlayer::GetAllSavestateLinks() const {
 
 // --- Helper Methods ---
 
-void RecordPlayer::PushUndoAction(EditActionType type, const std::string &description) {
-    EditAction action(type, description);
-    m_UndoStack.push_back(action);
-
-    // Clear redo stack when new action is performed
+void RecordPlayer::PushUndoAction(EditAction action) {
+    // A new edit invalidates everything that could be redone
+    for (const auto &redo : m_RedoStack) {
+        m_HistoryBytes -= redo.ByteSize();
+    }
     m_RedoStack.clear();
 
-    // Limit undo stack size
-    if (m_UndoStack.size() > m_MaxHistorySize) {
-        m_UndoStack.erase(m_UndoStack.begin());
+    m_HistoryBytes += action.ByteSize();
+    m_UndoStack.push_back(std::move(action));
+
+    TrimHistory();
+}
+
+void RecordPlayer::PushFrameEdit(EditActionType type, std::string description, size_t frame,
+                                 std::vector<RecordFrameData> before, std::vector<RecordFrameData> after,
+                                 size_t afterRepeat) {
+    EditAction action(type, std::move(description));
+    action.frame = frame;
+    action.before = std::move(before);
+    action.after = std::move(after);
+    action.afterRepeat = afterRepeat;
+    PushUndoAction(std::move(action));
+}
+
+void RecordPlayer::PushSectionEdit(EditActionType type, std::string description,
+                                   std::optional<RecordSection> before, std::optional<RecordSection> after) {
+    EditAction action(type, std::move(description));
+    action.sectionBefore = std::move(before);
+    action.sectionAfter = std::move(after);
+    PushUndoAction(std::move(action));
+}
+
+void RecordPlayer::PushMarkerEdit(EditActionType type, std::string description,
+                                  std::optional<RecordMarker> before, std::optional<RecordMarker> after) {
+    EditAction action(type, std::move(description));
+    action.markerBefore = std::move(before);
+    action.markerAfter = std::move(after);
+    PushUndoAction(std::move(action));
+}
+
+void RecordPlayer::PushCommentEdit(EditActionType type, std::string description, size_t index,
+                                   std::optional<RecordComment> before, std::optional<RecordComment> after) {
+    EditAction action(type, std::move(description));
+    action.commentIndex = index;
+    action.commentBefore = std::move(before);
+    action.commentAfter = std::move(after);
+    PushUndoAction(std::move(action));
+}
+
+void RecordPlayer::TrimHistory() {
+    // Discard the oldest undo actions first; the redo journal is always newer
+    while (!m_UndoStack.empty() &&
+           (m_UndoStack.size() > m_MaxHistorySize || m_HistoryBytes > m_MaxHistoryBytes)) {
+        m_HistoryBytes -= m_UndoStack.front().ByteSize();
+        m_UndoStack.pop_front();
+    }
+
+    // Redo actions count against the same budget; drop the furthest one first
+    while (!m_RedoStack.empty() && m_HistoryBytes > m_MaxHistoryBytes) {
+        m_HistoryBytes -= m_RedoStack.front().ByteSize();
+        m_RedoStack.pop_front();
+    }
+}
+
+void RecordPlayer::ApplyEdit(const EditAction &action, bool redo) {
+    if (!action.before.empty() || !action.after.empty()) {
+        if (redo) {
+            SpliceFrames(action.frame, action.before.size(), action.after, action.afterRepeat);
+        } else {
+            SpliceFrames(action.frame, action.after.size() * action.afterRepeat, action.before, 1);
+        }
+    }
+
+    const auto &sectionFrom = redo ? action.sectionBefore : action.sectionAfter;
+    const auto &sectionTo = redo ? action.sectionAfter : action.sectionBefore;
+    if (sectionFrom) {
+        m_Sections.erase(sectionFrom->name);
+    }
+    if (sectionTo) {
+        m_Sections[sectionTo->name] = *sectionTo;
+    }
+
+    const auto &markerFrom = redo ? action.markerBefore : action.markerAfter;
+    const auto &markerTo = redo ? action.markerAfter : action.markerBefore;
+    if (markerFrom) {
+        m_Markers.erase(markerFrom->name);
+    }
+    if (markerTo) {
+        m_Markers[markerTo->name] = *markerTo;
+    }
+
+    const auto &commentFrom = redo ? action.commentBefore : action.commentAfter;
+    const auto &commentTo = redo ? action.commentAfter : action.commentBefore;
+    const size_t index = action.commentIndex;
+    if (commentFrom && commentTo) {
+        if (index < m_Comments.size()) {
+            m_Comments[index] = *commentTo;
+        }
+    } else if (commentFrom) {
+        if (index < m_Comments.size()) {
+            m_Comments.erase(m_Comments.begin() + index);
+        }
+    } else if (commentTo) {
+        m_Comments.insert(m_Comments.begin() + std::min(index, m_Comments.size()), *commentTo);
+    }
+}
+
+void RecordPlayer::SpliceFrames(size_t frame, size_t removeCount,
+                                const std::vector<RecordFrameData> &insert, size_t insertRepeat) {
+    const size_t insertCount = insert.size() * insertRepeat;
+
+    frame = std::min(frame, m_Frames.GetSize());
+    removeCount = std::min(removeCount, m_Frames.GetSize() - frame);
+
+    // Only the runs around the spliced range are rewritten; the tail is not shifted
+    m_Frames.Splice(frame, removeCount, insert, insertRepeat);
+
+    if (m_KeyIndex.IsBuilt()) {
+        if (removeCount > insertCount) {
+            m_KeyIndex.Erase(frame + insertCount, removeCount - insertCount);
+        } else if (removeCount < insertCount) {
+            m_KeyIndex.Insert(frame + removeCount, insertCount - removeCount);
+        }
+        for (size_t i = 0; i < insertCount; ++i) {
+            m_KeyIndex.SetFrame(frame + i, insert[i % insert.size()].keyState);
+        }
     }
+
+    InvalidateKeyframes(frame);
+
+    m_TotalFrames = m_Frames.GetSize();
+    m_IsModified = true;
 }
 
 void RecordPlayer::UpdateMetadataStats() {
     m_Metadata.totalFrames = m_TotalFrames;
 
     float totalTime = 0.0f;
-    for (const auto &frame : m_Frames) {
-        totalTime += frame.deltaTime;
-    }
+    m_Frames.ForEachRun([&totalTime](size_t length, const RecordFrameData &frame) {
+        totalTime += frame.deltaTime * static_cast<float>(length);
+    });
     m_Metadata.totalTimeSeconds = totalTime / 1000.0f;
 
     m_Metadata.modifiedAt = std::time(nullptr);
 }
+
+// ===================================================================
+// Keyframes Implementation
+// ===================================================================
+
+void RecordPlayer::SetKeyframeInterval(size_t interval) {
+    m_KeyframeInterval = interval;
+    m_EffectiveKeyframeInterval = interval;
+    if (interval == 0) {
+        ClearKeyframes();
+        return;
+    }
+
+    // Keep only the keyframes that lie on the new grid
+    std::erase_if(m_Keyframes, [interval](const RecordKeyframe &keyframe) {
+        return keyframe.frame % interval != 0;
+    });
+    EnforceKeyframeBudget();
+}
+
+void RecordPlayer::SetKeyframeBudget(size_t bytes) {
+    m_KeyframeBudget = bytes;
+    EnforceKeyframeBudget();
+}
+
+void RecordPlayer::ClearKeyframes() {
+    m_Keyframes.clear();
+    m_Keyframes.shrink_to_fit();
+    m_EffectiveKeyframeInterval = m_KeyframeInterval;
+}
+
+void RecordPlayer::CaptureKeyframe() {
+    if (m_EffectiveKeyframeInterval == 0 || m_CurrentFrame % m_EffectiveKeyframeInterval != 0) {
+        return;
+    }
+
+    auto it = std::lower_bound(m_Keyframes.begin(), m_Keyframes.end(), m_CurrentFrame,
+                               [](const RecordKeyframe &keyframe, size_t frame) { return keyframe.frame < frame; });
+    if (it != m_Keyframes.end() && it->frame == m_CurrentFrame) {
+        return;
+    }
+
+    auto *gameInterface = m_Engine->GetGameInterface();
+    if (!gameInterface) {
+        return;
+    }
+
+    CK3dEntity *ball = gameInterface->GetActiveBall();
+    if (!ball) {
+        return;
+    }
+
+    const VxVector position = gameInterface->GetPosition(ball);
+    const VxQuaternion rotation = gameInterface->GetRotation(ball);
+    const VxVector velocity = gameInterface->GetVelocity(ball);
+    const VxVector angularVelocity = gameInterface->GetAngularVelocity(ball);
+    const RNGState rng = gameInterface->GetRNGState();
+
+    RecordKeyframe keyframe;
+    keyframe.frame = m_CurrentFrame;
+    keyframe.tick = m_Engine->GetCurrentTick();
+    keyframe.position[0] = position.x;
+    keyframe.position[1] = position.y;
+    keyframe.position[2] = position.z;
+    keyframe.rotation[0] = rotation.x;
+    keyframe.rotation[1] = rotation.y;
+    keyframe.rotation[2] = rotation.z;
+    keyframe.rotation[3] = rotation.w;
+    keyframe.velocity[0] = velocity.x;
+    keyframe.velocity[1] = velocity.y;
+    keyframe.velocity[2] = velocity.z;
+    keyframe.angularVelocity[0] = angularVelocity.x;
+    keyframe.angularVelocity[1] = angularVelocity.y;
+    keyframe.angularVelocity[2] = angularVelocity.z;
+    keyframe.rngId = rng.id;
+    keyframe.rngNextMovementCheck = rng.next_movement_check;
+    keyframe.rngIvpSeed = rng.ivp_seed;
+    keyframe.rngQhSeed = rng.qh_seed;
+
+    m_Keyframes.insert(it, keyframe);
+    EnforceKeyframeBudget();
+}
+
+bool RecordPlayer::RestoreKeyframe(const RecordKeyframe &keyframe) {
+    auto *gameInterface = m_Engine->GetGameInterface();
+    if (!gameInterface) {
+        return false;
+    }
+
+    CK3dEntity *ball = gameInterface->GetActiveBall();
+    if (!ball) {
+        Log::Warn("Cannot restore keyframe at frame %zu: no active ball.", keyframe.frame);
+        return false;
+    }
+
+    const VxVector position(keyframe.position[0], keyframe.position[1], keyframe.position[2]);
+    const VxQuaternion rotation(keyframe.rotation[0], keyframe.rotation[1], keyframe.rotation[2],
+                                keyframe.rotation[3]);
+    const VxVector velocity(keyframe.velocity[0], keyframe.velocity[1], keyframe.velocity[2]);
+    const VxVector angularVelocity(keyframe.angularVelocity[0], keyframe.angularVelocity[1],
+                                   keyframe.angularVelocity[2]);
+    if (!gameInterface->SetPhysicsState(ball, position, rotation, velocity, angularVelocity)) {
+        Log::Warn("Cannot restore keyframe at frame %zu: the ball is not physicalized.", keyframe.frame);
+        return false;
+    }
+
+    RNGState rng = {};
+    rng.id = keyframe.rngId;
+    rng.next_movement_check = keyframe.rngNextMovementCheck;
+    rng.ivp_seed = keyframe.rngIvpSeed;
+    rng.qh_seed = keyframe.rngQhSeed;
+    gameInterface->RestoreRNGState(rng);
+
+    // Put the engine tick back in step with the restored frame
+    m_Engine->SetCurrentTick(keyframe.tick);
+
+    Log::Info("Restored keyframe at frame %zu (tick %zu).", keyframe.frame, keyframe.tick);
+    return true;
+}
+
+const RecordKeyframe *RecordPlayer::FindKeyframe(size_t frame) const {
+    auto it = std::upper_bound(m_Keyframes.begin(), m_Keyframes.end(), frame,
+                               [](size_t value, const RecordKeyframe &keyframe) { return value < keyframe.frame; });
+    if (it == m_Keyframes.begin()) {
+        return nullptr;
+    }
+    return &*(it - 1);
+}
+
+void RecordPlayer::InvalidateKeyframes(size_t frame) {
+    // Input applied during frame N - 1 looks ahead at frame N to set the released
+    // bits, so editing frame N also changes the state at the start of frame N
+    const size_t firstStale = frame > 0 ? frame - 1 : 0;
+    auto it = std::lower_bound(m_Keyframes.begin(), m_Keyframes.end(), firstStale,
+                               [](const RecordKeyframe &keyframe, size_t value) { return keyframe.frame < value; });
+    m_Keyframes.erase(it, m_Keyframes.end());
+}
+
+void RecordPlayer::EnforceKeyframeBudget() {
+    while (m_EffectiveKeyframeInterval != 0 && m_Keyframes.size() > 1 &&
+           m_Keyframes.size() * sizeof(RecordKeyframe) > m_KeyframeBudget) {
+        m_EffectiveKeyframeInterval *= 2;
+
+        const size_t interval = m_EffectiveKeyframeInterval;
+        std::erase_if(m_Keyframes, [interval](const RecordKeyframe &keyframe) {
+            return keyframe.frame % interval != 0;
+        });
+
+        Log::Info("Keyframe budget exceeded; interval raised to %zu frames.", m_EffectiveKeyframeInterval);
+    }
+}
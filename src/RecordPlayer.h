@@ -6,53 +6,19 @@
 #include <unordered_map>
 #include <ctime>
 #include <memory>
+#include <deque>
+#include <optional>
 
 #include <CKDefines.h>
 
+#include "RecordFormat.h"
+#include "RecordFrameStore.h"
+#include "RecordKeyIndex.h"
+
 // Forward declarations
 class TASEngine;
 class TASProject;
 
-/**
- * @struct RecordKeyState
- * @brief Matches the exact binary format from legacy TAS records.
- */
-#pragma pack(push, 1)
-struct RecordKeyState {
-    unsigned key_up    : 1;
-    unsigned key_down  : 1;
-    unsigned key_left  : 1;
-    unsigned key_right : 1;
-    unsigned key_shift : 1;
-    unsigned key_space : 1;
-    unsigned key_q     : 1;
-    unsigned key_esc   : 1;
-    unsigned key_enter : 1;
-};
-#pragma pack(pop)
-
-/**
- * @struct RecordFrameData
- * @brief Matches the exact binary format from legacy TAS records.
- */
-#pragma pack(push, 1)
-struct RecordFrameData {
-    float deltaTime;
-
-    union {
-        RecordKeyState keyState;
-        int keyStates;
-    };
-
-    RecordFrameData() : deltaTime(0.0f), keyStates(0) {
-    }
-
-    explicit RecordFrameData(float deltaTime) : deltaTime(deltaTime) {
-        keyStates = 0;
-    }
-};
-#pragma pack(pop)
-
 // ===================================================================
 // Enhanced Record Features - Data Structures
 // ===================================================================
@@ -140,7 +106,7 @@ struct RecordComment {
 struct RecordMacro {
     std::string name;                    // Macro name
     std::string description;             // What the macro does
-    std::vector<RecordFrameData> frames; // Input sequence
+    RecordFrameStore frames;             // Input sequence, sharing blocks with the record it was cut from
     std::unordered_map<std::string, std::string> metadata;
 
     RecordMacro() = default;
@@ -192,22 +158,46 @@ enum class EditActionType : uint8_t {
     SetDeltaTime,
     CopyFrames,
     DuplicateFrame,
+    InsertMacro,
     AddSection,
     RemoveSection,
+    ModifySection,
     AddMarker,
     RemoveMarker,
+    ModifyMarker,
     AddComment,
-    RemoveComment
+    RemoveComment,
+    ModifyComment
 };
 
 /**
  * @struct EditAction
- * @brief Represents a single undoable edit action.
+ * @brief Represents a single undoable edit action as a compact diff.
+ *
+ * Frame edits are stored as a splice: at @c frame, the frames in @c before were
+ * replaced by @c after repeated @c afterRepeat times. Undo and redo replay the
+ * splice in either direction, so their cost is proportional to the diff size.
+ * Section, marker and comment edits store the entry state before and after the
+ * edit, where an empty optional means the entry did not exist.
  */
 struct EditAction {
     EditActionType type;
-    std::vector<uint8_t> data; // Serialized action data
-    std::string description;   // Human-readable description
+    std::string description; // Human-readable description
+
+    // Frame diff
+    size_t frame = 0;                    // First frame touched by the edit
+    std::vector<RecordFrameData> before; // Frames removed or overwritten
+    std::vector<RecordFrameData> after;  // Frames written (pattern)
+    size_t afterRepeat = 1;              // Number of times 'after' is repeated
+
+    // Annotation diff
+    std::optional<RecordSection> sectionBefore;
+    std::optional<RecordSection> sectionAfter;
+    std::optional<RecordMarker> markerBefore;
+    std::optional<RecordMarker> markerAfter;
+    size_t commentIndex = 0;
+    std::optional<RecordComment> commentBefore;
+    std::optional<RecordComment> commentAfter;
 
     EditAction() : type(EditActionType::ModifyFrame) {
     }
@@ -215,6 +205,12 @@ struct EditAction {
     EditAction(EditActionType t, std::string desc)
         : type(t), description(std::move(desc)) {
     }
+
+    /**
+     * @brief Approximates the memory held by this action.
+     * @return Size in bytes.
+     */
+    size_t ByteSize() const;
 };
 
 /**
@@ -227,7 +223,7 @@ struct RecordBranch {
     size_t divergenceFrame;              // Where this branch diverges from parent
     size_t convergenceFrame;             // Where branches merge (or -1 if no merge)
     std::string parentBranch;            // Parent branch name (empty for main branch)
-    std::vector<RecordFrameData> frames; // Alternative frames
+    RecordFrameStore frames;             // Whole timeline of the branch, sharing unedited blocks with its parent
 
     RecordBranch() : divergenceFrame(0), convergenceFrame(static_cast<size_t>(-1)) {
     }
@@ -251,6 +247,29 @@ struct SavestateLink {
     }
 };
 
+/**
+ * @struct RecordKeyframe
+ * @brief Game state snapshot captured during playback to make seeking cheap.
+ *
+ * Holds the state of the active ball and the physics RNG at the start of a frame,
+ * before that frame's input is applied.
+ */
+struct RecordKeyframe {
+    size_t frame = 0; // Record frame the snapshot precedes
+    size_t tick = 0;  // Engine tick at capture, re-applied when the keyframe is restored
+
+    float position[3] = {};
+    float rotation[4] = {0.0f, 0.0f, 0.0f, 1.0f}; // Quaternion (x, y, z, w)
+    float velocity[3] = {};
+    float angularVelocity[3] = {};
+
+    // Mirrors RNGState
+    short rngId = 0;
+    short rngNextMovementCheck = 0;
+    int rngIvpSeed = 0;
+    int rngQhSeed = 0;
+};
+
 /**
  * @class RecordPlayer
  * @brief Handles playback of binary .tas record files.
@@ -313,11 +332,22 @@ public:
 
     /**
      * @brief Seeks to a specific frame in the record.
+     *
+     * Restores the nearest keyframe at or before the target (if it is closer than the
+     * current position) and fast-forwards to the target with rendering skipped.
+     * Seeking backward without a usable keyframe only moves the playhead.
+     *
      * @param frame The frame number to seek to (0-based).
      * @return True if seek was successful, false if frame is out of bounds or not playing.
      */
     bool Seek(size_t frame);
 
+    /**
+     * @brief Checks if a seek is still fast-forwarding toward its target frame.
+     * @return True while fast-forwarding.
+     */
+    bool IsSeeking() const { return m_SeekTarget != kNoSeekTarget; }
+
     /**
      * @brief Gets the current playback frame.
      * @return The current frame number (0-based), or 0 if not playing.
@@ -519,9 +549,10 @@ public:
     /**
      * @brief Saves the current record to a file.
      * @param path Path to save the .tas file.
+     * @param legacyFormat True to write the single-stream legacy format instead of the chunked container.
      * @return True if successful, false on error.
      */
-    bool Save(const std::string &path);
+    bool Save(const std::string &path, bool legacyFormat = false);
 
     /**
      * @brief Exports frame inputs to a human-readable format.
@@ -903,7 +934,27 @@ public:
      * @brief Sets the maximum history size.
      * @param size Maximum number of undo actions to keep.
      */
-    void SetMaxHistorySize(size_t size) { m_MaxHistorySize = size; }
+    void SetMaxHistorySize(size_t size);
+
+    /**
+     * @brief Gets the memory held by the undo and redo journals.
+     * @return Size in bytes.
+     */
+    size_t GetHistoryBytes() const { return m_HistoryBytes; }
+
+    /**
+     * @brief Sets the memory budget of the undo and redo journals.
+     * Oldest undo actions are discarded once the budget is exceeded, then the
+     * furthest redo actions if the redo journal alone is over it.
+     * @param bytes Maximum number of bytes to keep.
+     */
+    void SetMaxHistoryBytes(size_t bytes);
+
+    /**
+     * @brief Gets the memory budget of the undo and redo journals.
+     * @return Size in bytes.
+     */
+    size_t GetMaxHistoryBytes() const { return m_MaxHistoryBytes; }
 
     // ===================================================================
     // Search & Filter
@@ -963,7 +1014,9 @@ public:
 
     /**
      * @brief Switches to a different branch.
-     * @param name Branch name.
+     * The edited frames are kept with the branch being left and the target's frames
+     * take their place. Undo history and keyframes refer to the old frames and are dropped.
+     * @param name Branch name (empty for the main branch).
      * @return True if successful.
      */
     bool SwitchBranch(const std::string &name);
@@ -1014,7 +1067,57 @@ public:
      */
     std::vector<SavestateLink> GetAllSavestateLinks() const;
 
+    // ===================================================================
+    // Keyframes
+    // ===================================================================
+
+    /**
+     * @brief Sets the frame interval between captured keyframes.
+     * While a record plays, the effective interval may grow to stay within the keyframe
+     * memory budget; it returns to this value when a record is loaded or stopped.
+     * @param interval Frames between keyframes (0 disables capturing).
+     */
+    void SetKeyframeInterval(size_t interval);
+
+    /**
+     * @brief Gets the configured frame interval between captured keyframes.
+     * @return Frames between keyframes (0 if capturing is disabled).
+     */
+    size_t GetKeyframeInterval() const { return m_KeyframeInterval; }
+
+    /**
+     * @brief Gets the interval keyframes are currently captured at.
+     * @return The configured interval, or a multiple of it if the budget forced it up.
+     */
+    size_t GetEffectiveKeyframeInterval() const { return m_EffectiveKeyframeInterval; }
+
+    /**
+     * @brief Sets the memory budget for keyframes.
+     * When exceeded, the effective interval is doubled and keyframes off the new grid are dropped.
+     * @param bytes Maximum bytes held by keyframes.
+     */
+    void SetKeyframeBudget(size_t bytes);
+
+    /**
+     * @brief Gets the memory budget for keyframes.
+     * @return Maximum bytes held by keyframes.
+     */
+    size_t GetKeyframeBudget() const { return m_KeyframeBudget; }
+
+    /**
+     * @brief Gets the number of captured keyframes.
+     * @return Keyframe count.
+     */
+    size_t GetKeyframeCount() const { return m_Keyframes.size(); }
+
+    /**
+     * @brief Discards all captured keyframes and resets the effective interval.
+     */
+    void ClearKeyframes();
+
 private:
+    static constexpr size_t kNoSeekTarget = static_cast<size_t>(-1);
+    static constexpr size_t kDefaultKeyframeInterval = 132; // About one second at the default tick rate
     /**
      * @brief Notifies status change via callback.
      * @param isPlaying True if starting playback, false if stopping.
@@ -1026,12 +1129,40 @@ private:
     }
 
     /**
-     * @brief Loads a .tas record file using the legacy format.
+     * @brief Loads a .tas record file, detecting the chunked or legacy format.
      * @param recordPath Path to the .tas file.
      * @return True if the file was loaded successfully.
      */
     bool LoadRecord(const std::string &recordPath);
 
+    /**
+     * @brief Loads a .tas record file using the legacy format.
+     * The whole payload is inflated at once; kept for compatibility with old records.
+     * @param recordPath Path to the .tas file.
+     * @return True if the file was loaded successfully.
+     */
+    bool LoadLegacyRecord(const std::string &recordPath);
+
+    /**
+     * @brief Gets a frame from the in-memory frames or the streaming reader.
+     * @param frame The frame number (0-based).
+     * @return The frame data, or a blank frame if the frame is out of bounds.
+     */
+    const RecordFrameData &FrameAt(size_t frame) const;
+
+    /**
+     * @brief Gets the bit-sliced key index, building it on first use.
+     * @return The key index covering all frames.
+     */
+    const RecordKeyIndex &GetKeyIndex() const;
+
+    /**
+     * @brief Decompresses a streamed record into m_Frames so it can be edited.
+     * Does nothing if the frames are already in memory.
+     * @return True if the frames are available in m_Frames.
+     */
+    bool MaterializeFrames();
+
     /**
      * @brief Applies legacy keyboard state input for the current frame.
      * @param currentFrame The current frame's input data.
@@ -1042,24 +1173,6 @@ private:
                          const RecordFrameData &nextFrame,
                          unsigned char *keyboardState) const;
 
-    /**
-     * @brief Converts the current and next key states to a keyboard state byte.
-     * @param current The current key state (pressed or not).
-     * @param next The next key state (pressed or not).
-     * @return KS_PRESSED if the key is currently pressed,
-     *         KS_RELEASED if it was just released,
-     *         KS_IDLE if it is not pressed.
-     */
-    static int ConvertKeyState(bool current, bool next);
-
-    /**
-     * @brief Gets the key state bit for a given key name.
-     * @param keyState The key state struct to query.
-     * @param keyName The name of the key (e.g., "up", "down", "space").
-     * @return True if the key is pressed in the given state, false otherwise.
-     */
-    static bool GetKeyStateBit(const RecordKeyState &keyState, const std::string &keyName);
-
     /**
      * @brief Sets the key state bit for a given key name.
      * @param keyState The key state struct to modify.
@@ -1069,17 +1182,59 @@ private:
      */
     static bool SetKeyStateBit(RecordKeyState &keyState, const std::string &keyName, bool pressed);
 
+    /**
+     * @brief Captures a keyframe for the current frame if it falls on the keyframe grid.
+     */
+    void CaptureKeyframe();
+
+    /**
+     * @brief Restores the game state stored in a keyframe.
+     * @param keyframe The keyframe to restore.
+     * @return True if the state was applied.
+     */
+    bool RestoreKeyframe(const RecordKeyframe &keyframe);
+
+    /**
+     * @brief Finds the latest keyframe at or before a frame.
+     * @param frame The frame number (0-based).
+     * @return The keyframe, or nullptr if none exists.
+     */
+    const RecordKeyframe *FindKeyframe(size_t frame) const;
+
+    /**
+     * @brief Drops keyframes whose state depends on an edited frame.
+     * Because input is applied with one frame of lookahead, this includes the
+     * keyframes at the edited frame and the frame before it.
+     * @param frame The first edited frame.
+     */
+    void InvalidateKeyframes(size_t frame);
+
+    /**
+     * @brief Doubles the effective keyframe interval and thins out keyframes until within budget.
+     */
+    void EnforceKeyframeBudget();
+
     // Core references
     TASEngine *m_Engine;
 
     // Record data
     size_t m_TotalFrames = 0;
     size_t m_CurrentFrame = 0;
-    std::vector<RecordFrameData> m_Frames;
+    RecordFrameStore m_Frames;
+    mutable RecordFrameStore::Cursor m_FrameCursor; // Keeps FrameAt O(1) while playing in order
+    std::unique_ptr<ChunkedRecordReader> m_Reader; // Set while a chunked record is streamed lazily
+    mutable RecordKeyIndex m_KeyIndex;             // Built lazily by searches and statistics
     bool m_IsPlaying = false;
     bool m_IsPaused = false;
     float m_PlaybackSpeed = 1.0f; // Playback speed multiplier
     bool m_IsModified = false;    // Track if record has been modified
+    size_t m_SeekTarget = kNoSeekTarget; // Frame a seek is fast-forwarding to
+
+    // Keyframes, sorted by frame
+    std::vector<RecordKeyframe> m_Keyframes;
+    size_t m_KeyframeInterval = kDefaultKeyframeInterval;          // As configured
+    size_t m_EffectiveKeyframeInterval = kDefaultKeyframeInterval; // Raised by the budget
+    size_t m_KeyframeBudget = 4 * 1024 * 1024;
 
     // Callback for execution status changes
     std::function<void(bool)> m_StatusCallback;
@@ -1112,18 +1267,34 @@ private:
     RecordMetadata m_Metadata;
 
     // Undo/Redo system
-    std::vector<EditAction> m_UndoStack;
-    std::vector<EditAction> m_RedoStack;
+    std::deque<EditAction> m_UndoStack;
+    std::deque<EditAction> m_RedoStack;
     size_t m_MaxHistorySize = 100;
+    size_t m_MaxHistoryBytes = 64 * 1024 * 1024;
+    size_t m_HistoryBytes = 0; // Bytes held by both stacks
 
     // Branch management
     std::unordered_map<std::string, RecordBranch> m_Branches;
     std::string m_CurrentBranch; // Empty string = main branch
+    RecordFrameStore m_MainFrames; // Main branch frames while another branch is current
 
     // Savestate links
     std::unordered_map<size_t, SavestateLink> m_SavestateLinks;
 
     // Helper methods
-    void PushUndoAction(EditActionType type, const std::string &description);
+    void PushUndoAction(EditAction action);
+    void PushFrameEdit(EditActionType type, std::string description, size_t frame,
+                       std::vector<RecordFrameData> before, std::vector<RecordFrameData> after,
+                       size_t afterRepeat = 1);
+    void PushSectionEdit(EditActionType type, std::string description,
+                         std::optional<RecordSection> before, std::optional<RecordSection> after);
+    void PushMarkerEdit(EditActionType type, std::string description,
+                        std::optional<RecordMarker> before, std::optional<RecordMarker> after);
+    void PushCommentEdit(EditActionType type, std::string description, size_t index,
+                         std::optional<RecordComment> before, std::optional<RecordComment> after);
+    void TrimHistory();
+    void ApplyEdit(const EditAction &action, bool redo);
+    void SpliceFrames(size_t frame, size_t removeCount,
+                      const std::vector<RecordFrameData> &insert, size_t insertRepeat);
     void UpdateMetadataStats();
 };
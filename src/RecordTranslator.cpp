@@ -0,0 +1,62 @@
+#include "RecordTranslator.h"
+
+#include "Logger.h"
+
+bool RecordTranslator::LoadFrames(const std::string &recordPath, std::vector<RecordFrameData> &outFrames) {
+    outFrames.clear();
+
+    if (!ChunkedRecordReader::IsChunkedRecord(recordPath)) {
+        return LegacyRecordReader::ReadAll(recordPath, outFrames);
+    }
+
+    ChunkedRecordReader reader;
+    if (!reader.Open(recordPath)) {
+        return false;
+    }
+
+    if (!reader.ReadAll(outFrames)) {
+        Log::Error("Failed to decompress record frames: %s", recordPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+uint8_t RecordTranslator::ConvertKeyState(bool current, bool next) {
+    uint8_t state = KS_IDLE;
+    if (current) {
+        state |= KS_PRESSED;
+        if (!next) {
+            state |= KS_RELEASED; // Last frame the key is held
+        }
+    }
+    return state;
+}
+
+RawInputState RecordTranslator::ConvertInput(const RecordKeyState &current, const RecordKeyState &next) {
+    RawInputState input;
+    input.keyUp = ConvertKeyState(current.key_up, next.key_up);
+    input.keyDown = ConvertKeyState(current.key_down, next.key_down);
+    input.keyLeft = ConvertKeyState(current.key_left, next.key_left);
+    input.keyRight = ConvertKeyState(current.key_right, next.key_right);
+    input.keyShift = ConvertKeyState(current.key_shift, next.key_shift);
+    input.keySpace = ConvertKeyState(current.key_space, next.key_space);
+    input.keyQ = ConvertKeyState(current.key_q, next.key_q);
+    input.keyEsc = ConvertKeyState(current.key_esc, next.key_esc);
+    return input;
+}
+
+void RecordTranslator::ConvertFrames(const std::vector<RecordFrameData> &frames, float deltaTime,
+                                     std::vector<FrameData> &outFrames) {
+    static const RecordFrameData blankFrame;
+
+    outFrames.clear();
+    outFrames.resize(frames.size());
+    for (size_t i = 0; i < frames.size(); ++i) {
+        const RecordFrameData &next = i + 1 < frames.size() ? frames[i + 1] : blankFrame;
+
+        FrameData &frame = outFrames[i];
+        frame.frameIndex = i;
+        frame.inputState = ConvertInput(frames[i].keyState, next.keyState);
+        frame.deltaTime = deltaTime;
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "RecordFormat.h"
+#include "RecordingBuffer.h"
+
+/**
+ * @class RecordTranslator
+ * @brief Converts .tas record frames into the frame stream the ScriptGenerator consumes.
+ *
+ * The key bits of each record frame are turned into the same keyboard state
+ * bytes RecordPlayer writes into the game during playback, so a script built
+ * from the converted frames matches one built by a live translation key for
+ * key. Nothing is simulated: the converted frames carry no physics data and no
+ * game events.
+ */
+class RecordTranslator {
+public:
+    /**
+     * @brief Loads every frame of a record, detecting the chunked or legacy format.
+     * @param recordPath Path to the .tas file.
+     * @param outFrames Receives all frames of the record.
+     * @return True if the file was read successfully.
+     */
+    static bool LoadFrames(const std::string &recordPath, std::vector<RecordFrameData> &outFrames);
+
+    /**
+     * @brief Converts the current and next key bits to a keyboard state byte.
+     * @param current Whether the key is held on this frame.
+     * @param next Whether the key is held on the next frame.
+     * @return KS_PRESSED while held, with KS_RELEASED added on the last held frame;
+     *         KS_IDLE if the key is not held.
+     */
+    static uint8_t ConvertKeyState(bool current, bool next);
+
+    /**
+     * @brief Converts the key bits of a frame to an input state.
+     * @param current The key state of this frame.
+     * @param next The key state of the next frame.
+     * @return The input state the game sees on this frame.
+     */
+    static RawInputState ConvertInput(const RecordKeyState &current, const RecordKeyState &next);
+
+    /**
+     * @brief Converts record frames to generator frames, numbered from tick 0.
+     * The frame after the last one is treated as blank, as during playback.
+     * @param frames The record frames.
+     * @param deltaTime The frame delta time in milliseconds.
+     * @param outFrames Receives one frame per record frame.
+     */
+    static void ConvertFrames(const std::vector<RecordFrameData> &frames, float deltaTime,
+                              std::vector<FrameData> &outFrames);
+};
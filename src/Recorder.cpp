@@ -3,6 +3,7 @@
 #include "Logger.h"
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <fstream>
 #include <iomanip>
 #include <sstream>
@@ -10,6 +11,7 @@
 #include "TASEngine.h"
 #include "GameInterface.h"
 #include "ScriptGenerator.h"
+#include "RecordingStream.h"
 
 Recorder::Recorder(TASEngine *engine)
     : m_Engine(engine) {
@@ -17,10 +19,6 @@ Recorder::Recorder(TASEngine *engine)
         throw std::runtime_error("Recorder requires valid TASEngine, BallanceTAS, and IBML instances.");
     }
 
-    // Reserve space for better performance
-    m_Frames.reserve(10000);
-    m_PendingEvents.reserve(100);
-
     // Initialize default generation options
     m_GenerationOptions = std::make_unique<GenerationOptions>();
     m_GenerationOptions->projectName = "Generated_TAS";
@@ -30,6 +28,15 @@ Recorder::Recorder(TASEngine *engine)
     m_GenerationOptions->addFrameComments = true;
 }
 
+Recorder::~Recorder() {
+    if (m_Stream) {
+        m_Stream->Close();
+    }
+    if (m_DumpThread.joinable()) {
+        m_DumpThread.join();
+    }
+}
+
 void Recorder::SetGenerationOptions(const GenerationOptions &options) {
     *m_GenerationOptions = options;
 }
@@ -40,10 +47,14 @@ void Recorder::Start() {
         Stop();
     }
 
-    // Clear previous data
-    m_Frames.clear();
-    m_PendingEvents.clear();
+    // Clear previous data and preallocate storage
+    size_t ringCapacity = 0;
+    if (m_RingBufferSeconds > 0.0f) {
+        ringCapacity = std::max<size_t>(1, static_cast<size_t>(std::ceil(m_RingBufferSeconds * 1000.0f / m_DeltaTime)));
+    }
+    m_Buffer.Reset(ringCapacity, m_MaxFrames);
     m_WarnedMaxFrames = false;
+    m_StreamWritten = false;
 
     // Acquire remapped keys from game interface
     auto *gameInterface = m_Engine->GetGameInterface();
@@ -60,7 +71,11 @@ void Recorder::Start() {
     NotifyStatusChange(true);
 
     const char *modeStr = m_IsTranslationMode ? "translation" : "recording";
-    Log::Info("Started %s session.", modeStr);
+    if (ringCapacity > 0) {
+        Log::Info("Started %s session (keeping the last %zu frames).", modeStr, ringCapacity);
+    } else {
+        Log::Info("Started %s session.", modeStr);
+    }
 }
 
 std::vector<FrameData> Recorder::Stop() {
@@ -72,24 +87,26 @@ std::vector<FrameData> Recorder::Stop() {
     m_IsRecording = false;
     NotifyStatusChange(false);
 
-    // Process any remaining pending events
-    if (!m_PendingEvents.empty() && !m_Frames.empty()) {
-        // Assign pending events to the last frame
-        m_Frames.back().events.insert(
-            m_Frames.back().events.end(),
-            m_PendingEvents.begin(),
-            m_PendingEvents.end()
-        );
-        m_PendingEvents.clear();
+    // Only the last partial chunk is still in memory at this point
+    if (m_Stream && m_Stream->IsOpen()) {
+        m_StreamWritten = m_Stream->Close();
+        Log::Info("Recording stream closed (%zu frames written%s).", m_Stream->GetFramesWritten(),
+                  m_StreamWritten ? "" : ", with errors");
+    }
+
+    // Convert the columns back to frames; remaining pending events go to the last frame
+    std::vector<FrameData> frames = m_Buffer.ToFrames();
+    if (m_Buffer.GetDroppedFrames() > 0) {
+        Log::Info("Ring buffer kept the last %zu frames (%zu older frames dropped).",
+                  frames.size(), m_Buffer.GetDroppedFrames());
     }
 
     // Auto-generate script if we have frames
-    if (!m_Frames.empty() && m_AutoGenerateOnStop) {
-        GenerateScript();
+    if (!frames.empty() && m_AutoGenerateOnStop) {
+        GenerateScript(frames);
     }
 
-    // Return a copy of the recorded frames
-    return m_Frames;
+    return frames;
 }
 
 std::string Recorder::GenerateAutoProjectName() const {
@@ -110,8 +127,8 @@ void Recorder::SetUpdateRate(float tickPerSecond) {
     m_DeltaTime = 1000.0f / tickPerSecond;
 }
 
-bool Recorder::GenerateScript() {
-    if (m_Frames.empty()) {
+bool Recorder::GenerateScript(const std::vector<FrameData> &frames) {
+    if (frames.empty()) {
         Log::Warn("No frames recorded, cannot generate script.");
         return false;
     }
@@ -164,7 +181,7 @@ bool Recorder::GenerateScript() {
 
         // Generate the script
         scriptGenerator->GenerateAsync(
-            m_Frames, options,
+            frames, options,
             [this, options, modeStr](bool success) {
                 if (success) {
                     Log::Info("Script auto-generated successfully from %s: %s", modeStr,
@@ -188,8 +205,8 @@ void Recorder::Tick(size_t currentTick, const unsigned char *keyboardState) {
         return;
     }
 
-    // Check frame limit
-    if (m_Frames.size() >= m_MaxFrames) {
+    // Check frame limit (ring mode overwrites the oldest frames instead)
+    if (!m_Buffer.IsRingMode() && m_Buffer.GetFrameCount() >= m_MaxFrames) {
         if (!m_WarnedMaxFrames) {
             Log::Warn("Recording reached maximum frame limit (%zu). Recording will stop.", m_MaxFrames);
             m_WarnedMaxFrames = true;
@@ -199,93 +216,173 @@ void Recorder::Tick(size_t currentTick, const unsigned char *keyboardState) {
     }
 
     try {
-        FrameData frame;
-        frame.frameIndex = currentTick;
-        frame.deltaTime = m_DeltaTime;
-        frame.inputState = CaptureRealInput(keyboardState);
+        const RawInputState input = CaptureRealInput(keyboardState);
 
         // Capture physics data
-        CapturePhysicsData(frame);
+        PhysicsData physics;
+        CapturePhysicsData(physics);
 
-        // Assign any events that were fired since the last tick to this frame
-        frame.events = std::move(m_PendingEvents);
-        m_PendingEvents.clear();
-
-        m_Frames.emplace_back(std::move(frame));
+        // Events fired since the last tick are attached to this frame by the buffer
+        m_Buffer.AppendFrame(currentTick, input, m_DeltaTime, physics);
+        if (m_Stream && m_Stream->IsOpen()) {
+            m_Stream->AppendFrame(currentTick, input, m_DeltaTime, physics);
+        }
     } catch (const std::exception &e) {
         Log::Error("Error during recording tick: %s", e.what());
         Stop(); // Stop recording on error to prevent corruption
     }
 }
 
-void Recorder::OnGameEvent(size_t currentTick, const std::string &eventName, int eventData) {
+void Recorder::PrepareStorage() {
+    if (m_IsRecording) {
+        m_Buffer.PrepareNextChunk();
+    }
+}
+
+bool Recorder::StartStreaming(const std::string &filePath) {
     if (!m_IsRecording) {
+        Log::Error("Cannot start streaming: recorder is not recording.");
+        return false;
+    }
+
+    if (!m_Stream) {
+        m_Stream = std::make_unique<RecordingStreamWriter>();
+    }
+
+    m_StreamWritten = m_Stream->Open(filePath, m_DeltaTime);
+    if (!m_StreamWritten) {
+        return false;
+    }
+
+    Log::Info("Streaming recording to: %s", filePath.c_str());
+    return true;
+}
+
+void Recorder::OnGameEvent(size_t currentTick, EventManager::EventId eventId, int eventData) {
+    if (!m_IsRecording || eventId == EventManager::kInvalidEventId) {
         return;
     }
 
     try {
-        // Store event in pending list
-        m_PendingEvents.emplace_back(currentTick, eventName, eventData);
+        // Map the global event ID to the buffer's own ID; only the first sighting hashes the name
+        const std::string &eventName = EventManager::GetEventName(eventId);
+        if (eventId >= m_BufferEventIds.size()) {
+            m_BufferEventIds.resize(eventId + 1, kUnmappedEvent);
+        }
+        RecordingBuffer::EventId &id = m_BufferEventIds[eventId];
+        if (id == kUnmappedEvent) {
+            id = m_Buffer.InternEvent(eventName);
+        }
+
+        // Store event in the sparse event stream
+        m_Buffer.AppendEvent(id, eventData, currentTick);
+        if (m_Stream && m_Stream->IsOpen()) {
+            m_Stream->AppendEvent(id, eventName, eventData, currentTick);
+        }
 
-        Log::Info("Recorded game event: %s (data: %d) at frame %d",
+        Log::Info("Recorded game event: %s (data: %d) at frame %zu",
                                     eventName.c_str(), eventData, currentTick);
     } catch (const std::exception &e) {
         Log::Error("Error recording game event: %s", e.what());
     }
 }
 
+void Recorder::OnGameEvent(size_t currentTick, const std::string &eventName, int eventData) {
+    OnGameEvent(currentTick, EventManager::InternEvent(eventName), eventData);
+}
+
 bool Recorder::DumpFrameData(const std::string &filePath, bool includePhysics) const {
     try {
-        std::ofstream file(filePath);
-        if (!file.is_open()) {
-            Log::Error("Failed to open file for text dump: %s", filePath.c_str());
-            return false;
+        return WriteFrameDataText(filePath, m_Buffer.ToFrames(), m_DeltaTime, GenerateAutoProjectName(),
+                                  includePhysics);
+    } catch (const std::exception &e) {
+        Log::Error("Exception during text dump: %s", e.what());
+        return false;
+    }
+}
+
+void Recorder::DumpFrameDataAsync(const std::string &filePath, bool includePhysics) {
+    if (m_DumpThread.joinable()) {
+        m_DumpThread.join();
+    }
+
+    std::vector<FrameData> frames = m_Buffer.ToFrames();
+    m_DumpThread = std::thread([filePath, frames = std::move(frames), deltaTime = m_DeltaTime,
+                                generatedAt = GenerateAutoProjectName(), includePhysics]() {
+        // Reports its own success or failure; nobody waits for the result
+        try {
+            WriteFrameDataText(filePath, frames, deltaTime, generatedAt, includePhysics);
+        } catch (const std::exception &e) {
+            Log::Error("Exception during text dump to %s: %s", filePath.c_str(), e.what());
         }
+    });
+}
+
+bool Recorder::WriteFrameDataText(const std::string &filePath, const std::vector<FrameData> &frames,
+                                  float deltaTime, const std::string &generatedAt, bool includePhysics) {
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        Log::Error("Failed to open file for text dump: %s", filePath.c_str());
+        return false;
+    }
+
+    // Format into one large buffer and write it out in big chunks
+    constexpr size_t kFlushSize = 1 << 20;
+    std::string buffer;
+    buffer.reserve(kFlushSize + 4096);
+
+    char line[512];
+    auto append = [&](int length) {
+        if (length > 0) {
+            buffer.append(line, std::min<size_t>(static_cast<size_t>(length), sizeof(line) - 1));
+        }
+    };
+
+    // Write header
+    append(snprintf(line, sizeof(line), "# TAS Frame Data\n# Generated: %s\n# Total Frames: %zu\n# Delta Time: %gms\n",
+                    generatedAt.c_str(), frames.size(), deltaTime));
+    if (includePhysics) {
+        buffer.append("# Format: Frame | DeltaTime | Input | Position | Velocity | Speed\n");
+    } else {
+        buffer.append("# Format: Frame | DeltaTime | Input\n");
+    }
+    buffer.append("\n");
+
+    // Write frame data
+    for (const auto &frame : frames) {
+        append(snprintf(line, sizeof(line), "%zu | %.3f | ", frame.frameIndex, frame.deltaTime));
+        buffer.append(FormatInputStateText(frame.inputState));
 
-        // Write header
-        file << "# TAS Frame Data\n";
-        file << "# Generated: " << GenerateAutoProjectName() << "\n";
-        file << "# Total Frames: " << m_Frames.size() << "\n";
-        file << "# Delta Time: " << m_DeltaTime << "ms\n";
         if (includePhysics) {
-            file << "# Format: Frame | DeltaTime | Input | Position | Velocity | Speed\n";
-        } else {
-            file << "# Format: Frame | DeltaTime | Input\n";
+            const PhysicsData &physics = frame.physics;
+            append(snprintf(line, sizeof(line), " | (%.2f,%.2f,%.2f) | (%.2f,%.2f,%.2f) | %.2f",
+                            physics.position.x, physics.position.y, physics.position.z,
+                            physics.velocity.x, physics.velocity.y, physics.velocity.z, physics.speed));
         }
-        file << "\n";
-
-        // Write frame data
-        for (const auto &frame : m_Frames) {
-            file << frame.frameIndex << " | "
-                << std::fixed << std::setprecision(3) << frame.deltaTime << " | "
-                << FormatInputStateText(frame.inputState);
-
-            if (includePhysics) {
-                file << " | (" << std::fixed << std::setprecision(2)
-                    << frame.physics.position.x << ","
-                    << frame.physics.position.y << ","
-                    << frame.physics.position.z << ")"
-                    << " | (" << frame.physics.velocity.x << ","
-                    << frame.physics.velocity.y << ","
-                    << frame.physics.velocity.z << ")"
-                    << " | " << frame.physics.speed;
-            }
 
-            file << "\n";
+        buffer.push_back('\n');
 
-            // Add events if any occurred on this frame
-            for (const auto &event : frame.events) {
-                file << "\tEVENT: " << event.eventName << " (data: " << event.eventData << ")\n";
-            }
+        // Add events if any occurred on this frame
+        for (const auto &event : frame.events) {
+            buffer.append("\tEVENT: ").append(event.eventName);
+            append(snprintf(line, sizeof(line), " (data: %d)\n", event.eventData));
         }
 
-        file.close();
-        Log::Info("Frame data text dump saved to: %s", filePath.c_str());
-        return true;
-    } catch (const std::exception &e) {
-        Log::Error("Exception during text dump: %s", e.what());
+        if (buffer.size() >= kFlushSize) {
+            file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.close();
+    if (!file) {
+        Log::Error("Failed to write text dump: %s", filePath.c_str());
         return false;
     }
+
+    Log::Info("Frame data text dump saved to: %s", filePath.c_str());
+    return true;
 }
 
 bool Recorder::LoadFrameData(const std::string &filePath, bool includePhysics) {
@@ -299,6 +396,7 @@ bool Recorder::LoadFrameData(const std::string &filePath, bool includePhysics) {
         // Clear existing data
         ClearFrameData();
 
+        std::vector<FrameData> frames;
         std::string line;
         size_t lineNumber = 0;
         FrameData *currentFrame = nullptr;
@@ -366,12 +464,13 @@ bool Recorder::LoadFrameData(const std::string &filePath, bool includePhysics) {
                 frame.physics.angularSpeed = frame.physics.angularVelocity.Magnitude();
             }
 
-            m_Frames.push_back(frame);
-            currentFrame = &m_Frames.back();
+            frames.push_back(frame);
+            currentFrame = &frames.back();
         }
 
         file.close();
-        Log::Info("Loaded %zu frames from: %s", m_Frames.size(), filePath.c_str());
+        m_Buffer.Assign(frames);
+        Log::Info("Loaded %zu frames from: %s", frames.size(), filePath.c_str());
         return true;
     } catch (const std::exception &e) {
         Log::Error("Exception during frame data loading: %s", e.what());
@@ -382,58 +481,68 @@ bool Recorder::LoadFrameData(const std::string &filePath, bool includePhysics) {
 
 bool Recorder::DumpFrameDataBinary(const std::string &filePath) const {
     try {
-        std::ofstream file(filePath, std::ios::binary);
-        if (!file.is_open()) {
-            Log::Error("Failed to open file for binary dump: %s", filePath.c_str());
+        const std::vector<FrameData> frames = m_Buffer.ToFrames();
+        if (!RecordingStreamWriter::WriteFrames(filePath, m_DeltaTime, frames)) {
+            Log::Error("Failed to write binary dump: %s", filePath.c_str());
             return false;
         }
 
-        // Write header with version and metadata
-        const uint32_t version = 1;
-        const uint32_t frameCount = static_cast<uint32_t>(m_Frames.size());
-
-        file.write(reinterpret_cast<const char *>(&version), sizeof(version));
-        file.write(reinterpret_cast<const char *>(&frameCount), sizeof(frameCount));
-        file.write(reinterpret_cast<const char *>(&m_DeltaTime), sizeof(m_DeltaTime));
-
-        // Write frame data
-        for (const auto &frame : m_Frames) {
-            // Frame basic data
-            file.write(reinterpret_cast<const char *>(&frame.frameIndex), sizeof(frame.frameIndex));
-            file.write(reinterpret_cast<const char *>(&frame.deltaTime), sizeof(frame.deltaTime));
-
-            // Input state
-            file.write(reinterpret_cast<const char *>(&frame.inputState), sizeof(frame.inputState));
+        Log::Info("Frame data binary dump saved to: %s (%zu frames)",
+                                    filePath.c_str(), frames.size());
+        return true;
+    } catch (const std::exception &e) {
+        Log::Error("Exception during binary dump: %s", e.what());
+        return false;
+    }
+}
 
-            // Physics data
-            file.write(reinterpret_cast<const char *>(&frame.physics), sizeof(frame.physics));
+bool Recorder::LoadFrameDataBinary(const std::string &filePath) {
+    if (!RecordingStreamReader::IsStreamFile(filePath)) {
+        return LoadLegacyFrameDataBinary(filePath);
+    }
 
-            // Events count and data
-            uint32_t eventCount = frame.events.size();
-            file.write(reinterpret_cast<const char *>(&eventCount), sizeof(eventCount));
+    try {
+        RecordingStreamReader reader;
+        if (!reader.Open(filePath)) {
+            return false;
+        }
 
-            for (const auto &event : frame.events) {
-                file.write(reinterpret_cast<const char *>(&event.frame), sizeof(event.frame));
-                file.write(reinterpret_cast<const char *>(&event.eventData), sizeof(event.eventData));
+        // Feed the mapped records straight into the columns
+        m_Buffer.Reset();
+        m_DeltaTime = reader.GetDeltaTime();
+
+        for (const auto &chunk : reader.GetChunks()) {
+            uint32_t e = 0;
+            for (uint32_t f = 0; f <= chunk.frameCount; ++f) {
+                for (; e < chunk.eventCount && chunk.events[e].frame <= f; ++e) {
+                    const RecordingStreamEvent &event = chunk.events[e];
+                    m_Buffer.AppendEvent(m_Buffer.InternEvent(reader.GetEventName(event.nameId)), event.data,
+                                         static_cast<size_t>(event.tick));
+                }
+                if (f == chunk.frameCount) {
+                    break;
+                }
 
-                // Write string length and content
-                uint32_t nameLength = static_cast<uint32_t>(event.eventName.length());
-                file.write(reinterpret_cast<const char *>(&nameLength), sizeof(nameLength));
-                file.write(event.eventName.c_str(), nameLength);
+                const RecordingStreamFrame &record = chunk.frames[f];
+                PhysicsData physics;
+                physics.position = VxVector(record.position[0], record.position[1], record.position[2]);
+                physics.velocity = VxVector(record.velocity[0], record.velocity[1], record.velocity[2]);
+                physics.angularVelocity = VxVector(record.angularVelocity[0], record.angularVelocity[1],
+                                                   record.angularVelocity[2]);
+                m_Buffer.AppendFrame(static_cast<size_t>(record.frameIndex), record.input, record.deltaTime, physics);
             }
         }
 
-        file.close();
-        Log::Info("Frame data binary dump saved to: %s (%zu frames)",
-                                    filePath.c_str(), m_Frames.size());
+        Log::Info("Loaded %zu frames from binary file: %s", m_Buffer.GetFrameCount(), filePath.c_str());
         return true;
     } catch (const std::exception &e) {
-        Log::Error("Exception during binary dump: %s", e.what());
+        Log::Error("Exception during binary frame data loading: %s", e.what());
+        ClearFrameData();
         return false;
     }
 }
 
-bool Recorder::LoadFrameDataBinary(const std::string &filePath) {
+bool Recorder::LoadLegacyFrameDataBinary(const std::string &filePath) {
     try {
         std::ifstream file(filePath, std::ios::binary);
         if (!file.is_open()) {
@@ -458,7 +567,9 @@ bool Recorder::LoadFrameDataBinary(const std::string &filePath) {
         }
 
         m_DeltaTime = deltaTime;
-        m_Frames.reserve(frameCount);
+
+        std::vector<FrameData> frames;
+        frames.reserve(frameCount);
 
         // Read frame data
         for (uint32_t i = 0; i < frameCount; ++i) {
@@ -495,11 +606,12 @@ bool Recorder::LoadFrameDataBinary(const std::string &filePath) {
                 frame.events.push_back(std::move(event));
             }
 
-            m_Frames.push_back(std::move(frame));
+            frames.push_back(std::move(frame));
         }
 
         file.close();
-        Log::Info("Loaded %zu frames from binary file: %s", m_Frames.size(), filePath.c_str());
+        m_Buffer.Assign(frames);
+        Log::Info("Loaded %zu frames from binary file: %s", frames.size(), filePath.c_str());
         return true;
     } catch (const std::exception &e) {
         Log::Error("Exception during binary frame data loading: %s", e.what());
@@ -523,8 +635,7 @@ std::pair<bool, bool> Recorder::DumpFrameDataBoth(const std::string &basePath, b
 }
 
 void Recorder::ClearFrameData() {
-    m_Frames.clear();
-    m_PendingEvents.clear();
+    m_Buffer.Clear();
 }
 
 RawInputState Recorder::CaptureRealInput(const unsigned char *keyboardState) const {
@@ -547,7 +658,7 @@ RawInputState Recorder::CaptureRealInput(const unsigned char *keyboardState) con
     return state;
 }
 
-void Recorder::CapturePhysicsData(FrameData &frameData) const {
+void Recorder::CapturePhysicsData(PhysicsData &physics) const {
     try {
         auto *gameInterface = m_Engine->GetGameInterface();
         if (!gameInterface) return;
@@ -556,8 +667,6 @@ void Recorder::CapturePhysicsData(FrameData &frameData) const {
         auto *ball = gameInterface->GetActiveBall();
         if (!ball) return;
 
-        PhysicsData &physics = frameData.physics;
-
         // Basic position and velocity
         physics.position = gameInterface->GetPosition(ball);
         physics.velocity = gameInterface->GetVelocity(ball);
@@ -568,7 +677,7 @@ void Recorder::CapturePhysicsData(FrameData &frameData) const {
         physics.angularSpeed = physics.angularVelocity.Magnitude();
     } catch (const std::exception &) {
         // Don't log physics capture errors as they're non-critical
-        frameData.physics = PhysicsData{}; // Reset to defaults
+        physics = PhysicsData{}; // Reset to defaults
     }
 }
 
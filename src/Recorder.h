@@ -6,123 +6,29 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include <thread>
 
 #include <CKInputManager.h>
 
+#include "RecordingBuffer.h"
+#include "EventManager.h"
+
 // Forward declarations
 class TASEngine;
 class EventManager;
 class IBML;
 class BallanceTAS;
+class RecordingStreamWriter;
 struct GenerationOptions;
 
-/**
- * @struct RawInputState
- * @brief A snapshot of the real keyboard's state for a single frame.
- * Each field contains the raw keyboard state value (KS_IDLE, KS_PRESSED, KS_RELEASED).
- */
-struct RawInputState {
-    uint8_t keyUp = KS_IDLE;
-    uint8_t keyDown = KS_IDLE;
-    uint8_t keyLeft = KS_IDLE;
-    uint8_t keyRight = KS_IDLE;
-    uint8_t keyShift = KS_IDLE;
-    uint8_t keySpace = KS_IDLE;
-    uint8_t keyQ = KS_IDLE;
-    uint8_t keyEsc = KS_IDLE;
-
-    bool operator==(const RawInputState &other) const {
-        return keyUp == other.keyUp &&
-            keyDown == other.keyDown &&
-            keyLeft == other.keyLeft &&
-            keyRight == other.keyRight &&
-            keyShift == other.keyShift &&
-            keySpace == other.keySpace &&
-            keyQ == other.keyQ &&
-            keyEsc == other.keyEsc;
-    }
-
-    bool operator!=(const RawInputState &other) const {
-        return !(*this == other);
-    }
-
-    // Check if any key has the PRESSED bit set
-    bool HasAnyPressed() const {
-        return (keyUp & KS_PRESSED) ||
-               (keyDown & KS_PRESSED) ||
-               (keyLeft & KS_PRESSED) ||
-               (keyRight & KS_PRESSED) ||
-               (keyShift & KS_PRESSED) ||
-               (keySpace & KS_PRESSED) ||
-               (keyQ & KS_PRESSED) ||
-               (keyEsc & KS_PRESSED);
-    }
-
-    // Check if any key has the RELEASED bit set
-    bool HasAnyReleased() const {
-        return (keyUp & KS_RELEASED) ||
-               (keyDown & KS_RELEASED) ||
-               (keyLeft & KS_RELEASED) ||
-               (keyRight & KS_RELEASED) ||
-               (keyShift & KS_RELEASED) ||
-               (keySpace & KS_RELEASED) ||
-               (keyQ & KS_RELEASED) ||
-               (keyEsc & KS_RELEASED);
-    }
-};
-
-/**
- * @struct GameEvent
- * @brief A record of a significant game event that occurred on a specific frame.
- */
-struct GameEvent {
-    size_t frame = 0;
-    std::string eventName;
-    int eventData = 0; // For events like checkpoint ID
-
-    explicit GameEvent(size_t frameNum, std::string name, int data = 0)
-        : frame(frameNum), eventName(std::move(name)), eventData(data) {}
-};
-
-/**
- * @struct PhysicsData
- * @brief Comprehensive physics data for better analysis and partitioning.
- */
-struct PhysicsData {
-    // Position and movement
-    VxVector position = VxVector(0, 0, 0);
-    VxVector velocity = VxVector(0, 0, 0);
-    VxVector angularVelocity = VxVector(0, 0, 0);
-
-    // Derived values
-    float speed = 0.0f;
-    float angularSpeed = 0.0f;
-};
-
-/**
- * @struct FrameData
- * @brief The core data unit for the recorder, storing all relevant information for one frame.
- */
-struct FrameData {
-    size_t frameIndex = 0;
-    RawInputState inputState;
-    std::vector<GameEvent> events;
-
-    // Physics data
-    PhysicsData physics;
-
-    // Frame timing
-    float deltaTime = 0.0f;
-};
-
 /**
  * @class Recorder
  * @brief Captures player input and game events on a per-frame basis.
  *
  * During a recording session, the Recorder's Tick() method is called every frame.
  * It captures the real (unsynthesized) player input and any significant game
- * events that occurred, storing them in a sequence of RawFrameData. This sequence
- * is later used by the ScriptGenerator to create a Lua script.
+ * events that occurred, storing them in a columnar RecordingBuffer. The frames are
+ * later converted to FrameData and used by the ScriptGenerator to create a Lua script.
  *
  * The Recorder handles its own lifecycle and auto-generation, similar to how
  * replay is handled by the TAS engine.
@@ -130,7 +36,7 @@ struct FrameData {
 class Recorder {
 public:
     explicit Recorder(TASEngine *engine);
-    ~Recorder() = default;
+    ~Recorder();
 
     // Recorder is not copyable or movable
     Recorder(const Recorder &) = delete;
@@ -155,9 +61,36 @@ public:
      */
     void Tick(size_t currentTick, const unsigned char *keyboardState);
 
+    /**
+     * @brief Allocates frame storage ahead of Tick(). Call once per frame outside the input hook.
+     */
+    void PrepareStorage();
+
+    /**
+     * @brief Streams the current recording to a file on a background thread.
+     * Frames are flushed in chunks while recording; the stream is closed by Stop().
+     * @param filePath Path of the streamed binary file.
+     * @return True if the stream was opened.
+     */
+    bool StartStreaming(const std::string &filePath);
+
+    /**
+     * @brief Checks whether the last streamed recording was opened and written completely.
+     * Valid after Stop() has closed the stream.
+     */
+    bool WasStreamWritten() const { return m_StreamWritten; }
+
     /**
      * @brief A callback for the TASEngine to notify the recorder of a game event.
      * @param currentTick The current game tick/frame index.
+     * @param eventId The interned ID of the event that occurred.
+     * @param eventData Optional data associated with the event.
+     */
+    void OnGameEvent(size_t currentTick, EventManager::EventId eventId, int eventData = 0);
+
+    /**
+     * @brief Records a game event by name. Interns the name and forwards to the ID overload.
+     * @param currentTick The current game tick/frame index.
      * @param eventName The name of the event that occurred.
      * @param eventData Optional data associated with the event.
      */
@@ -173,7 +106,7 @@ public:
      * @brief Gets the total number of frames recorded.
      * @return Total recorded frames.
      */
-    size_t GetTotalFrames() const { return m_Frames.size(); }
+    size_t GetTotalFrames() const { return m_Buffer.GetFrameCount(); }
 
     /**
      * @brief Dumps the recorded input states to a text file.
@@ -183,6 +116,14 @@ public:
      */
     bool DumpFrameData(const std::string &filePath, bool includePhysics = false) const;
 
+    /**
+     * @brief Dumps the recorded input states to a text file on a background thread.
+     * The frames are snapshotted before returning; a previous dump is waited for first.
+     * @param filePath Path where to save the text dump.
+     * @param includePhysics Whether to include physics data in the dump.
+     */
+    void DumpFrameDataAsync(const std::string &filePath, bool includePhysics = false);
+
     /**
      * @brief Loads frame data from a text file.
      * @param filePath Path to the text file to load.
@@ -193,14 +134,15 @@ public:
 
 
     /**
-     * @brief Dumps the recorded frame data to a modern binary file.
+     * @brief Dumps the recorded frame data to a streamed binary file.
      * @param filePath Path where to save the binary dump.
      * @return True if the dump was successful.
      */
     bool DumpFrameDataBinary(const std::string &filePath) const;
 
     /**
-     * @brief Loads frame data from a modern binary file.
+     * @brief Loads frame data from a binary file.
+     * Streamed files are memory-mapped; legacy version 1 dumps are still accepted.
      * @param filePath Path to the binary file to load.
      * @return True if the load was successful.
      */
@@ -283,6 +225,20 @@ public:
         m_WarnedMaxFrames = false; // Reset warning state
     }
 
+    /**
+     * @brief Sets the length of the ring buffer used for always-on capture.
+     * When non-zero, only the last N seconds are kept and the frame limit does not apply.
+     * Takes effect when the next recording starts.
+     * @param seconds Seconds of gameplay to keep, or 0 to keep the whole recording.
+     */
+    void SetRingBufferSeconds(float seconds) { m_RingBufferSeconds = seconds > 0.0f ? seconds : 0.0f; }
+
+    /**
+     * @brief Gets the length of the ring buffer.
+     * @return Seconds of gameplay kept, or 0 if the whole recording is kept.
+     */
+    float GetRingBufferSeconds() const { return m_RingBufferSeconds; }
+
     /**
      * @brief Gets the current delta time used for frame timing.
      * This is the time between frames in milliseconds.
@@ -299,10 +255,11 @@ public:
 
 private:
     /**
-     * @brief Generates a TAS script from the current recorded frames.
+     * @brief Generates a TAS script from recorded frames.
+     * @param frames The recorded frames.
      * @return True if generation was successful.
      */
-    bool GenerateScript();
+    bool GenerateScript(const std::vector<FrameData> &frames);
 
     /**
      * @brief Generates an automatic project name with timestamp.
@@ -320,9 +277,9 @@ private:
 
     /**
      * @brief Captures comprehensive physics data for analysis.
-     * @param frameData The frame data to populate with physics info.
+     * @param physics The physics data to populate.
      */
-    void CapturePhysicsData(FrameData &frameData) const;
+    void CapturePhysicsData(PhysicsData &physics) const;
 
     /**
      * @brief Notifies UI/callbacks about recording state changes.
@@ -330,6 +287,25 @@ private:
      */
     void NotifyStatusChange(bool isRecording);
 
+    /**
+     * @brief Writes frames in the text dump format.
+     * @param filePath Destination path.
+     * @param frames The frames to write.
+     * @param deltaTime Nominal delta time written to the header.
+     * @param generatedAt Timestamp written to the header.
+     * @param includePhysics Whether to include physics data.
+     * @return True if the file was written successfully.
+     */
+    static bool WriteFrameDataText(const std::string &filePath, const std::vector<FrameData> &frames,
+                                   float deltaTime, const std::string &generatedAt, bool includePhysics);
+
+    /**
+     * @brief Loads a legacy version 1 binary dump written field by field.
+     * @param filePath Path to the binary file to load.
+     * @return True if the load was successful.
+     */
+    bool LoadLegacyFrameDataBinary(const std::string &filePath);
+
     /**
      * @brief Formats a RawInputState as a human-readable string.
      * @param rawInput The input state to format.
@@ -378,8 +354,15 @@ private:
     std::unique_ptr<GenerationOptions> m_GenerationOptions;
 
     // Recorded data
-    std::vector<FrameData> m_Frames;
-    std::vector<GameEvent> m_PendingEvents; // Events waiting to be assigned to a frame
+    RecordingBuffer m_Buffer;
+    static constexpr RecordingBuffer::EventId kUnmappedEvent = UINT32_MAX;
+    std::vector<RecordingBuffer::EventId> m_BufferEventIds; // Indexed by EventManager::EventId
+    float m_RingBufferSeconds = 0.0f; // 0 = keep the whole recording
+
+    // Background output
+    std::unique_ptr<RecordingStreamWriter> m_Stream;
+    bool m_StreamWritten = false;
+    std::thread m_DumpThread;
 
     // Callbacks
     std::function<void(bool)> m_StatusCallback;
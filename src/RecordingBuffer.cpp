@@ -0,0 +1,155 @@
+#include "RecordingBuffer.h"
+
+#include <algorithm>
+
+void RecordingBuffer::Reset(size_t ringCapacity, size_t maxFrames) {
+    m_RingCapacity = ringCapacity;
+    m_FirstSequence = 0;
+    m_NextSequence = 0;
+    m_Events.clear();
+    m_EventStart = 0;
+    m_Events.reserve(1024);
+
+    // Ring mode needs every chunk before the first tick; linear mode grows one chunk at a time
+    const size_t chunkCount = ringCapacity ? (ringCapacity + kChunkFrames - 1) / kChunkFrames : 1;
+    if (m_Chunks.size() > chunkCount) {
+        m_Chunks.resize(chunkCount);
+    }
+    if (!ringCapacity && maxFrames) {
+        m_Chunks.reserve((maxFrames + kChunkFrames - 1) / kChunkFrames);
+    }
+    while (m_Chunks.size() < chunkCount) {
+        m_Chunks.push_back(std::make_unique<Chunk>());
+    }
+}
+
+void RecordingBuffer::PrepareNextChunk() {
+    if (m_RingCapacity) {
+        return; // Every chunk already exists
+    }
+
+    const size_t slot = SlotOf(m_NextSequence);
+    const size_t nextChunk = slot / kChunkFrames + 1;
+    if (slot % kChunkFrames >= kChunkFrames / 2 && nextChunk >= m_Chunks.size()) {
+        m_Chunks.push_back(std::make_unique<Chunk>());
+    }
+}
+
+void RecordingBuffer::Clear() {
+    m_Chunks.clear();
+    m_Chunks.shrink_to_fit();
+    m_RingCapacity = 0;
+    m_FirstSequence = 0;
+    m_NextSequence = 0;
+    m_Events.clear();
+    m_Events.shrink_to_fit();
+    m_EventStart = 0;
+}
+
+void RecordingBuffer::AppendFrame(size_t frameIndex, const RawInputState &input, float deltaTime,
+                                  const PhysicsData &physics) {
+    const size_t slot = SlotOf(m_NextSequence);
+    const size_t chunkIndex = slot / kChunkFrames;
+    if (chunkIndex >= m_Chunks.size()) {
+        // Only reached if PrepareNextChunk() was not called in time
+        m_Chunks.push_back(std::make_unique<Chunk>());
+    }
+
+    Chunk &chunk = *m_Chunks[chunkIndex];
+    const size_t i = slot % kChunkFrames;
+    chunk.frameIndex[i] = frameIndex;
+    chunk.input[i] = input;
+    chunk.deltaTime[i] = deltaTime;
+    chunk.position[0][i] = physics.position.x;
+    chunk.position[1][i] = physics.position.y;
+    chunk.position[2][i] = physics.position.z;
+    chunk.velocity[0][i] = physics.velocity.x;
+    chunk.velocity[1][i] = physics.velocity.y;
+    chunk.velocity[2][i] = physics.velocity.z;
+    chunk.angularVelocity[0][i] = physics.angularVelocity.x;
+    chunk.angularVelocity[1][i] = physics.angularVelocity.y;
+    chunk.angularVelocity[2][i] = physics.angularVelocity.z;
+
+    ++m_NextSequence;
+    if (m_RingCapacity && m_NextSequence - m_FirstSequence > m_RingCapacity) {
+        ++m_FirstSequence;
+        DropExpiredEvents();
+    }
+}
+
+RecordingBuffer::EventId RecordingBuffer::InternEvent(const std::string &name) {
+    auto it = m_EventIds.find(name);
+    if (it != m_EventIds.end()) {
+        return it->second;
+    }
+
+    const auto id = static_cast<EventId>(m_EventNames.size());
+    m_EventNames.push_back(name);
+    m_EventIds.emplace(name, id);
+    return id;
+}
+
+const std::string &RecordingBuffer::GetEventName(EventId id) const {
+    static const std::string empty;
+    return id < m_EventNames.size() ? m_EventNames[id] : empty;
+}
+
+void RecordingBuffer::AppendEvent(EventId id, int eventData, size_t tick) {
+    m_Events.push_back({m_NextSequence, tick, eventData, id});
+}
+
+void RecordingBuffer::Assign(const std::vector<FrameData> &frames) {
+    Reset();
+    for (const auto &frame : frames) {
+        for (const auto &event : frame.events) {
+            AppendEvent(InternEvent(event.eventName), event.eventData, event.frame);
+        }
+        AppendFrame(frame.frameIndex, frame.inputState, frame.deltaTime, frame.physics);
+    }
+}
+
+std::vector<FrameData> RecordingBuffer::ToFrames() const {
+    const size_t count = GetFrameCount();
+    std::vector<FrameData> frames(count);
+
+    for (size_t n = 0; n < count; ++n) {
+        const size_t slot = SlotOf(m_FirstSequence + n);
+        const Chunk &chunk = *m_Chunks[slot / kChunkFrames];
+        const size_t i = slot % kChunkFrames;
+
+        FrameData &frame = frames[n];
+        frame.frameIndex = chunk.frameIndex[i];
+        frame.inputState = chunk.input[i];
+        frame.deltaTime = chunk.deltaTime[i];
+
+        PhysicsData &physics = frame.physics;
+        physics.position = VxVector(chunk.position[0][i], chunk.position[1][i], chunk.position[2][i]);
+        physics.velocity = VxVector(chunk.velocity[0][i], chunk.velocity[1][i], chunk.velocity[2][i]);
+        physics.angularVelocity = VxVector(chunk.angularVelocity[0][i], chunk.angularVelocity[1][i],
+                                           chunk.angularVelocity[2][i]);
+        physics.speed = physics.velocity.Magnitude();
+        physics.angularSpeed = physics.angularVelocity.Magnitude();
+    }
+
+    if (count > 0) {
+        for (size_t e = m_EventStart; e < m_Events.size(); ++e) {
+            const EventEntry &event = m_Events[e];
+            const size_t n = std::min(event.sequence - m_FirstSequence, count - 1);
+            frames[n].events.emplace_back(event.tick, m_EventNames[event.name], event.data);
+        }
+    }
+
+    return frames;
+}
+
+void RecordingBuffer::DropExpiredEvents() {
+    while (m_EventStart < m_Events.size() && m_Events[m_EventStart].sequence < m_FirstSequence) {
+        ++m_EventStart;
+    }
+
+    // Compact in place once the dead prefix dominates; erase never reallocates
+    if (m_EventStart >= 1024 && m_EventStart * 2 >= m_Events.size()) {
+        m_Events.erase(m_Events.begin(), m_Events.begin() + static_cast<std::ptrdiff_t>(m_EventStart));
+        m_EventStart = 0;
+    }
+}
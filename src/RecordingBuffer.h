@@ -0,0 +1,242 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <CKInputManager.h>
+
+/**
+ * @struct RawInputState
+ * @brief A snapshot of the real keyboard's state for a single frame.
+ * Each field contains the raw keyboard state value (KS_IDLE, KS_PRESSED, KS_RELEASED).
+ */
+struct RawInputState {
+    uint8_t keyUp = KS_IDLE;
+    uint8_t keyDown = KS_IDLE;
+    uint8_t keyLeft = KS_IDLE;
+    uint8_t keyRight = KS_IDLE;
+    uint8_t keyShift = KS_IDLE;
+    uint8_t keySpace = KS_IDLE;
+    uint8_t keyQ = KS_IDLE;
+    uint8_t keyEsc = KS_IDLE;
+
+    bool operator==(const RawInputState &other) const {
+        return keyUp == other.keyUp &&
+            keyDown == other.keyDown &&
+            keyLeft == other.keyLeft &&
+            keyRight == other.keyRight &&
+            keyShift == other.keyShift &&
+            keySpace == other.keySpace &&
+            keyQ == other.keyQ &&
+            keyEsc == other.keyEsc;
+    }
+
+    bool operator!=(const RawInputState &other) const {
+        return !(*this == other);
+    }
+
+    // Check if any key has the PRESSED bit set
+    bool HasAnyPressed() const {
+        return (keyUp & KS_PRESSED) ||
+               (keyDown & KS_PRESSED) ||
+               (keyLeft & KS_PRESSED) ||
+               (keyRight & KS_PRESSED) ||
+               (keyShift & KS_PRESSED) ||
+               (keySpace & KS_PRESSED) ||
+               (keyQ & KS_PRESSED) ||
+               (keyEsc & KS_PRESSED);
+    }
+
+    // Check if any key has the RELEASED bit set
+    bool HasAnyReleased() const {
+        return (keyUp & KS_RELEASED) ||
+               (keyDown & KS_RELEASED) ||
+               (keyLeft & KS_RELEASED) ||
+               (keyRight & KS_RELEASED) ||
+               (keyShift & KS_RELEASED) ||
+               (keySpace & KS_RELEASED) ||
+               (keyQ & KS_RELEASED) ||
+               (keyEsc & KS_RELEASED);
+    }
+};
+
+/**
+ * @struct GameEvent
+ * @brief A record of a significant game event that occurred on a specific frame.
+ */
+struct GameEvent {
+    size_t frame = 0;
+    std::string eventName;
+    int eventData = 0; // For events like checkpoint ID
+
+    explicit GameEvent(size_t frameNum, std::string name, int data = 0)
+        : frame(frameNum), eventName(std::move(name)), eventData(data) {}
+};
+
+/**
+ * @struct PhysicsData
+ * @brief Comprehensive physics data for better analysis and partitioning.
+ */
+struct PhysicsData {
+    // Position and movement
+    VxVector position = VxVector(0, 0, 0);
+    VxVector velocity = VxVector(0, 0, 0);
+    VxVector angularVelocity = VxVector(0, 0, 0);
+
+    // Derived values
+    float speed = 0.0f;
+    float angularSpeed = 0.0f;
+};
+
+/**
+ * @struct FrameData
+ * @brief The core data unit for the recorder, storing all relevant information for one frame.
+ */
+struct FrameData {
+    size_t frameIndex = 0;
+    RawInputState inputState;
+    std::vector<GameEvent> events;
+
+    // Physics data
+    PhysicsData physics;
+
+    // Frame timing
+    float deltaTime = 0.0f;
+};
+
+/**
+ * @class RecordingBuffer
+ * @brief Columnar frame storage used by the Recorder.
+ *
+ * Frames are stored as struct-of-arrays columns inside fixed-size chunks. Appending
+ * a frame never moves recorded data, and PrepareNextChunk() allocates the next chunk
+ * ahead of time, so the per-tick path in the input hook is allocation free. Event names are interned
+ * to small IDs and events live in a separate sparse stream.
+ *
+ * In ring mode only the most recent frames are kept: every chunk is allocated up front
+ * and the oldest frames, together with their events, are overwritten.
+ */
+class RecordingBuffer {
+public:
+    using EventId = uint32_t;
+
+    static constexpr size_t kChunkFrames = 8192;
+
+    RecordingBuffer() = default;
+    ~RecordingBuffer() = default;
+
+    RecordingBuffer(const RecordingBuffer &) = delete;
+    RecordingBuffer &operator=(const RecordingBuffer &) = delete;
+
+    /**
+     * @brief Drops all frames and prepares storage for a new recording.
+     * @param ringCapacity Number of most recent frames to keep, or 0 to keep every frame.
+     * @param maxFrames Expected frame limit of a linear recording, used to size the chunk table.
+     */
+    void Reset(size_t ringCapacity = 0, size_t maxFrames = 0);
+
+    /**
+     * @brief Allocates the chunk after the one being written once it is half full.
+     * Call outside the input hook so AppendFrame() never has to allocate.
+     */
+    void PrepareNextChunk();
+
+    /**
+     * @brief Drops all frames and events and releases their memory.
+     */
+    void Clear();
+
+    bool IsRingMode() const { return m_RingCapacity != 0; }
+    size_t GetRingCapacity() const { return m_RingCapacity; }
+
+    /**
+     * @brief Gets the number of frames currently held.
+     * @return Frame count (at most the ring capacity in ring mode).
+     */
+    size_t GetFrameCount() const { return m_NextSequence - m_FirstSequence; }
+
+    /**
+     * @brief Gets the number of frames overwritten in ring mode.
+     * @return Number of dropped frames.
+     */
+    size_t GetDroppedFrames() const { return m_FirstSequence; }
+
+    /**
+     * @brief Appends a frame. Pending events are attached to it.
+     * @param frameIndex The game tick of the frame.
+     * @param input The captured input state.
+     * @param deltaTime The frame delta time in milliseconds.
+     * @param physics The captured physics state.
+     */
+    void AppendFrame(size_t frameIndex, const RawInputState &input, float deltaTime, const PhysicsData &physics);
+
+    /**
+     * @brief Gets the ID of an event name, interning it on first use.
+     * @param name The event name.
+     * @return The interned event ID.
+     */
+    EventId InternEvent(const std::string &name);
+
+    /**
+     * @brief Gets the name of an interned event.
+     * @param id The event ID.
+     * @return The event name, or an empty string if the ID is unknown.
+     */
+    const std::string &GetEventName(EventId id) const;
+
+    /**
+     * @brief Records an event. It is attached to the next appended frame.
+     * @param id The interned event ID.
+     * @param eventData Data associated with the event.
+     * @param tick The game tick at which the event fired.
+     */
+    void AppendEvent(EventId id, int eventData, size_t tick);
+
+    /**
+     * @brief Replaces the contents with frames in the row-oriented format.
+     * @param frames The frames to store.
+     */
+    void Assign(const std::vector<FrameData> &frames);
+
+    /**
+     * @brief Converts the held frames to the row-oriented format, oldest first.
+     * Events still pending at the end are attached to the last frame.
+     * @return The frames with their events.
+     */
+    std::vector<FrameData> ToFrames() const;
+
+private:
+    struct Chunk {
+        size_t frameIndex[kChunkFrames];
+        RawInputState input[kChunkFrames];
+        float deltaTime[kChunkFrames];
+        float position[3][kChunkFrames];
+        float velocity[3][kChunkFrames];
+        float angularVelocity[3][kChunkFrames];
+    };
+
+    struct EventEntry {
+        size_t sequence; // Sequence number of the frame the event is attached to
+        size_t tick;
+        int data;
+        EventId name;
+    };
+
+    size_t SlotOf(size_t sequence) const { return m_RingCapacity ? sequence % m_RingCapacity : sequence; }
+    void DropExpiredEvents();
+
+    std::vector<std::unique_ptr<Chunk>> m_Chunks;
+    size_t m_RingCapacity = 0;
+    size_t m_FirstSequence = 0; // Sequence number of the oldest held frame
+    size_t m_NextSequence = 0;  // Sequence number of the next appended frame
+
+    std::vector<EventEntry> m_Events;
+    size_t m_EventStart = 0; // First live entry in m_Events
+
+    std::unordered_map<std::string, EventId> m_EventIds;
+    std::vector<std::string> m_EventNames;
+};
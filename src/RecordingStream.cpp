@@ -0,0 +1,386 @@
+#include "RecordingStream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+
+#include "Logger.h"
+
+// ===================================================================
+// RecordingStreamWriter
+// ===================================================================
+
+RecordingStreamWriter::~RecordingStreamWriter() {
+    Close();
+}
+
+bool RecordingStreamWriter::Open(const std::string &path, float deltaTime) {
+    Close();
+
+    m_File.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_File) {
+        Log::Error("Failed to open recording stream: %s", path.c_str());
+        return false;
+    }
+
+    RecordingStreamHeader header = {};
+    header.magic = RecordingStreamFormat::kFileMagic;
+    header.version = RecordingStreamFormat::kVersion;
+    header.headerSize = sizeof(RecordingStreamHeader);
+    header.frameRecordSize = sizeof(RecordingStreamFrame);
+    header.eventRecordSize = sizeof(RecordingStreamEvent);
+    header.deltaTime = deltaTime;
+    m_File.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    m_File.flush();
+    if (!m_File) {
+        Log::Error("Failed to write recording stream header: %s", path.c_str());
+        m_File.close();
+        return false;
+    }
+
+    m_FreeBlocks.clear();
+    m_FreeBlocks.reserve(kBlockCount);
+    m_Queue.clear();
+    m_Queue.reserve(kBlockCount);
+    for (auto &block : m_Blocks) {
+        if (!block) {
+            block = std::make_unique<Block>();
+            block->frames.reserve(RecordingStreamFormat::kFramesPerChunk);
+            block->events.reserve(256);
+            block->names.reserve(1024);
+        }
+        m_FreeBlocks.push_back(block.get());
+    }
+
+    m_Active = m_FreeBlocks.back();
+    m_FreeBlocks.pop_back();
+    m_Closing = false;
+    m_Failed = false;
+    m_NamesWritten.clear();
+    m_FramesWritten.store(0, std::memory_order_relaxed);
+
+    m_Worker = std::thread(&RecordingStreamWriter::WorkerLoop, this);
+    return true;
+}
+
+bool RecordingStreamWriter::Close() {
+    if (!IsOpen()) {
+        return !m_Failed;
+    }
+
+    if (!m_Active->frames.empty() || !m_Active->events.empty()) {
+        SubmitActive();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Closing = true;
+    }
+    m_Cond.notify_all();
+    m_Worker.join();
+
+    m_File.close();
+    if (m_Active) {
+        m_Active->frames.clear();
+        m_Active->events.clear();
+        m_Active->names.clear();
+    }
+    m_Active = nullptr;
+
+    if (m_Failed) {
+        Log::Error("Recording stream was not fully written.");
+    }
+    return !m_Failed;
+}
+
+void RecordingStreamWriter::AppendFrame(size_t frameIndex, const RawInputState &input, float deltaTime,
+                                        const PhysicsData &physics) {
+    if (!m_Active) {
+        return;
+    }
+
+    RecordingStreamFrame &frame = m_Active->frames.emplace_back();
+    frame.frameIndex = frameIndex;
+    frame.deltaTime = deltaTime;
+    frame.position[0] = physics.position.x;
+    frame.position[1] = physics.position.y;
+    frame.position[2] = physics.position.z;
+    frame.velocity[0] = physics.velocity.x;
+    frame.velocity[1] = physics.velocity.y;
+    frame.velocity[2] = physics.velocity.z;
+    frame.angularVelocity[0] = physics.angularVelocity.x;
+    frame.angularVelocity[1] = physics.angularVelocity.y;
+    frame.angularVelocity[2] = physics.angularVelocity.z;
+    frame.input = input;
+
+    if (m_Active->frames.size() >= RecordingStreamFormat::kFramesPerChunk) {
+        SubmitActive();
+    }
+}
+
+void RecordingStreamWriter::AppendEvent(RecordingBuffer::EventId id, const std::string &name, int eventData,
+                                        size_t tick) {
+    if (!m_Active) {
+        return;
+    }
+    if (id >= RecordingStreamFormat::kMaxEventNames) {
+        Log::Warn("Recording stream: dropping event '%s', too many distinct event names.", name.c_str());
+        return;
+    }
+
+    // Define the name in the chunk that first uses it
+    if (id >= m_NamesWritten.size()) {
+        m_NamesWritten.resize(id + 1, false);
+    }
+    if (!m_NamesWritten[id]) {
+        const uint32_t length = static_cast<uint32_t>(name.size());
+        const char *idBytes = reinterpret_cast<const char *>(&id);
+        const char *lengthBytes = reinterpret_cast<const char *>(&length);
+        m_Active->names.insert(m_Active->names.end(), idBytes, idBytes + sizeof(uint32_t));
+        m_Active->names.insert(m_Active->names.end(), lengthBytes, lengthBytes + sizeof(uint32_t));
+        m_Active->names.insert(m_Active->names.end(), name.begin(), name.end());
+        m_NamesWritten[id] = true;
+    }
+
+    RecordingStreamEvent event = {};
+    event.tick = tick;
+    event.frame = static_cast<uint32_t>(m_Active->frames.size());
+    event.nameId = id;
+    event.data = eventData;
+    m_Active->events.push_back(event);
+}
+
+bool RecordingStreamWriter::WriteFrames(const std::string &path, float deltaTime,
+                                        const std::vector<FrameData> &frames) {
+    RecordingStreamWriter writer;
+    if (!writer.Open(path, deltaTime)) {
+        return false;
+    }
+
+    std::unordered_map<std::string, RecordingBuffer::EventId> ids;
+    for (const auto &frame : frames) {
+        for (const auto &event : frame.events) {
+            auto it = ids.emplace(event.eventName, static_cast<RecordingBuffer::EventId>(ids.size())).first;
+            writer.AppendEvent(it->second, event.eventName, event.eventData, event.frame);
+        }
+        writer.AppendFrame(frame.frameIndex, frame.inputState, frame.deltaTime, frame.physics);
+    }
+
+    return writer.Close();
+}
+
+void RecordingStreamWriter::SubmitActive() {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Queue.push_back(m_Active);
+    m_Cond.notify_all();
+
+    // Only blocks when the writer is a whole pool of chunks behind
+    m_Cond.wait(lock, [this] { return !m_FreeBlocks.empty(); });
+    m_Active = m_FreeBlocks.back();
+    m_FreeBlocks.pop_back();
+}
+
+void RecordingStreamWriter::WorkerLoop() {
+    while (true) {
+        Block *block = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Cond.wait(lock, [this] { return !m_Queue.empty() || m_Closing; });
+            if (m_Queue.empty()) {
+                return;
+            }
+            block = m_Queue.front();
+            m_Queue.erase(m_Queue.begin());
+        }
+
+        const bool ok = WriteBlock(*block);
+        block->frames.clear();
+        block->events.clear();
+        block->names.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (!ok) {
+                m_Failed = true;
+            }
+            m_FreeBlocks.push_back(block);
+        }
+        m_Cond.notify_all();
+    }
+}
+
+bool RecordingStreamWriter::WriteBlock(const Block &block) {
+    RecordingStreamChunk chunk = {};
+    chunk.magic = RecordingStreamFormat::kChunkMagic;
+    chunk.frameCount = static_cast<uint32_t>(block.frames.size());
+    chunk.eventCount = static_cast<uint32_t>(block.events.size());
+    chunk.nameBytes = static_cast<uint32_t>(block.names.size());
+
+    m_File.write(reinterpret_cast<const char *>(&chunk), sizeof(chunk));
+    m_File.write(reinterpret_cast<const char *>(block.frames.data()),
+                 static_cast<std::streamsize>(block.frames.size() * sizeof(RecordingStreamFrame)));
+    m_File.write(reinterpret_cast<const char *>(block.events.data()),
+                 static_cast<std::streamsize>(block.events.size() * sizeof(RecordingStreamEvent)));
+    m_File.write(block.names.data(), static_cast<std::streamsize>(block.names.size()));
+    m_File.flush();
+
+    if (!m_File) {
+        return false;
+    }
+
+    m_FramesWritten.fetch_add(block.frames.size(), std::memory_order_relaxed);
+    return true;
+}
+
+// ===================================================================
+// RecordingStreamReader
+// ===================================================================
+
+bool RecordingStreamReader::IsStreamFile(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    uint32_t magic = 0;
+    file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    return file.gcount() == sizeof(magic) && magic == RecordingStreamFormat::kFileMagic;
+}
+
+bool RecordingStreamReader::Open(const std::string &path) {
+    Close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        Log::Error("Could not open recording stream: %s", path.c_str());
+        return false;
+    }
+    m_FileHandle = file;
+
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(file, &fileSize) ||
+        static_cast<uint64_t>(fileSize.QuadPart) < sizeof(RecordingStreamHeader)) {
+        Log::Error("Recording stream is truncated: %s", path.c_str());
+        Close();
+        return false;
+    }
+    m_Size = static_cast<size_t>(fileSize.QuadPart);
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        Log::Error("Could not map recording stream: %s", path.c_str());
+        Close();
+        return false;
+    }
+    m_MappingHandle = mapping;
+
+    m_Data = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_Data) {
+        Log::Error("Could not map recording stream: %s", path.c_str());
+        Close();
+        return false;
+    }
+
+    RecordingStreamHeader header = {};
+    memcpy(&header, m_Data, sizeof(header));
+    if (header.magic != RecordingStreamFormat::kFileMagic || header.version > RecordingStreamFormat::kVersion ||
+        header.headerSize < sizeof(RecordingStreamHeader) ||
+        header.frameRecordSize != sizeof(RecordingStreamFrame) ||
+        header.eventRecordSize != sizeof(RecordingStreamEvent)) {
+        Log::Error("Invalid recording stream header: %s", path.c_str());
+        Close();
+        return false;
+    }
+    m_DeltaTime = header.deltaTime;
+
+    // Index complete chunks; anything after the first incomplete one is discarded
+    size_t offset = header.headerSize;
+    while (m_Size - offset >= sizeof(RecordingStreamChunk)) {
+        RecordingStreamChunk chunk = {};
+        memcpy(&chunk, m_Data + offset, sizeof(chunk));
+        if (chunk.magic != RecordingStreamFormat::kChunkMagic) {
+            Log::Warn("Recording stream chunk at offset %zu is corrupt; ignoring the rest.", offset);
+            break;
+        }
+
+        const uint64_t payload = static_cast<uint64_t>(chunk.frameCount) * sizeof(RecordingStreamFrame) +
+                                 static_cast<uint64_t>(chunk.eventCount) * sizeof(RecordingStreamEvent) +
+                                 chunk.nameBytes;
+        if (payload > m_Size - offset - sizeof(chunk)) {
+            Log::Warn("Recording stream ends with an incomplete chunk; %zu frames recovered.", m_FrameCount);
+            break;
+        }
+
+        const char *cursor = m_Data + offset + sizeof(chunk);
+        ChunkView view = {};
+        view.frames = reinterpret_cast<const RecordingStreamFrame *>(cursor);
+        view.frameCount = chunk.frameCount;
+        cursor += static_cast<size_t>(chunk.frameCount) * sizeof(RecordingStreamFrame);
+        view.events = reinterpret_cast<const RecordingStreamEvent *>(cursor);
+        view.eventCount = chunk.eventCount;
+        cursor += static_cast<size_t>(chunk.eventCount) * sizeof(RecordingStreamEvent);
+
+        const char *namesEnd = cursor + chunk.nameBytes;
+        while (namesEnd - cursor >= static_cast<std::ptrdiff_t>(2 * sizeof(uint32_t))) {
+            uint32_t id = 0;
+            uint32_t length = 0;
+            memcpy(&id, cursor, sizeof(id));
+            memcpy(&length, cursor + sizeof(id), sizeof(length));
+            cursor += 2 * sizeof(uint32_t);
+            if (length > static_cast<size_t>(namesEnd - cursor)) {
+                break;
+            }
+            if (id >= RecordingStreamFormat::kMaxEventNames) {
+                Log::Error("Recording stream defines an out-of-range event name ID %u: %s", id, path.c_str());
+                Close();
+                return false;
+            }
+            if (id >= m_EventNames.size()) {
+                m_EventNames.resize(id + 1);
+            }
+            m_EventNames[id].assign(cursor, length);
+            cursor += length;
+        }
+
+        m_Chunks.push_back(view);
+        m_FrameCount += chunk.frameCount;
+        offset += sizeof(chunk) + static_cast<size_t>(payload);
+    }
+
+    return true;
+}
+
+void RecordingStreamReader::Close() {
+    if (m_Data) {
+        UnmapViewOfFile(m_Data);
+        m_Data = nullptr;
+    }
+    if (m_MappingHandle) {
+        CloseHandle(static_cast<HANDLE>(m_MappingHandle));
+        m_MappingHandle = nullptr;
+    }
+    if (m_FileHandle) {
+        CloseHandle(static_cast<HANDLE>(m_FileHandle));
+        m_FileHandle = nullptr;
+    }
+
+    m_Size = 0;
+    m_DeltaTime = 0.0f;
+    m_FrameCount = 0;
+    m_Chunks.clear();
+    m_EventNames.clear();
+}
+
+const std::string &RecordingStreamReader::GetEventName(uint32_t id) const {
+    static const std::string empty;
+    return id < m_EventNames.size() ? m_EventNames[id] : empty;
+}
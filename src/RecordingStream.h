@@ -0,0 +1,234 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "RecordingBuffer.h"
+
+// ===================================================================
+// Streamed Recording Layout
+// ===================================================================
+//
+// Layout (little endian):
+//
+//   RecordingStreamHeader
+//   chunk 0 .. chunk N-1, each:
+//     RecordingStreamChunk
+//     RecordingStreamFrame[frameCount]
+//     RecordingStreamEvent[eventCount]
+//     name definitions (nameBytes): { uint32 id, uint32 length, char[length] }...
+//
+// Chunks are appended while recording, so a crash loses at most the chunk being
+// filled. Readers stop at the first incomplete chunk. Every record has a fixed
+// size, so a memory-mapped file can be read in place.
+//
+// Legacy binary dumps (version 1) start with the version number instead of the magic.
+
+namespace RecordingStreamFormat {
+    constexpr uint32_t kFileMagic = 0x44524642;  // "BFRD"
+    constexpr uint32_t kChunkMagic = 0x4B4E4843; // "CHNK"
+    constexpr uint16_t kVersion = 2;
+
+    constexpr uint32_t kFramesPerChunk = 4096;
+    constexpr uint32_t kMaxEventNames = 4096; // Event name IDs must stay below this
+}
+
+#pragma pack(push, 1)
+struct RecordingStreamHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;
+    uint32_t frameRecordSize;
+    uint32_t eventRecordSize;
+    float deltaTime;
+    uint32_t reserved;
+};
+
+struct RecordingStreamChunk {
+    uint32_t magic;
+    uint32_t frameCount;
+    uint32_t eventCount;
+    uint32_t nameBytes; // Size of the name definitions that follow the events
+};
+
+struct RecordingStreamFrame {
+    uint64_t frameIndex;
+    float deltaTime;
+    float position[3];
+    float velocity[3];
+    float angularVelocity[3];
+    RawInputState input;
+};
+
+struct RecordingStreamEvent {
+    uint64_t tick;
+    uint32_t frame;  // Frame within the chunk the event is attached to (may equal frameCount)
+    uint32_t nameId; // Defined in this chunk or an earlier one
+    int32_t data;
+    uint32_t reserved;
+};
+#pragma pack(pop)
+
+/**
+ * @class RecordingStreamWriter
+ * @brief Streams recorded frames to disk on a background thread.
+ *
+ * The recording thread fills a preallocated chunk; full chunks are handed to a
+ * writer thread that writes each one with a few large writes and flushes it.
+ * A small pool of chunks is recycled, so appending never allocates. The recording
+ * thread only waits when the disk falls a whole pool behind.
+ */
+class RecordingStreamWriter {
+public:
+    RecordingStreamWriter() = default;
+    ~RecordingStreamWriter();
+
+    RecordingStreamWriter(const RecordingStreamWriter &) = delete;
+    RecordingStreamWriter &operator=(const RecordingStreamWriter &) = delete;
+
+    /**
+     * @brief Creates the file, writes the header and starts the writer thread.
+     * @param path Destination path.
+     * @param deltaTime Nominal frame delta time in milliseconds.
+     * @return True if the file was created.
+     */
+    bool Open(const std::string &path, float deltaTime);
+
+    /**
+     * @brief Writes the pending chunk, stops the writer thread and closes the file.
+     * @return True if every chunk was written successfully.
+     */
+    bool Close();
+
+    bool IsOpen() const { return m_Worker.joinable(); }
+
+    /**
+     * @brief Gets the number of frames already written to disk.
+     * @return Written frame count.
+     */
+    size_t GetFramesWritten() const { return m_FramesWritten.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Appends a frame. Events appended before it are attached to it.
+     * @param frameIndex The game tick of the frame.
+     * @param input The captured input state.
+     * @param deltaTime The frame delta time in milliseconds.
+     * @param physics The captured physics state.
+     */
+    void AppendFrame(size_t frameIndex, const RawInputState &input, float deltaTime, const PhysicsData &physics);
+
+    /**
+     * @brief Appends an event, defining its name in the stream on first use.
+     * @param id The interned event ID.
+     * @param name The event name.
+     * @param eventData Data associated with the event.
+     * @param tick The game tick at which the event fired.
+     */
+    void AppendEvent(RecordingBuffer::EventId id, const std::string &name, int eventData, size_t tick);
+
+    /**
+     * @brief Writes a complete set of frames to a streamed recording file.
+     * @param path Destination path.
+     * @param deltaTime Nominal frame delta time in milliseconds.
+     * @param frames The frames to write.
+     * @return True if the file was written successfully.
+     */
+    static bool WriteFrames(const std::string &path, float deltaTime, const std::vector<FrameData> &frames);
+
+private:
+    struct Block {
+        std::vector<RecordingStreamFrame> frames;
+        std::vector<RecordingStreamEvent> events;
+        std::vector<char> names;
+    };
+
+    static constexpr size_t kBlockCount = 4;
+
+    void SubmitActive();
+    void WorkerLoop();
+    bool WriteBlock(const Block &block);
+
+    std::ofstream m_File;
+    std::thread m_Worker;
+    std::mutex m_Mutex;
+    std::condition_variable m_Cond;
+
+    std::unique_ptr<Block> m_Blocks[kBlockCount];
+    Block *m_Active = nullptr;         // Filled by the recording thread
+    std::vector<Block *> m_FreeBlocks; // Guarded by m_Mutex
+    std::vector<Block *> m_Queue;      // Guarded by m_Mutex, oldest first
+    bool m_Closing = false;
+    bool m_Failed = false;
+
+    std::vector<bool> m_NamesWritten;
+    std::atomic<size_t> m_FramesWritten{0};
+};
+
+/**
+ * @class RecordingStreamReader
+ * @brief Memory-maps a streamed recording and exposes its chunks in place.
+ */
+class RecordingStreamReader {
+public:
+    struct ChunkView {
+        const RecordingStreamFrame *frames;
+        uint32_t frameCount;
+        const RecordingStreamEvent *events;
+        uint32_t eventCount;
+    };
+
+    RecordingStreamReader() = default;
+    ~RecordingStreamReader() { Close(); }
+
+    RecordingStreamReader(const RecordingStreamReader &) = delete;
+    RecordingStreamReader &operator=(const RecordingStreamReader &) = delete;
+
+    /**
+     * @brief Checks whether a file starts with the streamed recording magic.
+     * @param path Path to the file.
+     * @return True if the file uses the streamed layout.
+     */
+    static bool IsStreamFile(const std::string &path);
+
+    /**
+     * @brief Maps a streamed recording and indexes its complete chunks.
+     * @param path Path to the file.
+     * @return True if the header is valid.
+     */
+    bool Open(const std::string &path);
+
+    /**
+     * @brief Unmaps the file.
+     */
+    void Close();
+
+    float GetDeltaTime() const { return m_DeltaTime; }
+    size_t GetFrameCount() const { return m_FrameCount; }
+    const std::vector<ChunkView> &GetChunks() const { return m_Chunks; }
+
+    /**
+     * @brief Gets the name of an event defined in the stream.
+     * @param id The event name ID.
+     * @return The event name, or an empty string if the ID is undefined.
+     */
+    const std::string &GetEventName(uint32_t id) const;
+
+private:
+    void *m_FileHandle = nullptr;
+    void *m_MappingHandle = nullptr;
+    const char *m_Data = nullptr;
+    size_t m_Size = 0;
+
+    float m_DeltaTime = 0.0f;
+    size_t m_FrameCount = 0;
+    std::vector<ChunkView> m_Chunks;
+    std::vector<std::string> m_EventNames;
+};
@@ -8,6 +8,7 @@
 #include "EventManager.h"
 #include "InputSystem.h"
 #include "ProjectManager.h"
+#include "LuaBytecodeCache.h"
 #include "ScriptContextManager.h"
 #include "MessageBus.h"
 #include "SharedDataManager.h"
@@ -67,6 +68,11 @@ bool ScriptContext::Initialize() {
         LuaApi::AddLuaPath(GetLuaState(), BML_TAS_PATH);
         LuaApi::AddLuaPath(GetLuaState(), BML_TAS_PATH "lua");
 
+        // Compile required modules through the shared bytecode cache
+        if (auto *projectManager = m_Engine->GetProjectManager()) {
+            LuaBytecodeCache::InstallSearcher(m_LuaState, projectManager->GetBytecodeCache());
+        }
+
         // 6. Set default GC mode (Generational for TAS workloads)
         SetGCMode(LuaGCMode::Generational);
 
@@ -251,8 +257,22 @@ bool ScriptContext::LoadAndExecute(TASProject *project) {
         Log::Info("[%s] Loading TAS script: %s",
                   m_Name.c_str(), entryScriptPath.c_str());
 
-        // Load and execute the main script file in the Lua VM
-        auto result = m_LuaState.safe_script_file(entryScriptPath, &sol::script_pass_on_error);
+        // Load the main script file (from the bytecode cache when unchanged) and execute it
+        auto *projectManager = m_Engine->GetProjectManager();
+        std::shared_ptr<LuaBytecodeCache> bytecodeCache = projectManager ? projectManager->GetBytecodeCache() : nullptr;
+        sol::load_result chunk = bytecodeCache
+            ? bytecodeCache->LoadFile(m_LuaState, entryScriptPath)
+            : m_LuaState.load_file(entryScriptPath);
+        if (!chunk.valid()) {
+            sol::error err = chunk;
+            Log::Error("[%s] Failed to load script: %s",
+                       m_Name.c_str(), err.what());
+            CleanupCurrentProject();
+            return false;
+        }
+
+        sol::protected_function entryFunc = chunk;
+        auto result = entryFunc();
         if (!result.valid()) {
             sol::error err = result;
             Log::Error("[%s] Failed to execute script: %s",
@@ -368,6 +388,24 @@ bool ScriptContext::IsExecuting() const {
     return m_IsExecuting && m_Scheduler && m_Scheduler->IsRunning();
 }
 
+void ScriptContext::SetPriority(int priority) {
+    if (m_Priority == priority) {
+        return;
+    }
+
+    m_Priority = priority;
+    if (auto *contextManager = GetScriptContextManager()) {
+        contextManager->OnContextPriorityChanged(this);
+    }
+}
+
+void ScriptContext::TransferOwnership(std::thread::id owner) {
+    m_ThreadValidator.SetOwner(owner);
+    if (m_Scheduler) {
+        m_Scheduler->TransferOwnership(owner);
+    }
+}
+
 ScriptContextManager *ScriptContext::GetScriptContextManager() const {
     return m_Engine->GetScriptContextManager();
 }
@@ -378,12 +416,17 @@ size_t ScriptContext::GetCurrentTick() const {
 
 template <typename... Args>
 void ScriptContext::FireGameEvent(const std::string &eventName, Args... args) {
-    if (!m_IsExecuting || !m_EventManager) {
+    FireGameEvent(EventManager::FindEvent(eventName), args...);
+}
+
+template <typename... Args>
+void ScriptContext::FireGameEvent(EventManager::EventId eventId, Args... args) {
+    if (!m_IsExecuting || !m_EventManager || eventId == EventManager::kInvalidEventId) {
         return;
     }
 
     try {
-        m_EventManager->FireEvent(eventName, args...);
+        m_EventManager->FireEvent(eventId, args...);
     } catch (const std::exception &e) {
         Log::Error("[%s] Exception firing game event to script: %s", m_Name.c_str(), e.what());
     }
@@ -392,6 +435,8 @@ void ScriptContext::FireGameEvent(const std::string &eventName, Args... args) {
 // Explicit template instantiations for events used in TASEngine
 template void ScriptContext::FireGameEvent(const std::string &);
 template void ScriptContext::FireGameEvent(const std::string &, int);
+template void ScriptContext::FireGameEvent(EventManager::EventId);
+template void ScriptContext::FireGameEvent(EventManager::EventId, int);
 
 std::string ScriptContext::PrepareProjectForExecution(TASProject *project) {
     if (!project || !project->IsScriptProject()) {
@@ -449,6 +494,10 @@ RecordPlayer *ScriptContext::GetRecordPlayer() const {
     return m_Engine->GetRecordPlayer();
 }
 
+TranslationController *ScriptContext::GetTranslationController() const {
+    return m_Engine->GetTranslationController();
+}
+
 GameInterface *ScriptContext::GetGameInterface() const {
     return m_Engine->GetGameInterface();
 }
@@ -5,16 +5,17 @@
 #include <memory>
 #include <functional>
 
+#include "EventManager.h"
 #include "ThreadOwnershipValidator.h"
 
 // Forward declarations
 class TASEngine;
 class TASProject;
 class LuaScheduler;
-class EventManager;
 class ProjectManager;
 class InputSystem;
 class RecordPlayer;
+class TranslationController;
 class GameInterface;
 class ScriptContextManager;
 
@@ -128,10 +129,36 @@ public:
     int GetPriority() const { return m_Priority; }
 
     /**
-     * @brief Sets the context priority.
+     * @brief Sets the context priority and re-sorts it in the manager's priority order.
      * @param priority The new priority value.
      */
-    void SetPriority(int priority) { m_Priority = priority; }
+    void SetPriority(int priority);
+
+    /**
+     * @brief Checks if the context is isolated (eligible for parallel ticking).
+     */
+    bool IsIsolated() const { return m_Isolated; }
+
+    /**
+     * @brief Marks the context as isolated, taking effect from the next tick.
+     *
+     * When ScriptContextManager ticks in parallel, isolated contexts tick on worker
+     * threads while the game thread waits. An isolated script may read game state
+     * and drive its own input, send messages and use shared data it alone writes.
+     * Event subscriptions, message handlers and watches it registers or removes
+     * take effect after its tick, at its place in the priority order.
+     * It must not modify game objects, load projects or create/destroy contexts.
+     * @param isolated True to allow ticking this context off the game thread.
+     */
+    void SetIsolated(bool isolated) { m_Isolated = isolated; }
+
+    /**
+     * @brief Hands the context (and its scheduler) to another thread.
+     * Used by ScriptContextManager around a parallel tick; the caller guarantees
+     * that no other thread touches the context until ownership is handed back.
+     * @param owner The thread that may use the context from now on.
+     */
+    void TransferOwnership(std::thread::id owner);
 
     /**
      * @brief Gets the ScriptContextManager that owns this context.
@@ -187,6 +214,12 @@ public:
      */
     RecordPlayer *GetRecordPlayer() const;
 
+    /**
+     * @brief Gets the translation controller associated with the engine.
+     * @return Pointer to the TranslationController, or nullptr if not available.
+     */
+    TranslationController *GetTranslationController() const;
+
     /**
      * @brief Gets the game interface associated with the engine.
      * @return Pointer to the GameInterface, or nullptr if not available.
@@ -274,6 +307,14 @@ public:
     template <typename... Args>
     void FireGameEvent(const std::string &eventName, Args... args);
 
+    /**
+     * @brief Fires an interned game event to any listening Lua scripts in this context.
+     * @param eventId The event ID (from EventManager::InternEvent).
+     * @param args Optional arguments to pass to event handlers.
+     */
+    template <typename... Args>
+    void FireGameEvent(EventManager::EventId eventId, Args... args);
+
 private:
     /**
      * @brief Prepares a project for execution by extracting it if needed.
@@ -304,6 +345,7 @@ private:
     std::string m_Name;
     ScriptContextType m_Type;
     int m_Priority;
+    bool m_Isolated = false;
 
     // Lua execution environment (isolated)
     sol::state m_LuaState;
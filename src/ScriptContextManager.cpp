@@ -6,6 +6,7 @@
 #include "SharedDataManager.h"
 #include "MessageBus.h"
 #include "GameInterface.h"
+#include "WorkerPool.h"
 #include <algorithm>
 
 namespace {
@@ -61,12 +62,17 @@ void ScriptContextManager::Shutdown() {
 
     try {
         // Destroy all contexts
+        m_EventSubscriptions.clear();
+        m_ByPriority.clear();
+        m_PendingPriorityEntries.clear();
+        m_PriorityOrderDirty = false;
         m_Contexts.clear();
         m_ContextPool.clear();
         m_CustomContextsPerLevel.clear();
         m_CustomContextLevelMap.clear();
-        m_CustomContextMemoryLimits.clear();
         m_CustomContextCount = 0;
+        m_WorkerPool.reset();
+        m_TickOutboxes.clear();
 
         // Shutdown message bus
         if (m_MessageBus) {
@@ -117,6 +123,7 @@ std::shared_ptr<ScriptContext> ScriptContextManager::CreateContext(const std::st
 
         // Store the context (shared ownership)
         m_Contexts[name] = context;
+        AddToPriorityOrder(context.get());
 
         Log::Info("Script context '%s' created successfully.", name.c_str());
         return context;
@@ -153,7 +160,7 @@ bool ScriptContextManager::DestroyContext(const std::string &name) {
 
     try {
         // Clean up event subscriptions for this context
-        UnsubscribeFromAllEvents(name);
+        UnsubscribeFromAllEvents(it->second.get());
 
         // Decrement custom context count if it's a custom context
         if (it->second && it->second->GetType() == ScriptContextType::Custom) {
@@ -163,13 +170,18 @@ bool ScriptContextManager::DestroyContext(const std::string &name) {
         }
 
         UnregisterCustomContext(name);
+        RemoveFromPriorityOrder(it->second.get());
 
         // Shutdown the context
         if (it->second) {
             it->second->Shutdown();
         }
 
-        // Remove from map
+        // Remove from map; a context destroyed during a priority walk may still be
+        // on the call stack, so it is freed when the walk ends
+        if (m_PriorityWalkDepth > 0) {
+            m_DeferredReleases.push_back(std::move(it->second));
+        }
         m_Contexts.erase(it);
 
         Log::Info("Script context '%s' destroyed.", name.c_str());
@@ -246,32 +258,15 @@ void ScriptContextManager::TickAll() {
             m_MessageBus->ProcessMessages();
         }
 
-        // Get contexts sorted by priority (highest first)
-        auto contexts = GetContextsByPriority();
-
+        // Walk contexts by priority (highest first); destruction is deferred past the walk
         std::vector<std::string> contextsToDestroy;
-        contextsToDestroy.reserve(contexts.size());
-
-        for (const auto &context : contexts) {
-            if (!context || !context->IsExecuting()) {
-                continue;
-            }
-
-            auto limitIt = m_CustomContextMemoryLimits.find(context->GetName());
-            if (limitIt != m_CustomContextMemoryLimits.end()) {
-                const size_t usage = context->GetLuaMemoryBytes();
-                if (usage > limitIt->second) {
-                    Log::Warn(
-                        "Custom context '%s' exceeded memory limit (%zu / %zu bytes). Destroying context.",
-                        context->GetName().c_str(), usage, limitIt->second
-                    );
-                    context->Stop();
-                    contextsToDestroy.push_back(context->GetName());
-                    continue;
-                }
+        {
+            PriorityWalkScope scope(*this);
+            if (m_WorkerPool) {
+                TickContextsParallel(contextsToDestroy);
+            } else {
+                TickContextsSerial(contextsToDestroy);
             }
-
-            context->Tick();
         }
 
         for (const auto &name : contextsToDestroy) {
@@ -282,6 +277,119 @@ void ScriptContextManager::TickAll() {
     }
 }
 
+bool ScriptContextManager::CheckMemoryLimit(const PriorityEntry &entry, std::vector<std::string> &contextsToDestroy) {
+    if (entry.memoryLimitBytes == 0) {
+        return true;
+    }
+
+    ScriptContext *context = entry.context;
+    const size_t usage = context->GetLuaMemoryBytes();
+    if (usage <= entry.memoryLimitBytes) {
+        return true;
+    }
+
+    Log::Warn(
+        "Custom context '%s' exceeded memory limit (%zu / %zu bytes). Destroying context.",
+        context->GetName().c_str(), usage, entry.memoryLimitBytes
+    );
+    context->Stop();
+    contextsToDestroy.push_back(context->GetName());
+    return false;
+}
+
+void ScriptContextManager::TickContextsSerial(std::vector<std::string> &contextsToDestroy) {
+    for (size_t i = 0; i < m_ByPriority.size(); ++i) {
+        ScriptContext *context = m_ByPriority[i].context;
+        if (!context || !context->IsExecuting()) {
+            continue;
+        }
+        if (!CheckMemoryLimit(m_ByPriority[i], contextsToDestroy)) {
+            continue;
+        }
+
+        context->Tick();
+    }
+}
+
+void ScriptContextManager::TickContextsParallel(std::vector<std::string> &contextsToDestroy) {
+    // The walk defers structural changes, so the list keeps its size and order here
+    const size_t count = m_ByPriority.size();
+    if (m_TickOutboxes.size() < count) {
+        m_TickOutboxes.resize(count);
+        m_TickDeferred.resize(count);
+    }
+
+    m_IsolatedBatch.clear();
+    for (size_t i = 0; i < count; ++i) {
+        const PriorityEntry &entry = m_ByPriority[i];
+        if (!entry.context || !entry.context->IsExecuting()) {
+            continue;
+        }
+        if (!CheckMemoryLimit(entry, contextsToDestroy)) {
+            continue;
+        }
+        if (entry.context->IsIsolated()) {
+            m_IsolatedBatch.push_back(i);
+        }
+    }
+
+    // 1. Isolated contexts, lent to whichever thread picks them up
+    const std::thread::id gameThread = std::this_thread::get_id();
+    m_WorkerPool->ParallelFor(m_IsolatedBatch.size(), [this, gameThread](size_t n) {
+        const size_t index = m_IsolatedBatch[n];
+        ScriptContext *context = m_ByPriority[index].context;
+
+        MessageBus::OutboxScope outbox(*m_MessageBus, m_TickOutboxes[index]);
+        WorkerPool::DeferScope deferred(m_TickDeferred[index]);
+        context->TransferOwnership(std::this_thread::get_id());
+        context->Tick(); // Does not throw; script errors stop the context
+        context->TransferOwnership(gameThread);
+    });
+
+    // 2. Everything else on this thread, in priority order. These contexts send
+    // directly (and may make synchronous requests); an isolated context's deferred
+    // registrations and captured messages are applied at its place in the order,
+    // as a serial tick would have.
+    size_t nextIsolated = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (nextIsolated < m_IsolatedBatch.size() && m_IsolatedBatch[nextIsolated] == i) {
+            ++nextIsolated; // Ticked in step 1
+            WorkerPool::RunDeferred(m_TickDeferred[i]);
+            m_MessageBus->FlushOutbox(m_TickOutboxes[i]);
+            continue;
+        }
+
+        ScriptContext *context = m_ByPriority[i].context;
+        if (!context || !context->IsExecuting()) {
+            continue;
+        }
+
+        context->Tick();
+    }
+}
+
+void ScriptContextManager::SetParallelTicking(bool enabled, size_t workerCount) {
+    if (m_PriorityWalkDepth > 0) {
+        Log::Warn("Cannot change parallel ticking while contexts are ticking.");
+        return;
+    }
+
+    if (!enabled) {
+        if (m_WorkerPool) {
+            m_WorkerPool.reset();
+            Log::Info("Parallel context ticking disabled.");
+        }
+        return;
+    }
+
+    if (m_WorkerPool && (workerCount == 0 || m_WorkerPool->GetThreadCount() == workerCount)) {
+        return;
+    }
+
+    m_WorkerPool = std::make_unique<WorkerPool>(workerCount);
+    Log::Info("Parallel context ticking enabled (%zu worker threads).", m_WorkerPool->GetThreadCount());
+}
+
 bool ScriptContextManager::IsAnyContextExecuting() const {
     for (const auto &[name, context] : m_Contexts) {
         if (context && context->IsExecuting()) {
@@ -293,42 +401,135 @@ bool ScriptContextManager::IsAnyContextExecuting() const {
 
 std::vector<std::shared_ptr<ScriptContext>> ScriptContextManager::GetContextsByPriority() {
     std::vector<std::shared_ptr<ScriptContext>> contexts;
-    contexts.reserve(m_Contexts.size());
-
-    for (auto &[name, context] : m_Contexts) {
-        if (context) {
-            contexts.push_back(context);
+    contexts.reserve(m_ByPriority.size());
+
+    // m_ByPriority is kept sorted; look the owners up to hand out shared pointers
+    for (const auto &entry : m_ByPriority) {
+        if (entry.context) {
+            auto it = m_Contexts.find(entry.context->GetName());
+            if (it != m_Contexts.end() && it->second.get() == entry.context) {
+                contexts.push_back(it->second);
+            }
         }
     }
 
-    // Sort by priority (highest first)
-    std::sort(contexts.begin(), contexts.end(),
-              [](const std::shared_ptr<ScriptContext> &a, const std::shared_ptr<ScriptContext> &b) {
-                  return a->GetPriority() > b->GetPriority();
-              });
-
     return contexts;
 }
 
 std::vector<std::shared_ptr<const ScriptContext>> ScriptContextManager::GetContextsByPriority() const {
     std::vector<std::shared_ptr<const ScriptContext>> contexts;
-    contexts.reserve(m_Contexts.size());
+    contexts.reserve(m_ByPriority.size());
 
-    for (const auto &[name, context] : m_Contexts) {
-        if (context) {
-            contexts.push_back(context);
+    for (const auto &entry : m_ByPriority) {
+        if (entry.context) {
+            auto it = m_Contexts.find(entry.context->GetName());
+            if (it != m_Contexts.end() && it->second.get() == entry.context) {
+                contexts.push_back(it->second);
+            }
         }
     }
 
-    // Sort by priority (highest first)
-    std::sort(contexts.begin(), contexts.end(),
-              [](const std::shared_ptr<const ScriptContext> &a, const std::shared_ptr<const ScriptContext> &b) {
-                  return a->GetPriority() > b->GetPriority();
-              });
-
     return contexts;
 }
 
+// ============================================================================
+// Priority Order
+// ============================================================================
+
+void ScriptContextManager::OnContextPriorityChanged(ScriptContext *context) {
+    PriorityEntry *entry = FindPriorityEntry(context);
+    if (!entry) {
+        return; // Pooled or pending contexts are sorted when (re)inserted
+    }
+
+    if (m_PriorityWalkDepth > 0) {
+        m_PriorityOrderDirty = true;
+        return;
+    }
+
+    const PriorityEntry moved = *entry;
+    m_ByPriority.erase(m_ByPriority.begin() + (entry - m_ByPriority.data()));
+    InsertSorted(moved);
+}
+
+void ScriptContextManager::AddToPriorityOrder(ScriptContext *context) {
+    PriorityEntry entry;
+    entry.context = context;
+
+    if (m_PriorityWalkDepth > 0) {
+        m_PendingPriorityEntries.push_back(entry);
+    } else {
+        InsertSorted(entry);
+    }
+}
+
+void ScriptContextManager::RemoveFromPriorityOrder(const ScriptContext *context) {
+    auto pendingIt = std::find_if(m_PendingPriorityEntries.begin(), m_PendingPriorityEntries.end(),
+                                  [context](const PriorityEntry &e) { return e.context == context; });
+    if (pendingIt != m_PendingPriorityEntries.end()) {
+        m_PendingPriorityEntries.erase(pendingIt);
+        return;
+    }
+
+    auto it = std::find_if(m_ByPriority.begin(), m_ByPriority.end(),
+                           [context](const PriorityEntry &e) { return e.context == context; });
+    if (it == m_ByPriority.end()) {
+        return;
+    }
+
+    if (m_PriorityWalkDepth > 0) {
+        // Keep indices stable for the walk; compacted in EndPriorityWalk()
+        it->context = nullptr;
+        m_PriorityOrderDirty = true;
+    } else {
+        m_ByPriority.erase(it);
+    }
+}
+
+ScriptContextManager::PriorityEntry *ScriptContextManager::FindPriorityEntry(const ScriptContext *context) {
+    for (auto *list : {&m_ByPriority, &m_PendingPriorityEntries}) {
+        for (auto &entry : *list) {
+            if (entry.context == context) {
+                return &entry;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void ScriptContextManager::InsertSorted(const PriorityEntry &entry) {
+    // After all entries of equal or higher priority
+    const int priority = entry.context->GetPriority();
+    auto it = std::find_if(m_ByPriority.begin(), m_ByPriority.end(),
+                           [priority](const PriorityEntry &e) { return e.context->GetPriority() < priority; });
+    m_ByPriority.insert(it, entry);
+}
+
+void ScriptContextManager::EndPriorityWalk() {
+    if (--m_PriorityWalkDepth > 0) {
+        return;
+    }
+
+    if (m_PriorityOrderDirty) {
+        m_ByPriority.erase(std::remove_if(m_ByPriority.begin(), m_ByPriority.end(),
+                                          [](const PriorityEntry &e) { return e.context == nullptr; }),
+                           m_ByPriority.end());
+        std::stable_sort(m_ByPriority.begin(), m_ByPriority.end(),
+                         [](const PriorityEntry &a, const PriorityEntry &b) {
+                             return a.context->GetPriority() > b.context->GetPriority();
+                         });
+        m_PriorityOrderDirty = false;
+    }
+
+    for (const auto &entry : m_PendingPriorityEntries) {
+        InsertSorted(entry);
+    }
+    m_PendingPriorityEntries.clear();
+
+    // Safe to free contexts destroyed during the walk now
+    m_DeferredReleases.clear();
+}
+
 std::string ScriptContextManager::GenerateLevelContextName(const std::string &levelName) {
     return "level_" + levelName;
 }
@@ -370,10 +571,11 @@ void ScriptContextManager::RegisterCustomContext(const std::string &name, const
         m_CustomContextsPerLevel[levelKey]++;
     }
 
-    if (memoryLimitBytes > 0) {
-        m_CustomContextMemoryLimits[name] = memoryLimitBytes;
-    } else {
-        m_CustomContextMemoryLimits.erase(name);
+    auto it = m_Contexts.find(name);
+    if (it != m_Contexts.end()) {
+        if (PriorityEntry *entry = FindPriorityEntry(it->second.get())) {
+            entry->memoryLimitBytes = memoryLimitBytes;
+        }
     }
 }
 
@@ -391,8 +593,6 @@ void ScriptContextManager::UnregisterCustomContext(const std::string &name) {
 
         m_CustomContextLevelMap.erase(levelIt);
     }
-
-    m_CustomContextMemoryLimits.erase(name);
 }
 
 // ============================================================================
@@ -406,52 +606,67 @@ void ScriptContextManager::SubscribeToEvent(const std::string &contextName, cons
     }
 
     // Check if context exists
-    if (!GetContext(contextName)) {
+    auto context = GetContext(contextName);
+    if (!context) {
         Log::Warn("Cannot subscribe: context '%s' does not exist.", contextName.c_str());
         return;
     }
 
+    SubscribeToEvent(context.get(), EventManager::InternEvent(eventName));
+}
+
+void ScriptContextManager::SubscribeToEvent(ScriptContext *context, EventManager::EventId eventId) {
+    if (!context || eventId == EventManager::kInvalidEventId) {
+        Log::Warn("Cannot subscribe with invalid context or event.");
+        return;
+    }
+
+    if (eventId >= m_EventSubscriptions.size()) {
+        m_EventSubscriptions.resize(eventId + 1);
+    }
+
     // Add to subscription list (avoid duplicates)
-    auto &subscribers = m_EventSubscriptions[eventName];
-    if (std::find(subscribers.begin(), subscribers.end(), contextName) == subscribers.end()) {
-        subscribers.push_back(contextName);
+    auto &subscribers = m_EventSubscriptions[eventId];
+    if (std::find(subscribers.begin(), subscribers.end(), context) == subscribers.end()) {
+        subscribers.push_back(context);
         Log::Info("Context '%s' subscribed to event '%s'.",
-                  contextName.c_str(), eventName.c_str());
+                  context->GetName().c_str(), EventManager::GetEventName(eventId).c_str());
     }
 }
 
 void ScriptContextManager::UnsubscribeFromEvent(const std::string &contextName, const std::string &eventName) {
-    auto it = m_EventSubscriptions.find(eventName);
-    if (it != m_EventSubscriptions.end()) {
-        auto &subscribers = it->second;
-        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), contextName), subscribers.end());
+    auto context = GetContext(contextName);
+    if (context) {
+        UnsubscribeFromEvent(context.get(), EventManager::FindEvent(eventName));
+    }
+}
 
-        // Clean up empty subscription lists
-        if (subscribers.empty()) {
-            m_EventSubscriptions.erase(it);
-        }
+void ScriptContextManager::UnsubscribeFromEvent(const ScriptContext *context, EventManager::EventId eventId) {
+    if (eventId < m_EventSubscriptions.size()) {
+        auto &subscribers = m_EventSubscriptions[eventId];
+        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), context), subscribers.end());
     }
 }
 
 void ScriptContextManager::UnsubscribeFromAllEvents(const std::string &contextName) {
-    for (auto it = m_EventSubscriptions.begin(); it != m_EventSubscriptions.end();) {
-        auto &subscribers = it->second;
-        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), contextName), subscribers.end());
+    auto context = GetContext(contextName);
+    if (context) {
+        UnsubscribeFromAllEvents(context.get());
+    }
+}
 
-        // Clean up empty subscription lists
-        if (subscribers.empty()) {
-            it = m_EventSubscriptions.erase(it);
-        } else {
-            ++it;
-        }
+void ScriptContextManager::UnsubscribeFromAllEvents(const ScriptContext *context) {
+    for (auto &subscribers : m_EventSubscriptions) {
+        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), context), subscribers.end());
     }
 }
 
 bool ScriptContextManager::IsSubscribedToEvent(const std::string &contextName, const std::string &eventName) const {
-    auto it = m_EventSubscriptions.find(eventName);
-    if (it != m_EventSubscriptions.end()) {
-        const auto &subscribers = it->second;
-        return std::find(subscribers.begin(), subscribers.end(), contextName) != subscribers.end();
+    auto context = GetContext(contextName);
+    const EventManager::EventId eventId = EventManager::FindEvent(eventName);
+    if (context && eventId < m_EventSubscriptions.size()) {
+        const auto &subscribers = m_EventSubscriptions[eventId];
+        return std::find(subscribers.begin(), subscribers.end(), context.get()) != subscribers.end();
     }
     return false;
 }
@@ -484,6 +699,7 @@ std::shared_ptr<ScriptContext> ScriptContextManager::AcquirePooledContext(Script
 
             // Re-register context with new name
             m_Contexts[name] = context;
+            AddToPriorityOrder(context.get());
 
             return context;
         }
@@ -516,13 +732,15 @@ bool ScriptContextManager::ReleaseOrPoolContext(ScriptContext *context) {
     std::string contextName = context->GetName();
     auto it = m_Contexts.find(contextName);
     if (it != m_Contexts.end()) {
-        // Stop the context (but don't destroy)
+        // Stop the context (but don't destroy); a reused context starts without subscriptions
         context->Stop();
+        UnsubscribeFromAllEvents(context);
 
         if (context->GetType() == ScriptContextType::Custom && m_CustomContextCount > 0) {
             m_CustomContextCount--;
         }
         UnregisterCustomContext(contextName);
+        RemoveFromPriorityOrder(context);
 
         // Move to pool
         PooledContext pooled;
@@ -1,17 +1,19 @@
 #pragma once
 
 #include <string>
+#include <functional>
 #include <map>
 #include <memory>
 #include <vector>
 #include <unordered_map>
 
 #include "ScriptContext.h"
+#include "MessageBus.h"
 
 // Forward declarations
 class TASEngine;
 class SharedDataManager;
-class MessageBus;
+class WorkerPool;
 
 /**
  * @brief Configuration for context pool
@@ -129,12 +131,46 @@ public:
      */
     void TickAll();
 
+    /**
+     * @brief Enables or disables parallel ticking of isolated contexts.
+     *
+     * When enabled, TickAll() ticks contexts marked with ScriptContext::SetIsolated()
+     * concurrently on a worker pool, then the remaining contexts serially on the
+     * calling thread. Messages sent during the tick are collected per context and
+     * queued in priority order, so the results match a serial tick.
+     * Must not be called from inside TickAll().
+     * @param enabled True to tick isolated contexts in parallel.
+     * @param workerCount Worker threads (0 = hardware concurrency - 1).
+     */
+    void SetParallelTicking(bool enabled, size_t workerCount = 0);
+
+    /**
+     * @brief Checks if parallel ticking is enabled.
+     */
+    bool IsParallelTickingEnabled() const { return m_WorkerPool != nullptr; }
+
     /**
      * @brief Checks if any context is currently executing.
      * @return True if at least one context is executing.
      */
     bool IsAnyContextExecuting() const;
 
+    /**
+     * @brief Calls fn(ScriptContext &) for every context in priority order (highest first).
+     *
+     * Walks the registry's priority list in place without allocating or copying
+     * shared pointers. Contexts created during the walk are visited from the next
+     * walk on; contexts destroyed during the walk are skipped and freed when it ends.
+     */
+    template <typename F>
+    void ForEachContextByPriority(F &&fn);
+
+    /**
+     * @brief Re-sorts a context after its priority changed (called by ScriptContext::SetPriority).
+     * @param context The context whose priority changed.
+     */
+    void OnContextPriorityChanged(ScriptContext *context);
+
     /**
      * @brief Gets all contexts sorted by priority (highest first).
      * @return Vector of shared pointers to contexts sorted by priority.
@@ -243,6 +279,8 @@ public:
     const CustomContextLimits &GetCustomContextLimits() const { return m_CustomLimits; }
 
     // --- Event Subscription ---
+    // Subscriptions are kept per EventId as direct context pointers; the name-based
+    // overloads resolve the context and event and forward to them.
 
     /**
      * @brief Subscribes a context to a game event.
@@ -251,6 +289,13 @@ public:
      */
     void SubscribeToEvent(const std::string &contextName, const std::string &eventName);
 
+    /**
+     * @brief Subscribes a context to an interned game event.
+     * @param context The context to subscribe (must be owned by this manager).
+     * @param eventId The event ID (from EventManager::InternEvent).
+     */
+    void SubscribeToEvent(ScriptContext *context, EventManager::EventId eventId);
+
     /**
      * @brief Unsubscribes a context from a game event.
      * @param contextName Name of the context to unsubscribe.
@@ -258,12 +303,25 @@ public:
      */
     void UnsubscribeFromEvent(const std::string &contextName, const std::string &eventName);
 
+    /**
+     * @brief Unsubscribes a context from an interned game event.
+     * @param context The context to unsubscribe.
+     * @param eventId The event ID.
+     */
+    void UnsubscribeFromEvent(const ScriptContext *context, EventManager::EventId eventId);
+
     /**
      * @brief Unsubscribes a context from all events.
      * @param contextName Name of the context.
      */
     void UnsubscribeFromAllEvents(const std::string &contextName);
 
+    /**
+     * @brief Unsubscribes a context from all events.
+     * @param context The context.
+     */
+    void UnsubscribeFromAllEvents(const ScriptContext *context);
+
     /**
      * @brief Checks if a context is subscribed to an event.
      * @param contextName Name of the context.
@@ -280,6 +338,14 @@ public:
     template <typename... Args>
     void FireGameEventToAll(const std::string &eventName, Args... args);
 
+    /**
+     * @brief Fires an interned game event to all subscribed contexts.
+     * @param eventId The event ID.
+     * @param args Optional arguments to pass to event handlers.
+     */
+    template <typename... Args>
+    void FireGameEventToAll(EventManager::EventId eventId, Args... args);
+
     /**
      * @brief Fires a game event to a specific context.
      * @param contextName Name of the context to fire the event to.
@@ -301,12 +367,56 @@ private:
     void RegisterCustomContext(const std::string &name, const std::string &levelKey, size_t memoryLimitBytes);
     void UnregisterCustomContext(const std::string &name);
 
+    // Priority list maintenance (see m_ByPriority)
+    struct PriorityEntry;
+    bool CheckMemoryLimit(const PriorityEntry &entry, std::vector<std::string> &contextsToDestroy);
+    void TickContextsSerial(std::vector<std::string> &contextsToDestroy);
+    void TickContextsParallel(std::vector<std::string> &contextsToDestroy);
+    void AddToPriorityOrder(ScriptContext *context);
+    void RemoveFromPriorityOrder(const ScriptContext *context);
+    PriorityEntry *FindPriorityEntry(const ScriptContext *context);
+    void InsertSorted(const PriorityEntry &entry);
+    void EndPriorityWalk();
+
+    class PriorityWalkScope {
+    public:
+        explicit PriorityWalkScope(ScriptContextManager &manager) : m_Manager(manager) { ++m_Manager.m_PriorityWalkDepth; }
+        ~PriorityWalkScope() { m_Manager.EndPriorityWalk(); }
+
+        PriorityWalkScope(const PriorityWalkScope &) = delete;
+        PriorityWalkScope &operator=(const PriorityWalkScope &) = delete;
+
+    private:
+        ScriptContextManager &m_Manager;
+    };
+
     // Core references
     TASEngine *m_Engine;
 
     // Context storage (name -> context)
     std::map<std::string, std::shared_ptr<ScriptContext>> m_Contexts;
 
+    // Contexts of m_Contexts sorted by priority (highest first, creation order on
+    // ties), updated on create/destroy/SetPriority only. Per-context tick data lives
+    // inline so TickAll needs no lookups.
+    struct PriorityEntry {
+        ScriptContext *context = nullptr; // nullptr = removed during a walk
+        size_t memoryLimitBytes = 0;      // 0 = unlimited
+    };
+    std::vector<PriorityEntry> m_ByPriority;
+
+    // Changes made while a walk is in progress are applied when the outermost walk ends
+    int m_PriorityWalkDepth = 0;
+    bool m_PriorityOrderDirty = false;
+    std::vector<PriorityEntry> m_PendingPriorityEntries;
+    std::vector<std::shared_ptr<ScriptContext>> m_DeferredReleases;
+
+    // Parallel ticking (null = serial); scratch state reused every tick
+    std::unique_ptr<WorkerPool> m_WorkerPool;
+    std::vector<size_t> m_IsolatedBatch;            // Indices into m_ByPriority
+    std::vector<MessageBus::Outbox> m_TickOutboxes; // Parallel to m_ByPriority
+    std::vector<std::vector<std::function<void()>>> m_TickDeferred; // Parallel to m_ByPriority
+
     // Inter-context communication
     std::unique_ptr<SharedDataManager> m_SharedData;
     std::unique_ptr<MessageBus> m_MessageBus;
@@ -326,10 +436,10 @@ private:
     size_t m_CustomContextCount = 0;
     std::unordered_map<std::string, size_t> m_CustomContextsPerLevel;
     std::unordered_map<std::string, std::string> m_CustomContextLevelMap;
-    std::unordered_map<std::string, size_t> m_CustomContextMemoryLimits;
 
-    // Event subscriptions (eventName -> set of contextNames)
-    std::map<std::string, std::vector<std::string>> m_EventSubscriptions;
+    // Event subscriptions indexed by EventId (contexts are removed before they
+    // are destroyed or pooled, so the pointers never dangle)
+    std::vector<std::vector<ScriptContext *>> m_EventSubscriptions;
 
     // Initialization state
     bool m_IsInitialized = false;
@@ -338,14 +448,28 @@ private:
 // Template implementations
 template <typename... Args>
 void ScriptContextManager::FireGameEventToAll(const std::string &eventName, Args... args) {
-    // Fire event only to subscribed contexts (subscription-based routing)
-    auto it = m_EventSubscriptions.find(eventName);
-    if (it != m_EventSubscriptions.end()) {
-        for (const auto &contextName : it->second) {
-            auto context = GetContext(contextName);
-            if (context && context->IsExecuting()) {
-                context->FireGameEvent(eventName, args...);
-            }
+    FireGameEventToAll(EventManager::FindEvent(eventName), args...);
+}
+
+template <typename... Args>
+void ScriptContextManager::FireGameEventToAll(EventManager::EventId eventId, Args... args) {
+    // Fire event only to subscribed contexts (subscription-based routing).
+    // Handlers may (un)subscribe, so re-check the list on every step.
+    for (size_t i = 0; eventId < m_EventSubscriptions.size() && i < m_EventSubscriptions[eventId].size(); ++i) {
+        ScriptContext *context = m_EventSubscriptions[eventId][i];
+        if (context->IsExecuting()) {
+            context->FireGameEvent(eventId, args...);
+        }
+    }
+}
+
+template <typename F>
+void ScriptContextManager::ForEachContextByPriority(F &&fn) {
+    PriorityWalkScope scope(*this);
+    for (size_t i = 0; i < m_ByPriority.size(); ++i) {
+        ScriptContext *context = m_ByPriority[i].context;
+        if (context) {
+            fn(*context);
         }
     }
 }
@@ -2,154 +2,164 @@
 
 #include "Logger.h"
 #include <set>
-#include <fstream>
+#include <sstream>
 #include <filesystem>
 #include <algorithm>
 #include <chrono>
 #include <iomanip>
-#include <thread>
 
 #include "TASEngine.h"
 #include "GameInterface.h"
+#include "WorkerPool.h"
+#include "InputPatternCompressor.h"
 
 namespace fs = std::filesystem;
 
-// Key name mapping for consistent script generation
-const std::vector<std::string> ScriptGenerator::KEY_NAMES = {
-    "up", "down", "left", "right", "lshift", "space", "q", "escape"
-};
-
 // ===================================================================
-// LuaScriptBuilder Implementation
+// ScriptGenerator Implementation
 // ===================================================================
 
-ScriptGenerator::LuaScriptBuilder::LuaScriptBuilder(const GenerationOptions &options) : m_Options(options) {
-    m_CurrentIndent = std::string(m_IndentLevel * m_Options.indentSize, ' ');
-}
-
-void ScriptGenerator::LuaScriptBuilder::Indent() {
-    m_IndentLevel++;
-    m_CurrentIndent = std::string(m_IndentLevel * m_Options.indentSize, ' ');
-}
-
-void ScriptGenerator::LuaScriptBuilder::Unindent() {
-    if (m_IndentLevel > 0) {
-        m_IndentLevel--;
-        m_CurrentIndent = std::string(m_IndentLevel * m_Options.indentSize, ' ');
+ScriptGenerator::ScriptGenerator(TASEngine *engine) : m_Engine(engine) {
+    if (!m_Engine) {
+        throw std::runtime_error("ScriptGenerator requires valid TASEngine and BallanceTAS instances.");
     }
 }
 
-void ScriptGenerator::LuaScriptBuilder::AddLine(const std::string &line) {
-    m_SS << m_CurrentIndent << line << "\n";
-}
-
-void ScriptGenerator::LuaScriptBuilder::AddComment(const std::string &comment) {
-    m_SS << m_CurrentIndent << "-- " << comment << "\n";
-}
-
-void ScriptGenerator::LuaScriptBuilder::AddBlockComment(const std::string &comment) {
-    std::istringstream iss(comment);
-    std::string line;
-    m_SS << m_CurrentIndent << "--[[\n";
-    while (std::getline(iss, line)) {
-        m_SS << m_CurrentIndent << "   " << line << "\n";
+ScriptGenerator::~ScriptGenerator() {
+    {
+        std::lock_guard<std::mutex> lock(m_JobMutex);
+        m_StopWorker = true;
+        m_Jobs.clear(); // The engine is going away; queued callbacks are not run
+        m_CancelRequested.store(true, std::memory_order_relaxed);
     }
-    m_SS << m_CurrentIndent << "--]]\n";
-}
-
-void ScriptGenerator::LuaScriptBuilder::AddBlankLine() {
-    m_SS << "\n";
-}
-
-void ScriptGenerator::LuaScriptBuilder::AddSeparator(const std::string &title) {
-    if (!m_Options.addSectionSeparators) return;
+    m_JobReady.notify_all();
 
-    AddBlankLine();
-    AddComment(std::string(60, '='));
-    if (!title.empty()) {
-        AddComment(title);
-        AddComment(std::string(60, '='));
+    if (m_Worker.joinable()) {
+        m_Worker.join();
     }
-    AddBlankLine();
-}
-
-void ScriptGenerator::LuaScriptBuilder::AddMainFunction() {
-    if (m_InMainFunction) return;
-
-    AddComment("Main TAS function - called when the script starts");
-    AddLine("function main()");
-    Indent();
-    m_InMainFunction = true;
 }
 
-void ScriptGenerator::LuaScriptBuilder::CloseMainFunction() {
-    if (!m_InMainFunction) return;
-
-    AddBlankLine();
-    AddComment("Script completed successfully");
-    AddLine("tas.log(\"TAS script completed.\")");
-    Unindent();
-    AddLine("end");
-    m_InMainFunction = false;
-}
+bool ScriptGenerator::ReserveProjectDirectory(const std::string &baseName, std::string &projectName) {
+    // Creating the directory is the reservation: a name whose directory already exists,
+    // possibly created by another generator a moment ago, counts as taken
+    for (int counter = 0; counter <= 1000; ++counter) {
+        std::string candidate = counter == 0 ? baseName : baseName + "_" + std::to_string(counter);
+        std::string projectDir = m_Engine->GetPath() + candidate;
+
+        std::error_code ec;
+        if (fs::create_directories(projectDir, ec)) {
+            projectName = std::move(candidate);
+            return true;
+        }
+        if (!fs::exists(projectDir)) {
+            Log::Error("Failed to create project directory: %s (%s)", projectDir.c_str(), ec.message().c_str());
+            return false;
+        }
+    }
 
-std::string ScriptGenerator::LuaScriptBuilder::GetScript() const {
-    return m_SS.str();
+    Log::Error("Could not find available project name after 1000 attempts.");
+    return false;
 }
 
 // ===================================================================
-// ScriptGenerator Implementation
+// Managed Worker
 // ===================================================================
 
-ScriptGenerator::ScriptGenerator(TASEngine *engine) : m_Engine(engine) {
-    if (!m_Engine) {
-        throw std::runtime_error("ScriptGenerator requires valid TASEngine and BallanceTAS instances.");
+void ScriptGenerator::GenerateAsync(std::vector<FrameData> frames,
+                                    const GenerationOptions &options,
+                                    std::function<void(bool)> onComplete) {
+    {
+        std::lock_guard<std::mutex> lock(m_JobMutex);
+        if (m_StopWorker) return;
+
+        m_Jobs.push_back({std::move(frames), options, std::move(onComplete)});
+        m_PendingJobs.fetch_add(1, std::memory_order_acq_rel);
+
+        if (!m_Worker.joinable()) {
+            m_Worker = std::thread(&ScriptGenerator::WorkerLoop, this);
+        }
     }
+    m_JobReady.notify_one();
 }
 
-std::string ScriptGenerator::FindAvailableProjectName(const std::string &baseName) {
-    std::string projectDir = m_Engine->GetPath() + baseName;
+void ScriptGenerator::Cancel() {
+    std::deque<PendingJob> dropped;
+    {
+        std::lock_guard<std::mutex> lock(m_JobMutex);
+        dropped.swap(m_Jobs);
+        m_CancelRequested.store(true, std::memory_order_relaxed);
+    }
 
-    // If the base name doesn't exist, use it
-    if (!fs::exists(projectDir)) {
-        return baseName;
+    if (!dropped.empty()) {
+        Log::Info("Cancelled %zu queued script generation(s).", dropped.size());
+        m_PendingJobs.fetch_sub(dropped.size(), std::memory_order_acq_rel);
     }
 
-    // Try incrementing numbers until we find an available name
-    int counter = 1;
-    std::string availableName;
+    for (auto &job : dropped) {
+        if (job.onComplete) {
+            m_Engine->AddTimer(1ul, [onComplete = std::move(job.onComplete)]() {
+                onComplete(false);
+            });
+        }
+    }
+}
 
-    do {
-        availableName = baseName + "_" + std::to_string(counter);
-        projectDir = m_Engine->GetPath() + availableName;
-        counter++;
+void ScriptGenerator::WorkerLoop() {
+    while (true) {
+        PendingJob job;
+        {
+            std::unique_lock<std::mutex> lock(m_JobMutex);
+            m_JobReady.wait(lock, [this] { return m_StopWorker || !m_Jobs.empty(); });
+            if (m_StopWorker) {
+                return;
+            }
 
-        // Safety check to avoid infinite loop
-        if (counter > 1000) {
-            Log::Error("Could not find available project name after 1000 attempts.");
-            return baseName + "_" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
+            job = std::move(m_Jobs.front());
+            m_Jobs.pop_front();
+            // A Cancel() before this point dropped the job instead
+            m_CancelRequested.store(false, std::memory_order_relaxed);
         }
-    } while (fs::exists(projectDir));
 
-    return availableName;
-}
+        const bool success = Generate(job.frames, job.options, &m_CancelRequested);
+        job.frames = {};
 
-void ScriptGenerator::GenerateAsync(const std::vector<FrameData> &frames,
-                                    const GenerationOptions &options,
-                                    const std::function<void(bool)> &onComplete) {
-    std::thread([this, frames, options, onComplete]() {
-        bool success = Generate(frames, options);
+        {
+            std::lock_guard<std::mutex> lock(m_JobMutex);
+            if (m_StopWorker) {
+                return;
+            }
+        }
 
         // When done, notify the main thread.
-        m_Engine->AddTimer(1ul, [success, onComplete]() {
+        m_Engine->AddTimer(1ul, [success, onComplete = std::move(job.onComplete)]() {
             if (onComplete) {
                 onComplete(success);
             }
         });
-    }).detach();
+        m_PendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void ScriptGenerator::RunParallel(size_t count, const std::function<void(size_t)> &job) {
+    if (count <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            job(i);
+        }
+        return;
+    }
+
+    if (!m_Pool) {
+        m_Pool = std::make_unique<WorkerPool>();
+    }
+    m_Pool->ParallelFor(count, job);
 }
 
-bool ScriptGenerator::Generate(const std::vector<FrameData> &frames, const GenerationOptions &options) {
+// ===================================================================
+// Generation
+// ===================================================================
+
+bool ScriptGenerator::Generate(const std::vector<FrameData> &frames, const GenerationOptions &options,
+                               const std::atomic<bool> *cancel) {
     if (frames.empty()) {
         Log::Error("Cannot generate script from empty frame data.");
         return false;
@@ -159,159 +169,220 @@ bool ScriptGenerator::Generate(const std::vector<FrameData> &frames, const Gener
     m_LastStats = {};
     m_LastStats.totalFrames = frames.size();
 
+    std::string projectDir;
+    bool projectCreated = false;
+    bool success = false;
+
     try {
         UpdateProgress(0.0f);
 
-        // Handle duplicate project names by finding an available name
-        std::string finalProjectName = FindAvailableProjectName(options.projectName);
-        if (finalProjectName != options.projectName) {
-            Log::Info("Project name '%s' already exists, using '%s' instead.",
-                                        options.projectName.c_str(), finalProjectName.c_str());
-        }
-
-        GenerationOptions finalOptions = options;
-        finalOptions.projectName = finalProjectName;
-
         Log::Info("Generating TAS script '%s' from %zu frames...",
-                                    finalOptions.projectName.c_str(), frames.size());
-
-        // Create project directory
-        std::string projectDir = m_Engine->GetPath() + finalOptions.projectName;
-        if (!fs::create_directories(projectDir) && !fs::exists(projectDir)) {
-            Log::Error("Failed to create project directory: %s", projectDir.c_str());
-            return false;
-        }
-        m_LastGeneratedPath = projectDir;
-        UpdateProgress(0.1f);
+                                    options.projectName.c_str(), frames.size());
 
         // Analyze timing
         Log::Info("Analyzing frame data...");
-        auto blocks = AnalyzeTiming(frames, finalOptions);
+        std::vector<FrameChunk> chunks;
+        auto blocks = AnalyzeTiming(frames, options, chunks, cancel);
+        if (IsCancelled(cancel)) {
+            Log::Info("Script generation cancelled.");
+            return false;
+        }
         m_LastStats.totalBlocks = blocks.size();
         UpdateProgress(0.4f);
 
-        // Generate script
-        Log::Info("Building script...");
-        std::string scriptContent = BuildScript(frames, blocks, finalOptions);
-        UpdateProgress(0.7f);
-
-        // Generate manifest
-        std::string manifestContent = GenerateManifest(finalOptions);
-        UpdateProgress(0.9f);
-
-        // Write files
-        if (!CreateProjectFiles(projectDir, scriptContent, manifestContent)) {
+        // Handle duplicate project names; the directory is created as the name is chosen
+        std::string finalProjectName;
+        if (!ReserveProjectDirectory(options.projectName, finalProjectName)) {
             return false;
         }
-        UpdateProgress(1.0f);
+        projectDir = m_Engine->GetPath() + finalProjectName;
+        projectCreated = true;
 
-        auto endTime = std::chrono::high_resolution_clock::now();
-        m_LastStats.generationTime = std::chrono::duration<double>(endTime - startTime).count();
+        if (finalProjectName != options.projectName) {
+            Log::Info("Project name '%s' already exists, using '%s' instead.",
+                                        options.projectName.c_str(), finalProjectName.c_str());
+        }
 
-        Log::Info("Script generation completed successfully!");
-        Log::Info("  Project: %s", projectDir.c_str());
-        Log::Info("  Blocks: %zu", m_LastStats.totalBlocks);
-        Log::Info("  Key events: %zu", m_LastStats.keyEvents);
-        Log::Info("  Generation time: %.2fs", m_LastStats.generationTime);
+        GenerationOptions finalOptions = options;
+        finalOptions.projectName = finalProjectName;
 
-        return true;
+        // Generate script, streamed straight into main.lua
+        Log::Info("Building script...");
+        std::string scriptPath = projectDir + "/main.lua";
+        std::ofstream scriptFile(scriptPath, std::ios::binary);
+        if (!scriptFile.is_open()) {
+            Log::Error("Failed to create script file: %s", scriptPath.c_str());
+        } else if (BuildScript(frames, chunks, finalOptions, scriptFile, cancel)) {
+            scriptFile.close();
+            UpdateProgress(0.9f);
+
+            // Generate manifest
+            if (!scriptFile.fail() && WriteManifest(projectDir, GenerateManifest(finalOptions))) {
+                success = true;
+            } else if (scriptFile.fail()) {
+                Log::Error("Failed to write script file: %s", scriptPath.c_str());
+            }
+        } else if (IsCancelled(cancel)) {
+            Log::Info("Script generation cancelled.");
+        } else {
+            Log::Error("Failed to write script file: %s", scriptPath.c_str());
+        }
     } catch (const std::exception &e) {
         Log::Error("Exception during script generation: %s", e.what());
+    }
+
+    if (!success) {
+        // Don't leave a half-written project behind (only ever the directory this call created)
+        if (projectCreated) {
+            std::error_code ec;
+            fs::remove_all(projectDir, ec);
+        }
         return false;
     }
+
+    m_LastGeneratedPath = projectDir;
+    UpdateProgress(1.0f);
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    m_LastStats.generationTime = std::chrono::duration<double>(endTime - startTime).count();
+
+    Log::Info("Script generation completed successfully!");
+    Log::Info("  Project: %s", projectDir.c_str());
+    Log::Info("  Blocks: %zu", m_LastStats.totalBlocks);
+    Log::Info("  Key events: %zu", m_LastStats.keyEvents);
+    Log::Info("  Generation time: %.2fs", m_LastStats.generationTime);
+
+    return true;
 }
 
 std::vector<InputBlock> ScriptGenerator::AnalyzeTiming(const std::vector<FrameData> &frames,
-                                                       const GenerationOptions &options) {
+                                                       const GenerationOptions &options,
+                                                       std::vector<FrameChunk> &chunks,
+                                                       const std::atomic<bool> *cancel) {
     std::vector<InputBlock> blocks;
+    chunks.clear();
     if (frames.empty()) return blocks;
 
-    InputBlock currentBlock;
-    currentBlock.startFrame = frames[0].frameIndex;
-    currentBlock.endFrame = frames[0].frameIndex;
-
-    RawInputState previousState; // Start with all keys idle
-    float totalSpeed = 0.0f;
-    int speedSamples = 0;
-
-    for (size_t i = 0; i < frames.size(); ++i) {
-        const auto &frame = frames[i];
+    const size_t chunkCount = (frames.size() + kChunkFrames - 1) / kChunkFrames;
+    chunks.resize(chunkCount);
 
-        // Detect key transitions
-        auto keyEvents = DetectKeyTransitions(previousState, frame.inputState, frame.frameIndex);
+    // 1. Detect transitions chunk by chunk. A chunk only needs the frame before it.
+    RunParallel(chunkCount, [&](size_t c) {
+        FrameChunk &chunk = chunks[c];
+        chunk.beginFrame = c * kChunkFrames;
+        chunk.endFrame = std::min(frames.size(), chunk.beginFrame + kChunkFrames);
+        if (IsCancelled(cancel)) return;
 
-        // Add key events to current block
-        currentBlock.keyEvents.insert(currentBlock.keyEvents.end(), keyEvents.begin(), keyEvents.end());
-        m_LastStats.keyEvents += keyEvents.size();
-
-        // Properly preserve frame association for game events
-        for (const auto &event : frame.events) {
-            currentBlock.gameEvents.emplace_back(frame.frameIndex, event.eventName, event.eventData);
-            m_LastStats.eventsProcessed++;
+        RawInputState previousState; // Start with all keys idle
+        if (chunk.beginFrame > 0) {
+            previousState = frames[chunk.beginFrame - 1].inputState;
         }
 
-        // Track physics data
-        if (frame.physics.speed > 0.0f) {
-            totalSpeed += frame.physics.speed;
-            speedSamples++;
-        }
+        for (size_t i = chunk.beginFrame; i < chunk.endFrame; ++i) {
+            const auto &frame = frames[i];
+            const size_t firstKeyEvent = chunk.keyEvents.size();
 
-        // Update block end frame BEFORE checking for splits
-        currentBlock.endFrame = frame.frameIndex;
+            if (frame.inputState != previousState) {
+                DetectKeyTransitions(previousState, frame.inputState, frame.frameIndex, chunk.keyEvents);
+            }
 
-        // Check if we should start a new block (but not on the last frame)
-        bool shouldStartNewBlock = false;
-        if (i < frames.size() - 1 && options.addSectionSeparators) {
-            // Start new block when we have accumulated enough events
-            size_t totalEvents = currentBlock.keyEvents.size() + currentBlock.gameEvents.size();
-            shouldStartNewBlock = (totalEvents > 25); // Adjustable threshold
+            FrameMark mark;
+            mark.frame = i;
+            mark.keyEvents = chunk.keyEvents.size() - firstKeyEvent;
+            mark.gameEvents = frame.events.size();
+            mark.gapAfter = i + 1 < frames.size() && frames[i + 1].frameIndex - frame.frameIndex > 30;
+            if (mark.keyEvents > 0 || mark.gameEvents > 0 || mark.gapAfter) {
+                chunk.marks.push_back(mark);
+            }
 
-            // Also split on significant time gaps (optional)
-            if (!shouldStartNewBlock && i + 1 < frames.size()) {
-                size_t frameGap = frames[i + 1].frameIndex - frame.frameIndex;
-                shouldStartNewBlock = (frameGap > 30); // Split on gaps > 30 frames
+            chunk.gameEventCount += frame.events.size();
+            if (mark.keyEvents > 0 || mark.gameEvents > 0) {
+                chunk.lastEventFrame = frame.frameIndex;
             }
+            previousState = frame.inputState;
         }
 
-        if (shouldStartNewBlock) {
-            // Finalize current block
-            if (speedSamples > 0) {
-                currentBlock.averageSpeed = totalSpeed / speedSamples;
-                currentBlock.hasSignificantMovement = currentBlock.averageSpeed > 1.0f;
+        // Net effect of the chunk on the keys held by tas.key_down()
+        for (const auto &event : chunk.keyEvents) {
+            const uint8_t bit = static_cast<uint8_t>(1u << event.key);
+            if (event.transition == KeyTransition::Pressed) {
+                chunk.heldSet |= bit;
+                chunk.heldCleared &= static_cast<uint8_t>(~bit);
+            } else if (event.transition == KeyTransition::Released) {
+                chunk.heldCleared |= bit;
+                chunk.heldSet &= static_cast<uint8_t>(~bit);
             }
+        }
+    });
+    if (IsCancelled(cancel)) return {};
+    UpdateProgress(0.3f);
+
+    // 2. Stitch the chunks in frame order
+    size_t eventIndex = 0;
+    size_t lastEventFrame = 0;
+    uint8_t held = 0;
+    for (auto &chunk : chunks) {
+        chunk.firstEventIndex = eventIndex;
+        chunk.lastFrameBefore = lastEventFrame;
+
+        const size_t chunkEvents = chunk.keyEvents.size() + chunk.gameEventCount;
+        if (chunkEvents > 0) {
+            lastEventFrame = chunk.lastEventFrame;
+        }
+        eventIndex += chunkEvents;
+        held = static_cast<uint8_t>((held & ~chunk.heldCleared) | chunk.heldSet);
 
-            if (!currentBlock.IsEmpty()) {
-                blocks.push_back(currentBlock);
+        m_LastStats.keyEvents += chunk.keyEvents.size();
+        m_LastStats.eventsProcessed += chunk.gameEventCount;
+    }
+    m_HeldAtEnd = held;
+
+    // 3. Split into blocks. Splits only happen on frames with events or before a gap,
+    //    so only the marked frames have to be visited.
+    InputBlock currentBlock;
+    currentBlock.startFrame = frames.front().frameIndex;
+    currentBlock.endFrame = frames.front().frameIndex;
+
+    for (const auto &chunk : chunks) {
+        for (const auto &mark : chunk.marks) {
+            currentBlock.keyEventCount += mark.keyEvents;
+            currentBlock.gameEventCount += mark.gameEvents;
+            currentBlock.endFrame = frames[mark.frame].frameIndex;
+
+            // Check if we should start a new block (but not on the last frame)
+            if (!options.addSectionSeparators || mark.frame + 1 >= frames.size()) {
+                continue;
             }
 
-            // Start new block from next frame
-            currentBlock = InputBlock{};
-            currentBlock.startFrame = frames[i + 1].frameIndex;
-            currentBlock.endFrame = frames[i + 1].frameIndex;
-            totalSpeed = 0.0f;
-            speedSamples = 0;
-        }
+            // Start new block when we have accumulated enough events,
+            // or on significant time gaps
+            const size_t totalEvents = currentBlock.keyEventCount + currentBlock.gameEventCount;
+            if (totalEvents > 25 || mark.gapAfter) {
+                if (!currentBlock.IsEmpty()) {
+                    blocks.push_back(currentBlock);
+                }
 
-        previousState = frame.inputState;
+                // Start new block from next frame
+                currentBlock = InputBlock{};
+                currentBlock.startFrame = frames[mark.frame + 1].frameIndex;
+                currentBlock.endFrame = frames[mark.frame + 1].frameIndex;
+            }
+        }
     }
 
     // Add the final block
+    currentBlock.endFrame = frames.back().frameIndex;
     if (!currentBlock.IsEmpty()) {
-        if (speedSamples > 0) {
-            currentBlock.averageSpeed = totalSpeed / speedSamples;
-            currentBlock.hasSignificantMovement = currentBlock.averageSpeed > 1.0f;
-        }
         blocks.push_back(currentBlock);
     }
 
     return blocks;
 }
 
-std::vector<KeyEvent> ScriptGenerator::DetectKeyTransitions(const RawInputState &previousState,
-                                                            const RawInputState &currentState,
-                                                            size_t frameIndex) {
-    std::vector<KeyEvent> events;
-
+void ScriptGenerator::DetectKeyTransitions(const RawInputState &previousState,
+                                           const RawInputState &currentState,
+                                           size_t frameIndex,
+                                           std::vector<KeyEvent> &events) {
     for (int keyIdx = 0; keyIdx < KEY_COUNT; ++keyIdx) {
         uint8_t prevKeyState = GetKeyState(previousState, keyIdx);
         uint8_t currentKeyState = GetKeyState(currentState, keyIdx);
@@ -344,170 +415,134 @@ std::vector<KeyEvent> ScriptGenerator::DetectKeyTransitions(const RawInputState
 
         // Only add events for meaningful transitions
         if (transition != KeyTransition::NoChange) {
-            events.emplace_back(frameIndex, GetKeyName(keyIdx), transition);
+            events.emplace_back(frameIndex, static_cast<uint8_t>(keyIdx), transition);
         }
     }
+}
 
-    return events;
+void ScriptGenerator::RenderChunk(const std::vector<FrameData> &frames, const FrameChunk &chunk,
+                                  size_t totalEvents, const GenerationOptions &options,
+                                  LuaScriptBuilder &builder) {
+    // Flatten the chunk into steps. Events at the same frame: game events first, then key events
+    std::vector<InputPatternCompressor::Step> steps;
+    std::vector<StepSource> sources;
+    steps.reserve(chunk.keyEvents.size() + chunk.gameEventCount);
+    sources.reserve(steps.capacity());
+
+    size_t lastFrame = chunk.lastFrameBefore;
+    size_t nextKeyEvent = 0;
+    auto addStep = [&](size_t frameNumber, uint16_t action, const GameEvent *gameEvent, const KeyEvent *keyEvent) {
+        steps.push_back({frameNumber > lastFrame ? frameNumber - lastFrame : 0, action});
+        sources.push_back({frameNumber, gameEvent, keyEvent});
+        lastFrame = frameNumber;
+    };
+
+    for (const auto &mark : chunk.marks) {
+        const FrameData &frame = frames[mark.frame];
+        for (const auto &gameEvent : frame.events) {
+            addStep(frame.frameIndex, InputPatternCompressor::kBarrier, &gameEvent, nullptr);
+        }
+        for (size_t k = 0; k < mark.keyEvents; ++k) {
+            const KeyEvent &keyEvent = chunk.keyEvents[nextKeyEvent++];
+            addStep(keyEvent.frame,
+                    InputPatternCompressor::MakeAction(keyEvent.key, static_cast<uint8_t>(keyEvent.transition)),
+                    nullptr, &keyEvent);
+        }
+    }
+
+    RenderSteps(steps, sources, chunk.firstEventIndex, totalEvents, options, builder);
 }
 
-std::string ScriptGenerator::BuildScript(const std::vector<FrameData> &frames,
-                                         const std::vector<InputBlock> &blocks,
-                                         const GenerationOptions &options) {
-    LuaScriptBuilder builder(options);
+bool ScriptGenerator::BuildScript(const std::vector<FrameData> &frames,
+                                  const std::vector<FrameChunk> &chunks,
+                                  const GenerationOptions &options,
+                                  std::ofstream &out,
+                                  const std::atomic<bool> *cancel) {
+    LuaScriptBuilder builder(options, &out);
 
     // Script header
     builder.AddComment("TAS script for Ballance");
-    builder.AddComment("Project: " + options.projectName);
-    builder.AddComment("Generated on: " + []() {
+    builder.AddComment("Project: ", options.projectName);
+    builder.AddComment("Generated on: ", []() {
         auto now = std::chrono::system_clock::now();
         auto time_t = std::chrono::system_clock::to_time_t(now);
         std::stringstream ss;
         ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
         return ss.str();
     }());
-    builder.AddComment("Total key events: " + std::to_string(m_LastStats.keyEvents));
+    builder.AddComment("Total key events: ", m_LastStats.keyEvents);
     builder.AddSeparator();
 
     builder.AddMainFunction();
 
-    // Track currently pressed keys for validation and cleanup
-    std::set<std::string> currentlyPressed;
-
-    // Collect ALL events with frame associations
-    std::vector<std::pair<size_t, std::variant<KeyEvent, GameEvent>>> allEvents;
-
-    for (const auto &block : blocks) {
-        // Add key events
-        for (const auto &keyEvent : block.keyEvents) {
-            allEvents.emplace_back(keyEvent.frame, keyEvent);
-        }
-
-        // Add game events
-        for (const auto &gameEvent : block.gameEvents) {
-            allEvents.emplace_back(gameEvent.frame, gameEvent);
-        }
+    // Render the chunks in waves so only a few chunk buffers are alive at once
+    size_t totalEvents = 0;
+    for (const auto &chunk : chunks) {
+        totalEvents += chunk.keyEvents.size() + chunk.gameEventCount;
     }
 
-    // Sort all events by frame number for chronological processing
-    std::sort(allEvents.begin(), allEvents.end(),
-              [](const auto &a, const auto &b) {
-                  // Handle events at the same frame: game events first, then key events
-                  if (a.first == b.first) {
-                      bool aIsGame = std::holds_alternative<GameEvent>(a.second);
-                      bool bIsGame = std::holds_alternative<GameEvent>(b.second);
-                      return aIsGame && !bIsGame; // Game events before key events
-                  }
-                  return a.first < b.first;
-              });
-
-    size_t lastFrame = 0;
-
-    // Wait to the first frame if it's not 0
-    if (!allEvents.empty() && allEvents[0].first > 0) {
-        size_t initialWait = allEvents[0].first;
-        if (options.addFrameComments) {
-            builder.AddComment("Wait " + std::to_string(initialWait) + " frames to start");
-        }
-        builder.AddLine("tas.wait_ticks(" + std::to_string(initialWait) + ")");
-        lastFrame = allEvents[0].first;
-    }
+    const size_t waveSize = m_Pool ? m_Pool->GetThreadCount() + 1 : 1;
+    std::vector<std::string> rendered(std::min(waveSize, chunks.size()));
 
-    // Process all events in chronological order
-    for (size_t i = 0; i < allEvents.size(); ++i) {
-        const auto &[frameNumber, event] = allEvents[i];
+    for (size_t wave = 0; wave < chunks.size(); wave += waveSize) {
+        if (IsCancelled(cancel)) return false;
 
-        // Wait until this event's frame
-        int64_t waitFrames = frameNumber - lastFrame;
-        if (waitFrames > 0) {
-            if (options.addFrameComments) {
-                builder.AddComment("Wait " + std::to_string(waitFrames) +
-                    " frames (to frame " + std::to_string(frameNumber) + ")");
-            }
-            builder.AddLine("tas.wait_ticks(" + std::to_string(waitFrames) + ")");
-        }
+        const size_t count = std::min(waveSize, chunks.size() - wave);
+        RunParallel(count, [&](size_t n) {
+            LuaScriptBuilder chunkBuilder(options);
+            chunkBuilder.Indent();
+            RenderChunk(frames, chunks[wave + n], totalEvents, options, chunkBuilder);
+            rendered[n] = std::move(chunkBuilder.GetBuffer());
+        });
 
-        // Handle the event based on its type
-        if (std::holds_alternative<KeyEvent>(event)) {
-            const auto &keyEvent = std::get<KeyEvent>(event);
+        for (size_t n = 0; n < count; ++n) {
+            builder.AppendRaw(rendered[n]);
+            std::string().swap(rendered[n]);
+        }
+        if (!builder.Flush()) return false;
 
-            // Generate key command based on transition type
-            if (keyEvent.transition == KeyTransition::Pressed) {
-                currentlyPressed.insert(keyEvent.key);
+        UpdateProgress(0.4f + 0.5f * static_cast<float>(wave + count) / static_cast<float>(chunks.size()));
+    }
 
-                if (options.addFrameComments) {
-                    builder.AddComment("Press " + keyEvent.key + " at frame " + std::to_string(keyEvent.frame));
-                }
-                builder.AddLine("tas.key_down(\"" + keyEvent.key + "\")");
-            } else if (keyEvent.transition == KeyTransition::Released) {
-                currentlyPressed.erase(keyEvent.key);
+    // Wait until the actual end of recording, then release remaining keys
+    size_t lastFrame = chunks.empty() ? 0 : chunks.back().lastFrameBefore;
+    if (!chunks.empty() && chunks.back().keyEvents.size() + chunks.back().gameEventCount > 0) {
+        lastFrame = chunks.back().lastEventFrame;
+    }
 
-                if (options.addFrameComments) {
-                    builder.AddComment("Release " + keyEvent.key + " at frame " + std::to_string(keyEvent.frame));
-                }
-                builder.AddLine("tas.key_up(\"" + keyEvent.key + "\")");
-            } else if (keyEvent.transition == KeyTransition::PressedAndReleased) {
-                // Key was pressed and released in the same frame
-                // Use tas.press() for single-frame press/release
-                if (options.addFrameComments) {
-                    builder.AddComment(
-                        "Press and release " + keyEvent.key + " in single frame " + std::to_string(keyEvent.frame));
-                }
-                builder.AddLine("tas.press(\"" + keyEvent.key + "\")");
+    // Find the true final frame from the original recording data
+    const size_t finalRecordingFrame = frames.back().frameIndex;
 
-                // Don't track this in currentlyPressed since it's immediately released
-            }
-        } else if (std::holds_alternative<GameEvent>(event)) {
-            const auto &gameEvent = std::get<GameEvent>(event);
-
-            // Game events placed at their exact frame
-            if (options.addEventAnchors) {
-                builder.AddComment("GAME EVENT: " + gameEvent.eventName +
-                    (gameEvent.eventData != 0 ? " (data: " + std::to_string(gameEvent.eventData) + ")" : "") +
-                    " at frame " + std::to_string(gameEvent.frame));
-            }
+    // Wait until the final frame if we haven't reached it yet
+    if (finalRecordingFrame > lastFrame) {
+        builder.AddBlankLine();
+        if (options.addFrameComments) {
+            builder.AddComment("Wait until end of recording (frame ", finalRecordingFrame, ")");
         }
+        builder.AddLine("tas.wait_ticks(", finalRecordingFrame - lastFrame, ")");
+    }
 
-        lastFrame = frameNumber;
-
-        // Add section separator every 20 events for readability
-        if (options.addSectionSeparators && (i + 1) % 20 == 0 && i + 1 < allEvents.size()) {
-            builder.AddBlankLine();
-            builder.AddComment("--- Section " + std::to_string((i + 1) / 20 + 1) + " ---");
-            builder.AddBlankLine();
+    // Now release any keys that are still pressed, in name order
+    std::set<std::string> currentlyPressed;
+    for (int keyIdx = 0; keyIdx < KEY_COUNT; ++keyIdx) {
+        if (m_HeldAtEnd & (1u << keyIdx)) {
+            currentlyPressed.insert(GetKeyName(keyIdx));
         }
     }
 
-    // Wait until the actual end of recording, then release remaining keys
-    if (!frames.empty()) {
-        // Find the true final frame from the original recording data
-        size_t finalRecordingFrame = frames.back().frameIndex;
-
-        // Wait until the final frame if we haven't reached it yet
-        int64_t finalWait = finalRecordingFrame - lastFrame;
-        if (finalWait > 0) {
-            builder.AddBlankLine();
+    if (!currentlyPressed.empty()) {
+        builder.AddBlankLine();
+        builder.AddComment("Recording ended - release all remaining pressed keys");
+        for (const auto &key : currentlyPressed) {
             if (options.addFrameComments) {
-                builder.AddComment("Wait until end of recording (frame " + std::to_string(finalRecordingFrame) + ")");
-            }
-            builder.AddLine("tas.wait_ticks(" + std::to_string(finalWait) + ")");
-        }
-
-        // Now release any keys that are still pressed
-        if (!currentlyPressed.empty()) {
-            builder.AddBlankLine();
-            builder.AddComment("Recording ended - release all remaining pressed keys");
-            for (const auto &key : currentlyPressed) {
-                if (options.addFrameComments) {
-                    builder.AddComment("Release " + key + " at end of recording (frame " + std::to_string(finalRecordingFrame) + ")");
-                }
-                builder.AddLine("tas.key_up(\"" + key + "\")");
+                builder.AddComment("Release ", key, " at end of recording (frame ", finalRecordingFrame, ")");
             }
+            builder.AddLine("tas.key_up(\"", key, "\")");
         }
     }
 
     builder.CloseMainFunction();
-    return builder.GetScript();
+    return builder.Flush();
 }
 
 std::string ScriptGenerator::GenerateManifest(const GenerationOptions &options) {
@@ -539,20 +574,8 @@ std::string ScriptGenerator::GenerateManifest(const GenerationOptions &options)
     return ss.str();
 }
 
-bool ScriptGenerator::CreateProjectFiles(const std::string &projectPath,
-                                         const std::string &scriptContent,
-                                         const std::string &manifestContent) {
+bool ScriptGenerator::WriteManifest(const std::string &projectPath, const std::string &manifestContent) {
     try {
-        // Write main.lua
-        std::string scriptPath = projectPath + "/main.lua";
-        std::ofstream scriptFile(scriptPath);
-        if (!scriptFile.is_open()) {
-            Log::Error("Failed to create script file: %s", scriptPath.c_str());
-            return false;
-        }
-        scriptFile << scriptContent;
-        scriptFile.close();
-
         // Write manifest.lua
         std::string manifestPath = projectPath + "/manifest.lua";
         std::ofstream manifestFile(manifestPath);
@@ -563,7 +586,7 @@ bool ScriptGenerator::CreateProjectFiles(const std::string &projectPath,
         manifestFile << manifestContent;
         manifestFile.close();
 
-        return true;
+        return !manifestFile.fail();
     } catch (const std::exception &e) {
         Log::Error("Exception creating project files: %s", e.what());
         return false;
@@ -571,22 +594,18 @@ bool ScriptGenerator::CreateProjectFiles(const std::string &projectPath,
 }
 
 void ScriptGenerator::UpdateProgress(float progress) {
+    progress = std::max(0.0f, std::min(1.0f, progress));
+    m_Progress.store(progress, std::memory_order_relaxed);
+
     if (m_ProgressCallback) {
         try {
-            m_ProgressCallback(std::max(0.0f, std::min(1.0f, progress)));
+            m_ProgressCallback(progress);
         } catch (const std::exception &e) {
             Log::Error("Error in progress callback: %s", e.what());
         }
     }
 }
 
-std::string ScriptGenerator::GetKeyName(int keyIndex) {
-    if (keyIndex >= 0 && keyIndex < static_cast<int>(KEY_NAMES.size())) {
-        return KEY_NAMES[keyIndex];
-    }
-    return "unknown";
-}
-
 uint8_t ScriptGenerator::GetKeyState(const RawInputState &state, int keyIndex) {
     switch (keyIndex) {
     case 0: return state.keyUp;
@@ -1,21 +1,32 @@
 #pragma once
 
 #include "Recorder.h"
-
+#include "InputPatternCompressor.h"
+
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <vector>
-#include <sstream>
-#include <memory>
 
 // Forward declarations
 class TASEngine;
 class TASProject;
+class WorkerPool;
 
 /**
  * @enum KeyTransition
  * @brief Represents a key state transition between frames.
  */
-enum class KeyTransition {
+enum class KeyTransition : uint8_t {
     NoChange,           // Key state didn't change
     Pressed,            // Key was just pressed (IDLE -> PRESSED)
     Released,           // Key was just released (PRESSED -> RELEASED)
@@ -28,30 +39,26 @@ enum class KeyTransition {
  */
 struct KeyEvent {
     size_t frame = 0;
-    std::string key;
+    uint8_t key = 0; // Index into the generator's key table
     KeyTransition transition = KeyTransition::NoChange;
 
-    KeyEvent(size_t f, std::string k, KeyTransition t)
-        : frame(f), key(std::move(k)), transition(t) {}
+    KeyEvent(size_t f, uint8_t k, KeyTransition t)
+        : frame(f), key(k), transition(t) {}
 };
 
 /**
  * @struct InputBlock
- * @brief A precise representation of input over time.
- *        This tracks exact frame-by-frame changes.
+ * @brief Summary of a run of frames between two section splits.
+ *        The events themselves stay in the analyzed chunks.
  */
 struct InputBlock {
     size_t startFrame = 0;
     size_t endFrame = 0;
-    std::vector<KeyEvent> keyEvents;   // All key transitions in this block
-    std::vector<GameEvent> gameEvents; // Game events that occurred
-
-    // Analysis metadata
-    float averageSpeed = 0.0f;
-    bool hasSignificantMovement = false;
+    size_t keyEventCount = 0;
+    size_t gameEventCount = 0;
 
     size_t GetDuration() const { return endFrame - startFrame + 1; }
-    bool IsEmpty() const { return keyEvents.empty() && endFrame == startFrame; }
+    bool IsEmpty() const { return keyEventCount == 0 && endFrame == startFrame; }
 };
 
 /**
@@ -72,6 +79,7 @@ struct GenerationOptions {
     int indentSize = 2;               // Spaces per indent level
     bool addSectionSeparators = true; // Add visual separators between sections
     bool addEventAnchors = true;      // Add event-based comments
+    bool compressRepeats = true;      // Fold repeated input patterns into loops
 };
 
 /**
@@ -81,33 +89,62 @@ struct GenerationOptions {
  * This class implements precise script generation that captures exact key press/release
  * timing from the recorded input data. It generates explicit tas.key_down() and
  * tas.key_up() commands to exactly reproduce the original input sequence.
+ *
+ * Long recordings are split into frame chunks. Key transitions are detected and the
+ * script text is rendered chunk by chunk on a worker pool; the chunks are stitched
+ * back together in frame order and streamed to disk, so the whole script is never
+ * held in memory.
+ *
+ * Thread Safety:
+ * - GenerateAsync(), Cancel(), IsGenerating() and GetProgress() may be called from any thread
+ * - Generate() must not run concurrently on the same generator
  */
 class ScriptGenerator {
 public:
     explicit ScriptGenerator(TASEngine *engine);
-    ~ScriptGenerator() = default;
+    ~ScriptGenerator();
 
     // ScriptGenerator is not copyable or movable
     ScriptGenerator(const ScriptGenerator &) = delete;
     ScriptGenerator &operator=(const ScriptGenerator &) = delete;
 
     /**
-     * @brief Asynchronously generates a TAS script from the recorded frames.
+     * @brief Queues generation of a TAS script on the generator's worker thread.
+     * Jobs run one at a time in the order they were queued.
      * @param frames The raw frame data captured by the Recorder.
      * @param options Configuration options for generation.
-     * @param onComplete Callback called when generation is complete.
+     * @param onComplete Callback called on the main thread when the job is done or cancelled.
      */
-    void GenerateAsync(const std::vector<FrameData> &frames,
+    void GenerateAsync(std::vector<FrameData> frames,
                        const GenerationOptions &options,
-                       const std::function<void(bool)> &onComplete);
+                       std::function<void(bool)> onComplete);
+
+    /**
+     * @brief Cancels the running job and drops the queued ones.
+     * Their callbacks still run, with false.
+     */
+    void Cancel();
+
+    /**
+     * @brief Checks if a queued or running job is pending.
+     */
+    bool IsGenerating() const { return m_PendingJobs.load(std::memory_order_acquire) > 0; }
+
+    /**
+     * @brief Gets the progress of the running generation (0.0 - 1.0).
+     */
+    float GetProgress() const { return m_Progress.load(std::memory_order_relaxed); }
 
     /**
      * @brief The main generation method.
      * @param frames The raw frame data captured by the Recorder.
      * @param options Configuration options for generation.
+     * @param cancel Optional flag polled between chunks; generation stops and
+     *        the partial project is removed once it is set.
      * @return True if the script and project were generated successfully.
      */
-    bool Generate(const std::vector<FrameData> &frames, const GenerationOptions &options = {});
+    bool Generate(const std::vector<FrameData> &frames, const GenerationOptions &options = {},
+                  const std::atomic<bool> *cancel = nullptr);
 
     /**
      * @brief Get the path of the last generated project.
@@ -117,50 +154,205 @@ public:
 
     /**
      * @brief Set a callback to be called during generation progress.
+     * The callback runs on the thread that generates.
      * @param callback Function called with progress percentage (0.0 to 1.0).
      */
     void SetProgressCallback(std::function<void(float)> callback) {
         m_ProgressCallback = std::move(callback);
     }
 
+    /**
+     * @brief A helper class to build the Lua script text with proper indentation.
+     *
+     * Lines are appended to a reserved buffer from string and integer pieces without
+     * temporary strings. With a sink attached the buffer is written out whenever it
+     * grows past the flush threshold.
+     */
+    class LuaScriptBuilder {
+    public:
+        explicit LuaScriptBuilder(const GenerationOptions &options, std::ofstream *sink = nullptr);
+
+        void Indent();
+        void Unindent();
+
+        template <typename... Parts>
+        void AddLine(const Parts &...parts) {
+            m_Buffer.append(m_CurrentIndent);
+            (Append(parts), ...);
+            m_Buffer.push_back('\n');
+            MaybeFlush();
+        }
+
+        template <typename... Parts>
+        void AddComment(const Parts &...parts) {
+            AddLine("-- ", parts...);
+        }
+
+        void AddBlockComment(const std::string &comment);
+        void AddBlankLine();
+        void AddSeparator(const std::string &title = "");
+        void AddMainFunction();
+        void CloseMainFunction();
+
+        /**
+         * @brief Appends text rendered by another builder.
+         */
+        void AppendRaw(std::string_view text);
+
+        /**
+         * @brief Writes the buffered text to the sink.
+         * @return False if the sink reported an error.
+         */
+        bool Flush();
+
+        std::string &GetBuffer() { return m_Buffer; }
+        std::string GetScript() const { return m_Buffer; }
+
+    private:
+        void Append(std::string_view text) { m_Buffer.append(text); }
+        void Append(const char *text) { m_Buffer.append(text); }
+        void Append(const std::string &text) { m_Buffer.append(text); }
+
+        template <typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+        void Append(T value) {
+            char digits[24];
+            const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            m_Buffer.append(digits, result.ptr);
+        }
+
+        void MaybeFlush() {
+            if (m_Sink && m_Buffer.size() >= kFlushThreshold) {
+                Flush();
+            }
+        }
+
+        std::string m_Buffer;
+        std::ofstream *m_Sink;
+        int m_IndentLevel = 0;
+        std::string m_CurrentIndent;
+        const GenerationOptions &m_Options;
+        bool m_InMainFunction = false;
+    };
+
+    /**
+     * @struct StepSource
+     * @brief The event behind a rendered step: a game event or a key event at a frame.
+     */
+    struct StepSource {
+        size_t frame = 0;
+        const GameEvent *gameEvent = nullptr;
+        const KeyEvent *keyEvent = nullptr;
+    };
+
+    /**
+     * @brief Renders a stream of steps as Lua.
+     * Game event steps are barriers: they only emit their wait and, with event anchors, a comment.
+     * If the steps start the script, the wait before the first one is emitted up front, so a loop
+     * can begin at the first step. Repeated stretches become loops if compressRepeats is set, and
+     * a section separator follows every 20th event except the last one of the script.
+     * @param steps The steps, in script order; the wait of the first one may be zeroed.
+     * @param sources The event of each step.
+     * @param firstEventIndex Global index of the first step's event.
+     * @param totalEvents Number of events in the whole script.
+     * @param options Generation options.
+     * @param builder Receives the rendered lines.
+     */
+    static void RenderSteps(std::vector<InputPatternCompressor::Step> &steps,
+                            const std::vector<StepSource> &sources,
+                            size_t firstEventIndex, size_t totalEvents,
+                            const GenerationOptions &options, LuaScriptBuilder &builder);
+
 private:
+    static constexpr size_t kChunkFrames = 16384;        // Frames analyzed and rendered per chunk
+    static constexpr size_t kFlushThreshold = 256 * 1024; // Script bytes buffered before a write
+
+    /**
+     * @struct FrameMark
+     * @brief A frame that has events or is followed by a gap in the frame numbers.
+     */
+    struct FrameMark {
+        size_t frame = 0; // Index into the frame vector
+        size_t keyEvents = 0;
+        size_t gameEvents = 0;
+        bool gapAfter = false;
+    };
+
+    /**
+     * @struct FrameChunk
+     * @brief The analysis of one contiguous range of frames.
+     */
+    struct FrameChunk {
+        size_t beginFrame = 0; // Index into the frame vector
+        size_t endFrame = 0;   // One past the last frame
+        std::vector<KeyEvent> keyEvents;
+        std::vector<FrameMark> marks;
+        size_t gameEventCount = 0;
+        size_t lastEventFrame = 0; // Frame number of the chunk's last event
+
+        // Keys the chunk leaves held or released through tas.key_down()/tas.key_up()
+        uint8_t heldSet = 0;
+        uint8_t heldCleared = 0;
+
+        // Stitching state, filled in frame order after the parallel pass
+        size_t firstEventIndex = 0; // Global index of the chunk's first event
+        size_t lastFrameBefore = 0; // Frame number of the last event before the chunk
+    };
+
+    struct PendingJob {
+        std::vector<FrameData> frames;
+        GenerationOptions options;
+        std::function<void(bool)> onComplete;
+    };
+
     /**
-     * @brief Finds an available project name, handling duplicates by adding numeric suffixes.
+     * @brief Picks a project name and creates its directory, adding numeric suffixes to duplicates.
+     * A name whose directory already exists is skipped, so concurrent generators never share one.
      * @param baseName The desired base name for the project.
-     * @return An available project name (may have numeric suffix if base name exists).
+     * @param projectName Receives the reserved name (may have a numeric suffix).
+     * @return True if a directory was created for the name.
      */
-    std::string FindAvailableProjectName(const std::string &baseName);
+    bool ReserveProjectDirectory(const std::string &baseName, std::string &projectName);
 
     /**
-     * @brief Analyzes frame sequence and detects all key state transitions.
+     * @brief Detects all key transitions, chunk by chunk in parallel, then stitches the
+     *        chunks and splits the frames into blocks.
      * @param frames The raw frame data.
      * @param options Generation options.
-     * @return A vector of InputBlocks.
+     * @param chunks Receives the analyzed chunks in frame order.
+     * @param cancel Optional cancellation flag.
+     * @return The block summaries, or an empty vector if cancelled.
      */
     std::vector<InputBlock> AnalyzeTiming(const std::vector<FrameData> &frames,
-                                          const GenerationOptions &options);
+                                          const GenerationOptions &options,
+                                          std::vector<FrameChunk> &chunks,
+                                          const std::atomic<bool> *cancel);
 
     /**
      * @brief Detects key state transitions between two consecutive frames.
      * @param previousState Previous frame's input state.
      * @param currentState Current frame's input state.
      * @param frameIndex Current frame number.
-     * @return Vector of key events for this frame.
+     * @param events Receives the key events for this frame.
      */
-    std::vector<KeyEvent> DetectKeyTransitions(const RawInputState &previousState,
-                                               const RawInputState &currentState,
-                                               size_t frameIndex);
+    static void DetectKeyTransitions(const RawInputState &previousState,
+                                     const RawInputState &currentState,
+                                     size_t frameIndex,
+                                     std::vector<KeyEvent> &events);
 
     /**
-     * @brief Generates the main script with structure and comments.
+     * @brief Renders the script and streams it to a file.
      * @param frames The raw frame data.
-     * @param blocks The analyzed input blocks.
+     * @param chunks The analyzed chunks.
      * @param options Generation options.
-     * @return A string containing the script.
+     * @param out The script file.
+     * @param cancel Optional cancellation flag.
+     * @return False if cancelled or the file could not be written.
      */
-    std::string BuildScript(const std::vector<FrameData> &frames,
-                            const std::vector<InputBlock> &blocks,
-                            const GenerationOptions &options);
+    bool BuildScript(const std::vector<FrameData> &frames,
+                     const std::vector<FrameChunk> &chunks,
+                     const GenerationOptions &options,
+                     std::ofstream &out,
+                     const std::atomic<bool> *cancel);
 
     /**
      * @brief Generate the manifest.lua file for the project.
@@ -170,15 +362,12 @@ private:
     std::string GenerateManifest(const GenerationOptions &options);
 
     /**
-     * @brief Create the project directory and files.
+     * @brief Write the manifest file of the project.
      * @param projectPath The full path to the project directory.
-     * @param scriptContent The main.lua content.
      * @param manifestContent The manifest.lua content.
-     * @return True if files were created successfully.
+     * @return True if the file was created successfully.
      */
-    bool CreateProjectFiles(const std::string &projectPath,
-                            const std::string &scriptContent,
-                            const std::string &manifestContent);
+    bool WriteManifest(const std::string &projectPath, const std::string &manifestContent);
 
     /**
      * @brief Update progress callback if set.
@@ -186,12 +375,22 @@ private:
      */
     void UpdateProgress(float progress);
 
+    /**
+     * @brief Runs the given job count in parallel when the pool is worth it.
+     */
+    void RunParallel(size_t count, const std::function<void(size_t)> &job);
+
+    /**
+     * @brief Processes queued jobs until the generator is destroyed.
+     */
+    void WorkerLoop();
+
     /**
      * @brief Get the string name for a key from the input state.
      * @param keyIndex Index of the key in the RawInputState structure.
      * @return String name of the key.
      */
-    static std::string GetKeyName(int keyIndex);
+    static const std::string &GetKeyName(int keyIndex);
 
     /**
      * @brief Get the keyboard state value for a specific key from RawInputState.
@@ -201,32 +400,22 @@ private:
      */
     static uint8_t GetKeyState(const RawInputState &state, int keyIndex);
 
+    static bool IsCancelled(const std::atomic<bool> *cancel) {
+        return cancel && cancel->load(std::memory_order_relaxed);
+    }
+
     /**
-     * @brief A helper class to build the Lua script string with proper indentation.
+     * @brief Renders the events of one chunk.
+     * Repeated stretches of key events are emitted as loops if compressRepeats is set.
+     * @param frames The raw frame data.
+     * @param chunk The analyzed chunk.
+     * @param totalEvents Number of events in the whole script.
+     * @param options Generation options.
+     * @param builder Receives the rendered lines.
      */
-    class LuaScriptBuilder {
-    public:
-        explicit LuaScriptBuilder(const GenerationOptions &options);
-
-        void Indent();
-        void Unindent();
-        void AddLine(const std::string &line);
-        void AddComment(const std::string &comment);
-        void AddBlockComment(const std::string &comment);
-        void AddBlankLine();
-        void AddSeparator(const std::string &title = "");
-        void AddMainFunction();
-        void CloseMainFunction();
-
-        std::string GetScript() const;
-
-    private:
-        std::stringstream m_SS;
-        int m_IndentLevel = 0;
-        std::string m_CurrentIndent;
-        const GenerationOptions &m_Options;
-        bool m_InMainFunction = false;
-    };
+    static void RenderChunk(const std::vector<FrameData> &frames, const FrameChunk &chunk,
+                            size_t totalEvents, const GenerationOptions &options,
+                            LuaScriptBuilder &builder);
 
     // Core references
     TASEngine *m_Engine;
@@ -234,6 +423,18 @@ private:
     // State
     std::string m_LastGeneratedPath;
     std::function<void(float)> m_ProgressCallback;
+    std::atomic<float> m_Progress{0.0f};
+    std::unique_ptr<WorkerPool> m_Pool; // Created on the first generation with several chunks
+    uint8_t m_HeldAtEnd = 0;            // Keys still held after the last frame, one bit per key
+
+    // Managed worker
+    std::thread m_Worker;
+    std::mutex m_JobMutex;
+    std::condition_variable m_JobReady;
+    std::deque<PendingJob> m_Jobs;
+    std::atomic<size_t> m_PendingJobs{0};
+    std::atomic<bool> m_CancelRequested{false};
+    bool m_StopWorker = false;
 
     // Statistics
     struct GenerationStats {
@@ -0,0 +1,210 @@
+#include "ScriptGenerator.h"
+
+#include <sstream>
+
+// Key name mapping for consistent script generation
+const std::vector<std::string> ScriptGenerator::KEY_NAMES = {
+    "up", "down", "left", "right", "lshift", "space", "q", "escape"
+};
+
+// ===================================================================
+// LuaScriptBuilder Implementation
+// ===================================================================
+
+ScriptGenerator::LuaScriptBuilder::LuaScriptBuilder(const GenerationOptions &options, std::ofstream *sink)
+    : m_Sink(sink), m_Options(options) {
+    m_CurrentIndent = std::string(m_IndentLevel * m_Options.indentSize, ' ');
+    if (m_Sink) {
+        m_Buffer.reserve(kFlushThreshold + 4096);
+    }
+}
+
+void ScriptGenerator::LuaScriptBuilder::Indent() {
+    m_IndentLevel++;
+    m_CurrentIndent = std::string(m_IndentLevel * m_Options.indentSize, ' ');
+}
+
+void ScriptGenerator::LuaScriptBuilder::Unindent() {
+    if (m_IndentLevel > 0) {
+        m_IndentLevel--;
+        m_CurrentIndent = std::string(m_IndentLevel * m_Options.indentSize, ' ');
+    }
+}
+
+void ScriptGenerator::LuaScriptBuilder::AddBlockComment(const std::string &comment) {
+    std::istringstream iss(comment);
+    std::string line;
+    AddLine("--[[");
+    while (std::getline(iss, line)) {
+        AddLine("   ", line);
+    }
+    AddLine("--]]");
+}
+
+void ScriptGenerator::LuaScriptBuilder::AddBlankLine() {
+    m_Buffer.push_back('\n');
+}
+
+void ScriptGenerator::LuaScriptBuilder::AddSeparator(const std::string &title) {
+    if (!m_Options.addSectionSeparators) return;
+
+    AddBlankLine();
+    AddComment(std::string(60, '='));
+    if (!title.empty()) {
+        AddComment(title);
+        AddComment(std::string(60, '='));
+    }
+    AddBlankLine();
+}
+
+void ScriptGenerator::LuaScriptBuilder::AddMainFunction() {
+    if (m_InMainFunction) return;
+
+    AddComment("Main TAS function - called when the script starts");
+    AddLine("function main()");
+    Indent();
+    m_InMainFunction = true;
+}
+
+void ScriptGenerator::LuaScriptBuilder::CloseMainFunction() {
+    if (!m_InMainFunction) return;
+
+    AddBlankLine();
+    AddComment("Script completed successfully");
+    AddLine("tas.log(\"TAS script completed.\")");
+    Unindent();
+    AddLine("end");
+    m_InMainFunction = false;
+}
+
+void ScriptGenerator::LuaScriptBuilder::AppendRaw(std::string_view text) {
+    m_Buffer.append(text);
+    MaybeFlush();
+}
+
+bool ScriptGenerator::LuaScriptBuilder::Flush() {
+    if (!m_Sink) return true;
+
+    if (!m_Buffer.empty()) {
+        m_Sink->write(m_Buffer.data(), static_cast<std::streamsize>(m_Buffer.size()));
+        m_Buffer.clear();
+    }
+    return m_Sink->good();
+}
+
+// ===================================================================
+// Step Rendering
+// ===================================================================
+
+void ScriptGenerator::RenderSteps(std::vector<InputPatternCompressor::Step> &steps,
+                                  const std::vector<StepSource> &sources,
+                                  size_t firstEventIndex, size_t totalEvents,
+                                  const GenerationOptions &options, LuaScriptBuilder &builder) {
+    if (steps.empty()) return;
+
+    // Wait to the first frame if it's not 0
+    if (firstEventIndex == 0 && steps[0].wait > 0) {
+        if (options.addFrameComments) {
+            builder.AddComment("Wait ", steps[0].wait, " frames to start");
+        }
+        builder.AddLine("tas.wait_ticks(", steps[0].wait, ")");
+        steps[0].wait = 0;
+    }
+
+    std::vector<InputPatternCompressor::Run> runs;
+    if (options.compressRepeats) {
+        InputPatternCompressor().FindRuns(steps, runs);
+    }
+
+    auto emitStep = [&](size_t s, bool withComments) {
+        const StepSource &source = sources[s];
+        withComments = withComments && options.addFrameComments;
+
+        // Wait until this event's frame
+        if (steps[s].wait > 0) {
+            if (withComments) {
+                builder.AddComment("Wait ", steps[s].wait, " frames (to frame ", source.frame, ")");
+            }
+            builder.AddLine("tas.wait_ticks(", steps[s].wait, ")");
+        }
+
+        if (source.gameEvent) {
+            // Game events placed at their exact frame
+            const GameEvent &gameEvent = *source.gameEvent;
+            if (!options.addEventAnchors) return;
+            if (gameEvent.eventData != 0) {
+                builder.AddComment("GAME EVENT: ", gameEvent.eventName, " (data: ", gameEvent.eventData,
+                                   ") at frame ", source.frame);
+            } else {
+                builder.AddComment("GAME EVENT: ", gameEvent.eventName, " at frame ", source.frame);
+            }
+            return;
+        }
+
+        // Generate key command based on transition type
+        const KeyEvent &keyEvent = *source.keyEvent;
+        const std::string &key = GetKeyName(keyEvent.key);
+        if (keyEvent.transition == KeyTransition::Pressed) {
+            if (withComments) {
+                builder.AddComment("Press ", key, " at frame ", keyEvent.frame);
+            }
+            builder.AddLine("tas.key_down(\"", key, "\")");
+        } else if (keyEvent.transition == KeyTransition::Released) {
+            if (withComments) {
+                builder.AddComment("Release ", key, " at frame ", keyEvent.frame);
+            }
+            builder.AddLine("tas.key_up(\"", key, "\")");
+        } else if (keyEvent.transition == KeyTransition::PressedAndReleased) {
+            // Key was pressed and released in the same frame
+            // Use tas.press() for single-frame press/release
+            if (withComments) {
+                builder.AddComment("Press and release ", key, " in single frame ", keyEvent.frame);
+            }
+            builder.AddLine("tas.press(\"", key, "\")");
+        }
+    };
+
+    size_t eventIndex = firstEventIndex;
+    size_t nextRun = 0;
+    for (size_t s = 0; s < steps.size();) {
+        const size_t previousIndex = eventIndex;
+
+        if (nextRun < runs.size() && runs[nextRun].begin == s) {
+            // The steps of a run repeat exactly, waits included, so the loop replays them tick for tick
+            const InputPatternCompressor::Run &run = runs[nextRun++];
+            if (options.addFrameComments) {
+                builder.AddComment("Repeat ", run.repeats, " times (frames ", sources[s].frame, " to ",
+                                   sources[run.GetEnd() - 1].frame, ")");
+            }
+            builder.AddLine("for _ = 1, ", run.repeats, " do");
+            builder.Indent();
+            for (size_t j = s; j < s + run.period; ++j) {
+                emitStep(j, false);
+            }
+            builder.Unindent();
+            builder.AddLine("end");
+
+            eventIndex += run.GetLength();
+            s = run.GetEnd();
+        } else {
+            emitStep(s, true);
+            ++eventIndex;
+            ++s;
+        }
+
+        // Add section separator every 20 events for readability
+        if (options.addSectionSeparators && eventIndex / 20 != previousIndex / 20 && eventIndex < totalEvents) {
+            builder.AddBlankLine();
+            builder.AddComment("--- Section ", eventIndex / 20 + 1, " ---");
+            builder.AddBlankLine();
+        }
+    }
+}
+
+const std::string &ScriptGenerator::GetKeyName(int keyIndex) {
+    static const std::string unknown = "unknown";
+    if (keyIndex >= 0 && keyIndex < static_cast<int>(KEY_NAMES.size())) {
+        return KEY_NAMES[keyIndex];
+    }
+    return unknown;
+}
@@ -2,6 +2,7 @@
 
 #include "Logger.h"
 #include "TASEngine.h"
+#include <algorithm>
 #include <stdexcept>
 #include <chrono>
 
@@ -24,9 +25,15 @@ bool SharedDataManager::Initialize() {
     Log::Info("Initializing SharedDataManager...");
 
     try {
-        // Initialize mutex and clear any existing data
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        m_Data.clear();
+        // Clear any existing data
+        for (Shard &shard : m_Shards) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.data.clear();
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_ExpiryMutex);
+            m_Expiry.clear();
+        }
 
         m_IsInitialized = true;
         Log::Info("SharedDataManager initialized successfully.");
@@ -44,6 +51,14 @@ void SharedDataManager::Shutdown() {
 
     try {
         Clear();
+        {
+            std::unique_lock<std::shared_mutex> lock(m_WatchMutex);
+            m_SlotWatches.clear();
+        }
+        {
+            std::unique_lock<std::shared_mutex> lock(m_SlotMutex);
+            m_Slots.clear();
+        }
         m_IsInitialized = false;
         Log::Info("SharedDataManager shutdown complete.");
     } catch (const std::exception &e) {
@@ -60,30 +75,33 @@ bool SharedDataManager::Set(const std::string &key, sol::object value, const Set
     }
 
     try {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-
-        // Get old value for watch notifications
-        StoredValue oldValue;
-        auto it = m_Data.find(key);
-        if (it != m_Data.end()) {
-            oldValue = it->second;
-        }
+        // Convert before locking; the stored value is never modified afterwards
+        auto stored = std::make_shared<StoredValue>(StoredValue::FromLuaObject(value));
 
         // Calculate expiry time if TTL is set
-        int64_t expiryTime = 0;
         if (options.ttl_ms > 0) {
-            expiryTime = GetCurrentTimeMs() + options.ttl_ms;
+            stored->expiryTime = GetCurrentTimeMs() + options.ttl_ms;
+        }
+        const int64_t expiryTime = stored->expiryTime;
+        ValuePtr newValue = std::move(stored);
+
+        ValuePtr oldValue;
+        {
+            Shard &shard = GetShard(key);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            ValuePtr &slot = shard.data[key];
+            oldValue = std::move(slot);
+            slot = newValue;
+
+            // Queue watch notification for delivery on next Tick() (avoids mutex deadlock)
+            QueueWatchNotification(key, oldValue, newValue);
         }
 
-        // Create new value from Lua object
-        StoredValue newValue = StoredValue::FromLuaObject(value);
-        newValue.expiryTime = expiryTime;
-
-        // Store the value
-        m_Data[key] = newValue;
-
-        // Queue watch notification for delivery on next Tick() (avoids mutex deadlock)
-        QueueWatchNotificationLocked(key, oldValue, newValue);
+        if (expiryTime > 0) {
+            std::lock_guard<std::mutex> lock(m_ExpiryMutex);
+            m_Expiry.push_back({expiryTime, key});
+            std::push_heap(m_Expiry.begin(), m_Expiry.end(), std::greater<>());
+        }
 
         return true;
     } catch (const std::exception &e) {
@@ -100,20 +118,22 @@ sol::object SharedDataManager::Get(sol::state_view lua, const std::string &key,
     }
 
     try {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        auto it = m_Data.find(key);
-        if (it != m_Data.end()) {
-            // Check if value has expired
-            if (it->second.IsExpired(GetCurrentTimeMs())) {
-                // Value expired, remove it and return default
-                StoredValue expiredValue = it->second;
-                QueueWatchNotificationLocked(key, expiredValue, StoredValue());
-                m_Data.erase(it);
+        ValuePtr value;
+        {
+            const Shard &shard = GetShard(key);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.data.find(key);
+            if (it == shard.data.end()) {
                 return defaultValue;
             }
-            return it->second.ToLuaObject(lua);
+            value = it->second;
         }
-        return defaultValue;
+
+        // Expired values are removed (and watchers notified) by the next Tick()
+        if (value->IsExpired(GetCurrentTimeMs())) {
+            return defaultValue;
+        }
+        return value->ToLuaObject(lua);
     } catch (const std::exception &e) {
         Log::Error("SharedDataManager: Failed to get key '%s': %s",
                                     key.c_str(), e.what());
@@ -122,14 +142,15 @@ sol::object SharedDataManager::Get(sol::state_view lua, const std::string &key,
 }
 
 bool SharedDataManager::Has(const std::string &key) const {
-    std::lock_guard<std::mutex> lock(m_Mutex);
-    auto it = m_Data.find(key);
-    if (it == m_Data.end()) {
+    const Shard &shard = GetShard(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.data.find(key);
+    if (it == shard.data.end()) {
         return false;
     }
 
     int64_t currentTime = GetCurrentTimeMs();
-    if (it->second.IsExpired(currentTime)) {
+    if (it->second->IsExpired(currentTime)) {
         return false;
     }
 
@@ -137,46 +158,56 @@ bool SharedDataManager::Has(const std::string &key) const {
 }
 
 bool SharedDataManager::Remove(const std::string &key) {
-    std::lock_guard<std::mutex> lock(m_Mutex);
-    auto it = m_Data.find(key);
-    if (it == m_Data.end()) {
+    Shard &shard = GetShard(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.data.find(key);
+    if (it == shard.data.end()) {
         return false;
     }
 
-    StoredValue oldValue = it->second;
-    m_Data.erase(it);
-    QueueWatchNotificationLocked(key, oldValue, StoredValue());
+    ValuePtr oldValue = std::move(it->second);
+    shard.data.erase(it);
+    QueueWatchNotification(key, std::move(oldValue), nullptr);
     return true;
 }
 
 void SharedDataManager::Clear() {
-    std::lock_guard<std::mutex> lock(m_Mutex);
-    for (const auto &[key, value] : m_Data) {
-        QueueWatchNotificationLocked(key, value, StoredValue());
+    for (Shard &shard : m_Shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        for (auto &[key, value] : shard.data) {
+            QueueWatchNotification(key, std::move(value), nullptr);
+        }
+        shard.data.clear();
     }
-    m_Data.clear();
+
+    std::lock_guard<std::mutex> lock(m_ExpiryMutex);
+    m_Expiry.clear();
 }
 
 std::vector<std::string> SharedDataManager::GetKeys() const {
-    std::lock_guard<std::mutex> lock(m_Mutex);
     std::vector<std::string> keys;
-    keys.reserve(m_Data.size());
     int64_t currentTime = GetCurrentTimeMs();
-    for (const auto &[key, value] : m_Data) {
-        if (!value.IsExpired(currentTime)) {
-            keys.push_back(key);
+    for (const Shard &shard : m_Shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        keys.reserve(keys.size() + shard.data.size());
+        for (const auto &[key, value] : shard.data) {
+            if (!value->IsExpired(currentTime)) {
+                keys.push_back(key);
+            }
         }
     }
     return keys;
 }
 
 size_t SharedDataManager::GetSize() const {
-    std::lock_guard<std::mutex> lock(m_Mutex);
     int64_t currentTime = GetCurrentTimeMs();
     size_t count = 0;
-    for (const auto &[key, value] : m_Data) {
-        if (!value.IsExpired(currentTime)) {
-            ++count;
+    for (const Shard &shard : m_Shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        for (const auto &[key, value] : shard.data) {
+            if (!value->IsExpired(currentTime)) {
+                ++count;
+            }
         }
     }
     return count;
@@ -298,29 +329,43 @@ void SharedDataManager::Watch(const std::string &contextName, std::weak_ptr<Scri
         return;
     }
 
-    std::lock_guard<std::mutex> lock(m_Mutex);
-    m_Watches[key][contextName] = WatchEntry(contextPtr, callback, ++m_WatchGeneration);
+    std::unique_lock<std::shared_mutex> lock(m_WatchMutex);
+    auto &entries = m_Watches[key];
+    if (entries.empty()) {
+        m_WatchedKeys.fetch_add(1, std::memory_order_relaxed);
+    }
+    entries[contextName] = WatchEntry(contextPtr, callback, ++m_WatchGeneration);
     Log::Info("[%s] Watching key '%s' (generation: %llu).",
                                contextName.c_str(), key.c_str(), m_WatchGeneration);
 }
 
 void SharedDataManager::Unwatch(const std::string &contextName, const std::string &key) {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::unique_lock<std::shared_mutex> lock(m_WatchMutex);
     auto it = m_Watches.find(key);
     if (it != m_Watches.end()) {
         it->second.erase(contextName);
         if (it->second.empty()) {
             m_Watches.erase(it);
+            m_WatchedKeys.fetch_sub(1, std::memory_order_relaxed);
         }
     }
 }
 
 void SharedDataManager::UnwatchAll(const std::string &contextName) {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::unique_lock<std::shared_mutex> lock(m_WatchMutex);
     for (auto it = m_Watches.begin(); it != m_Watches.end();) {
         it->second.erase(contextName);
         if (it->second.empty()) {
             it = m_Watches.erase(it);
+            m_WatchedKeys.fetch_sub(1, std::memory_order_relaxed);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = m_SlotWatches.begin(); it != m_SlotWatches.end();) {
+        it->second.entries.erase(contextName);
+        if (it->second.entries.empty()) {
+            it = m_SlotWatches.erase(it);
         } else {
             ++it;
         }
@@ -336,7 +381,7 @@ void SharedDataManager::TriggerWatches(const std::string &key,
     // Step 1: Copy watch entries while holding mutex (avoid race condition)
     std::unordered_map<std::string, WatchEntry> watchEntries;
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::shared_lock<std::shared_mutex> lock(m_WatchMutex);
         auto it = m_Watches.find(key);
         if (it == m_Watches.end()) {
             return;  // No watches for this key
@@ -345,7 +390,16 @@ void SharedDataManager::TriggerWatches(const std::string &key,
     }
 
     // Step 2: Invoke all callbacks outside mutex, validating context lifetime
-    for (const auto &[contextName, entry] : watchEntries) {
+    InvokeWatchEntries(key, watchEntries, [&](sol::state_view lua) {
+        return std::make_pair(newValue.ToLuaObject(lua), oldValue.ToLuaObject(lua));
+    });
+}
+
+void SharedDataManager::InvokeWatchEntries(
+    const std::string &key,
+    const std::unordered_map<std::string, WatchEntry> &entries,
+    const std::function<std::pair<sol::object, sol::object>(sol::state_view)> &makeValues) {
+    for (const auto &[contextName, entry] : entries) {
         // Validate context is still alive
         auto contextPtr = entry.context.lock();
         if (!contextPtr) {
@@ -364,8 +418,7 @@ void SharedDataManager::TriggerWatches(const std::string &key,
             sol::state_view lua = entry.callback.lua_state();
 
             // Convert values to Lua objects
-            sol::object oldLuaValue = oldValue.ToLuaObject(lua);
-            sol::object newLuaValue = newValue.ToLuaObject(lua);
+            auto [newLuaValue, oldLuaValue] = makeValues(lua);
 
             // Invoke callback with (newValue, oldValue, key)
             auto result = entry.callback(newLuaValue, oldLuaValue, key);
@@ -381,65 +434,157 @@ void SharedDataManager::TriggerWatches(const std::string &key,
     }
 }
 
-void SharedDataManager::QueueWatchNotificationLocked(const std::string &key,
-                                                    const StoredValue &oldValue,
-                                                    const StoredValue &newValue) {
-    auto it = m_Watches.find(key);
-    if (it == m_Watches.end()) {
+void SharedDataManager::QueueWatchNotification(const std::string &key, ValuePtr oldValue, ValuePtr newValue) {
+    if (m_WatchedKeys.load(std::memory_order_relaxed) == 0) {
         return;
     }
 
-    m_PendingNotifications.push_back({key, oldValue, newValue});
+    {
+        std::shared_lock<std::shared_mutex> lock(m_WatchMutex);
+        if (m_Watches.find(key) == m_Watches.end()) {
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_NotificationMutex);
+    m_PendingNotifications.push_back({key, std::move(oldValue), std::move(newValue)});
 }
 
 // ============================================================================
-// TTL Management
+// Typed Slots
 // ============================================================================
 
-void SharedDataManager::Tick() {
-    // Step 1: Collect pending notifications accumulated during Set/Remove/etc.
-    std::vector<WatchNotification> notifications;
+std::shared_ptr<SharedSlot> SharedDataManager::GetSlot(const std::string &name) {
     {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        notifications = std::move(m_PendingNotifications);
-        m_PendingNotifications.clear();
+        std::shared_lock<std::shared_mutex> lock(m_SlotMutex);
+        auto it = m_Slots.find(name);
+        if (it != m_Slots.end()) {
+            return it->second;
+        }
     }
 
-    // Step 2: Process TTL expiration and gather additional notifications
-    std::vector<std::string> expiredKeys;
-    std::vector<WatchNotification> ttlNotifications;
-    {
-        std::lock_guard<std::mutex> lock(m_Mutex);
+    std::unique_lock<std::shared_mutex> lock(m_SlotMutex);
+    auto &slot = m_Slots[name];
+    if (!slot) {
+        slot = std::make_shared<SharedSlot>(name);
+    }
+    return slot;
+}
 
-        int64_t currentTime = GetCurrentTimeMs();
+void SharedDataManager::WatchSlot(const std::string &contextName, std::weak_ptr<ScriptContext> contextPtr,
+                                  const std::string &name, sol::function callback) {
+    if (contextName.empty() || name.empty() || !callback.valid()) {
+        Log::Warn("[%s] SharedDataManager: Invalid slot watch parameters (slot: %s).",
+                  contextName.empty() ? "unknown" : contextName.c_str(),
+                  name.empty() ? "empty" : name.c_str());
+        return;
+    }
 
-        for (auto it = m_Data.begin(); it != m_Data.end();) {
-            if (it->second.IsExpired(currentTime)) {
-                expiredKeys.push_back(it->first);
+    std::unique_lock<std::shared_mutex> lock(m_WatchMutex);
+    SlotWatch &watch = m_SlotWatches[name];
+    if (!watch.slot) {
+        // Changes are reported from the value current at registration
+        watch.slot = GetSlot(name);
+        watch.version = watch.slot->Load(watch.value);
+    }
+    watch.entries[contextName] = WatchEntry(contextPtr, callback, ++m_WatchGeneration);
+}
 
-                auto watchIt = m_Watches.find(it->first);
-                if (watchIt != m_Watches.end()) {
-                    ttlNotifications.push_back({it->first, it->second, StoredValue()});
-                }
+void SharedDataManager::UnwatchSlot(const std::string &contextName, const std::string &name) {
+    std::unique_lock<std::shared_mutex> lock(m_WatchMutex);
+    auto it = m_SlotWatches.find(name);
+    if (it != m_SlotWatches.end()) {
+        it->second.entries.erase(contextName);
+        if (it->second.entries.empty()) {
+            m_SlotWatches.erase(it);
+        }
+    }
+}
 
-                it = m_Data.erase(it);
-            } else {
-                ++it;
+void SharedDataManager::TickSlotWatches() {
+    struct SlotChange {
+        std::string name;
+        SharedSlot::Value oldValue;
+        SharedSlot::Value newValue;
+        std::unordered_map<std::string, WatchEntry> entries;
+    };
+
+    // One version check per watched slot; unchanged slots cost nothing else
+    std::vector<SlotChange> changes;
+    {
+        std::unique_lock<std::shared_mutex> lock(m_WatchMutex);
+        for (auto &[name, watch] : m_SlotWatches) {
+            SharedSlot::Value value;
+            if (!watch.slot->LoadIfChanged(watch.version, value)) {
+                continue;
             }
+            changes.push_back({name, std::move(watch.value), value, watch.entries});
+            watch.value = std::move(value);
+        }
+    }
+
+    for (const auto &change : changes) {
+        InvokeWatchEntries(change.name, change.entries, [&](sol::state_view lua) {
+            return std::make_pair(SharedSlot::ToLuaObject(lua, change.newValue),
+                                  SharedSlot::ToLuaObject(lua, change.oldValue));
+        });
+    }
+}
+
+// ============================================================================
+// TTL Management
+// ============================================================================
+
+void SharedDataManager::Tick() {
+    // Step 1: Pop the TTL deadlines that have passed (usually none)
+    int64_t currentTime = GetCurrentTimeMs();
+    std::vector<ExpiryEntry> due;
+    {
+        std::lock_guard<std::mutex> lock(m_ExpiryMutex);
+        while (!m_Expiry.empty() && m_Expiry.front().expiryTime <= currentTime) {
+            std::pop_heap(m_Expiry.begin(), m_Expiry.end(), std::greater<>());
+            due.push_back(std::move(m_Expiry.back()));
+            m_Expiry.pop_back();
         }
     }
 
-    notifications.insert(notifications.end(), ttlNotifications.begin(), ttlNotifications.end());
+    // Step 2: Remove the keys that still carry that deadline
+    std::vector<std::string> expiredKeys;
+    for (auto &entry : due) {
+        Shard &shard = GetShard(entry.key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.data.find(entry.key);
+        if (it == shard.data.end() || it->second->expiryTime != entry.expiryTime) {
+            continue; // Removed or set again since the deadline was recorded
+        }
+
+        QueueWatchNotification(entry.key, std::move(it->second), nullptr);
+        shard.data.erase(it);
+        expiredKeys.push_back(std::move(entry.key));
+    }
+
+    // Step 3: Collect notifications accumulated during Set/Remove/expiry
+    std::vector<WatchNotification> notifications;
+    {
+        std::lock_guard<std::mutex> lock(m_NotificationMutex);
+        notifications.swap(m_PendingNotifications);
+    }
 
-    // Step 3: Invoke watch callbacks outside mutex to avoid deadlocks
+    // Step 4: Invoke watch callbacks outside the locks to avoid deadlocks
+    static const StoredValue nilValue;
     for (const auto &notif : notifications) {
-        TriggerWatches(notif.key, notif.oldValue, notif.newValue);
+        TriggerWatches(notif.key,
+                       notif.oldValue ? *notif.oldValue : nilValue,
+                       notif.newValue ? *notif.newValue : nilValue);
     }
 
-    // Step 4: Log expired keys after processing
+    // Step 5: Log expired keys after processing
     for (const auto &key : expiredKeys) {
         Log::Info("SharedDataManager: Key '%s' expired, removing.", key.c_str());
     }
+
+    // Step 6: Fire slot watches
+    TickSlotWatches();
 }
 
 int64_t SharedDataManager::GetCurrentTimeMs() {
@@ -4,7 +4,13 @@
 #include <string>
 #include <unordered_map>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <memory>
 #include <any>
+#include <functional>
+
+#include "SharedSlot.h"
 
 // Forward declarations
 class TASEngine;
@@ -18,6 +24,15 @@ class ScriptContext;
  * from all script contexts. It supports Lua values and provides serialization
  * for cross-context data sharing.
  *
+ * Values that change every tick can use typed slots instead (see SharedSlot):
+ * they are read in place without serialization, and slot watches fire once
+ * per tick at most, only when the slot's version moved.
+ *
+ * Keys are spread over lock-striped shards. Values are immutable once stored,
+ * so readers only hold a shard's shared lock long enough to copy a pointer and
+ * never block each other. Keys with a TTL are also kept in a deadline-ordered
+ * heap, so Tick() only looks at the keys that are due.
+ *
  * Lua API:
  *   tas.shared.set(key, value)
  *   tas.shared.get(key, default)
@@ -25,6 +40,7 @@ class ScriptContext;
  *   tas.shared.remove(key)
  *   tas.shared.clear()
  *   tas.shared.keys()
+ *   tas.shared.slot(name)
  */
 class SharedDataManager {
 public:
@@ -125,6 +141,30 @@ public:
      */
     void UnwatchAll(const std::string &contextName);
 
+    /**
+     * @brief Gets a typed slot, creating an empty one on first use.
+     * @param name The slot name (slots do not share names with keyed values).
+     * @return The slot, valid until Shutdown().
+     */
+    std::shared_ptr<SharedSlot> GetSlot(const std::string &name);
+
+    /**
+     * @brief Watches a typed slot; the callback fires during Tick() when its version changed.
+     * @param contextName Name of the context registering the watch.
+     * @param contextPtr Weak pointer to the context (for lifetime tracking).
+     * @param name The slot to watch.
+     * @param callback Lua function to call (receives new_value, old_value, name).
+     */
+    void WatchSlot(const std::string &contextName, std::weak_ptr<ScriptContext> contextPtr,
+                   const std::string &name, sol::function callback);
+
+    /**
+     * @brief Removes a slot watch for a context.
+     * @param contextName Name of the context.
+     * @param name The slot to stop watching.
+     */
+    void UnwatchSlot(const std::string &contextName, const std::string &name);
+
     /**
      * @brief Processes TTL expiration and triggers change notifications.
      * Should be called once per tick.
@@ -178,6 +218,33 @@ private:
         static StoredValue FromLuaObject(sol::object obj);
     };
 
+    using ValuePtr = std::shared_ptr<const StoredValue>;
+
+    /**
+     * @brief One lock stripe of the store.
+     */
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, ValuePtr> data;
+    };
+
+    /**
+     * @brief A pending TTL expiry. Stale entries (the key was removed or set
+     *        again) are recognized by their deadline and skipped.
+     */
+    struct ExpiryEntry {
+        int64_t expiryTime;
+        std::string key;
+
+        bool operator>(const ExpiryEntry &other) const { return expiryTime > other.expiryTime; }
+    };
+
+    static constexpr size_t kShardCount = 16;
+
+    Shard &GetShard(const std::string &key) const {
+        return m_Shards[std::hash<std::string>{}(key) & (kShardCount - 1)];
+    }
+
     /**
      * @brief Serializes a Lua table to a storable format.
      * @param table The Lua table to serialize.
@@ -208,30 +275,71 @@ private:
      */
     void TriggerWatches(const std::string &key, const StoredValue &oldValue, const StoredValue &newValue);
 
-    void QueueWatchNotificationLocked(const std::string &key,
-                                      const StoredValue &oldValue,
-                                      const StoredValue &newValue);
+    /**
+     * @brief Invokes watch callbacks of live contexts with (new, old, key).
+     * @param makeValues Converts the new and old values into the callback's Lua state.
+     */
+    void InvokeWatchEntries(const std::string &key,
+                            const std::unordered_map<std::string, WatchEntry> &entries,
+                            const std::function<std::pair<sol::object, sol::object>(sol::state_view)> &makeValues);
+
+    /**
+     * @brief Fires slot watches whose slot changed since the last tick.
+     */
+    void TickSlotWatches();
+
+    /**
+     * @brief Queues a watch notification if the key is watched.
+     * @note Called while holding the key's shard lock, so notifications keep the
+     *       order of the changes.
+     */
+    void QueueWatchNotification(const std::string &key, ValuePtr oldValue, ValuePtr newValue);
 
     // Core references
     TASEngine *m_Engine;
 
-    // Thread-safe storage
-    mutable std::mutex m_Mutex;
-    std::unordered_map<std::string, StoredValue> m_Data;
+    // Sharded storage
+    mutable Shard m_Shards[kShardCount];
+
+    // TTL deadlines, earliest first
+    std::mutex m_ExpiryMutex;
+    std::vector<ExpiryEntry> m_Expiry; // Min-heap (std::greater<>)
 
     // Watch callbacks: key -> (contextName -> WatchEntry)
+    mutable std::shared_mutex m_WatchMutex;
     std::unordered_map<std::string, std::unordered_map<std::string, WatchEntry>> m_Watches;
-    uint64_t m_WatchGeneration = 0; // Global generation counter for watch versioning
+    uint64_t m_WatchGeneration = 0;     // Global generation counter for watch versioning
+    std::atomic<size_t> m_WatchedKeys{0}; // Lets Set() skip the watch lookup when nothing is watched
+
+    // Typed slots, never removed before Shutdown() so handles stay valid
+    std::shared_mutex m_SlotMutex;
+    std::unordered_map<std::string, std::shared_ptr<SharedSlot>> m_Slots;
+
+    // Slot watches (guarded by m_WatchMutex)
+    struct SlotWatch {
+        std::shared_ptr<SharedSlot> slot;
+        uint64_t version = 0;    // Last version reported to the watchers
+        SharedSlot::Value value; // Value at that version
+        std::unordered_map<std::string, WatchEntry> entries;
+    };
+
+    std::unordered_map<std::string, SlotWatch> m_SlotWatches;
 
     // Pending watch notifications (queued for delivery on Tick())
     struct WatchNotification {
         std::string key;
-        StoredValue oldValue;
-        StoredValue newValue;
+        ValuePtr oldValue; // nullptr = nil
+        ValuePtr newValue; // nullptr = nil
     };
 
+    std::mutex m_NotificationMutex;
     std::vector<WatchNotification> m_PendingNotifications;
 
+    // LOCK ORDERING:
+    //   shard mutex -> m_WatchMutex -> m_NotificationMutex
+    //   m_ExpiryMutex is never held together with another lock
+    //   m_WatchMutex -> m_SlotMutex
+
     // Initialization state
     bool m_IsInitialized = false;
 };
@@ -0,0 +1,167 @@
+#include "SharedSlot.h"
+
+#include <stdexcept>
+#include <thread>
+
+#include <VxMath.h>
+
+bool SharedSlot::Value::operator==(const Value &other) const {
+    if (type != other.type) return false;
+
+    switch (type) {
+        case Type::Empty:
+            return true;
+        case Type::Number:
+            return number == other.number;
+        case Type::Vector:
+        case Type::FloatArray:
+            if (count != other.count) return false;
+            for (size_t i = 0; i < count; ++i) {
+                if (floats[i] != other.floats[i]) return false;
+            }
+            return true;
+        case Type::Buffer:
+            return buffer == other.buffer;
+    }
+    return false;
+}
+
+uint64_t SharedSlot::Store(const Value &value) {
+    // Writers exclude each other by making the version odd
+    uint64_t version = m_Version.load(std::memory_order_relaxed);
+    while ((version & 1) != 0 ||
+           !m_Version.compare_exchange_weak(version, version + 1, std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+        if ((version & 1) != 0) {
+            std::this_thread::yield();
+            version = m_Version.load(std::memory_order_relaxed);
+        }
+    }
+    // Field stores must not become visible before the odd version
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const size_t count = value.count < kMaxFloats ? value.count : kMaxFloats;
+    m_Type.store(value.type, std::memory_order_relaxed);
+    m_Count.store(static_cast<uint8_t>(count), std::memory_order_relaxed);
+    m_Number.store(value.number, std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        m_Floats[i].store(value.floats[i], std::memory_order_relaxed);
+    }
+    m_Buffer.store(value.type == Type::Buffer ? value.buffer : nullptr, std::memory_order_relaxed);
+
+    m_Version.store(version + 2, std::memory_order_release);
+    return version + 2;
+}
+
+uint64_t SharedSlot::Load(Value &out) const {
+    while (true) {
+        const uint64_t before = m_Version.load(std::memory_order_acquire);
+        if ((before & 1) != 0) {
+            std::this_thread::yield(); // Write in progress
+            continue;
+        }
+
+        out.type = m_Type.load(std::memory_order_relaxed);
+        out.count = m_Count.load(std::memory_order_relaxed);
+        out.number = m_Number.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < out.count && i < kMaxFloats; ++i) {
+            out.floats[i] = m_Floats[i].load(std::memory_order_relaxed);
+        }
+        if (out.type == Type::Buffer) {
+            out.buffer = m_Buffer.load(std::memory_order_relaxed);
+        } else {
+            out.buffer.reset();
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_Version.load(std::memory_order_relaxed) == before) {
+            return before;
+        }
+    }
+}
+
+bool SharedSlot::LoadIfChanged(uint64_t &knownVersion, Value &out) const {
+    if (GetVersion() == knownVersion) {
+        return false;
+    }
+    knownVersion = Load(out);
+    return true;
+}
+
+SharedSlot::Value SharedSlot::FromLuaObject(const sol::object &obj) {
+    Value value;
+
+    switch (obj.get_type()) {
+        case sol::type::nil:
+        case sol::type::none:
+            return value;
+
+        case sol::type::number:
+            value.type = Type::Number;
+            value.number = obj.as<double>();
+            return value;
+
+        case sol::type::userdata:
+            if (obj.is<VxVector>()) {
+                const VxVector &v = obj.as<const VxVector &>();
+                value.type = Type::Vector;
+                value.count = 3;
+                value.floats[0] = v.x;
+                value.floats[1] = v.y;
+                value.floats[2] = v.z;
+                return value;
+            }
+            if (obj.is<std::shared_ptr<SharedBuffer>>()) {
+                value.type = Type::Buffer;
+                value.buffer = obj.as<std::shared_ptr<SharedBuffer>>();
+                return value;
+            }
+            throw std::runtime_error("Shared slots only hold VxVector or SharedBuffer userdata");
+
+        case sol::type::table: {
+            sol::table table = obj.as<sol::table>();
+            const size_t count = table.size();
+            if (count > kMaxFloats) {
+                throw std::runtime_error("Shared slot arrays hold at most " + std::to_string(kMaxFloats) + " numbers");
+            }
+            value.type = Type::FloatArray;
+            value.count = static_cast<uint8_t>(count);
+            for (size_t i = 0; i < count; ++i) {
+                sol::object element = table[i + 1];
+                if (element.get_type() != sol::type::number) {
+                    throw std::runtime_error("Shared slot arrays may only contain numbers");
+                }
+                value.floats[i] = element.as<float>();
+            }
+            return value;
+        }
+
+        default:
+            throw std::runtime_error("Shared slots hold numbers, VxVector, number arrays or SharedBuffer");
+    }
+}
+
+sol::object SharedSlot::ToLuaObject(sol::state_view lua, const Value &value) {
+    switch (value.type) {
+        case Type::Number:
+            return sol::make_object(lua, value.number);
+
+        case Type::Vector:
+            return sol::make_object(lua, VxVector(value.floats[0], value.floats[1], value.floats[2]));
+
+        case Type::FloatArray: {
+            sol::table result = lua.create_table(value.count, 0);
+            for (size_t i = 0; i < value.count; ++i) {
+                result[i + 1] = value.floats[i];
+            }
+            return result;
+        }
+
+        case Type::Buffer:
+            return sol::make_object(lua, value.buffer);
+
+        case Type::Empty:
+        default:
+            return sol::make_object(lua, sol::nil);
+    }
+}
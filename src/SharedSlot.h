@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <sol/sol.hpp>
+
+#include "SharedBuffer.h"
+
+/**
+ * @class SharedSlot
+ * @brief Fixed-layout shared value: a number, a vector, a small float array or a
+ *        SharedBuffer reference.
+ *
+ * Slots are the allocation-free alternative to keyed shared data for values that
+ * change every tick (ball position, speed, HUD state). The value is stored in
+ * place and published through a sequence lock:
+ * - The version is odd while a write is in progress and grows by two per write
+ * - Readers copy the fields and retry only if they raced with a writer
+ * - A reader that remembers the version it last saw can skip unchanged values
+ *
+ * Thread Safety:
+ * - Any number of concurrent readers and writers; writers exclude each other
+ * - Reads never take a lock
+ */
+class SharedSlot {
+public:
+    enum class Type : uint8_t {
+        Empty,
+        Number,
+        Vector,     // 3 floats
+        FloatArray, // Up to kMaxFloats floats
+        Buffer      // SharedBuffer reference (zero-copy)
+    };
+
+    static constexpr size_t kMaxFloats = 16;
+
+    /**
+     * @brief Plain copy of a slot's value.
+     */
+    struct Value {
+        Type type = Type::Empty;
+        uint8_t count = 0; // Floats used in `floats`
+        double number = 0.0;
+        std::array<float, kMaxFloats> floats{};
+        std::shared_ptr<SharedBuffer> buffer;
+
+        bool operator==(const Value &other) const;
+        bool operator!=(const Value &other) const { return !(*this == other); }
+    };
+
+    explicit SharedSlot(std::string name) : m_Name(std::move(name)) {}
+
+    // SharedSlot is not copyable or movable
+    SharedSlot(const SharedSlot &) = delete;
+    SharedSlot &operator=(const SharedSlot &) = delete;
+
+    const std::string &GetName() const { return m_Name; }
+
+    /**
+     * @brief Gets the version of the last completed write (0 = never written).
+     */
+    uint64_t GetVersion() const { return m_Version.load(std::memory_order_acquire) & ~uint64_t(1); }
+
+    /**
+     * @brief Publishes a new value.
+     * @param value The value to store.
+     * @return The new version.
+     */
+    uint64_t Store(const Value &value);
+
+    /**
+     * @brief Reads the current value.
+     * @param out Receives the value.
+     * @return The version that was read.
+     */
+    uint64_t Load(Value &out) const;
+
+    /**
+     * @brief Reads the value only if it changed.
+     * @param knownVersion Version the caller last saw; updated when a newer value is read.
+     * @param out Receives the value if it changed.
+     * @return True if a newer value was read.
+     */
+    bool LoadIfChanged(uint64_t &knownVersion, Value &out) const;
+
+    /**
+     * @brief Converts a Lua value into a slot value.
+     * @param obj A number, VxVector, array of up to kMaxFloats numbers or SharedBuffer.
+     * @return The slot value.
+     * @throws std::runtime_error for any other value.
+     */
+    static Value FromLuaObject(const sol::object &obj);
+
+    /**
+     * @brief Converts a slot value into a new Lua value (nil if empty).
+     */
+    static sol::object ToLuaObject(sol::state_view lua, const Value &value);
+
+private:
+    std::string m_Name;
+
+    std::atomic<uint64_t> m_Version{0};
+    std::atomic<Type> m_Type{Type::Empty};
+    std::atomic<uint8_t> m_Count{0};
+    std::atomic<double> m_Number{0.0};
+    std::array<std::atomic<float>, kMaxFloats> m_Floats{};
+    std::atomic<std::shared_ptr<SharedBuffer>> m_Buffer;
+};
@@ -4,9 +4,17 @@
  */
 
 #include "TASControllers.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+
 #include "ServiceContainer.h"
+#include "TASEngine.h"
 #include "Recorder.h"
 #include "RecordPlayer.h"
+#include "RecordTranslator.h"
 #include "ScriptGenerator.h"
 #include "InputSystem.h"
 #include "DX8InputManager.h"
@@ -456,44 +464,48 @@ void PlaybackController::ApplyMergedContextInputs(DX8InputManager *inputManager)
         return;
     }
 
-    // Get all active contexts sorted by priority (highest first)
-    auto contexts = scriptManager->GetContextsByPriority();
-
-    // If no contexts are executing, nothing to apply
-    if (contexts.empty()) {
-        return;
-    }
-
-    // Collect inputs from all executing contexts
-    std::vector<const InputSystem *> activeInputs;
-    std::vector<std::string> contextNames; // For conflict logging
+    // Collect inputs from all executing contexts (highest priority first)
+    m_ActiveInputs.clear();
+    scriptManager->ForEachContextByPriority([this](ScriptContext &context) {
+        if (!context.IsExecuting()) {
+            return;
+        }
 
-    for (const auto &context : contexts) {
-        if (context && context->IsExecuting()) {
-            const InputSystem *inputSys = context->GetInputSystem();
-            if (inputSys) {
-                if (inputSys->IsEnabled()) {
-                    activeInputs.push_back(inputSys);
-                    contextNames.push_back(context->GetName());
-                }
-            } else {
-                // Warn if an executing context has no InputSystem (initialization issue)
-                Log::Warn("Context '%s' is executing but has no InputSystem.",
-                          context->GetName().c_str());
+        InputSystem *inputSys = context.GetInputSystem();
+        if (inputSys) {
+            if (inputSys->IsEnabled()) {
+                m_ActiveInputs.push_back(inputSys);
             }
+        } else {
+            // Warn if an executing context has no InputSystem (initialization issue)
+            Log::Warn("Context '%s' is executing but has no InputSystem.",
+                      context.GetName().c_str());
         }
-    }
+    });
 
     // If no active inputs, nothing to apply
-    if (activeInputs.empty()) {
+    if (m_ActiveInputs.empty()) {
         return;
     }
 
-    // === Priority-Based Merging Strategy ===
-    // Process from lowest to highest priority (so highest priority wins)
-    for (size_t i = activeInputs.size(); i > 0; --i) {
-        InputSystem *inputSys = const_cast<InputSystem *>(activeInputs[i - 1]);
-        inputSys->Apply(m_CurrentTick, inputManager);
+    // === Merging Strategy ===
+    // Keyboard: the union of all contexts' key masks is written once, so a key
+    // pressed by any context stays down regardless of what the others hold.
+    // Mouse and joysticks: applied from lowest to highest priority (highest wins).
+    KeyMask pressed;
+    KeyMask released;
+    for (size_t i = m_ActiveInputs.size(); i > 0; --i) {
+        InputSystem *inputSys = m_ActiveInputs[i - 1];
+        inputSys->AdvanceHeldInputs(m_CurrentTick);
+        pressed |= inputSys->GetPressedKeyMask();
+        released |= inputSys->GetReleasedKeyMask();
+        inputSys->ApplyMouseAndJoysticks(inputManager);
+    }
+
+    InputSystem::WriteKeyboard(inputManager, pressed, released);
+
+    for (InputSystem *inputSys : m_ActiveInputs) {
+        inputSys->PrepareNextFrame();
     }
 }
 
@@ -529,6 +541,15 @@ TranslationController::TranslationController(ServiceProvider *provider)
     }
 }
 
+TranslationController::~TranslationController() {
+    // The remaining records of a running batch are abandoned
+    m_CancelOffline.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(m_OfflineMutex);
+    if (m_OfflineThread.joinable()) {
+        m_OfflineThread.join();
+    }
+}
+
 Result<void> TranslationController::Initialize() {
     if (m_IsInitialized) {
         return Result<void>::Ok();
@@ -633,6 +654,177 @@ void TranslationController::StopTranslation(bool clearProject) {
     Log::Info("TranslationController: Stopped translation");
 }
 
+GenerationOptions TranslationController::MakeGenerationOptions(const TASProject &project) {
+    GenerationOptions options;
+    options.projectName = project.GetName() + "_Script";
+    options.authorName = project.GetAuthor();
+    options.targetLevel = project.GetTargetLevel();
+    options.description = "Translated from legacy record: " + project.GetName();
+    options.updateRate = project.GetUpdateRate();
+    options.addFrameComments = true;
+    return options;
+}
+
+Result<void> TranslationController::TranslateOffline(TASProject *project, const GenerationOptions &options) {
+    if (!m_IsInitialized) {
+        return Result<void>::Error("TranslationController not initialized", "state");
+    }
+
+    if (!project) {
+        return Result<void>::Error("Project cannot be null", "invalid_argument");
+    }
+
+    if (!project->CanBeTranslated()) {
+        return Result<void>::Error(project->GetTranslationCompatibilityMessage(), "invalid_argument");
+    }
+
+    // The job keeps its own copy; the project may be dropped by a refresh meanwhile
+    std::vector<OfflineJob> jobs;
+    jobs.push_back({project->GetPath(), options});
+    return StartOfflineJobs(std::move(jobs));
+}
+
+Result<size_t> TranslationController::TranslateDirectory(const std::string &directory) {
+    if (!m_IsInitialized) {
+        return Result<size_t>::Error("TranslationController not initialized", "state");
+    }
+
+    namespace fs = std::filesystem;
+
+    std::vector<OfflineJob> jobs;
+    std::error_code ec;
+    for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code typeEc;
+        if (!it->is_regular_file(typeEc)) {
+            continue;
+        }
+
+        std::string extension = it->path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (extension == ".tas") {
+            jobs.push_back({it->path().string(), std::nullopt});
+        }
+    }
+
+    if (ec) {
+        return Result<size_t>::Error("Cannot read directory '" + directory + "': " + ec.message(), "io");
+    }
+    if (jobs.empty()) {
+        return Result<size_t>::Error("No .tas records found in '" + directory + "'", "not_found");
+    }
+
+    std::sort(jobs.begin(), jobs.end(), [](const OfflineJob &a, const OfflineJob &b) {
+        return a.recordPath < b.recordPath;
+    });
+
+    const size_t count = jobs.size();
+    auto result = StartOfflineJobs(std::move(jobs));
+    if (!result.IsOk()) {
+        return Result<size_t>::Error(result.GetError());
+    }
+    return Result<size_t>::Ok(count);
+}
+
+Result<void> TranslationController::StartOfflineJobs(std::vector<OfflineJob> jobs) {
+    std::lock_guard<std::mutex> lock(m_OfflineMutex);
+    if (m_OfflineRunning.load(std::memory_order_acquire)) {
+        return Result<void>::Error("An offline translation is already running", "state");
+    }
+
+    // Reap the previous, finished job
+    if (m_OfflineThread.joinable()) {
+        m_OfflineThread.join();
+    }
+
+    Log::Info("TranslationController: Started offline translation of %zu record(s)", jobs.size());
+
+    m_CancelOffline.store(false, std::memory_order_release);
+    m_OfflineRunning.store(true, std::memory_order_release);
+    auto engine = m_ServiceProvider->Resolve<TASEngine>();
+    m_OfflineThread = std::thread([this, engine, jobs = std::move(jobs)]() {
+        RunOfflineJobs(engine, jobs);
+    });
+    return Result<void>::Ok();
+}
+
+void TranslationController::RunOfflineJobs(TASEngine *engine, const std::vector<OfflineJob> &jobs) {
+    const auto startTime = std::chrono::steady_clock::now();
+
+    size_t translated = 0;
+    size_t skipped = 0;
+    size_t failed = 0;
+
+    try {
+        // A generator of its own, so a live translation or recording can generate meanwhile
+        ScriptGenerator generator(engine);
+        std::vector<RecordFrameData> records;
+        std::vector<FrameData> frames;
+
+        for (const auto &job : jobs) {
+            if (m_CancelOffline.load(std::memory_order_acquire)) {
+                break;
+            }
+
+            GenerationOptions options;
+            if (job.options) {
+                options = *job.options;
+            } else {
+                TASProject project(job.recordPath);
+                if (!project.CanBeTranslated()) {
+                    Log::Warn("Skipping record '%s': %s", job.recordPath.c_str(),
+                              project.GetTranslationCompatibilityMessage().c_str());
+                    ++skipped;
+                    continue;
+                }
+                options = MakeGenerationOptions(project);
+            }
+
+            // A live translation takes the level from the loaded map; offline there is none
+            if (options.targetLevel.empty()) {
+                options.targetLevel = GenerationOptions{}.targetLevel;
+                Log::Warn("Record '%s' does not name its level; the script targets %s.",
+                          job.recordPath.c_str(), options.targetLevel.c_str());
+            }
+
+            if (!RecordTranslator::LoadFrames(job.recordPath, records) || records.empty()) {
+                Log::Error("Cannot translate record '%s': no frames could be read.", job.recordPath.c_str());
+                ++failed;
+                continue;
+            }
+
+            RecordTranslator::ConvertFrames(records, 1000.0f / options.updateRate, frames);
+            if (generator.Generate(frames, options, &m_CancelOffline)) {
+                ++translated;
+            } else {
+                ++failed;
+            }
+        }
+    } catch (const std::exception &e) {
+        Log::Error("Offline translation error: %s", e.what());
+        ++failed;
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    const bool cancelled = m_CancelOffline.load(std::memory_order_acquire);
+    m_OfflineRunning.store(false, std::memory_order_release);
+
+    if (cancelled || !engine) {
+        return;
+    }
+
+    // Report and pick up the new projects on the main thread
+    engine->AddTimer(1ul, [this, translated, skipped, failed, elapsed]() {
+        Log::Info("Offline translation finished in %.2fs: %zu translated, %zu skipped, %zu failed",
+                  elapsed.count(), translated, skipped, failed);
+
+        auto projectManager = m_ServiceProvider->Resolve<ProjectManager>();
+        if (projectManager && translated > 0) {
+            projectManager->RefreshProjectsAsync();
+        }
+    });
+}
+
 bool TranslationController::IsTranslating() const {
     return m_IsTranslating;
 }
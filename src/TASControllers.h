@@ -24,7 +24,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
 
 #include "Result.h"
 #include "TASProject.h"
@@ -249,6 +254,9 @@ private:
     bool m_IsInitialized = false;
     size_t m_CurrentTick = 0;
 
+    // Enabled input systems of executing contexts, reused every tick (highest priority first)
+    std::vector<InputSystem *> m_ActiveInputs;
+
     // Helper methods
     void SetupInputSystemForPlayback(PlaybackType type);
     void CleanupAfterPlayback();
@@ -267,13 +275,14 @@ private:
  *
  * Responsibilities:
  * - Coordinate record playback for translation
+ * - Translate records offline, without playing them back
  * - Generate Lua scripts from recorded input
  * - Manage translation state
  */
 class TranslationController {
 public:
     explicit TranslationController(ServiceProvider *provider);
-    ~TranslationController() = default;
+    ~TranslationController();
 
     // TranslationController is not copyable or movable
     TranslationController(const TranslationController &) = delete;
@@ -298,6 +307,38 @@ public:
      */
     void StopTranslation(bool clearProject = true);
 
+    /**
+     * @brief Builds the generation options used to translate a record project
+     * @param project The record project
+     */
+    static GenerationOptions MakeGenerationOptions(const TASProject &project);
+
+    /**
+     * @brief Translates a record project to a script without playing it back
+     *
+     * The record's key bits are converted straight into the generator's input
+     * stream on a background thread, so the game does not need to run. The
+     * script carries no physics annotations or game event anchors; use
+     * StartTranslation() when those are wanted.
+     *
+     * @param project The record project to translate
+     * @param options Script generation options
+     * @return Result indicating whether the job was started
+     */
+    Result<void> TranslateOffline(TASProject *project, const GenerationOptions &options);
+
+    /**
+     * @brief Translates every translatable .tas record in a directory without playing them back
+     * @param directory The directory to scan (not recursive)
+     * @return Result holding the number of records queued
+     */
+    Result<size_t> TranslateDirectory(const std::string &directory);
+
+    /**
+     * @brief Checks if an offline translation job is running
+     */
+    bool IsTranslatingOffline() const { return m_OfflineRunning.load(std::memory_order_acquire); }
+
     /**
      * @brief Checks if currently translating
      */
@@ -341,6 +382,19 @@ private:
     bool m_IsInitialized = false;
     size_t m_CurrentTick = 0;
 
+    // Offline translation
+    struct OfflineJob {
+        std::string recordPath;
+        std::optional<GenerationOptions> options; // Derived from the record if not set
+    };
+
+    std::mutex m_OfflineMutex; // Guards starting and joining the offline thread
+    std::thread m_OfflineThread;
+    std::atomic<bool> m_OfflineRunning{false};
+    std::atomic<bool> m_CancelOffline{false};
+
     // Helper methods
     void OnTranslationPlaybackComplete();
+    Result<void> StartOfflineJobs(std::vector<OfflineJob> jobs);
+    void RunOfflineJobs(TASEngine *engine, const std::vector<OfflineJob> &jobs);
 };
@@ -6,6 +6,7 @@
 #include "InputSystem.h"
 #include "DX8InputManager.h"
 #include "EventManager.h"
+#include "GameEvents.h"
 #include "TASHook.h"
 #include "TASProject.h"
 #include "Recorder.h"
@@ -365,9 +366,7 @@ void TASEngine::StopRecording() {
                     std::string path = m_Path;
                     path.append("\\").append(m_Recorder->GetGenerationOptions().projectName)
                         .append("\\recording_").append(std::to_string(std::time(nullptr))).append(".txt");
-                    if (!m_Recorder->DumpFrameData(path, true)) {
-                        Log::Error("Failed to dump frame data to: %s", path.c_str());
-                    }
+                    m_Recorder->DumpFrameDataAsync(path, true);
                 }
             }
         }
@@ -538,6 +537,30 @@ bool TASEngine::StartTranslation() {
     return true;
 }
 
+bool TASEngine::TranslateOffline(TASProject *project) {
+    if (m_ShuttingDown) {
+        return false;
+    }
+
+    if (!m_TranslationController) {
+        Log::Error("TranslationController not initialized.");
+        return false;
+    }
+
+    if (!project || !project->IsRecordProject() || !project->IsValid()) {
+        Log::Error("Translation requires a valid record project (.tas file).");
+        return false;
+    }
+
+    auto result = m_TranslationController->TranslateOffline(
+        project, TranslationController::MakeGenerationOptions(*project));
+    if (!result.IsOk()) {
+        Log::Error("Failed to start offline translation: %s", result.GetError().message.c_str());
+        return false;
+    }
+    return true;
+}
+
 void TASEngine::StopTranslation(bool clearProject) {
     if (m_ShuttingDown) {
         StopTranslationImmediate();
@@ -619,6 +642,10 @@ bool TASEngine::StartValidationRecording(const std::string &outputPath) {
     m_Recorder->ClearFrameData();
     m_Recorder->Start();
 
+    // Stream the binary capture while playing so stopping does not have to write it
+    m_ValidationTimestamp = std::to_string(std::time(nullptr));
+    m_Recorder->StartStreaming(outputPath + "validation_" + m_ValidationTimestamp + ".bin");
+
     Log::Info("Validation recording enabled - output path: %s", outputPath.c_str());
     return true;
 }
@@ -635,24 +662,24 @@ bool TASEngine::StopValidationRecording() {
         return false;
     }
 
-    // Stop recording and get frame data
+    // Stop recording and get frame data; this closes the streamed binary capture
     auto frameData = m_Recorder->Stop();
-
-    // Generate validation dumps with timestamped filename
-    std::string timestampedPath = m_ValidationOutputPath + "validation_" +
-        std::to_string(std::time(nullptr)) + ".txt";
-
-    bool success = m_Recorder->DumpFrameData(timestampedPath, true);
-    if (success) {
-        Log::Info("Validation recording completed - %zu frames captured, dumps saved to: %s",
-                  frameData.size(), timestampedPath.c_str());
-    } else {
-        Log::Error("Failed to generate validation dumps to: %s", timestampedPath.c_str());
+    const std::string basePath = m_ValidationOutputPath + "validation_" + m_ValidationTimestamp;
+    const bool captured = m_Recorder->WasStreamWritten();
+    if (!captured) {
+        Log::Error("Validation capture could not be written to: %s.bin", basePath.c_str());
     }
 
+    // The text dump is formatted in the background and logs its own result
+    const std::string textPath = basePath + ".txt";
+    Log::Info("Validation recording stopped - %zu frames captured, saving text dump to: %s",
+              frameData.size(), textPath.c_str());
+    m_Recorder->DumpFrameDataAsync(textPath, true);
+
     m_ValidationRecording = false;
     m_ValidationOutputPath.clear();
-    return success;
+    m_ValidationTimestamp.clear();
+    return captured;
 }
 
 bool TASEngine::RestartCurrentProject() {
@@ -800,13 +827,7 @@ void TASEngine::StartTranslationInternal() {
 
     try {
         // Set up generation options for translation
-        GenerationOptions options;
-        options.projectName = project->GetName() + "_Script";
-        options.authorName = project->GetAuthor();
-        options.targetLevel = project->GetTargetLevel();
-        options.description = "Translated from legacy record: " + project->GetName();
-        options.updateRate = project->GetUpdateRate();
-        options.addFrameComments = true;
+        GenerationOptions options = TranslationController::MakeGenerationOptions(*project);
 
         // Start translation via controller
         // Controller handles: tick reset, callback setup, recorder/player coordination
@@ -872,13 +893,13 @@ void TASEngine::OnTranslationPlaybackComplete() {
 // Context Lifecycle Management
 // ============================================================================
 
-void TASEngine::HandleContextLifecycleEvent(const std::string &eventName) {
+void TASEngine::HandleContextLifecycleEvent(EventManager::EventId eventId) {
     if (!m_ScriptContextManager) {
         return;
     }
 
     // === Game Start Events ===
-    if (eventName == "post_start_menu") {
+    if (eventId == GameEvents::PostStartMenu) {
         // Create global context when game starts
         Log::Info("Creating global context...");
         auto globalContext = m_ScriptContextManager->GetOrCreateGlobalContext();
@@ -890,7 +911,7 @@ void TASEngine::HandleContextLifecycleEvent(const std::string &eventName) {
     }
 
     // === Level Start Events ===
-    else if (eventName == "start_level") {
+    else if (eventId == GameEvents::StartLevel) {
         // Create level context when level starts
         std::string levelName = GetCurrentLevelName();
         if (!levelName.empty()) {
@@ -900,11 +921,11 @@ void TASEngine::HandleContextLifecycleEvent(const std::string &eventName) {
                 Log::Info("Level context created successfully.");
 
                 // Subscribe level context to level-specific events
-                m_ScriptContextManager->SubscribeToEvent(levelContext->GetName(), "start_level");
-                m_ScriptContextManager->SubscribeToEvent(levelContext->GetName(), "level_finish");
-                m_ScriptContextManager->SubscribeToEvent(levelContext->GetName(), "game_over");
-                m_ScriptContextManager->SubscribeToEvent(levelContext->GetName(), "pre_checkpoint_reached");
-                m_ScriptContextManager->SubscribeToEvent(levelContext->GetName(), "post_checkpoint_reached");
+                m_ScriptContextManager->SubscribeToEvent(levelContext.get(), GameEvents::StartLevel);
+                m_ScriptContextManager->SubscribeToEvent(levelContext.get(), GameEvents::LevelFinish);
+                m_ScriptContextManager->SubscribeToEvent(levelContext.get(), GameEvents::GameOver);
+                m_ScriptContextManager->SubscribeToEvent(levelContext.get(), GameEvents::PreCheckpointReached);
+                m_ScriptContextManager->SubscribeToEvent(levelContext.get(), GameEvents::PostCheckpointReached);
             } else {
                 Log::Error("Failed to create level context.");
             }
@@ -912,7 +933,7 @@ void TASEngine::HandleContextLifecycleEvent(const std::string &eventName) {
     }
 
     // === Level End Events ===
-    else if (eventName == "post_exit_level") {
+    else if (eventId == GameEvents::PostExitLevel) {
         // Destroy level contexts when leaving level
         Log::Info("Destroying level contexts...");
         m_ScriptContextManager->DestroyAllLevelContexts();
@@ -920,7 +941,7 @@ void TASEngine::HandleContextLifecycleEvent(const std::string &eventName) {
     }
 
     // === Game Over / Cleanup Events ===
-    else if (eventName == "game_over") {
+    else if (eventId == GameEvents::GameOver) {
         // Keep global context but cleanup level contexts
         Log::Info("Game over: cleaning up level contexts...");
         m_ScriptContextManager->DestroyAllLevelContexts();
@@ -949,17 +970,17 @@ std::string TASEngine::GetCurrentLevelName() const {
 // ============================================================================
 
 template <typename... Args>
-void TASEngine::OnGameEvent(const std::string &eventName, Args... args) {
-    if (m_ShuttingDown) {
+void TASEngine::OnGameEvent(EventManager::EventId eventId, Args... args) {
+    if (m_ShuttingDown || eventId == EventManager::kInvalidEventId) {
         return;
     }
 
     // === Context Lifecycle Management ===
-    HandleContextLifecycleEvent(eventName);
+    HandleContextLifecycleEvent(eventId);
 
     // === Forward to Multi-Context System ===
     if (m_ScriptContextManager) {
-        m_ScriptContextManager->FireGameEventToAll(eventName, args...);
+        m_ScriptContextManager->FireGameEventToAll(eventId, args...);
     }
 
     // === Forward to Recorder ===
@@ -968,17 +989,24 @@ void TASEngine::OnGameEvent(const std::string &eventName, Args... args) {
             // If there are arguments, pass the first one as event data
             auto firstArg = std::get<0>(std::make_tuple(args...));
             if constexpr (std::is_convertible_v<decltype(firstArg), int>) {
-                m_Recorder->OnGameEvent(m_CurrentTick, eventName, static_cast<int>(firstArg));
+                m_Recorder->OnGameEvent(m_CurrentTick, eventId, static_cast<int>(firstArg));
             } else {
-                m_Recorder->OnGameEvent(m_CurrentTick, eventName, 0);
+                m_Recorder->OnGameEvent(m_CurrentTick, eventId, 0);
             }
         } else {
-            m_Recorder->OnGameEvent(m_CurrentTick, eventName, 0);
+            m_Recorder->OnGameEvent(m_CurrentTick, eventId, 0);
         }
     }
 }
 
+template <typename... Args>
+void TASEngine::OnGameEvent(const std::string &eventName, Args... args) {
+    OnGameEvent(EventManager::InternEvent(eventName), args...);
+}
+
 // Explicit template instantiations for events used in BallanceTAS.cpp
+template void TASEngine::OnGameEvent(EventManager::EventId);
+template void TASEngine::OnGameEvent(EventManager::EventId, int);
 template void TASEngine::OnGameEvent(const std::string &);
 template void TASEngine::OnGameEvent(const std::string &, int);
 
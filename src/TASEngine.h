@@ -7,6 +7,7 @@
 #include <sol/sol.hpp>
 
 #include "TASControllers.h" // For PlaybackType definition
+#include "EventManager.h"
 
 // Forward declare TASStateMachine to avoid circular dependency
 class TASStateMachine;
@@ -24,7 +25,6 @@ class ProjectManager;
 class InputSystem;
 class DX8InputManager;
 class GameInterface;
-class EventManager;
 
 // Script and record execution subsystems
 class ScriptContextManager; // Multi-context script system
@@ -137,6 +137,15 @@ public:
 
     /**
      * @brief Handles game events forwarded from BallanceTASMod.
+     * @param eventId The interned event ID (see GameEvents).
+     * @param args Optional arguments for the event.
+     */
+    template <typename... Args>
+    void OnGameEvent(EventManager::EventId eventId, Args... args);
+
+    /**
+     * @brief Handles a game event by name.
+     * Interns the name and forwards to the ID overload; kept for callers without a pre-interned ID.
      * @param eventName The name of the event (e.g., "level_start").
      * @param args Optional arguments for the event.
      */
@@ -190,6 +199,14 @@ public:
      */
     void StopTranslation(bool clearProject = false);
 
+    /**
+     * @brief Translates a record project to a script in the background, without playing it.
+     * Unlike StartTranslation(), no level is needed and the script has no physics annotations.
+     * @param project The record project to translate.
+     * @return True if the translation was started.
+     */
+    bool TranslateOffline(TASProject *project);
+
     // === Validation Recording Control ===
 
     /**
@@ -201,7 +218,9 @@ public:
 
     /**
      * @brief Stop validation recording and generates validation dumps.
-     * @return True if validation dumps were generated successfully.
+     * The binary capture is finalized here; the text dump is written in the background
+     * and logs its own success or failure.
+     * @return True if the binary capture was written completely.
      */
     bool StopValidationRecording();
 
@@ -338,9 +357,9 @@ private:
 
     /**
      * @brief Handles context lifecycle events (creating/destroying contexts).
-     * @param eventName The name of the game event.
+     * @param eventId The interned ID of the game event.
      */
-    void HandleContextLifecycleEvent(const std::string &eventName);
+    void HandleContextLifecycleEvent(EventManager::EventId eventId);
 
     /**
      * @brief Gets the current level name from GameInterface.
@@ -404,4 +423,5 @@ private:
     bool m_ValidationEnabled = false;
     bool m_ValidationRecording = false;
     std::string m_ValidationOutputPath;
+    std::string m_ValidationTimestamp; // Shared by the streamed and text validation dumps
 };
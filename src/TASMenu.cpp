@@ -77,7 +77,8 @@ void TASMenu::OnClose() {
 }
 
 void TASMenu::RefreshProjects() {
-    m_Engine->GetProjectManager()->RefreshProjects();
+    // Scans in the background; the list updates once ProjectManager::PollRefresh() publishes it
+    m_Engine->GetProjectManager()->RefreshProjectsAsync();
 }
 
 TASProject *TASMenu::GetCurrentProject() const {
@@ -205,6 +206,27 @@ void TASMenu::TranslateProject(TASProject *project) {
     }
 }
 
+void TASMenu::TranslateProjectOffline(TASProject *project) {
+    if (!project || !project->IsRecordProject() || !project->IsValid()) {
+        Log::Error("Cannot translate: invalid record project.");
+        return;
+    }
+
+    if (!project->CanBeTranslated()) {
+        Log::Error("Cannot translate record: %s",
+                                     project->GetTranslationCompatibilityMessage().c_str());
+        return;
+    }
+
+    // Runs in the background; the project list refreshes when the script is written
+    if (m_Engine->TranslateOffline(project)) {
+        Log::Info("Translating record to script offline: %s (%.1f Hz)",
+                                    project->GetName().c_str(), project->GetUpdateRate());
+    } else {
+        Log::Error("Failed to start offline translation from menu.");
+    }
+}
+
 void TASMenu::StopTranslation() {
     if (m_Engine->IsTranslating() || m_Engine->IsPendingTranslate()) {
         m_Engine->StopTranslation();
@@ -533,6 +555,8 @@ void TASDetailsPage::DrawActionButtons() {
     bool isTASActive = m_Menu->IsTASActive();
     bool canPlay = project->IsValid() && !isTASActive;
     bool canTranslate = project->CanBeTranslated() && !isTASActive;
+    auto *translationController = engine->GetTranslationController();
+    bool canTranslateOffline = canTranslate && translationController && !translationController->IsTranslatingOffline();
 
     const auto menuPos = Bui::GetMenuPos();
     const auto menuSize = Bui::GetMenuSize();
@@ -592,11 +616,28 @@ void TASDetailsPage::DrawActionButtons() {
             // Translate button (below play button)
             ImGui::SetCursorPosX(playButtonPos.x);
 
-            if (!canTranslate) {
+            if (!canTranslateOffline) {
                 ImGui::BeginDisabled();
             }
 
             if (Bui::MainButton("Translate to Script")) {
+                m_Menu->TranslateProjectOffline(project);
+            }
+
+            if (!canTranslateOffline) {
+                ImGui::EndDisabled();
+            }
+
+            ImGui::NewLine();
+
+            // Live translation plays the record to capture physics and game events
+            ImGui::SetCursorPosX(playButtonPos.x);
+
+            if (!canTranslate) {
+                ImGui::BeginDisabled();
+            }
+
+            if (Bui::MainButton("Translate with Playback")) {
                 m_Menu->TranslateProject(project);
             }
 
@@ -626,12 +667,12 @@ void TASDetailsPage::DrawActionButtons() {
                 ImGui::PopStyleColor();
             } else {
                 ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.7f, 1.0f, 0.7f, 1.0f));
-                Bui::WrappedText("Ready - Load a level after clicking an option", menuSize.x);
+                Bui::WrappedText("Ready - Load a level after clicking Play or Translate with Playback", menuSize.x);
                 ImGui::PopStyleColor();
 
                 ImGui::SetCursorPosX(menuPos.x * 1.05f);
                 ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.8f, 0.9f, 1.0f, 1.0f));
-                Bui::WrappedText("Translate converts .tas records to script format", menuSize.x, 0.9f);
+                Bui::WrappedText("Translate converts .tas records to script format without playing them", menuSize.x, 0.9f);
                 ImGui::PopStyleColor();
             }
         } else {
@@ -47,6 +47,7 @@ public:
     void StartRecording();
     void StopRecording();
     void TranslateProject(TASProject *project);
+    void TranslateProjectOffline(TASProject *project);
     void StopTranslation();
 
     // State queries
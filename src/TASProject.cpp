@@ -1,5 +1,6 @@
 #include "TASProject.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 
@@ -11,56 +12,109 @@ namespace fs = std::filesystem;
 
 // Constructor for script-based projects
 TASProject::TASProject(std::string projectPath, sol::table manifest)
-    : m_ProjectPath(std::move(projectPath)), m_Manifest(std::move(manifest)), m_ProjectType(ProjectType::Script) {
-    ParseManifest(m_Manifest);
+    : m_ProjectPath(std::move(projectPath)) {
+    m_Info.type = ProjectType::Script;
+    ParseManifest(manifest);
 }
 
 // Constructor for record-based projects (.tas files)
 TASProject::TASProject(std::string tasFilePath)
-    : m_ProjectPath(std::move(tasFilePath)), m_ProjectType(ProjectType::Record) {
+    : m_ProjectPath(std::move(tasFilePath)) {
+    m_Info.type = ProjectType::Record;
     ParseRecordProject(m_ProjectPath);
 }
 
+// Constructor for projects restored from previously parsed info (project index)
+TASProject::TASProject(std::string projectPath, TASProjectInfo info)
+    : m_ProjectPath(std::move(projectPath)), m_Info(std::move(info)) {}
+
+sol::table TASProject::GetManifestTable(sol::state_view lua) const {
+    sol::table manifest = lua.create_table();
+    for (const auto &field : m_Info.manifestFields) {
+        switch (field.type) {
+        case ManifestField::Type::String:
+            manifest[field.key] = field.text;
+            break;
+        case ManifestField::Type::Number:
+            manifest[field.key] = field.number;
+            break;
+        case ManifestField::Type::Boolean:
+            manifest[field.key] = field.number != 0;
+            break;
+        }
+    }
+    return manifest;
+}
+
 void TASProject::ParseManifest(const sol::table &manifest) {
     if (!manifest.valid()) {
-        m_IsValid = false;
+        m_Info.isValid = false;
         return;
     }
 
+    // Keep the scalar fields so scripts can still read the whole manifest
+    for (const auto &[key, value] : manifest) {
+        if (key.get_type() != sol::type::string) {
+            continue;
+        }
+
+        ManifestField field;
+        field.key = key.as<std::string>();
+        switch (value.get_type()) {
+        case sol::type::string:
+            field.type = ManifestField::Type::String;
+            field.text = value.as<std::string>();
+            break;
+        case sol::type::number:
+            field.type = ManifestField::Type::Number;
+            field.number = value.as<double>();
+            break;
+        case sol::type::boolean:
+            field.type = ManifestField::Type::Boolean;
+            field.number = value.as<bool>() ? 1 : 0;
+            break;
+        default:
+            continue;
+        }
+        m_Info.manifestFields.push_back(std::move(field));
+    }
+    std::sort(m_Info.manifestFields.begin(), m_Info.manifestFields.end(),
+              [](const ManifestField &a, const ManifestField &b) { return a.key < b.key; });
+
     // Safely extract fields from the Lua table using sol2's `get_or`
-    m_Name = manifest.get_or<std::string>("name", "Unnamed TAS");
-    m_Author = manifest.get_or<std::string>("author", "Unknown");
-    m_TargetLevel = manifest.get_or<std::string>("level", "");
-    m_EntryScript = manifest.get_or<std::string>("entry_script", "main.lua");
-    m_Description = manifest.get_or<std::string>("description", "No description.");
-    m_UpdateRate = manifest.get_or<float>("update_rate", 132);
+    m_Info.name = manifest.get_or<std::string>("name", "Unnamed TAS");
+    m_Info.author = manifest.get_or<std::string>("author", "Unknown");
+    m_Info.targetLevel = manifest.get_or<std::string>("level", "");
+    m_Info.entryScript = manifest.get_or<std::string>("entry_script", "main.lua");
+    m_Info.description = manifest.get_or<std::string>("description", "No description.");
+    m_Info.updateRate = manifest.get_or<float>("update_rate", 132);
 
     // Parse project scope (default to Level for backward compatibility)
     std::string scopeStr = manifest.get_or<std::string>("scope", "level");
     if (scopeStr == "global") {
-        m_ProjectScope = ProjectScope::Global;
+        m_Info.scope = ProjectScope::Global;
     } else {
-        m_ProjectScope = ProjectScope::Level; // Default
+        m_Info.scope = ProjectScope::Level; // Default
     }
 
     // Parse execution trigger (default to level for backward compatibility)
-    m_ExecutionTrigger = manifest.get_or<std::string>("trigger", "level");
-    if (m_ExecutionTrigger != "startup" && m_ExecutionTrigger != "menu" && m_ExecutionTrigger != "level") {
-        m_ExecutionTrigger = "level"; // Default if invalid
+    m_Info.executionTrigger = manifest.get_or<std::string>("trigger", "level");
+    if (m_Info.executionTrigger != "startup" && m_Info.executionTrigger != "menu" && m_Info.executionTrigger != "level") {
+        m_Info.executionTrigger = "level"; // Default if invalid
     }
 
     // Validation rules:
     // - Level projects must have a target level
     // - Global projects can work without a specific target level
-    if (m_ProjectScope == ProjectScope::Level) {
+    if (m_Info.scope == ProjectScope::Level) {
         // Level projects require a target level to be valid
-        if (!m_TargetLevel.empty() && !m_Name.empty() && !m_Author.empty()) {
-            m_IsValid = true;
+        if (!m_Info.targetLevel.empty() && !m_Info.name.empty() && !m_Info.author.empty()) {
+            m_Info.isValid = true;
         }
     } else {
         // Global projects are valid with just name and author (level is optional)
-        if (!m_Name.empty() && !m_Author.empty()) {
-            m_IsValid = true;
+        if (!m_Info.name.empty() && !m_Info.author.empty()) {
+            m_Info.isValid = true;
         }
     }
 }
@@ -68,25 +122,48 @@ void TASProject::ParseManifest(const sol::table &manifest) {
 void TASProject::ParseRecordProject(const std::string &tasFilePath) {
     // Validate that the .tas file exists
     if (!fs::exists(tasFilePath) || !fs::is_regular_file(tasFilePath)) {
-        m_IsValid = false;
+        m_Info.isValid = false;
         return;
     }
 
     // Extract project name from filename (without extension)
     fs::path filePath(tasFilePath);
-    m_Name = filePath.stem().string();
+    m_Info.name = filePath.stem().string();
 
     // Set default values for record projects
-    m_Author = "Unknown (Record)";
-    m_Description = "TAS record file";
-    m_TargetLevel = "";    // Will be determined during playback if possible
-    m_UpdateRate = 132.0f; // Standard Physics rate
+    m_Info.author = "Unknown (Record)";
+    m_Info.description = "TAS record file";
+    m_Info.targetLevel = "";    // Will be determined during playback if possible
+    m_Info.updateRate = 132.0f; // Standard Physics rate
 
     // Try to parse timing and basic info from the file
     try {
+        // Chunked records carry their timing info in the header, so only
+        // the header and block index need to be read.
+        if (ChunkedRecordReader::IsChunkedRecord(tasFilePath)) {
+            ChunkedRecordReader reader;
+            if (!reader.Open(tasFilePath)) {
+                m_Info.isValid = false;
+                return;
+            }
+
+            const size_t frameCount = reader.GetTotalFrames();
+            if (frameCount > 0 && reader.GetBaseDeltaTime() > 0.0f) {
+                m_Info.updateRate = 1000.0f / reader.GetBaseDeltaTime();
+            }
+            m_Info.hasConstantDeltaTime = frameCount == 0 || reader.HasConstantDeltaTime();
+
+            std::ostringstream desc;
+            desc << "TAS record (" << frameCount << " frames)";
+            m_Info.description = frameCount > 0 ? desc.str() : "Empty TAS record file";
+
+            m_Info.isValid = true;
+            return;
+        }
+
         std::ifstream file(tasFilePath, std::ios::binary);
         if (!file.is_open()) {
-            m_IsValid = false;
+            m_Info.isValid = false;
             return;
         }
 
@@ -94,21 +171,21 @@ void TASProject::ParseRecordProject(const std::string &tasFilePath) {
         uint32_t uncompressedSize;
         file.read(reinterpret_cast<char *>(&uncompressedSize), sizeof(uncompressedSize));
         if (file.gcount() != sizeof(uncompressedSize)) {
-            m_IsValid = false;
+            m_Info.isValid = false;
             return;
         }
 
         if (uncompressedSize == 0) {
             // Empty file - technically valid but no useful data
-            m_Description = "Empty TAS record file";
-            m_IsValid = true;
+            m_Info.description = "Empty TAS record file";
+            m_Info.isValid = true;
             return;
         }
 
         // Validate that uncompressed size makes sense
         const size_t frameDataSize = sizeof(float) + sizeof(int); // deltaTime + keyStates
         if (uncompressedSize % frameDataSize != 0) {
-            m_IsValid = false;
+            m_Info.isValid = false;
             return;
         }
 
@@ -122,14 +199,14 @@ void TASProject::ParseRecordProject(const std::string &tasFilePath) {
 
         size_t compressedSize = static_cast<size_t>(fileSize) - sizeof(uncompressedSize);
         if (compressedSize == 0) {
-            m_IsValid = false;
+            m_Info.isValid = false;
             return;
         }
 
         std::vector<char> compressedData(compressedSize);
         file.read(compressedData.data(), compressedSize);
         if (static_cast<size_t>(file.gcount()) != compressedSize) {
-            m_IsValid = false;
+            m_Info.isValid = false;
             return;
         }
         file.close();
@@ -137,7 +214,7 @@ void TASProject::ParseRecordProject(const std::string &tasFilePath) {
         // Decompress the data
         char *uncompressedData = CKUnPackData(static_cast<int>(uncompressedSize), compressedData.data(), compressedSize);
         if (!uncompressedData) {
-            m_IsValid = false;
+            m_Info.isValid = false;
             return;
         }
 
@@ -156,12 +233,12 @@ void TASProject::ParseRecordProject(const std::string &tasFilePath) {
                 }
             }
 
-            m_UpdateRate = 1000.0f / initialDeltaTime; // Convert from ms to Hz
+            m_Info.updateRate = 1000.0f / initialDeltaTime; // Convert from ms to Hz
 
             // Store delta time consistency information
-            m_HasConstantDeltaTime = hasConstantDeltaTime;
+            m_Info.hasConstantDeltaTime = hasConstantDeltaTime;
         } else {
-            m_HasConstantDeltaTime = true; // Empty record is technically constant
+            m_Info.hasConstantDeltaTime = true; // Empty record is technically constant
         }
 
         // Clean up decompressed data
@@ -170,14 +247,14 @@ void TASProject::ParseRecordProject(const std::string &tasFilePath) {
         // Update description
         std::ostringstream desc;
         desc << "TAS record (" << frameCount << " frames)";
-        m_Description = desc.str();
+        m_Info.description = desc.str();
 
-        m_IsValid = true;
+        m_Info.isValid = true;
     } catch (const std::exception &) {
         // If we can't read the file properly, mark as invalid
-        m_IsValid = false;
-        m_HasConstantDeltaTime = false;
-        m_Description = "Invalid TAS record file";
+        m_Info.isValid = false;
+        m_Info.hasConstantDeltaTime = false;
+        m_Info.description = "Invalid TAS record file";
     }
 }
 
@@ -200,7 +277,7 @@ std::string TASProject::GetEntryScriptPath(const std::string &executionBasePath)
     if (IsRecordProject()) {
         return ""; // Record projects don't have entry scripts
     }
-    return GetProjectFilePath(m_EntryScript, executionBasePath);
+    return GetProjectFilePath(m_Info.entryScript, executionBasePath);
 }
 
 std::string TASProject::GetProjectFilePath(const std::string &fileName, const std::string &executionBasePath) const {
@@ -239,7 +316,7 @@ std::string TASProject::GetTranslationCompatibilityMessage() const {
         return "Invalid record file";
     }
 
-    if (!m_HasConstantDeltaTime) {
+    if (!m_Info.hasConstantDeltaTime) {
         std::ostringstream msg;
         msg << "Variable timing detected. "
             << "Only records with constant delta time can be translated to scripts.";
@@ -254,7 +331,7 @@ std::vector<std::string> TASProject::GetRequirements() const {
 
     // Add translation-specific requirements for record projects
     if (IsRecordProject() && IsValid()) {
-        if (!m_HasConstantDeltaTime) {
+        if (!m_Info.hasConstantDeltaTime) {
             requirements.emplace_back("Variable Timing (Translation Not Recommended)");
         }
     }
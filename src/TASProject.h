@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <vector>
+
 #include <sol/sol.hpp>
 
 /**
@@ -22,6 +25,54 @@ enum class ProjectScope {
     Global  // Global projects - work across menus and multiple levels
 };
 
+/**
+ * @struct ManifestField
+ * @brief A top-level scalar field of a manifest, kept so scripts can read custom keys.
+ */
+struct ManifestField {
+    enum class Type : uint8_t {
+        String,
+        Number,
+        Boolean
+    };
+
+    std::string key;
+    Type type = Type::String;
+    std::string text;   // String value
+    double number = 0;  // Number value, or 0/1 for Boolean
+
+    bool operator==(const ManifestField &other) const = default;
+};
+
+/**
+ * @struct TASProjectInfo
+ * @brief Everything a TASProject learns from its manifest or record header.
+ *
+ * Plain data with no Lua references, so it can be built on a background
+ * thread, stored in the project index and turned back into a project
+ * without parsing anything.
+ */
+struct TASProjectInfo {
+    ProjectType type = ProjectType::Script;
+    ProjectScope scope = ProjectScope::Level;
+
+    std::string name = "Unnamed TAS";
+    std::string author = "Unknown";
+    std::string description = "No description.";
+    std::string entryScript = "main.lua";
+    std::string targetLevel;
+    std::string executionTrigger = "level"; // "startup", "menu", or "level"
+    float updateRate = 132.0f;              // Default to 132 = 66 * 2 (game's physics update rate)
+
+    bool isValid = false;
+    bool isZipProject = false;
+    bool hasConstantDeltaTime = true; // Whether delta time is constant across frames
+
+    std::vector<ManifestField> manifestFields; // Empty for record projects
+
+    bool operator==(const TASProjectInfo &other) const = default;
+};
+
 /**
  * @class TASProject
  * @brief Represents a single TAS project found on the filesystem.
@@ -40,32 +91,46 @@ public:
     // Constructor for record-based projects (.tas files)
     explicit TASProject(std::string tasFilePath);
 
+    // Constructor for projects restored from previously parsed info (project index)
+    TASProject(std::string projectPath, TASProjectInfo info);
+
+    /**
+     * @brief Gets the parsed project info.
+     */
+    const TASProjectInfo &GetInfo() const { return m_Info; }
+
     // --- Type Information ---
-    ProjectType GetProjectType() const { return m_ProjectType; }
-    bool IsScriptProject() const { return m_ProjectType == ProjectType::Script; }
-    bool IsRecordProject() const { return m_ProjectType == ProjectType::Record; }
+    ProjectType GetProjectType() const { return m_Info.type; }
+    bool IsScriptProject() const { return m_Info.type == ProjectType::Script; }
+    bool IsRecordProject() const { return m_Info.type == ProjectType::Record; }
 
     // --- Scope Information ---
-    ProjectScope GetProjectScope() const { return m_ProjectScope; }
-    bool IsLevelProject() const { return m_ProjectScope == ProjectScope::Level; }
-    bool IsGlobalProject() const { return m_ProjectScope == ProjectScope::Global; }
+    ProjectScope GetProjectScope() const { return m_Info.scope; }
+    bool IsLevelProject() const { return m_Info.scope == ProjectScope::Level; }
+    bool IsGlobalProject() const { return m_Info.scope == ProjectScope::Global; }
 
     // --- Accessors for Manifest Data ---
-    sol::table GetManifestTable() const { return m_Manifest; }
+    /**
+     * @brief Builds the manifest as a table in the given Lua state.
+     * Only top-level string, number and boolean fields are kept.
+     * @param lua The Lua state that receives the table.
+     * @return A new table, empty for record projects.
+     */
+    sol::table GetManifestTable(sol::state_view lua) const;
 
-    const std::string &GetName() const { return m_Name; }
-    const std::string &GetAuthor() const { return m_Author; }
-    const std::string &GetDescription() const { return m_Description; }
-    const std::string &GetTargetLevel() const { return m_TargetLevel; }
-    const std::string &GetEntryScript() const { return m_EntryScript; }
-    float GetUpdateRate() const { return m_UpdateRate; }
-    float GetDeltaTime() const { return 1000.0f / m_UpdateRate; }
+    const std::string &GetName() const { return m_Info.name; }
+    const std::string &GetAuthor() const { return m_Info.author; }
+    const std::string &GetDescription() const { return m_Info.description; }
+    const std::string &GetTargetLevel() const { return m_Info.targetLevel; }
+    const std::string &GetEntryScript() const { return m_Info.entryScript; }
+    float GetUpdateRate() const { return m_Info.updateRate; }
+    float GetDeltaTime() const { return 1000.0f / m_Info.updateRate; }
 
     // --- Execution Trigger Information ---
-    const std::string &GetExecutionTrigger() const { return m_ExecutionTrigger; }
-    bool ShouldExecuteOnStartup() const { return m_ExecutionTrigger == "startup"; }
-    bool ShouldExecuteOnMenu() const { return m_ExecutionTrigger == "menu"; }
-    bool ShouldExecuteOnLevel() const { return m_ExecutionTrigger == "level"; }
+    const std::string &GetExecutionTrigger() const { return m_Info.executionTrigger; }
+    bool ShouldExecuteOnStartup() const { return m_Info.executionTrigger == "startup"; }
+    bool ShouldExecuteOnMenu() const { return m_Info.executionTrigger == "menu"; }
+    bool ShouldExecuteOnLevel() const { return m_Info.executionTrigger == "level"; }
 
 
     // --- Path Accessors ---
@@ -95,10 +160,10 @@ public:
      */
     std::string GetProjectFilePath(const std::string &fileName, const std::string &executionBasePath = "") const;
 
-    bool IsValid() const { return m_IsValid; }
+    bool IsValid() const { return m_Info.isValid; }
 
-    bool IsZipProject() const { return m_IsZipProject; }
-    void SetIsZipProject(bool isZip) { m_IsZipProject = isZip; }
+    bool IsZipProject() const { return m_Info.isZipProject; }
+    void SetIsZipProject(bool isZip) { m_Info.isZipProject = isZip; }
 
     /**
      * @brief Sets the execution base path (used for extracted zip projects).
@@ -121,10 +186,10 @@ public:
     bool IsReadyForExecution() const {
         if (IsRecordProject()) {
             // Record projects just need the .tas file to exist
-            return m_IsValid;
+            return m_Info.isValid;
         }
         // Script projects need extraction if they're zip-based
-        return !m_IsZipProject || !m_ExecutionBasePath.empty();
+        return !m_Info.isZipProject || !m_ExecutionBasePath.empty();
     }
 
     // --- Translation Compatibility ---
@@ -135,14 +200,14 @@ public:
      * @return True if the record has constant delta time and can be translated.
      */
     bool CanBeTranslated() const {
-        return IsRecordProject() && IsValid() && m_HasConstantDeltaTime;
+        return IsRecordProject() && IsValid() && m_Info.hasConstantDeltaTime;
     }
 
     /**
      * @brief Gets whether the record has constant delta time across all frames.
      * @return True if delta time is constant (required for accurate translation).
      */
-    bool HasConstantDeltaTime() const { return m_HasConstantDeltaTime; }
+    bool HasConstantDeltaTime() const { return m_Info.hasConstantDeltaTime; }
 
     /**
      * @brief Gets a detailed message about translation compatibility.
@@ -162,23 +227,5 @@ private:
 
     std::string m_ProjectPath;       // Original path (zip file path for zip projects, .tas file for record projects)
     std::string m_ExecutionBasePath; // Path for execution (temp directory for zip projects)
-    sol::table m_Manifest;           // Keep a copy of the raw manifest table (invalid for record projects)
-
-    ProjectType m_ProjectType;
-
-    // Parsed and cached data
-    std::string m_Name = "Unnamed TAS";
-    std::string m_Author = "Unknown";
-    std::string m_Description = "No description.";
-    std::string m_EntryScript = "main.lua";
-    std::string m_TargetLevel;
-    float m_UpdateRate = 132.0f; // Default to 132 = 66 * 2 (game's physics update rate)
-
-    // Project scope and execution
-    ProjectScope m_ProjectScope = ProjectScope::Level;
-    std::string m_ExecutionTrigger = "level"; // "startup", "menu", or "level"
-
-    bool m_IsValid = false;
-    bool m_IsZipProject = false;
-    bool m_HasConstantDeltaTime = true; // Whether delta time is constant across frames
+    TASProjectInfo m_Info;           // Parsed and cached data
 };
@@ -49,7 +49,9 @@ public:
 
     /**
      * Explicitly set the owner thread (e.g., during ownership transfer).
-     * Use with caution - this is primarily for initialization scenarios.
+     * Also used to lend a component to a worker thread for one parallel tick and
+     * hand it back afterwards; the caller must ensure the two threads never use
+     * the component at the same time.
      */
     void SetOwner(std::thread::id newOwner) {
         m_OwnerThread.store(newOwner, std::memory_order_release);
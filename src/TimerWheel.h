@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Hierarchical timing wheel keyed by absolute tick
+ *
+ * Four levels of 64 slots cover 2^24 ticks ahead of the current tick; timers
+ * further out wait in an overflow list that is re-sorted every 2^24 ticks.
+ * A timer sits in the level matching its distance and is moved one level down
+ * each time the slot it lives in comes up, so it is touched at most once per
+ * level before it expires.
+ *
+ * Cost per Advance() is proportional to the number of expiring timers (plus an
+ * occasional cascade), independent of how many timers are pending.
+ *
+ * Thread Safety:
+ * - Not thread-safe; owned by a single scheduler
+ *
+ * Template Parameters:
+ * - T: Timer payload (must be movable)
+ */
+template <typename T>
+class TimerWheel {
+public:
+    TimerWheel() = default;
+
+    /**
+     * @brief Gets the tick the wheel was last advanced to
+     */
+    uint64_t Now() const { return m_Now; }
+
+    /**
+     * @brief Gets the number of pending timers
+     */
+    size_t Size() const { return m_Size; }
+
+    bool IsEmpty() const { return m_Size == 0; }
+
+    /**
+     * @brief Schedules a timer
+     * @param due Absolute tick at which the timer expires (clamped to Now() + 1)
+     * @param value Timer payload
+     */
+    void Schedule(uint64_t due, T value) {
+        Insert(Timer{due > m_Now ? due : m_Now + 1, std::move(value)});
+        ++m_Size;
+    }
+
+    /**
+     * @brief Advances the wheel by one tick
+     * @param expired Receives the payloads of timers expiring at the new tick
+     *                (in slot order, not necessarily scheduling order)
+     */
+    void Advance(std::vector<T> &expired) {
+        ++m_Now;
+
+        // Cascade from the top so timers moved into a lower slot that is also
+        // due now keep moving down
+        if ((m_Now & kOverflowMask) == 0) {
+            Cascade(m_Overflow);
+        }
+        for (int level = kLevels - 1; level >= 1; --level) {
+            const uint64_t lowerMask = (uint64_t(1) << (kSlotBits * level)) - 1;
+            if ((m_Now & lowerMask) == 0) {
+                Cascade(m_Slots[level][SlotIndex(m_Now, level)]);
+            }
+        }
+
+        auto &slot = m_Slots[0][SlotIndex(m_Now, 0)];
+        for (auto &timer : slot) {
+            expired.push_back(std::move(timer.value));
+        }
+        m_Size -= slot.size();
+        slot.clear();
+    }
+
+    /**
+     * @brief Removes all pending timers (the current tick is kept)
+     */
+    void Clear() {
+        for (auto &level : m_Slots) {
+            for (auto &slot : level) {
+                slot.clear();
+            }
+        }
+        m_Overflow.clear();
+        m_Size = 0;
+    }
+
+private:
+    static constexpr int kLevels = 4;
+    static constexpr int kSlotBits = 6;
+    static constexpr size_t kSlotCount = size_t(1) << kSlotBits;
+    static constexpr uint64_t kOverflowMask = (uint64_t(1) << (kSlotBits * kLevels)) - 1;
+
+    struct Timer {
+        uint64_t due;
+        T value;
+    };
+
+    static size_t SlotIndex(uint64_t tick, int level) {
+        return static_cast<size_t>(tick >> (kSlotBits * level)) & (kSlotCount - 1);
+    }
+
+    void Insert(Timer &&timer) {
+        const uint64_t delta = timer.due > m_Now ? timer.due - m_Now : 0;
+        for (int level = 0; level < kLevels; ++level) {
+            if (delta < (uint64_t(1) << (kSlotBits * (level + 1)))) {
+                m_Slots[level][SlotIndex(timer.due, level)].push_back(std::move(timer));
+                return;
+            }
+        }
+        m_Overflow.push_back(std::move(timer));
+    }
+
+    void Cascade(std::vector<Timer> &slot) {
+        std::vector<Timer> timers;
+        timers.swap(slot);
+        for (auto &timer : timers) {
+            Insert(std::move(timer));
+        }
+    }
+
+    uint64_t m_Now = 0;
+    size_t m_Size = 0;
+    std::array<std::array<std::vector<Timer>, kSlotCount>, kLevels> m_Slots;
+    std::vector<Timer> m_Overflow;
+};
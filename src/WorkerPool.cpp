@@ -0,0 +1,118 @@
+#include "WorkerPool.h"
+
+namespace {
+    thread_local WorkerPool::DeferredActions *t_DeferredActions = nullptr;
+}
+
+WorkerPool::WorkerPool(size_t threadCount) {
+    if (threadCount == 0) {
+        const size_t hardware = std::thread::hardware_concurrency();
+        threadCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    m_Threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        m_Threads.emplace_back(&WorkerPool::WorkerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stopping = true;
+    }
+    m_WorkReady.notify_all();
+
+    for (auto &thread : m_Threads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::ParallelFor(size_t count, const std::function<void(size_t)> &job) {
+    if (count == 0) {
+        return;
+    }
+    if (count == 1 || m_Threads.empty()) {
+        for (size_t i = 0; i < count; ++i) {
+            job(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Job = &job;
+        m_Count = count;
+        m_NextIndex.store(0, std::memory_order_relaxed);
+        m_ActiveWorkers = m_Threads.size();
+        ++m_Generation;
+    }
+    m_WorkReady.notify_all();
+
+    // The calling thread works on the batch too
+    RunIndices();
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_WorkDone.wait(lock, [this] { return m_ActiveWorkers == 0; });
+    m_Job = nullptr;
+}
+
+void WorkerPool::WorkerLoop() {
+    uint64_t seenGeneration = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_WorkReady.wait(lock, [&] { return m_Stopping || m_Generation != seenGeneration; });
+            if (m_Stopping) {
+                return;
+            }
+            seenGeneration = m_Generation;
+        }
+
+        RunIndices();
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            last = --m_ActiveWorkers == 0;
+        }
+        if (last) {
+            m_WorkDone.notify_one();
+        }
+    }
+}
+
+void WorkerPool::RunIndices() {
+    const std::function<void(size_t)> &job = *m_Job;
+    const size_t count = m_Count;
+
+    for (size_t i = m_NextIndex.fetch_add(1, std::memory_order_relaxed); i < count;
+         i = m_NextIndex.fetch_add(1, std::memory_order_relaxed)) {
+        job(i);
+    }
+}
+
+WorkerPool::DeferScope::DeferScope(DeferredActions &actions) : m_Previous(t_DeferredActions) {
+    t_DeferredActions = &actions;
+}
+
+WorkerPool::DeferScope::~DeferScope() {
+    t_DeferredActions = m_Previous;
+}
+
+bool WorkerPool::RunOrDefer(std::function<void()> action) {
+    if (t_DeferredActions) {
+        t_DeferredActions->push_back(std::move(action));
+        return true;
+    }
+    action();
+    return false;
+}
+
+void WorkerPool::RunDeferred(DeferredActions &actions) {
+    for (auto &action : actions) {
+        action();
+    }
+    actions.clear();
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkerPool
+ * @brief Fixed set of threads running fork-join batches.
+ *
+ * ParallelFor() hands out the indices of one batch to the workers and to the
+ * calling thread, and returns once every index has run. Batches never overlap:
+ * the pool is meant to be driven by a single thread (the game thread).
+ *
+ * A job that has to touch state shared with other jobs can defer that work:
+ * under a DeferScope, RunOrDefer() queues actions instead of running them, and
+ * the calling thread replays each index's actions in index order afterwards.
+ *
+ * Thread Safety:
+ * - ParallelFor() must not be called concurrently or from inside a job
+ * - Everything written by a job happens-before ParallelFor() returns
+ */
+class WorkerPool {
+public:
+    /**
+     * @brief Starts the worker threads.
+     * @param threadCount Number of worker threads (0 = hardware concurrency - 1).
+     */
+    explicit WorkerPool(size_t threadCount = 0);
+    ~WorkerPool();
+
+    // WorkerPool is not copyable or movable
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /**
+     * @brief Runs job(i) for every i in [0, count) and waits for all of them.
+     * @param count Number of indices.
+     * @param job Called once per index, on a worker or on the calling thread.
+     *            Jobs must not throw.
+     */
+    void ParallelFor(size_t count, const std::function<void(size_t)> &job);
+
+    /**
+     * @brief Gets the number of worker threads (excluding the calling thread).
+     */
+    size_t GetThreadCount() const { return m_Threads.size(); }
+
+    /**
+     * @brief Actions deferred by a job, in the order they were deferred.
+     */
+    using DeferredActions = std::vector<std::function<void()>>;
+
+    /**
+     * @brief Makes RunOrDefer() on the current thread queue into a list until destroyed.
+     */
+    class DeferScope {
+    public:
+        explicit DeferScope(DeferredActions &actions);
+        ~DeferScope();
+
+        DeferScope(const DeferScope &) = delete;
+        DeferScope &operator=(const DeferScope &) = delete;
+
+    private:
+        DeferredActions *m_Previous;
+    };
+
+    /**
+     * @brief Runs an action now, or queues it if a DeferScope is active on this thread.
+     * @return True if the action was queued.
+     */
+    static bool RunOrDefer(std::function<void()> action);
+
+    /**
+     * @brief Runs deferred actions in order and clears the list.
+     */
+    static void RunDeferred(DeferredActions &actions);
+
+private:
+    void WorkerLoop();
+    void RunIndices();
+
+    std::vector<std::thread> m_Threads;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_WorkReady;
+    std::condition_variable m_WorkDone;
+
+    // Current batch (written under m_Mutex before the generation changes)
+    const std::function<void(size_t)> *m_Job = nullptr;
+    size_t m_Count = 0;
+    std::atomic<size_t> m_NextIndex{0};
+    size_t m_ActiveWorkers = 0;
+    uint64_t m_Generation = 0;
+    bool m_Stopping = false;
+};
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "EventManager.h"
+
+#include <chrono>
+#include <cstdio>
+
+// ============================================================================
+// Interning Tests
+// ============================================================================
+
+TEST(EventManagerTest, InternedNamesMapToStableIds) {
+    const EventManager::EventId id = EventManager::InternEvent("test_intern");
+    EXPECT_NE(id, EventManager::kInvalidEventId);
+    EXPECT_EQ(EventManager::InternEvent("test_intern"), id);
+    EXPECT_EQ(EventManager::FindEvent("test_intern"), id);
+    EXPECT_EQ(EventManager::GetEventName(id), "test_intern");
+
+    EXPECT_EQ(EventManager::InternEvent(""), EventManager::kInvalidEventId);
+    EXPECT_EQ(EventManager::FindEvent("test_never_interned"), EventManager::kInvalidEventId);
+}
+
+TEST(EventManagerTest, NameAndIdOverloadsShareListeners) {
+    EventManager events;
+    int calls = 0;
+    events.RegisterListener("test_shared", [&calls] { ++calls; });
+
+    const EventManager::EventId id = EventManager::FindEvent("test_shared");
+    events.FireEvent(id);
+    events.FireEvent("test_shared");
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(events.GetListenerCount(id), 1u);
+}
+
+// ============================================================================
+// Dispatch Tests
+// ============================================================================
+
+TEST(EventManagerTest, ListenersMayChangeListenersWhileDispatching) {
+    EventManager events;
+    const EventManager::EventId id = EventManager::InternEvent("test_reentrant");
+    int first = 0, self = 0, added = 0;
+
+    events.RegisterListener(id, std::function<void()>([&first] { ++first; }));
+    EventManager::ListenerId selfId = EventManager::kInvalidListenerId;
+    selfId = events.RegisterListener(id, std::function<void()>([&] {
+        ++self;
+        events.UnregisterListener(id, selfId);
+        events.RegisterListener(id, std::function<void()>([&added] { ++added; }));
+    }));
+    bool nested = false;
+    events.RegisterOnceListener("test_reentrant", [&] {
+        if (!nested) {
+            nested = true;
+            events.FireEvent(id);
+        }
+    });
+
+    events.FireEvent(id);
+    EXPECT_EQ(first, 2);  // Outer and nested fire
+    EXPECT_EQ(self, 1);   // Removed itself before the nested fire
+    EXPECT_EQ(added, 1);  // Added during the outer fire, seen by the nested one only
+    EXPECT_EQ(events.GetListenerCount(id), 2u);
+
+    events.FireEvent(id);
+    EXPECT_EQ(first, 3);
+    EXPECT_EQ(added, 2);
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+TEST(EventManagerTest, FireByNameAgainstFireById) {
+    constexpr int kFires = 1000000;
+    EventManager events;
+    int calls = 0;
+    events.RegisterListener("test_physics_tick", [&calls] { ++calls; });
+    const EventManager::EventId id = EventManager::FindEvent("test_physics_tick");
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kFires; ++i) {
+        events.FireEvent(std::string("test_physics_tick"));
+    }
+    const std::chrono::duration<double, std::nano> byName = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kFires; ++i) {
+        events.FireEvent(id);
+    }
+    const std::chrono::duration<double, std::nano> byId = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(calls, 2 * kFires);
+    printf("[ BENCH    ] fire with one listener: by name %6.1f ns, by id %6.1f ns\n",
+           byName.count() / kFires, byId.count() / kFires);
+}
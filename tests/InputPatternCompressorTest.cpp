@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+#include "InputPatternCompressor.h"
+#include "ScriptGenerator.h"
+
+#include <sol/sol.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace {
+    using Step = InputPatternCompressor::Step;
+    using PatternRun = InputPatternCompressor::Run;
+
+    const char *const kKeys[] = {"up", "down", "left", "right", "lshift", "space"};
+
+    Step MakeStep(size_t wait, uint8_t key, uint8_t transition) {
+        return {wait, InputPatternCompressor::MakeAction(key, transition)};
+    }
+
+    // Steps and the events behind them, laid out the way RenderChunk flattens a chunk
+    struct StepStream {
+        std::deque<KeyEvent> keyEvents; // Stable addresses for the sources
+        std::deque<GameEvent> gameEvents;
+        std::vector<Step> steps;
+        std::vector<ScriptGenerator::StepSource> sources;
+        size_t frame = 0;
+
+        void AddKey(size_t wait, uint8_t key, KeyTransition transition) {
+            frame += wait;
+            const KeyEvent &event = keyEvents.emplace_back(frame, key, transition);
+            steps.push_back({wait, InputPatternCompressor::MakeAction(key, static_cast<uint8_t>(transition))});
+            sources.push_back({frame, nullptr, &event});
+        }
+
+        void AddGameEvent(size_t wait, const char *name) {
+            frame += wait;
+            const GameEvent &event = gameEvents.emplace_back(frame, name);
+            steps.push_back({wait, InputPatternCompressor::kBarrier});
+            sources.push_back({frame, &event, nullptr});
+        }
+    };
+
+    // Renders the steps with the generator, with or without loops
+    std::string Render(const StepStream &stream, bool compressRepeats) {
+        GenerationOptions options;
+        options.compressRepeats = compressRepeats;
+
+        ScriptGenerator::LuaScriptBuilder builder(options);
+        builder.AddLine("function main()");
+        builder.Indent();
+        std::vector<Step> steps = stream.steps;
+        ScriptGenerator::RenderSteps(steps, stream.sources, 0, steps.size(), options, builder);
+        builder.Unindent();
+        builder.AddLine("end");
+        return builder.GetScript();
+    }
+
+    // The calls the steps stand for, in the format of Replay()
+    std::string ExpectedTrace(const StepStream &stream) {
+        std::string trace;
+        for (size_t s = 0; s < stream.steps.size(); ++s) {
+            if (stream.steps[s].wait > 0) {
+                trace += "w" + std::to_string(stream.steps[s].wait) + ";";
+            }
+            if (const KeyEvent *event = stream.sources[s].keyEvent) {
+                const char *command = event->transition == KeyTransition::Pressed    ? "d"
+                                      : event->transition == KeyTransition::Released ? "u"
+                                                                                     : "p";
+                trace += command + std::string(kKeys[event->key]) + ";";
+            }
+        }
+        return trace;
+    }
+
+    // Counts the rendered events: key commands and game event anchors
+    size_t CountEvents(const std::string &source) {
+        size_t count = 0;
+        for (const char *marker : {"tas.key_down(", "tas.key_up(", "tas.press(", "GAME EVENT:"}) {
+            for (size_t pos = source.find(marker); pos != std::string::npos; pos = source.find(marker, pos + 1)) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    // Runs a script against a tas table that records every call
+    std::string Replay(const std::string &source) {
+        sol::state lua;
+        lua.open_libraries(sol::lib::base);
+
+        std::string trace;
+        sol::table tas = lua.create_named_table("tas");
+        tas["wait_ticks"] = [&trace](int ticks) { trace += "w" + std::to_string(ticks) + ";"; };
+        tas["key_down"] = [&trace](const std::string &key) { trace += "d" + key + ";"; };
+        tas["key_up"] = [&trace](const std::string &key) { trace += "u" + key + ";"; };
+        tas["press"] = [&trace](const std::string &key) { trace += "p" + key + ";"; };
+
+        sol::protected_function_result loaded = lua.safe_script(source);
+        EXPECT_TRUE(loaded.valid());
+        sol::protected_function_result ran = lua["main"]();
+        EXPECT_TRUE(ran.valid());
+        return trace;
+    }
+
+    double MeasureLoadMilliseconds(const std::string &source) {
+        double best = 1e30;
+        for (int i = 0; i < 5; ++i) {
+            sol::state lua;
+            const auto start = std::chrono::steady_clock::now();
+            sol::load_result chunk = lua.load(source);
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            EXPECT_TRUE(chunk.valid());
+            best = std::min(best, elapsed.count());
+        }
+        return best;
+    }
+
+    // Shaped like a real run: stretches of fixed-interval jumps and alternating
+    // steering, with irregular input and game events in between
+    StepStream MakeRun(size_t stretches) {
+        StepStream stream;
+        for (size_t n = 0; n < stretches; ++n) {
+            const size_t interval = 20 + n % 17;
+            for (int i = 0; i < 40; ++i) {
+                stream.AddKey(interval, 1, KeyTransition::PressedAndReleased);
+            }
+            for (int i = 0; i < 30; ++i) {
+                stream.AddKey(i == 0 ? 5 : 9, 2, KeyTransition::Pressed);
+                stream.AddKey(6, 2, KeyTransition::Released);
+            }
+            stream.AddKey(1 + n % 5, 0, n % 2 ? KeyTransition::Released : KeyTransition::Pressed);
+            stream.AddGameEvent(3, "checkpoint");
+        }
+        return stream;
+    }
+}
+
+// ============================================================================
+// Pattern Tests
+// ============================================================================
+
+TEST(InputPatternCompressorTest, FindsRepeatsAndStopsAtBarriers) {
+    std::vector<Step> steps;
+    steps.push_back(MakeStep(7, 0, 1));
+    for (int i = 0; i < 5; ++i) {
+        steps.push_back(MakeStep(5, 1, 1));
+        steps.push_back(MakeStep(3, 1, 2));
+    }
+    steps.push_back({2, InputPatternCompressor::kBarrier});
+    steps.push_back({2, InputPatternCompressor::kBarrier});
+    steps.push_back({2, InputPatternCompressor::kBarrier});
+    for (int i = 0; i < 10; ++i) {
+        steps.push_back(MakeStep(1, 2, 3));
+    }
+
+    std::vector<PatternRun> runs;
+    InputPatternCompressor().FindRuns(steps, runs);
+    ASSERT_EQ(runs.size(), 2u);
+    EXPECT_EQ(runs[0].begin, 1u);
+    EXPECT_EQ(runs[0].period, 2u);
+    EXPECT_EQ(runs[0].repeats, 5u);
+    EXPECT_EQ(runs[1].begin, 14u);
+    EXPECT_EQ(runs[1].period, 1u);
+    EXPECT_EQ(runs[1].repeats, 10u);
+
+    // Too few repetitions to be worth a loop
+    steps.assign(4, MakeStep(1, 0, 3));
+    InputPatternCompressor(32, 3, 4).FindRuns(steps, runs);
+    EXPECT_TRUE(runs.empty());
+}
+
+TEST(InputPatternCompressorTest, LoopedScriptReplaysIdentically) {
+    const StepStream stream = MakeRun(20);
+
+    const std::string plain = Render(stream, false);
+    const std::string looped = Render(stream, true);
+    EXPECT_EQ(plain.find("for _ = 1, "), std::string::npos);
+    EXPECT_NE(looped.find("for _ = 1, "), std::string::npos);
+    EXPECT_LT(looped.size(), plain.size());
+    EXPECT_EQ(Replay(plain), ExpectedTrace(stream));
+    EXPECT_EQ(Replay(looped), ExpectedTrace(stream));
+}
+
+TEST(InputPatternCompressorTest, RendersStartWaitBarriersAndSections) {
+    StepStream stream;
+    for (int i = 0; i < 12; ++i) {
+        stream.AddKey(10, 5, KeyTransition::PressedAndReleased);
+    }
+    stream.AddGameEvent(4, "checkpoint");
+    stream.AddGameEvent(0, "checkpoint");
+    for (int i = 0; i < 8; ++i) {
+        stream.AddKey(3, 0, KeyTransition::Pressed);
+        stream.AddKey(2, 0, KeyTransition::Released);
+    }
+
+    // The wait before the first step is issued once, ahead of the loop that starts there
+    const std::string looped = Render(stream, true);
+    EXPECT_NE(looped.find("  -- Wait 10 frames to start\n  tas.wait_ticks(10)\n"), std::string::npos);
+    EXPECT_EQ(Replay(looped), ExpectedTrace(stream));
+
+    // Game events never end up inside a loop
+    for (size_t loop = looped.find("for _ = 1, "); loop != std::string::npos; loop = looped.find("for _ = 1, ", loop + 1)) {
+        const size_t end = looped.find("  end\n", loop);
+        ASSERT_NE(end, std::string::npos);
+        EXPECT_EQ(looped.substr(loop, end - loop).find("GAME EVENT"), std::string::npos);
+    }
+    EXPECT_NE(looped.find("-- GAME EVENT: checkpoint at frame 124\n"), std::string::npos);
+
+    // A separator follows the 20th event, but none follows the last one
+    const std::string plain = Render(stream, false);
+    EXPECT_EQ(Replay(plain), ExpectedTrace(stream));
+    const size_t separator = plain.find("-- --- Section 2 ---");
+    ASSERT_NE(separator, std::string::npos);
+    EXPECT_EQ(CountEvents(plain.substr(0, separator)), 20u);
+    EXPECT_EQ(plain.find("-- --- Section", separator + 1), std::string::npos);
+
+    // The loop that crosses event 20 also ends the script, so the looped script has none
+    EXPECT_EQ(looped.find("-- --- Section"), std::string::npos);
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+TEST(InputPatternCompressorTest, ScriptSizeAndLoadTime) {
+    const StepStream stream = MakeRun(2000);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<PatternRun> runs;
+    InputPatternCompressor().FindRuns(stream.steps, runs);
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    const std::string plain = Render(stream, false);
+    const std::string looped = Render(stream, true);
+    const double plainMs = MeasureLoadMilliseconds(plain);
+    const double loopedMs = MeasureLoadMilliseconds(looped);
+    EXPECT_LT(looped.size() * 4, plain.size());
+
+    printf("[ BENCH    ] find runs in %zu steps: %8.2f ms (%zu loops)\n", stream.steps.size(), elapsed.count(), runs.size());
+    printf("[ BENCH    ] unrolled script: %9zu bytes, load %8.2f ms\n", plain.size(), plainMs);
+    printf("[ BENCH    ] looped script  : %9zu bytes, load %8.2f ms\n", looped.size(), loopedMs);
+}
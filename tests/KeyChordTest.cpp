@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "KeyChord.h"
+
+#include <vector>
+
+// ============================================================================
+// KeyMask Tests
+// ============================================================================
+
+TEST(KeyChordTest, MaskCoversAllWords) {
+    KeyMask mask;
+    EXPECT_FALSE(mask.Any());
+
+    const std::vector<uint8_t> codes = {0, 63, 64, 127, 128, 200, 255};
+    for (uint8_t code : codes) {
+        mask.Set(code);
+    }
+    EXPECT_EQ(mask.Count(), codes.size());
+
+    std::vector<uint8_t> visited;
+    mask.ForEach([&visited](uint8_t code) { visited.push_back(code); });
+    EXPECT_EQ(visited, codes);
+
+    mask.Reset(64);
+    EXPECT_FALSE(mask.Test(64));
+    EXPECT_TRUE(mask.Test(63));
+    EXPECT_TRUE(mask.Test(255));
+}
+
+TEST(KeyChordTest, SubsetAndIntersection) {
+    KeyMask pressed;
+    pressed.Set(200);
+    pressed.Set(203);
+    pressed.Set(205);
+
+    KeyMask upRight;
+    upRight.Set(200);
+    upRight.Set(205);
+    EXPECT_TRUE(pressed.ContainsAll(upRight));
+    EXPECT_TRUE(pressed.Intersects(upRight));
+
+    upRight.Set(57);
+    EXPECT_FALSE(pressed.ContainsAll(upRight));
+    EXPECT_TRUE(pressed.Intersects(upRight));
+
+    pressed.Remove(upRight);
+    EXPECT_EQ(pressed.Count(), 1u);
+    EXPECT_FALSE(pressed.Intersects(upRight));
+}
+
+// ============================================================================
+// KeyChord Tests
+// ============================================================================
+
+TEST(KeyChordTest, UnknownKeysMakeChordUnqueryable) {
+    KeyChord chord;
+    EXPECT_FALSE(chord.IsQueryable());
+
+    chord.AddKey(200);
+    EXPECT_TRUE(chord.IsQueryable());
+
+    KeyChord unknown;
+    unknown.AddKey(203);
+    unknown.MarkUnknownKey();
+    EXPECT_FALSE(unknown.IsQueryable());
+
+    const KeyChord merged = chord | unknown;
+    EXPECT_EQ(merged.GetKeyCount(), 2u);
+    EXPECT_TRUE(merged.HasUnknownKeys());
+}
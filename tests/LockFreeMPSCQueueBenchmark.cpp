@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "LockFreeMPSCQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr int kProducerCount = 4;
+    constexpr uint32_t kMessagesPerProducer = 200000;
+
+    // Producer id in the upper bits, per-producer sequence number in the lower bits
+    uint64_t MakeMessage(int producer, uint32_t sequence) {
+        return static_cast<uint64_t>(producer) << 32 | sequence;
+    }
+
+    struct RunResult {
+        double seconds = 0.0;
+        size_t received = 0;
+        bool ordered = true;
+    };
+
+    // Runs kProducerCount producers against one consumer draining with batchSize
+    // (0 = one Dequeue() per message)
+    RunResult RunProducers(LockFreeMPSCQueue<uint64_t, 15> &queue, size_t batchSize) {
+        RunResult result;
+        std::vector<std::thread> producers;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int p = 0; p < kProducerCount; ++p) {
+            producers.emplace_back([&, p] {
+                for (uint32_t i = 0; i < kMessagesPerProducer; ++i) {
+                    while (!queue.Enqueue(MakeMessage(p, i), p % 2 ? 8 : 0)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        std::vector<uint32_t> nextSequence(kProducerCount, 0);
+        std::vector<uint64_t> batch;
+        const size_t expected = static_cast<size_t>(kProducerCount) * kMessagesPerProducer;
+        auto consume = [&](uint64_t message) {
+            const int producer = static_cast<int>(message >> 32);
+            const auto sequence = static_cast<uint32_t>(message);
+            result.ordered &= sequence == nextSequence[producer]++;
+            ++result.received;
+        };
+
+        while (result.received < expected) {
+            if (batchSize == 0) {
+                if (auto message = queue.Dequeue()) {
+                    consume(*message);
+                }
+            } else if (queue.DequeueBatch(batch, batchSize) > 0) {
+                for (uint64_t message : batch) {
+                    consume(message);
+                }
+                batch.clear();
+            }
+        }
+
+        for (auto &thread : producers) {
+            thread.join();
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+}
+
+// ============================================================================
+// Ordering Tests
+// ============================================================================
+
+TEST(LockFreeMPSCQueueTest, HighestPriorityFirstFifoWithinLane) {
+    LockFreeMPSCQueue<int, 15> queue(100);
+    queue.Enqueue(1, 0);
+    queue.Enqueue(2, 15);
+    queue.Enqueue(3, 7);
+    queue.Enqueue(4, 15);
+    queue.Enqueue(5, 0);
+
+    std::vector<int> batch;
+    EXPECT_EQ(queue.DequeueBatch(batch, 3), 3u);
+    EXPECT_EQ(batch, (std::vector<int>{2, 4, 3}));
+
+    EXPECT_EQ(queue.Dequeue(), 1);
+    EXPECT_EQ(queue.Dequeue(), 5);
+    EXPECT_FALSE(queue.Dequeue().has_value());
+    EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(LockFreeMPSCQueueTest, RejectsWhenFull) {
+    LockFreeMPSCQueue<int, 3> queue(2);
+    EXPECT_TRUE(queue.Enqueue(1, 1));
+    EXPECT_TRUE(queue.Enqueue(2, 1));
+    EXPECT_FALSE(queue.Enqueue(3, 1));
+    EXPECT_EQ(queue.Size(), 2u);
+}
+
+// ============================================================================
+// Multi-Producer Benchmark
+// ============================================================================
+
+TEST(LockFreeMPSCQueueTest, MultiProducerThroughput) {
+    LockFreeMPSCQueue<uint64_t, 15> queue(4096);
+
+    const RunResult single = RunProducers(queue, 0);
+    const size_t warmNodes = queue.AllocatedNodes();
+    const RunResult batched = RunProducers(queue, 64);
+
+    const size_t expected = static_cast<size_t>(kProducerCount) * kMessagesPerProducer;
+    EXPECT_EQ(single.received, expected);
+    EXPECT_EQ(batched.received, expected);
+    EXPECT_TRUE(single.ordered);
+    EXPECT_TRUE(batched.ordered);
+
+    // The pool never outgrows the queue capacity (plus stubs and racing producers),
+    // so the second run is served from recycled nodes
+    EXPECT_LE(queue.AllocatedNodes(), queue.Capacity() + 16 + kProducerCount + 256);
+    EXPECT_TRUE(queue.IsEmpty());
+
+    printf("[ BENCH    ] %d producers x %u messages\n", kProducerCount, kMessagesPerProducer);
+    printf("[ BENCH    ] Dequeue()        : %8.2f ms (%6.1f M msg/s)\n", single.seconds * 1000.0,
+           expected / single.seconds / 1e6);
+    printf("[ BENCH    ] DequeueBatch(64) : %8.2f ms (%6.1f M msg/s)\n", batched.seconds * 1000.0,
+           expected / batched.seconds / 1e6);
+    printf("[ BENCH    ] pool size        : %zu nodes\n", warmNodes);
+}
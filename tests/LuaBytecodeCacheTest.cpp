@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "LuaBytecodeCache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+    // Shaped like ScriptGenerator output: one statement per recorded frame
+    std::string GenerateScript(int frames) {
+        std::string source = "local frames = {}\n";
+        for (int i = 0; i < frames; ++i) {
+            source += "frames[" + std::to_string(i) + "] = { keys = \"up right\", hold = " +
+                std::to_string(i % 7) + " }\n";
+        }
+        source += "return #frames + 1\n";
+        return source;
+    }
+
+    class LuaBytecodeCacheTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            m_Dir = fs::temp_directory_path() / "tas_bytecode_cache_test";
+            fs::remove_all(m_Dir);
+        }
+
+        void TearDown() override {
+            fs::remove_all(m_Dir);
+        }
+
+        void WriteFile(const fs::path &path, const std::string &content) {
+            std::ofstream file(path, std::ios::binary);
+            file << content;
+        }
+
+        fs::path m_Dir;
+    };
+}
+
+// ============================================================================
+// Cache Tests
+// ============================================================================
+
+TEST_F(LuaBytecodeCacheTest, HitsAfterMissAndInvalidatesOnEdit) {
+    LuaBytecodeCache cache(m_Dir.string());
+    const fs::path script = m_Dir / "main.lua";
+    WriteFile(script, "#!shebang line\nreturn 40 + 2\n");
+
+    for (int run = 0; run < 2; ++run) {
+        sol::state lua;
+        sol::load_result chunk = cache.LoadFile(lua, script.string());
+        ASSERT_TRUE(chunk.valid());
+        sol::protected_function fn = chunk;
+        EXPECT_EQ(fn().get<int>(), 42);
+    }
+    EXPECT_EQ(cache.GetMissCount(), 1u);
+    EXPECT_EQ(cache.GetHitCount(), 1u);
+
+    // Editing the script changes its key
+    WriteFile(script, "return 7\n");
+    sol::state lua;
+    sol::load_result chunk = cache.LoadFile(lua, script.string());
+    ASSERT_TRUE(chunk.valid());
+    sol::protected_function fn = chunk;
+    EXPECT_EQ(fn().get<int>(), 7);
+    EXPECT_EQ(cache.GetMissCount(), 2u);
+
+    // Syntax errors report the script name, as luaL_loadfile does
+    sol::load_result broken = cache.LoadBuffer(lua, "return +", "@broken.lua");
+    ASSERT_FALSE(broken.valid());
+    sol::error err = broken;
+    EXPECT_NE(std::string(err.what()).find("broken.lua"), std::string::npos);
+}
+
+TEST_F(LuaBytecodeCacheTest, RequireGoesThroughCache) {
+    auto cache = std::make_shared<LuaBytecodeCache>((m_Dir / "cache").string());
+    WriteFile(m_Dir / "helper.lua", "return { answer = function() return 42 end }\n");
+
+    for (int run = 0; run < 2; ++run) {
+        sol::state lua;
+        lua.open_libraries(sol::lib::base, sol::lib::package);
+        lua["package"]["path"] = (m_Dir / "?.lua").string();
+        LuaBytecodeCache::InstallSearcher(lua, cache);
+
+        EXPECT_EQ(lua.safe_script("return require('helper').answer()").get<int>(), 42);
+        EXPECT_FALSE(lua.safe_script("return require('missing')", &sol::script_pass_on_error).valid());
+    }
+    EXPECT_EQ(cache->GetMissCount(), 1u);
+    EXPECT_EQ(cache->GetHitCount(), 1u);
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+TEST_F(LuaBytecodeCacheTest, LoadGeneratedScript) {
+    constexpr int kFrames = 100000;
+    constexpr int kRuns = 5;
+    const std::string source = GenerateScript(kFrames);
+    LuaBytecodeCache cache(m_Dir.string());
+
+    sol::state lua;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRuns; ++i) {
+        sol::load_result chunk = lua.load(source, "@generated.lua");
+        ASSERT_TRUE(chunk.valid());
+    }
+    const std::chrono::duration<double, std::milli> compile = std::chrono::steady_clock::now() - start;
+
+    ASSERT_TRUE(cache.LoadBuffer(lua, source, "@generated.lua").valid()); // Populate
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRuns; ++i) {
+        sol::load_result chunk = cache.LoadBuffer(lua, source, "@generated.lua");
+        ASSERT_TRUE(chunk.valid());
+    }
+    const std::chrono::duration<double, std::milli> cached = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(cache.GetHitCount(), static_cast<uint64_t>(kRuns));
+    sol::protected_function fn = cache.LoadBuffer(lua, source, "@generated.lua");
+    EXPECT_EQ(fn().get<int>(), kFrames);
+
+    printf("[ BENCH    ] %d-line script: compile %8.2f ms, bytecode cache %8.2f ms\n",
+           kFrames + 2, compile.count() / kRuns, cached.count() / kRuns);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "LuaScheduler.h"
+
+#include <vector>
+
+namespace {
+    // Builds the coroutine the same way tas.async does: a scheduler thread plus the
+    // handle returned to the script, copied before the scheduler ever resumes it
+    struct TrackedCoroutine {
+        std::shared_ptr<detail::SchedulerCothread> thread;
+        sol::coroutine handle;
+
+        TrackedCoroutine(sol::state &lua, const char *body) {
+            sol::function func = lua.load(body);
+            thread = std::make_shared<detail::SchedulerCothread>(lua, func);
+            handle = thread->coroutine;
+        }
+
+        void Resume() { thread->coroutine(); }
+    };
+
+    class LuaSchedulerTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            lua.open_libraries(sol::lib::base, sol::lib::coroutine);
+        }
+
+        sol::state lua;
+    };
+}
+
+// ============================================================================
+// Coroutine State Tests
+// ============================================================================
+
+TEST_F(LuaSchedulerTest, InvalidAndUnstartedCoroutinesAreNotRunning) {
+    EXPECT_FALSE(SchedulerTask::IsCoroutineRunning(sol::coroutine()));
+
+    TrackedCoroutine fresh(lua, "coroutine.yield()");
+    EXPECT_FALSE(SchedulerTask::IsCoroutineRunning(fresh.handle));
+}
+
+TEST_F(LuaSchedulerTest, YieldedCoroutineIsRunningUntilItReturns) {
+    TrackedCoroutine co(lua, "coroutine.yield() coroutine.yield()");
+
+    co.Resume();
+    EXPECT_TRUE(SchedulerTask::IsCoroutineRunning(co.handle));
+    co.Resume();
+    EXPECT_TRUE(SchedulerTask::IsCoroutineRunning(co.handle));
+    co.Resume();
+    EXPECT_FALSE(SchedulerTask::IsCoroutineRunning(co.handle));
+}
+
+TEST_F(LuaSchedulerTest, FailedCoroutineIsNotRunning) {
+    TrackedCoroutine co(lua, "error('boom')");
+
+    co.Resume();
+    EXPECT_FALSE(SchedulerTask::IsCoroutineRunning(co.handle));
+}
+
+// ============================================================================
+// Wait Task Tests
+// ============================================================================
+
+TEST_F(LuaSchedulerTest, WaitOnCoroutineThatFinishedWithoutYielding) {
+    // Regression: the script's handle never saw the run, so its own status()
+    // still read "ok" and tas.wait() on it never completed
+    lua["status"] = "start";
+    TrackedCoroutine done(lua, "status = 'dependency_finished'");
+
+    done.Resume();
+    EXPECT_EQ(lua["status"].get<std::string>(), "dependency_finished");
+    EXPECT_FALSE(SchedulerTask::IsCoroutineRunning(done.handle));
+
+    CoroutineWaitTask wait({done.handle});
+    EXPECT_TRUE(wait.IsComplete());
+
+    ParallelTask parallel({done.handle});
+    EXPECT_TRUE(parallel.IsComplete());
+}
+
+TEST_F(LuaSchedulerTest, WaitCompletesOnceEveryCoroutineFinishes) {
+    TrackedCoroutine first(lua, "coroutine.yield()");
+    TrackedCoroutine second(lua, "coroutine.yield() coroutine.yield()");
+    first.Resume();
+    second.Resume();
+
+    CoroutineWaitTask wait({first.handle, second.handle});
+    EXPECT_FALSE(wait.IsComplete());
+
+    first.Resume();
+    EXPECT_FALSE(wait.IsComplete());
+
+    second.Resume();
+    second.Resume();
+    EXPECT_TRUE(wait.IsComplete());
+}
+
+TEST_F(LuaSchedulerTest, RaceCompletesOnFirstFinishedCoroutine) {
+    TrackedCoroutine slow(lua, "coroutine.yield() coroutine.yield()");
+    TrackedCoroutine fast(lua, "coroutine.yield()");
+    slow.Resume();
+    fast.Resume();
+
+    RaceTask race({slow.handle, fast.handle});
+    EXPECT_FALSE(race.IsComplete());
+
+    fast.Resume();
+    EXPECT_TRUE(race.IsComplete());
+
+    TrackedCoroutine done(lua, "return 1");
+    done.Resume();
+    RaceTask finished({slow.handle, done.handle});
+    EXPECT_TRUE(finished.IsComplete());
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "MessagePayload.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace {
+    template <typename Fn>
+    double MeasureNanoseconds(int iterations, Fn &&fn) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            fn();
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / iterations;
+    }
+
+    void RunBenchmark(const char *name, sol::state &sender, sol::state &receiver, const sol::object &value,
+                      int iterations) {
+        const MessagePayload payload = MessagePayload::FromLuaObject(value);
+
+        const double encodeNs = MeasureNanoseconds(iterations, [&] {
+            MessagePayload encoded = MessagePayload::FromLuaObject(value);
+            ASSERT_FALSE(encoded.GetBytes().empty());
+        });
+        const double decodeNs = MeasureNanoseconds(iterations, [&] {
+            sol::object decoded = payload.ToLuaObject(receiver);
+            ASSERT_TRUE(decoded.is<sol::table>());
+        });
+        sender.collect_garbage();
+        receiver.collect_garbage();
+
+        printf("[ BENCH    ] %-16s: %8zu bytes, encode %10.1f ns, decode %10.1f ns\n", name,
+               payload.EstimateSize(), encodeNs, decodeNs);
+    }
+}
+
+// ============================================================================
+// Round Trip Tests
+// ============================================================================
+
+TEST(MessagePayloadTest, RoundTripsNestedValues) {
+    sol::state sender;
+    sol::state receiver;
+    receiver.open_libraries(sol::lib::base);
+    sol::table value = sender.script(R"(
+        return {
+            name = "ball",
+            alive = true,
+            pos = { x = 1.5, y = -2, z = 3 },
+            path = { 1, 2, 3, 4 },
+            mixed = { "a", false, { name = "ball" } },
+            sparse = { [0] = "zero", [5] = "five" },
+            empty = {},
+        }
+    )");
+
+    const MessagePayload payload = MessagePayload::FromLuaObject(value);
+    EXPECT_EQ(payload.GetType(), MessagePayload::Type::Table);
+
+    receiver["v"] = payload.ToLuaObject(receiver);
+    const bool ok = receiver.script(R"(
+        return v.name == "ball" and v.alive == true
+           and v.pos.x == 1.5 and v.pos.y == -2 and v.pos.z == 3
+           and #v.path == 4 and v.path[4] == 4
+           and v.mixed[1] == "a" and v.mixed[2] == false and v.mixed[3].name == "ball"
+           and v.sparse[0] == "zero" and v.sparse[5] == "five" and v.sparse[1] == nil
+           and next(v.empty) == nil
+    )");
+    EXPECT_TRUE(ok);
+}
+
+TEST(MessagePayloadTest, InternsRepeatedStrings) {
+    sol::state lua;
+    sol::table records = lua.script(R"(
+        local t = {}
+        for i = 1, 100 do t[i] = { checkpoint = "sector_01", index = i } end
+        return t
+    )");
+
+    // Keys and the repeated value are stored once, later uses are a two-byte reference
+    const MessagePayload payload = MessagePayload::FromLuaObject(records);
+    EXPECT_LT(payload.EstimateSize(), 100u * 20u);
+}
+
+TEST(MessagePayloadTest, SharedBufferStaysZeroCopy) {
+    sol::state sender;
+    sol::state receiver;
+    auto buffer = SharedBuffer::Create(1024);
+    sender["buf"] = buffer;
+    sol::object value = sender["buf"];
+
+    const MessagePayload payload = MessagePayload::FromLuaObject(value);
+    EXPECT_EQ(payload.GetType(), MessagePayload::Type::SharedBufferRef);
+    EXPECT_EQ(payload.AsSharedBuffer().get(), buffer.get());
+
+    sol::object decoded = payload.ToLuaObject(receiver);
+    EXPECT_EQ(decoded.as<std::shared_ptr<SharedBuffer>>().get(), buffer.get());
+}
+
+TEST(MessagePayloadTest, RejectsUnsupportedValues) {
+    sol::state lua;
+    lua.open_libraries(sol::lib::base);
+    auto encode = [&](const char *code) {
+        sol::object value = lua.script(code);
+        return MessagePayload::FromLuaObject(value);
+    };
+
+    EXPECT_THROW(encode("return { f = print }"), std::runtime_error);
+    EXPECT_THROW(encode("return { 1, x = 2 }"), std::runtime_error);
+    EXPECT_THROW(encode("local t = {} t.self = t return t"), std::runtime_error);
+    EXPECT_EQ(lua_gettop(lua.lua_state()), 0);
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+TEST(MessagePayloadTest, Benchmark) {
+    sol::state sender;
+    sol::state receiver;
+
+    sol::object smallTable = sender.script(R"(
+        return { type = "checkpoint", sector = 3, time = 12.5, ball = "wood", ok = true }
+    )");
+    sol::object numberArray = sender.script(R"(
+        local t = {}
+        for i = 1, 10000 do t[i] = i * 0.5 end
+        return t
+    )");
+    sol::object recordArray = sender.script(R"(
+        local t = {}
+        for i = 1, 10000 do t[i] = { frame = i, key = "up" } end
+        return t
+    )");
+
+    RunBenchmark("small table", sender, receiver, smallTable, 100000);
+    RunBenchmark("10k numbers", sender, receiver, numberArray, 200);
+    RunBenchmark("10k records", sender, receiver, recordArray, 50);
+}
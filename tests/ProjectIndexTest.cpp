@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "ProjectIndex.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+    ProjectIndex::Entry MakeEntry(int i) {
+        ProjectIndex::Entry entry;
+        entry.path = "C:\\TAS\\project_" + std::to_string(i);
+        entry.kind = i % 3 == 0 ? ProjectIndex::SourceKind::Zip : ProjectIndex::SourceKind::Directory;
+        entry.stamp = {static_cast<uint64_t>(100 + i), 1000 + i};
+        entry.hasProject = i % 7 != 0;
+        entry.info.name = "Project " + std::to_string(i);
+        entry.info.targetLevel = "Level_0" + std::to_string(1 + i % 9);
+        entry.info.updateRate = 132.0f;
+        entry.info.isValid = entry.hasProject;
+        entry.info.isZipProject = entry.kind == ProjectIndex::SourceKind::Zip;
+
+        ManifestField custom;
+        custom.key = "difficulty";
+        custom.type = ManifestField::Type::Number;
+        custom.number = i;
+        entry.info.manifestFields.push_back(custom);
+        return entry;
+    }
+
+    class ProjectIndexTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            m_Dir = fs::temp_directory_path() / "tas_project_index_test";
+            fs::remove_all(m_Dir);
+            fs::create_directories(m_Dir);
+            m_File = (m_Dir / "projects.idx").string();
+        }
+
+        void TearDown() override {
+            fs::remove_all(m_Dir);
+        }
+
+        fs::path m_Dir;
+        std::string m_File;
+    };
+}
+
+// ============================================================================
+// Index Tests
+// ============================================================================
+
+TEST_F(ProjectIndexTest, RoundTripsAndMatchesStamps) {
+    ProjectIndex index;
+    for (int i = 0; i < 20; ++i) {
+        index.Add(MakeEntry(i));
+    }
+    ASSERT_TRUE(index.Save(m_File));
+
+    ProjectIndex loaded;
+    ASSERT_TRUE(loaded.Load(m_File));
+    ASSERT_EQ(loaded.GetSize(), index.GetSize());
+    for (int i = 0; i < 20; ++i) {
+        const ProjectIndex::Entry expected = MakeEntry(i);
+        const auto *entry = loaded.Find(expected.path, expected.kind, expected.stamp);
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->hasProject, expected.hasProject);
+        EXPECT_EQ(entry->info, expected.info);
+    }
+
+    // A changed stamp or source kind makes the entry stale
+    const ProjectIndex::Entry first = MakeEntry(1);
+    EXPECT_EQ(loaded.Find(first.path, first.kind, {first.stamp.size, first.stamp.mtime + 1}), nullptr);
+    EXPECT_EQ(loaded.Find(first.path, ProjectIndex::SourceKind::Record, first.stamp), nullptr);
+}
+
+TEST_F(ProjectIndexTest, RejectsDamagedFile) {
+    ProjectIndex index;
+    index.Add(MakeEntry(1));
+    ASSERT_TRUE(index.Save(m_File));
+
+    // Truncate the last byte
+    fs::resize_file(m_File, fs::file_size(m_File) - 1);
+    ProjectIndex loaded;
+    EXPECT_FALSE(loaded.Load(m_File));
+    EXPECT_EQ(loaded.GetSize(), 0u);
+
+    EXPECT_FALSE(loaded.Load((m_Dir / "missing.idx").string()));
+}
+
+TEST_F(ProjectIndexTest, ReadsFileStamps) {
+    const std::string path = (m_Dir / "manifest.lua").string();
+    {
+        std::ofstream file(path);
+        file << "return { name = \"x\" }\n";
+    }
+
+    ProjectIndex::Stamp stamp;
+    ASSERT_TRUE(ProjectIndex::ReadStamp(path, stamp));
+    EXPECT_EQ(stamp.size, fs::file_size(path));
+
+    fs::last_write_time(path, fs::last_write_time(path) + std::chrono::seconds(5));
+    ProjectIndex::Stamp touched;
+    ASSERT_TRUE(ProjectIndex::ReadStamp(path, touched));
+    EXPECT_NE(touched, stamp);
+
+    EXPECT_FALSE(ProjectIndex::ReadStamp((m_Dir / "missing.lua").string(), stamp));
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+TEST_F(ProjectIndexTest, LoadAndLookup) {
+    constexpr int kProjects = 500;
+    ProjectIndex index;
+    for (int i = 0; i < kProjects; ++i) {
+        index.Add(MakeEntry(i));
+    }
+    ASSERT_TRUE(index.Save(m_File));
+
+    const auto start = std::chrono::steady_clock::now();
+    ProjectIndex loaded;
+    ASSERT_TRUE(loaded.Load(m_File));
+    int found = 0;
+    for (int i = 0; i < kProjects; ++i) {
+        const ProjectIndex::Entry expected = MakeEntry(i);
+        found += loaded.Find(expected.path, expected.kind, expected.stamp) ? 1 : 0;
+    }
+    const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(found, kProjects);
+    printf("[ BENCH    ] load + look up %d indexed projects: %8.1f us\n", kProjects, elapsed.count());
+}
@@ -0,0 +1,305 @@
+#include <gtest/gtest.h>
+#include "RecordFrameStore.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr float kDeltaTime = 1000.0f / 132.0f;
+
+    RecordFrameData MakeFrame(int keys, float deltaTime = kDeltaTime) {
+        RecordFrameData frame(deltaTime);
+        frame.keyStates = keys;
+        return frame;
+    }
+
+    // Shaped like a real run: keys held for dozens of frames at a time
+    std::vector<RecordFrameData> MakeRun(size_t frameCount, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::vector<RecordFrameData> frames;
+        frames.reserve(frameCount);
+        int keys = 0;
+        while (frames.size() < frameCount) {
+            const size_t hold = 1 + rng() % 60;
+            for (size_t i = 0; i < hold && frames.size() < frameCount; ++i) {
+                frames.push_back(MakeFrame(keys));
+            }
+            keys ^= 1 << (rng() % 8);
+        }
+        return frames;
+    }
+
+    void ExpectSameFrames(const RecordFrameStore &store, const std::vector<RecordFrameData> &expected) {
+        ASSERT_EQ(store.GetSize(), expected.size());
+
+        RecordFrameStore::Cursor cursor;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_TRUE(RecordFrameStore::IsSameFrame(store.Get(i, cursor), expected[i])) << "frame " << i;
+        }
+
+        std::vector<RecordFrameData> copied;
+        store.CopyRange(0, store.GetSize(), copied);
+        ASSERT_EQ(copied.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_TRUE(RecordFrameStore::IsSameFrame(copied[i], expected[i])) << "frame " << i;
+        }
+    }
+}
+
+// ============================================================================
+// Store Tests
+// ============================================================================
+
+TEST(RecordFrameStoreTest, CoalescesRuns) {
+    RecordFrameStore store;
+    std::vector<RecordFrameData> frames(1000, MakeFrame(1));
+    store.Assign(frames);
+    EXPECT_EQ(store.GetRunCount(), 1u);
+
+    // Overwriting one frame splits the run, restoring it merges it again
+    store.Set(500, MakeFrame(2));
+    EXPECT_EQ(store.GetRunCount(), 3u);
+    store.Set(500, MakeFrame(1));
+    EXPECT_EQ(store.GetRunCount(), 1u);
+
+    // A million inserted copies of one frame are a single run
+    store.Splice(1000, 0, {MakeFrame(4)}, 1000000);
+    EXPECT_EQ(store.GetSize(), 1001000u);
+    EXPECT_EQ(store.GetRunCount(), 2u);
+
+    // Delta time is part of the frame
+    store.Set(0, MakeFrame(1, kDeltaTime * 2));
+    EXPECT_FLOAT_EQ(store.Get(0).deltaTime, kDeltaTime * 2);
+    EXPECT_EQ(store.GetRunCount(), 3u);
+}
+
+TEST(RecordFrameStoreTest, MatchesVectorUnderRandomEdits) {
+    std::vector<RecordFrameData> expected = MakeRun(20000, 7);
+    RecordFrameStore store;
+    store.Assign(expected);
+    ExpectSameFrames(store, expected);
+
+    std::mt19937 rng(42);
+    for (int step = 0; step < 2000; ++step) {
+        const size_t size = expected.size();
+        const size_t frame = size > 0 ? rng() % (size + 1) : 0;
+
+        switch (rng() % 4) {
+        case 0: {
+            if (frame < size) {
+                const RecordFrameData value = MakeFrame(static_cast<int>(rng() % 4));
+                store.Set(frame, value);
+                expected[frame] = value;
+            }
+            break;
+        }
+        case 1: {
+            const size_t count = rng() % 200;
+            store.Splice(frame, count, {}, 1);
+            expected.erase(expected.begin() + frame, expected.begin() + std::min(size, frame + count));
+            break;
+        }
+        default: {
+            std::vector<RecordFrameData> pattern;
+            for (size_t i = rng() % 4; i > 0; --i) {
+                pattern.push_back(MakeFrame(static_cast<int>(rng() % 3)));
+            }
+            const size_t repeat = 1 + rng() % 50;
+            const size_t removeCount = rng() % 30;
+            store.Splice(frame, removeCount, pattern, repeat);
+
+            std::vector<RecordFrameData> inserted;
+            for (size_t i = 0; i < repeat; ++i) {
+                inserted.insert(inserted.end(), pattern.begin(), pattern.end());
+            }
+            const size_t removed = std::min(removeCount, size - frame);
+            expected.erase(expected.begin() + frame, expected.begin() + frame + removed);
+            expected.insert(expected.begin() + frame, inserted.begin(), inserted.end());
+            break;
+        }
+        }
+
+        if (step % 250 == 0) {
+            ExpectSameFrames(store, expected);
+        }
+    }
+    ExpectSameFrames(store, expected);
+
+    store.Clear();
+    EXPECT_EQ(store.GetSize(), 0u);
+    EXPECT_EQ(store.GetRunCount(), 0u);
+}
+
+TEST(RecordFrameStoreTest, CopiesShareBlocksUntilEdited) {
+    const std::vector<RecordFrameData> frames = MakeRun(20000, 11);
+    RecordFrameStore store;
+    store.Assign(frames);
+
+    RecordFrameStore branch = store;
+    EXPECT_EQ(store.GetSharedBlockCount(), store.GetBlockCount());
+
+    // An edit replaces the blocks around it and leaves the original untouched
+    std::vector<RecordFrameData> edited = frames;
+    branch.Set(10000, MakeFrame(0x100));
+    edited[10000] = MakeFrame(0x100);
+    branch.Splice(15000, 20, {MakeFrame(0x200)}, 5);
+    edited.erase(edited.begin() + 15000, edited.begin() + 15020);
+    edited.insert(edited.begin() + 15000, 5, MakeFrame(0x200));
+
+    ExpectSameFrames(store, frames);
+    ExpectSameFrames(branch, edited);
+
+    // Each edit rewrote its block and one neighbour on each side, into at most four blocks
+    EXPECT_GE(branch.GetSharedBlockCount() + 2 * 4, branch.GetBlockCount());
+}
+
+TEST(RecordFrameStoreTest, SlicesMatchVectorRanges) {
+    std::vector<RecordFrameData> frames = MakeRun(20000, 5);
+    RecordFrameStore store;
+    store.Assign(frames);
+
+    std::mt19937 rng(9);
+    for (int step = 0; step < 300; ++step) {
+        const size_t frame = rng() % (frames.size() + 1);
+        const size_t count = rng() % 3000;
+        RecordFrameStore slice = store.Slice(frame, count);
+
+        const size_t end = std::min(frames.size(), frame + count);
+        std::vector<RecordFrameData> expected(frames.begin() + std::min(frame, end), frames.begin() + end);
+        ExpectSameFrames(slice, expected);
+
+        // Editing either side must not show through the other
+        if (!expected.empty()) {
+            const size_t at = rng() % expected.size();
+            slice.Set(at, MakeFrame(0x400));
+            expected[at] = MakeFrame(0x400);
+            ExpectSameFrames(slice, expected);
+        }
+        if (frame < frames.size()) {
+            store.Set(frame, MakeFrame(static_cast<int>(step)));
+            frames[frame] = MakeFrame(static_cast<int>(step));
+        }
+    }
+    ExpectSameFrames(store, frames);
+
+    // A cursor follows a store being swapped out from under it
+    RecordFrameStore other = store.Slice(100, 50);
+    RecordFrameStore::Cursor cursor;
+    EXPECT_TRUE(RecordFrameStore::IsSameFrame(store.Get(120, cursor), frames[120]));
+    std::swap(store, other);
+    EXPECT_TRUE(RecordFrameStore::IsSameFrame(store.Get(20, cursor), frames[120]));
+    EXPECT_TRUE(RecordFrameStore::IsSameFrame(store.Get(21, cursor), frames[121]));
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+TEST(RecordFrameStoreTest, EditFortyMinuteRun) {
+    constexpr size_t kFrames = 40 * 60 * 132;
+    std::vector<RecordFrameData> frames = MakeRun(kFrames, 3);
+
+    RecordFrameStore store;
+    store.Assign(frames);
+
+    using Clock = std::chrono::steady_clock;
+    using Micros = std::chrono::duration<double, std::micro>;
+
+    // Sequential playback, reading the current and next frame like Tick
+    auto start = Clock::now();
+    RecordFrameStore::Cursor cursor;
+    int checksum = 0;
+    for (size_t i = 0; i + 1 < kFrames; ++i) {
+        checksum += store.Get(i, cursor).keyStates ^ store.Get(i + 1, cursor).keyStates;
+    }
+    const Micros sequential = Clock::now() - start;
+
+    start = Clock::now();
+    std::mt19937 rng(1);
+    for (int i = 0; i < 100000; ++i) {
+        checksum += store.Get(rng() % kFrames).keyStates;
+    }
+    const Micros random = Clock::now() - start;
+
+    // Insert and delete in the middle, against shifting the flat vector
+    start = Clock::now();
+    for (int i = 0; i < 100; ++i) {
+        store.Splice(kFrames / 2, 0, {MakeFrame(3)}, 10);
+        store.Splice(kFrames / 3, 10, {}, 1);
+    }
+    const Micros storeSplice = Clock::now() - start;
+
+    start = Clock::now();
+    for (int i = 0; i < 100; ++i) {
+        frames.insert(frames.begin() + kFrames / 2, 10, MakeFrame(3));
+        frames.erase(frames.begin() + kFrames / 3, frames.begin() + kFrames / 3 + 10);
+    }
+    const Micros vectorSplice = Clock::now() - start;
+
+    ExpectSameFrames(store, frames);
+    EXPECT_NE(checksum, -1);
+
+    printf("[ BENCH    ] %zu frames in %zu runs: %zu bytes (flat vector %zu bytes)\n", kFrames,
+           store.GetRunCount(), store.ByteSize(), kFrames * sizeof(RecordFrameData));
+    printf("[ BENCH    ] sequential read: %6.2f ns/frame, random read: %6.1f ns\n",
+           sequential.count() * 1000.0 / kFrames, random.count() * 1000.0 / 100000);
+    printf("[ BENCH    ] 200 middle splices: store %8.1f us, vector %8.1f us\n", storeSplice.count(),
+           vectorSplice.count());
+}
+
+TEST(RecordFrameStoreTest, BranchFortyMinuteRun) {
+    constexpr size_t kFrames = 40 * 60 * 132;
+    constexpr size_t kBranches = 50;
+    const std::vector<RecordFrameData> frames = MakeRun(kFrames, 3);
+
+    RecordFrameStore store;
+    store.Assign(frames);
+
+    using Clock = std::chrono::steady_clock;
+    using Micros = std::chrono::duration<double, std::micro>;
+
+    // Each branch diverges with a handful of edits, like exploratory routing
+    std::mt19937 rng(2);
+    auto start = Clock::now();
+    std::vector<RecordFrameStore> branches;
+    for (size_t i = 0; i < kBranches; ++i) {
+        RecordFrameStore branch = store;
+        for (int edit = 0; edit < 5; ++edit) {
+            branch.Set(rng() % kFrames, MakeFrame(0x100 + edit));
+        }
+        branches.push_back(std::move(branch));
+    }
+    const Micros storeBranch = Clock::now() - start;
+
+    start = Clock::now();
+    std::vector<std::vector<RecordFrameData>> flatBranches;
+    for (size_t i = 0; i < kBranches; ++i) {
+        std::vector<RecordFrameData> branch = frames;
+        for (int edit = 0; edit < 5; ++edit) {
+            branch[rng() % kFrames] = MakeFrame(0x100 + edit);
+        }
+        flatBranches.push_back(std::move(branch));
+    }
+    const Micros vectorBranch = Clock::now() - start;
+
+    // Switching is a swap of the block tables
+    start = Clock::now();
+    for (size_t i = 0; i < 1000; ++i) {
+        std::swap(store, branches[i % kBranches]);
+    }
+    const Micros storeSwitch = Clock::now() - start;
+
+    size_t ownedBlocks = 0;
+    for (const auto &branch : branches) {
+        ownedBlocks += branch.GetBlockCount() - branch.GetSharedBlockCount();
+    }
+    EXPECT_LE(ownedBlocks, kBranches * 5 * 4);
+
+    printf("[ BENCH    ] %zu branches with 5 edits: store %8.1f us, vector copies %8.1f us\n", kBranches,
+           storeBranch.count(), vectorBranch.count());
+    printf("[ BENCH    ] blocks owned by branches: %zu of %zu, flat copies hold %zu bytes\n", ownedBlocks,
+           store.GetBlockCount(), kBranches * kFrames * sizeof(RecordFrameData));
+    printf("[ BENCH    ] 1000 branch switches: %8.1f us\n", storeSwitch.count());
+}
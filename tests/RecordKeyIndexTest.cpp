@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "RecordKeyIndex.h"
+
+#include <random>
+#include <vector>
+
+namespace {
+    RecordKeyState MakeKeyState(uint32_t bits) {
+        RecordFrameData frame;
+        frame.keyState.key_up = (bits >> 0) & 1;
+        frame.keyState.key_down = (bits >> 1) & 1;
+        frame.keyState.key_left = (bits >> 2) & 1;
+        frame.keyState.key_right = (bits >> 3) & 1;
+        frame.keyState.key_shift = (bits >> 4) & 1;
+        frame.keyState.key_space = (bits >> 5) & 1;
+        frame.keyState.key_q = (bits >> 6) & 1;
+        frame.keyState.key_esc = (bits >> 7) & 1;
+        frame.keyState.key_enter = (bits >> 8) & 1;
+        return frame.keyState;
+    }
+
+    // Reference model: one slot bit mask per frame
+    void ExpectMatchesModel(const RecordKeyIndex &index, const std::vector<uint32_t> &model) {
+        ASSERT_EQ(index.GetFrameCount(), model.size());
+
+        for (size_t slot = 0; slot < RecordKeyIndex::kKeyCount; ++slot) {
+            size_t expectedCount = 0;
+            for (size_t i = 0; i < model.size(); ++i) {
+                ASSERT_EQ(index.Test(slot, i), ((model[i] >> slot) & 1) != 0);
+                expectedCount += (model[i] >> slot) & 1;
+            }
+            EXPECT_EQ(index.Count(slot, 0, model.size()), expectedCount);
+        }
+    }
+}
+
+// ============================================================================
+// Key Name Tests
+// ============================================================================
+
+TEST(RecordKeyIndexTest, KeySlots) {
+    EXPECT_EQ(RecordKeyIndex::GetKeySlot("up"), 0);
+    EXPECT_EQ(RecordKeyIndex::GetKeySlot("enter"), 8);
+    EXPECT_EQ(RecordKeyIndex::GetKeySlot("jump"), -1);
+    EXPECT_STREQ(RecordKeyIndex::GetKeyName(5), "space");
+    EXPECT_STREQ(RecordKeyIndex::GetKeyName(42), "");
+}
+
+// ============================================================================
+// Query Tests
+// ============================================================================
+
+TEST(RecordKeyIndexTest, CountAndFind) {
+    RecordKeyIndex index;
+    index.Reset(200);
+
+    // "up" on every third frame, "space" on every even frame
+    for (size_t i = 0; i < 200; ++i) {
+        uint32_t bits = 0;
+        if (i % 3 == 0) bits |= 1u << 0;
+        if (i % 2 == 0) bits |= 1u << 5;
+        index.SetFrame(i, MakeKeyState(bits));
+    }
+
+    EXPECT_EQ(index.Count(0, 0, 200), 67u);
+    EXPECT_EQ(index.Count(5, 10, 20), 5u);
+    EXPECT_EQ(index.Count(1, 0, 200), 0u);
+
+    std::vector<size_t> frames;
+    index.FindAll((1u << 0) | (1u << 5), 60, 130, frames);
+    ASSERT_EQ(frames.size(), 12u);
+    EXPECT_EQ(frames.front(), 60u);
+    EXPECT_EQ(frames.back(), 126u);
+
+    EXPECT_EQ(index.FindChange(0, 0), 1u);
+    EXPECT_EQ(index.FindChange(0, 1), 3u);
+    EXPECT_EQ(index.FindChange(1, 0), RecordKeyIndex::npos);
+}
+
+// ============================================================================
+// Incremental Update Tests
+// ============================================================================
+
+TEST(RecordKeyIndexTest, IncrementalEditsMatchModel) {
+    std::mt19937 rng(1234);
+    std::vector<uint32_t> model(1000);
+    for (auto &bits : model) {
+        bits = rng() & 0x1FF;
+    }
+
+    RecordKeyIndex index;
+    index.Reset(model.size());
+    for (size_t i = 0; i < model.size(); ++i) {
+        index.SetFrame(i, MakeKeyState(model[i]));
+    }
+    ExpectMatchesModel(index, model);
+
+    for (int step = 0; step < 50; ++step) {
+        const size_t pos = rng() % (model.size() + 1);
+        const size_t count = rng() % 150;
+
+        switch (rng() % 3) {
+        case 0:
+            index.Insert(pos, count);
+            model.insert(model.begin() + pos, count, 0);
+            break;
+        case 1:
+            if (pos < model.size()) {
+                const size_t actual = std::min(count, model.size() - pos);
+                index.Erase(pos, actual);
+                model.erase(model.begin() + pos, model.begin() + pos + actual);
+            }
+            break;
+        default:
+            if (pos < model.size()) {
+                model[pos] = rng() & 0x1FF;
+                index.SetFrame(pos, MakeKeyState(model[pos]));
+            }
+            break;
+        }
+
+        ExpectMatchesModel(index, model);
+    }
+}
+
+TEST(RecordKeyIndexTest, NotBuiltIgnoresEdits) {
+    RecordKeyIndex index;
+    index.SetFrame(0, MakeKeyState(1));
+    index.Insert(0, 10);
+
+    EXPECT_FALSE(index.IsBuilt());
+    EXPECT_EQ(index.GetFrameCount(), 0u);
+}
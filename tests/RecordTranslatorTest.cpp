@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "RecordTranslator.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr float kDeltaTime = 1000.0f / 132.0f;
+
+    RecordFrameData MakeFrame(bool up, bool space, bool right) {
+        RecordFrameData frame(kDeltaTime);
+        frame.keyState.key_up = up;
+        frame.keyState.key_space = space;
+        frame.keyState.key_right = right;
+        return frame;
+    }
+
+    // Shaped like a real run: long holds with the occasional tap
+    std::vector<RecordFrameData> MakeRun(size_t frameCount) {
+        std::vector<RecordFrameData> frames;
+        frames.reserve(frameCount);
+        for (size_t i = 0; i < frameCount; ++i) {
+            frames.push_back(MakeFrame((i / 97) % 3 != 0, i % 211 == 0, (i / 53) % 2 == 0));
+        }
+        return frames;
+    }
+}
+
+// ============================================================================
+// Conversion Tests
+// ============================================================================
+
+TEST(RecordTranslatorTest, MatchesPlaybackKeyStates) {
+    EXPECT_EQ(RecordTranslator::ConvertKeyState(false, false), KS_IDLE);
+    EXPECT_EQ(RecordTranslator::ConvertKeyState(false, true), KS_IDLE);
+    EXPECT_EQ(RecordTranslator::ConvertKeyState(true, true), KS_PRESSED);
+    EXPECT_EQ(RecordTranslator::ConvertKeyState(true, false), KS_PRESSED | KS_RELEASED);
+
+    // up held for frames 0-2, space tapped on frame 3, right held through the end
+    const std::vector<RecordFrameData> records = {
+        MakeFrame(true, false, false),
+        MakeFrame(true, false, true),
+        MakeFrame(true, false, true),
+        MakeFrame(false, true, true),
+    };
+
+    std::vector<FrameData> frames;
+    RecordTranslator::ConvertFrames(records, kDeltaTime, frames);
+    ASSERT_EQ(frames.size(), records.size());
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+        EXPECT_EQ(frames[i].frameIndex, i);
+        EXPECT_FLOAT_EQ(frames[i].deltaTime, kDeltaTime);
+        EXPECT_TRUE(frames[i].events.empty());
+    }
+
+    EXPECT_EQ(frames[0].inputState.keyUp, KS_PRESSED);
+    EXPECT_EQ(frames[2].inputState.keyUp, KS_PRESSED | KS_RELEASED);
+    EXPECT_EQ(frames[3].inputState.keyUp, KS_IDLE);
+    EXPECT_EQ(frames[3].inputState.keySpace, KS_PRESSED | KS_RELEASED);
+
+    // The frame after the last one is blank, so held keys are released at the end
+    EXPECT_EQ(frames[1].inputState.keyRight, KS_PRESSED);
+    EXPECT_EQ(frames[3].inputState.keyRight, KS_PRESSED | KS_RELEASED);
+}
+
+TEST(RecordTranslatorTest, LoadsChunkedRecords) {
+    const fs::path path = fs::temp_directory_path() / "tas_record_translator_test.tas";
+    const std::vector<RecordFrameData> records = MakeRun(10000);
+    ASSERT_TRUE(ChunkedRecordWriter::Write(path.string(), records.data(), records.size(), 1024));
+
+    std::vector<RecordFrameData> loaded;
+    ASSERT_TRUE(RecordTranslator::LoadFrames(path.string(), loaded));
+    ASSERT_EQ(loaded.size(), records.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+        ASSERT_EQ(loaded[i].keyStates, records[i].keyStates) << "frame " << i;
+    }
+
+    fs::remove(path);
+    EXPECT_FALSE(RecordTranslator::LoadFrames(path.string(), loaded));
+}
+
+TEST(RecordTranslatorTest, RejectsShortInnerBlocks) {
+    const fs::path path = fs::temp_directory_path() / "tas_record_translator_corrupt.tas";
+    const std::vector<RecordFrameData> records = MakeRun(3000);
+    ASSERT_TRUE(ChunkedRecordWriter::Write(path.string(), records.data(), records.size(), 1024));
+
+    ChunkedRecordReader reader;
+    ASSERT_TRUE(reader.Open(path.string()));
+    reader.Close();
+
+    // Move 24 frames from the first block to the last one; the total still adds up
+    RecordFileFooter footer = {};
+    std::vector<RecordBlockEntry> index;
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(-static_cast<std::streamoff>(sizeof(footer)), std::ios::end);
+        file.read(reinterpret_cast<char *>(&footer), sizeof(footer));
+        ASSERT_EQ(footer.blockCount, 3u);
+
+        index.resize(footer.blockCount);
+        file.seekg(static_cast<std::streamoff>(footer.indexOffset), std::ios::beg);
+        file.read(reinterpret_cast<char *>(index.data()), sizeof(RecordBlockEntry) * index.size());
+        index.front().frameCount -= 24;
+        index.back().frameCount += 24;
+        file.seekp(static_cast<std::streamoff>(footer.indexOffset), std::ios::beg);
+        file.write(reinterpret_cast<const char *>(index.data()), sizeof(RecordBlockEntry) * index.size());
+        ASSERT_TRUE(file.good());
+    }
+
+    EXPECT_FALSE(reader.Open(path.string()));
+    EXPECT_EQ(reader.GetFrame(1500), nullptr);
+
+    fs::remove(path);
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+TEST(RecordTranslatorTest, ConvertFortyMinuteRun) {
+    constexpr size_t kFrames = 40 * 60 * 132;
+    const std::vector<RecordFrameData> records = MakeRun(kFrames);
+
+    std::vector<FrameData> frames;
+    const auto start = std::chrono::steady_clock::now();
+    RecordTranslator::ConvertFrames(records, kDeltaTime, frames);
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(frames.size(), kFrames);
+    printf("[ BENCH    ] convert %zu record frames (40 min at 132 Hz): %8.2f ms\n", kFrames, elapsed.count());
+}
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include "RecordingStream.h"
+
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace {
+    constexpr size_t kFrameCount = 500000;
+
+    std::vector<FrameData> MakeFrames() {
+        std::vector<FrameData> frames(kFrameCount);
+        for (size_t i = 0; i < frames.size(); ++i) {
+            FrameData &frame = frames[i];
+            frame.frameIndex = i;
+            frame.deltaTime = 1000.0f / 132.0f;
+            frame.inputState.keyUp = (i / 40) % 2 ? KS_PRESSED : KS_IDLE;
+            frame.physics.position = VxVector(static_cast<float>(i), 1.0f, 2.0f);
+            frame.physics.velocity = VxVector(0.5f, 0.0f, static_cast<float>(i % 7));
+            if (i % 10000 == 0) {
+                frame.events.emplace_back(i, "post_checkpoint_reached", static_cast<int>(i / 10000));
+            }
+        }
+        return frames;
+    }
+
+    // The version 1 dump: one write per field per frame
+    bool WriteLegacy(const std::string &path, const std::vector<FrameData> &frames) {
+        std::ofstream file(path, std::ios::binary);
+        const uint32_t version = 1;
+        const uint32_t frameCount = static_cast<uint32_t>(frames.size());
+        const float deltaTime = 1000.0f / 132.0f;
+        file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+        file.write(reinterpret_cast<const char *>(&frameCount), sizeof(frameCount));
+        file.write(reinterpret_cast<const char *>(&deltaTime), sizeof(deltaTime));
+
+        for (const auto &frame : frames) {
+            file.write(reinterpret_cast<const char *>(&frame.frameIndex), sizeof(frame.frameIndex));
+            file.write(reinterpret_cast<const char *>(&frame.deltaTime), sizeof(frame.deltaTime));
+            file.write(reinterpret_cast<const char *>(&frame.inputState), sizeof(frame.inputState));
+            file.write(reinterpret_cast<const char *>(&frame.physics), sizeof(frame.physics));
+
+            uint32_t eventCount = static_cast<uint32_t>(frame.events.size());
+            file.write(reinterpret_cast<const char *>(&eventCount), sizeof(eventCount));
+            for (const auto &event : frame.events) {
+                file.write(reinterpret_cast<const char *>(&event.frame), sizeof(event.frame));
+                file.write(reinterpret_cast<const char *>(&event.eventData), sizeof(event.eventData));
+                uint32_t nameLength = static_cast<uint32_t>(event.eventName.length());
+                file.write(reinterpret_cast<const char *>(&nameLength), sizeof(nameLength));
+                file.write(event.eventName.c_str(), nameLength);
+            }
+        }
+        return static_cast<bool>(file);
+    }
+
+    template <typename Fn>
+    double MeasureSeconds(Fn &&fn) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double ThroughputMB(const std::string &path, double seconds) {
+        return static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0) / seconds;
+    }
+}
+
+// ============================================================================
+// Round Trip
+// ============================================================================
+
+TEST(RecordingStreamTest, RoundTripThroughMapping) {
+    const std::vector<FrameData> frames = MakeFrames();
+    const std::string path = (std::filesystem::temp_directory_path() / "tas_stream_roundtrip.bin").string();
+
+    ASSERT_TRUE(RecordingStreamWriter::WriteFrames(path, 1000.0f / 132.0f, frames));
+    ASSERT_TRUE(RecordingStreamReader::IsStreamFile(path));
+
+    RecordingStreamReader reader;
+    ASSERT_TRUE(reader.Open(path));
+    EXPECT_EQ(reader.GetFrameCount(), frames.size());
+
+    size_t base = 0;
+    size_t events = 0;
+    for (const auto &chunk : reader.GetChunks()) {
+        for (uint32_t i = 0; i < chunk.frameCount; ++i) {
+            ASSERT_EQ(chunk.frames[i].frameIndex, frames[base + i].frameIndex);
+            ASSERT_EQ(chunk.frames[i].input.keyUp, frames[base + i].inputState.keyUp);
+            ASSERT_EQ(chunk.frames[i].position[0], frames[base + i].physics.position.x);
+        }
+        for (uint32_t i = 0; i < chunk.eventCount; ++i) {
+            EXPECT_EQ(reader.GetEventName(chunk.events[i].nameId), "post_checkpoint_reached");
+            EXPECT_EQ(base + chunk.events[i].frame, chunk.events[i].tick);
+        }
+        base += chunk.frameCount;
+        events += chunk.eventCount;
+    }
+    EXPECT_EQ(events, kFrameCount / 10000);
+
+    reader.Close();
+    std::filesystem::remove(path);
+}
+
+TEST(RecordingStreamTest, RejectsOutOfRangeEventNameIds) {
+    std::vector<FrameData> frames(100);
+    for (size_t i = 0; i < frames.size(); ++i) {
+        frames[i].frameIndex = i;
+    }
+    frames[50].events.emplace_back(50, "post_checkpoint_reached", 1);
+    const std::string path = (std::filesystem::temp_directory_path() / "tas_stream_bad_name.bin").string();
+    ASSERT_TRUE(RecordingStreamWriter::WriteFrames(path, 1000.0f / 132.0f, frames));
+
+    // The name definition is the ID and the length, then the name itself
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    const size_t name = bytes.find("post_checkpoint_reached");
+    ASSERT_NE(name, std::string::npos);
+    ASSERT_GE(name, 2 * sizeof(uint32_t));
+    const uint32_t badId = 0xFFFFFFFF;
+    memcpy(&bytes[name - 2 * sizeof(uint32_t)], &badId, sizeof(badId));
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    RecordingStreamReader reader;
+    EXPECT_FALSE(reader.Open(path));
+    EXPECT_EQ(reader.GetFrameCount(), 0u);
+
+    std::filesystem::remove(path);
+}
+
+// ============================================================================
+// Throughput Benchmark
+// ============================================================================
+
+TEST(RecordingStreamTest, ThroughputAgainstPerFieldWrites) {
+    const std::vector<FrameData> frames = MakeFrames();
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string legacyPath = (dir / "tas_stream_legacy.bin").string();
+    const std::string streamPath = (dir / "tas_stream_chunked.bin").string();
+
+    bool legacyOk = false;
+    bool streamOk = false;
+    const double legacySeconds = MeasureSeconds([&] { legacyOk = WriteLegacy(legacyPath, frames); });
+    const double streamSeconds = MeasureSeconds([&] {
+        streamOk = RecordingStreamWriter::WriteFrames(streamPath, 1000.0f / 132.0f, frames);
+    });
+    ASSERT_TRUE(legacyOk);
+    ASSERT_TRUE(streamOk);
+
+    // Time spent on the recording thread when frames are appended as they are captured
+    RecordingStreamWriter writer;
+    ASSERT_TRUE(writer.Open(streamPath, 1000.0f / 132.0f));
+    const double appendSeconds = MeasureSeconds([&] {
+        for (const auto &frame : frames) {
+            writer.AppendFrame(frame.frameIndex, frame.inputState, frame.deltaTime, frame.physics);
+        }
+    });
+    ASSERT_TRUE(writer.Close());
+
+    printf("[ BENCH    ] %zu frames\n", frames.size());
+    printf("[ BENCH    ] per-field writes : %8.2f ms (%8.1f MB/s)\n", legacySeconds * 1000.0,
+           ThroughputMB(legacyPath, legacySeconds));
+    printf("[ BENCH    ] streamed chunks  : %8.2f ms (%8.1f MB/s)\n", streamSeconds * 1000.0,
+           ThroughputMB(streamPath, streamSeconds));
+    printf("[ BENCH    ] append per frame : %8.1f ns on the recording thread\n",
+           appendSeconds * 1e9 / static_cast<double>(frames.size()));
+
+    std::filesystem::remove(legacyPath);
+    std::filesystem::remove(streamPath);
+}
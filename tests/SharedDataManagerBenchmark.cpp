@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include "SharedDataManager.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr int kKeyCount = 100000;
+    constexpr int kTtlEvery = 100; // 1% of the keys carry a TTL
+
+    // The manager only keeps the engine pointer for validation, it is never dereferenced
+    TASEngine *FakeEngine() {
+        static int storage;
+        return reinterpret_cast<TASEngine *>(&storage);
+    }
+
+    std::string KeyName(int i) {
+        return "key_" + std::to_string(i);
+    }
+
+    void Populate(SharedDataManager &shared, sol::state &lua) {
+        for (int i = 0; i < kKeyCount; ++i) {
+            SharedDataManager::SetOptions options;
+            if (i % kTtlEvery == 0) {
+                options.ttl_ms = 60000;
+            }
+            ASSERT_TRUE(shared.Set(KeyName(i), sol::make_object(lua, static_cast<double>(i)), options));
+        }
+    }
+
+    double TickNs(SharedDataManager &shared, int ticks) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ticks; ++i) {
+            shared.Tick();
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / ticks;
+    }
+
+    // Each reader thread stands in for a context with its own Lua state
+    double ReadNsPerOp(SharedDataManager &shared, int readers, int readsPerThread) {
+        std::atomic<int> ready{0};
+        std::atomic<bool> go{false};
+        std::atomic<long long> misses{0};
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < readers; ++t) {
+            threads.emplace_back([&, t] {
+                sol::state lua;
+                std::vector<std::string> keys;
+                keys.reserve(1024);
+                for (int i = 0; i < 1024; ++i) {
+                    keys.push_back(KeyName((i * 97 + t * 7919) % kKeyCount));
+                }
+
+                ready.fetch_add(1);
+                while (!go.load()) {
+                    std::this_thread::yield();
+                }
+
+                long long localMisses = 0;
+                for (int i = 0; i < readsPerThread; ++i) {
+                    const std::string &key = keys[i & 1023];
+                    if ((i & 3) == 0) {
+                        sol::object value = shared.Get(lua, key);
+                        localMisses += value.is<double>() ? 0 : 1;
+                    } else {
+                        localMisses += shared.Has(key) ? 0 : 1;
+                    }
+                }
+                misses.fetch_add(localMisses);
+            });
+        }
+
+        while (ready.load() < readers) {
+            std::this_thread::yield();
+        }
+        const auto start = std::chrono::steady_clock::now();
+        go.store(true);
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        EXPECT_EQ(misses.load(), 0);
+        return elapsed.count() / (static_cast<double>(readers) * readsPerThread);
+    }
+}
+
+// ============================================================================
+// Expiry Tests
+// ============================================================================
+
+TEST(SharedDataManagerTest, ExpiresOnlyKeysThatAreDue) {
+    SharedDataManager shared(FakeEngine());
+    ASSERT_TRUE(shared.Initialize());
+    sol::state lua;
+
+    SharedDataManager::SetOptions shortTtl;
+    shortTtl.ttl_ms = 20;
+    ASSERT_TRUE(shared.Set("short", sol::make_object(lua, 1.0), shortTtl));
+    ASSERT_TRUE(shared.Set("forever", sol::make_object(lua, 2.0)));
+
+    // Setting a key again replaces its deadline
+    ASSERT_TRUE(shared.Set("renewed", sol::make_object(lua, 3.0), shortTtl));
+    ASSERT_TRUE(shared.Set("renewed", sol::make_object(lua, 4.0)));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    EXPECT_FALSE(shared.Has("short"));
+    shared.Tick();
+
+    EXPECT_FALSE(shared.Has("short"));
+    EXPECT_TRUE(shared.Has("forever"));
+    EXPECT_TRUE(shared.Has("renewed"));
+    EXPECT_EQ(shared.GetSize(), 2u);
+    EXPECT_EQ(shared.Get(lua, "renewed").as<double>(), 4.0);
+}
+
+TEST(SharedDataManagerTest, TypedSlotTracksVersions) {
+    SharedDataManager shared(FakeEngine());
+    ASSERT_TRUE(shared.Initialize());
+
+    auto slot = shared.GetSlot("ball");
+    EXPECT_EQ(shared.GetSlot("ball").get(), slot.get());
+    EXPECT_EQ(slot->GetVersion(), 0u);
+
+    SharedSlot::Value value;
+    value.type = SharedSlot::Type::Vector;
+    value.count = 3;
+    value.floats = {1.0f, 2.0f, 3.0f};
+    const uint64_t written = slot->Store(value);
+
+    uint64_t seen = 0;
+    SharedSlot::Value read;
+    ASSERT_TRUE(slot->LoadIfChanged(seen, read));
+    EXPECT_EQ(seen, written);
+    EXPECT_EQ(read, value);
+    EXPECT_FALSE(slot->LoadIfChanged(seen, read));
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+TEST(SharedDataManagerTest, Benchmark) {
+    SharedDataManager shared(FakeEngine());
+    ASSERT_TRUE(shared.Initialize());
+    sol::state lua;
+    Populate(shared, lua);
+    ASSERT_EQ(shared.GetSize(), static_cast<size_t>(kKeyCount));
+
+    printf("[ BENCH    ] Tick with %d keys (%d with TTL, none due): %8.1f ns\n",
+           kKeyCount, kKeyCount / kTtlEvery, TickNs(shared, 1000));
+
+    for (int readers : {1, 2, 4, 8}) {
+        printf("[ BENCH    ] %d reader context(s): %8.1f ns/read\n",
+               readers, ReadNsPerOp(shared, readers, 400000));
+    }
+}
+
+TEST(SharedDataManagerTest, BallStateKeyedVersusSlot) {
+    constexpr int kIterations = 200000;
+    SharedDataManager shared(FakeEngine());
+    ASSERT_TRUE(shared.Initialize());
+    sol::state writer;
+    sol::state reader;
+
+    // Keyed value: a table serialized on set and rebuilt on every get
+    sol::table ball = writer.create_table_with("x", 1.0, "y", 2.0, "z", 3.0, "speed", 4.0);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        ball["x"] = static_cast<double>(i);
+        shared.Set("ball", ball);
+        sol::object value = shared.Get(reader, "ball");
+        ASSERT_TRUE(value.is<sol::table>());
+    }
+    const std::chrono::duration<double, std::nano> keyed = std::chrono::steady_clock::now() - start;
+
+    // Typed slot: fixed layout, read in place
+    auto slot = shared.GetSlot("ball");
+    SharedSlot::Value value;
+    value.type = SharedSlot::Type::FloatArray;
+    value.count = 4;
+    SharedSlot::Value read;
+    uint64_t seen = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        value.floats[0] = static_cast<float>(i);
+        slot->Store(value);
+        ASSERT_TRUE(slot->LoadIfChanged(seen, read));
+    }
+    const std::chrono::duration<double, std::nano> typed = std::chrono::steady_clock::now() - start;
+
+    reader.collect_garbage();
+    printf("[ BENCH    ] ball state set+get: keyed table %8.1f ns, typed slot %8.1f ns\n",
+           keyed.count() / kIterations, typed.count() / kIterations);
+}
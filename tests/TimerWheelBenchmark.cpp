@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "TimerWheel.h"
+
+#include <chrono>
+#include <cstdio>
+#include <list>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+    // Mirrors the polled TickWaitTask the scheduler used for every sleeping coroutine
+    class PolledTask {
+    public:
+        virtual ~PolledTask() = default;
+        virtual bool IsComplete() = 0;
+    };
+
+    class PolledTickWait : public PolledTask {
+    public:
+        explicit PolledTickWait(int ticks) : m_RemainingTicks(ticks) {}
+
+        bool IsComplete() override {
+            --m_RemainingTicks;
+            return m_RemainingTicks <= 0;
+        }
+
+    private:
+        int m_RemainingTicks;
+    };
+
+    constexpr int kSleepTicks = 600;
+    constexpr int kMeasuredTicks = 1200;
+
+    // Every sleeper wakes, then immediately sleeps again (a wait_ticks loop)
+    double PolledNsPerTick(size_t sleepers) {
+        std::list<std::shared_ptr<PolledTask>> tasks;
+        for (size_t i = 0; i < sleepers; ++i) {
+            tasks.push_back(std::make_shared<PolledTickWait>(1 + static_cast<int>(i % kSleepTicks)));
+        }
+
+        size_t wakeups = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int tick = 0; tick < kMeasuredTicks; ++tick) {
+            for (auto it = tasks.begin(); it != tasks.end();) {
+                if ((*it)->IsComplete()) {
+                    it = tasks.erase(it);
+                    tasks.push_back(std::make_shared<PolledTickWait>(kSleepTicks));
+                    ++wakeups;
+                } else {
+                    ++it;
+                }
+            }
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        EXPECT_GT(wakeups, 0u);
+        return elapsed.count() / kMeasuredTicks;
+    }
+
+    double WheelNsPerTick(size_t sleepers) {
+        TimerWheel<size_t> wheel;
+        for (size_t i = 0; i < sleepers; ++i) {
+            wheel.Schedule(1 + i % kSleepTicks, i);
+        }
+
+        std::vector<size_t> expired;
+        size_t wakeups = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int tick = 0; tick < kMeasuredTicks; ++tick) {
+            wheel.Advance(expired);
+            for (size_t id : expired) {
+                wheel.Schedule(wheel.Now() + kSleepTicks, id);
+            }
+            wakeups += expired.size();
+            expired.clear();
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        EXPECT_GT(wakeups, 0u);
+        EXPECT_EQ(wheel.Size(), sleepers);
+        return elapsed.count() / kMeasuredTicks;
+    }
+}
+
+// ============================================================================
+// Expiry Tests
+// ============================================================================
+
+TEST(TimerWheelTest, ExpiresExactlyAtDueTick) {
+    std::mt19937_64 rng(42);
+    TimerWheel<uint64_t> wheel;
+    std::multimap<uint64_t, uint64_t> model;
+    std::vector<uint64_t> expired;
+
+    for (int tick = 0; tick < 300000; ++tick) {
+        for (int i = rng() % 3; i > 0; --i) {
+            // Spread distances across all levels and the overflow list
+            static const uint64_t kRanges[] = {70, 5000, 300000, uint64_t(1) << 25};
+            const uint64_t due = wheel.Now() + 1 + rng() % kRanges[rng() % 4];
+            wheel.Schedule(due, due);
+            model.emplace(due, due);
+        }
+
+        expired.clear();
+        wheel.Advance(expired);
+        for (uint64_t due : expired) {
+            ASSERT_EQ(due, wheel.Now());
+            model.erase(model.find(due));
+        }
+        ASSERT_TRUE(model.empty() || model.begin()->first > wheel.Now());
+        ASSERT_EQ(wheel.Size(), model.size());
+    }
+}
+
+TEST(TimerWheelTest, PastDueIsClampedToNextTick) {
+    TimerWheel<int> wheel;
+    std::vector<int> expired;
+    wheel.Advance(expired);
+    wheel.Schedule(0, 7);
+
+    wheel.Advance(expired);
+    ASSERT_EQ(expired.size(), 1u);
+    EXPECT_EQ(expired[0], 7);
+    EXPECT_TRUE(wheel.IsEmpty());
+}
+
+// ============================================================================
+// Tick Cost Benchmark
+// ============================================================================
+
+TEST(TimerWheelTest, TickCostAgainstSleepingCoroutines) {
+    for (size_t sleepers : {100u, 1000u, 5000u, 20000u}) {
+        const double polled = PolledNsPerTick(sleepers);
+        const double wheel = WheelNsPerTick(sleepers);
+        printf("[ BENCH    ] %6zu sleeping: polled %10.1f ns/tick, wheel %8.1f ns/tick\n",
+               sleepers, polled, wheel);
+    }
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace {
+    // Stands in for one context tick: a fixed amount of independent work
+    uint64_t Spin(uint64_t seed, int iterations) {
+        uint64_t x = seed;
+        for (int i = 0; i < iterations; ++i) {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+        }
+        return x;
+    }
+}
+
+// ============================================================================
+// Batch Tests
+// ============================================================================
+
+TEST(WorkerPoolTest, RunsEveryIndexOnce) {
+    WorkerPool pool(3);
+    for (size_t count : {0u, 1u, 2u, 7u, 1000u}) {
+        std::vector<std::atomic<int>> hits(count);
+        pool.ParallelFor(count, [&](size_t i) { hits[i].fetch_add(1); });
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(hits[i].load(), 1) << "count " << count << " index " << i;
+        }
+    }
+}
+
+TEST(WorkerPoolTest, ResultsVisibleAfterJoin) {
+    WorkerPool pool(4);
+    std::vector<uint64_t> results(64);
+    for (int round = 0; round < 200; ++round) {
+        pool.ParallelFor(results.size(), [&](size_t i) { results[i] = Spin(i + round, 100); });
+        for (size_t i = 0; i < results.size(); ++i) {
+            ASSERT_EQ(results[i], Spin(i + round, 100));
+        }
+    }
+}
+
+TEST(WorkerPoolTest, DeferredSubscriptionsMatchSerialOrder) {
+    // Mirrors ScriptContextManager: isolated contexts subscribe to events while ticking on
+    // the pool, into an unlocked table, and their calls are replayed in priority order
+    constexpr size_t kContexts = 8;
+    constexpr size_t kEvents = 5;
+    using Table = std::vector<std::vector<size_t>>;
+
+    auto tick = [](Table &table, size_t context, int round) {
+        for (size_t i = 0; i < 20; ++i) {
+            const size_t event = (context * 7 + i + round) % kEvents;
+            WorkerPool::RunOrDefer([&table, context, event] {
+                auto &subscribers = table[event];
+                if (std::find(subscribers.begin(), subscribers.end(), context) == subscribers.end()) {
+                    subscribers.push_back(context);
+                } else {
+                    subscribers.erase(std::find(subscribers.begin(), subscribers.end(), context));
+                }
+            });
+        }
+    };
+
+    WorkerPool pool(4);
+    std::vector<WorkerPool::DeferredActions> deferred(kContexts);
+    Table serial(kEvents);
+    Table parallel(kEvents);
+    for (int round = 0; round < 100; ++round) {
+        for (size_t context = 0; context < kContexts; ++context) {
+            tick(serial, context, round);
+        }
+
+        pool.ParallelFor(kContexts, [&](size_t context) {
+            WorkerPool::DeferScope scope(deferred[context]);
+            Spin(context, 1000 * static_cast<int>(kContexts - context)); // Finish out of order
+            tick(parallel, context, round);
+        });
+        for (size_t context = 0; context < kContexts; ++context) {
+            WorkerPool::RunDeferred(deferred[context]);
+            EXPECT_TRUE(deferred[context].empty());
+        }
+        ASSERT_EQ(parallel, serial) << "round " << round;
+    }
+
+    // Without a scope the action runs at once
+    bool ran = false;
+    EXPECT_FALSE(WorkerPool::RunOrDefer([&ran] { ran = true; }));
+    EXPECT_TRUE(ran);
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+TEST(WorkerPoolTest, TickCostAgainstContextCount) {
+    constexpr int kTicks = 200;
+    constexpr int kWorkPerContext = 20000;
+    WorkerPool pool;
+    std::vector<uint64_t> sink(16);
+
+    for (size_t contexts : {1u, 2u, 4u, 8u, 16u}) {
+        auto start = std::chrono::steady_clock::now();
+        for (int tick = 0; tick < kTicks; ++tick) {
+            for (size_t i = 0; i < contexts; ++i) {
+                sink[i] = Spin(sink[i] + 1, kWorkPerContext);
+            }
+        }
+        const std::chrono::duration<double, std::micro> serial = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        for (int tick = 0; tick < kTicks; ++tick) {
+            pool.ParallelFor(contexts, [&](size_t i) { sink[i] = Spin(sink[i] + 1, kWorkPerContext); });
+        }
+        const std::chrono::duration<double, std::micro> parallel = std::chrono::steady_clock::now() - start;
+
+        printf("[ BENCH    ] %2zu contexts: serial %8.1f us/tick, parallel %8.1f us/tick (%zu workers)\n",
+               contexts, serial.count() / kTicks, parallel.count() / kTicks, pool.GetThreadCount());
+    }
+}